@@ -0,0 +1,96 @@
+#include "bench.h"
+
+#include <errno.h>
+#include <stdlib.h>
+
+#if LELY_BENCH_NALLOC
+
+// The number of successful heap allocations. The benchmarks are
+// single-threaded, so the counter does not need to be atomic.
+static size_t nalloc;
+
+// The glibc implementations of the allocation functions. Replacing malloc()
+// and friends in the executable also intercepts the calls made by the Lely
+// libraries.
+void *__libc_malloc(size_t size);
+void *__libc_calloc(size_t nmemb, size_t size);
+void *__libc_realloc(void *ptr, size_t size);
+void *__libc_memalign(size_t alignment, size_t size);
+void __libc_free(void *ptr);
+
+size_t
+bench_nalloc(void)
+{
+	return nalloc;
+}
+
+void *
+malloc(size_t size)
+{
+	void *ptr = __libc_malloc(size);
+	if (ptr)
+		nalloc++;
+	return ptr;
+}
+
+void *
+calloc(size_t nmemb, size_t size)
+{
+	void *ptr = __libc_calloc(nmemb, size);
+	if (ptr)
+		nalloc++;
+	return ptr;
+}
+
+void *
+realloc(void *ptr, size_t size)
+{
+	ptr = __libc_realloc(ptr, size);
+	if (ptr)
+		nalloc++;
+	return ptr;
+}
+
+void *
+memalign(size_t alignment, size_t size)
+{
+	void *ptr = __libc_memalign(alignment, size);
+	if (ptr)
+		nalloc++;
+	return ptr;
+}
+
+void *
+aligned_alloc(size_t alignment, size_t size)
+{
+	return memalign(alignment, size);
+}
+
+int
+posix_memalign(void **memptr, size_t alignment, size_t size)
+{
+	if (!alignment || (alignment & (alignment - 1))
+			|| alignment % sizeof(void *))
+		return EINVAL;
+	void *ptr = memalign(alignment, size);
+	if (!ptr && size)
+		return ENOMEM;
+	*memptr = ptr;
+	return 0;
+}
+
+void
+free(void *ptr)
+{
+	__libc_free(ptr);
+}
+
+#else // !LELY_BENCH_NALLOC
+
+size_t
+bench_nalloc(void)
+{
+	return 0;
+}
+
+#endif // !LELY_BENCH_NALLOC
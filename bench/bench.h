@@ -0,0 +1,76 @@
+#ifndef LELY_BENCH_INTERN_BENCH_H_
+#define LELY_BENCH_INTERN_BENCH_H_
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <lely/compat/time.h>
+#include <lely/util/time.h>
+
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * Heap allocations can only be counted if the C library allows malloc() and
+ * friends to be replaced (see bench.c).
+ */
+#ifndef LELY_BENCH_NALLOC
+#if defined(__GLIBC__) && !LELY_NO_MALLOC
+#define LELY_BENCH_NALLOC 1
+#else
+#define LELY_BENCH_NALLOC 0
+#endif
+#endif
+
+/**
+ * Returns the total number of heap allocations (successful calls to malloc(),
+ * calloc(), realloc(), aligned_alloc(), memalign() and posix_memalign())
+ * performed by the process, or 0 if #LELY_BENCH_NALLOC is 0.
+ */
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+size_t bench_nalloc(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+/// Returns the current value of the monotonic clock (in nanoseconds).
+static inline int_least64_t
+bench_now(void)
+{
+	struct timespec now = { 0, 0 };
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (int_least64_t)now.tv_sec * 1000000000 + now.tv_nsec;
+}
+
+/**
+ * Prints the result of a benchmark.
+ *
+ * @param name   the name of the benchmark.
+ * @param n      the number of operations performed.
+ * @param ns     the total duration (in nanoseconds) of the operations.
+ * @param nalloc the total number of heap allocations performed by the
+ *               operations (see bench_nalloc()).
+ */
+static inline void
+bench_report(const char *name, uint_least64_t n, int_least64_t ns,
+		size_t nalloc)
+{
+	double ns_op = n ? (double)ns / n : 0;
+	printf("%-48s %12" PRIuLEAST64 " ops %10.1f ns/op %14.0f ops/s", name,
+			n, ns_op, ns_op > 0 ? 1e9 / ns_op : 0);
+#if LELY_BENCH_NALLOC
+	printf(" %8.2f allocs/op", n ? (double)nalloc / n : 0);
+#else
+	(void)nalloc;
+#endif
+	printf("\n");
+	fflush(stdout);
+}
+
+#endif // !LELY_BENCH_INTERN_BENCH_H_
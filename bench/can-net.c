@@ -0,0 +1,73 @@
+#include "bench.h"
+#include <lely/can/net.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NUM_NODES 127
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+// The COB-IDs of the receivers of a fully populated master: EMCY consumers,
+// RPDOs, SDO clients and heartbeat consumers for every node.
+static const uint_least32_t cobid[] = { 0x080, 0x180, 0x280, 0x580, 0x700 };
+
+#define NUM_RECV (sizeof(cobid) / sizeof(*cobid) * NUM_NODES)
+
+static int recv_func(const struct can_msg *msg, void *data);
+
+static void bench_recv(const char *name, enum can_net_recv_lookup lookup);
+
+int
+main(void)
+{
+	bench_recv("can_net_recv() [tree]", CAN_NET_RECV_LOOKUP_TREE);
+	bench_recv("can_net_recv() [table]", CAN_NET_RECV_LOOKUP_TABLE);
+
+	return 0;
+}
+
+static int
+recv_func(const struct can_msg *msg, void *data)
+{
+	(void)msg;
+
+	++*(uint_least64_t *)data;
+
+	return 0;
+}
+
+static void
+bench_recv(const char *name, enum can_net_recv_lookup lookup)
+{
+	can_net_t *net = can_net_create(NULL);
+	assert(net);
+	if (can_net_set_recv_lookup(net, lookup) == -1)
+		abort();
+
+	uint_least64_t n = 0;
+
+	can_recv_t *recv[NUM_RECV];
+	struct can_msg msg[NUM_RECV];
+	for (size_t i = 0; i < NUM_RECV; i++) {
+		recv[i] = can_recv_create(NULL);
+		assert(recv[i]);
+		can_recv_set_func(recv[i], &recv_func, &n);
+
+		msg[i] = (struct can_msg)CAN_MSG_INIT;
+		msg[i].id = cobid[i / NUM_NODES] + 1 + i % NUM_NODES;
+		msg[i].len = CAN_MAX_LEN;
+		can_recv_start(recv[i], net, msg[i].id, 0);
+	}
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++)
+		can_net_recv(net, &msg[i % NUM_RECV]);
+	bench_report(name, n, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	for (size_t i = 0; i < NUM_RECV; i++)
+		can_recv_destroy(recv[i]);
+
+	can_net_destroy(net);
+}
@@ -0,0 +1,78 @@
+#include "bench.h"
+#include <lely/can/net.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NUM_NODES 127
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+// The heartbeat producer time of each node, and the (slightly longer) consumer
+// time of the master.
+#define HB_PRODUCER_MS 100
+#define HB_CONSUMER_MS 150
+
+static int timer_func(const struct timespec *tp, void *data);
+
+static void bench_hb(const char *name, enum can_net_timer_queue queue);
+
+int
+main(void)
+{
+	bench_hb("can_timer_timeout() [heap]", CAN_NET_TIMER_QUEUE_HEAP);
+	bench_hb("can_timer_timeout() [wheel]", CAN_NET_TIMER_QUEUE_WHEEL);
+
+	return 0;
+}
+
+static int
+timer_func(const struct timespec *tp, void *data)
+{
+	(void)tp;
+
+	++*(uint_least64_t *)data;
+
+	return 0;
+}
+
+static void
+bench_hb(const char *name, enum can_net_timer_queue queue)
+{
+	can_net_t *net = can_net_create(NULL);
+	assert(net);
+	if (can_net_set_timer_queue(net, queue) == -1)
+		abort();
+
+	// The number of heartbeat timeouts, which should remain 0.
+	uint_least64_t n = 0;
+
+	// Start a heartbeat consumer timer for every node, like a master
+	// monitoring a fully populated network.
+	can_timer_t *timer[NUM_NODES];
+	for (size_t i = 0; i < NUM_NODES; i++) {
+		timer[i] = can_timer_create(NULL);
+		assert(timer[i]);
+		can_timer_set_func(timer[i], &timer_func, &n);
+		can_timer_timeout(timer[i], net, HB_CONSUMER_MS);
+	}
+
+	// Every operation advances the time to the reception of the next
+	// heartbeat message and restarts the consumer timer of its producer.
+	struct timespec now = { 0, 0 };
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		timespec_add_usec(&now, HB_PRODUCER_MS * 1000 / NUM_NODES);
+		can_net_set_time(net, &now);
+		can_timer_timeout(timer[i % NUM_NODES], net, HB_CONSUMER_MS);
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+	if (n)
+		abort();
+
+	for (size_t i = 0; i < NUM_NODES; i++)
+		can_timer_destroy(timer[i]);
+
+	can_net_destroy(net);
+}
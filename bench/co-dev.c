@@ -0,0 +1,221 @@
+#include "bench.h"
+#include <lely/co/dcf.h>
+#include <lely/co/dev.h>
+#if !LELY_NO_CO_SNAP
+#include <lely/co/snap.h>
+#endif
+#include <lely/util/config.h>
+#include <lely/util/diag.h>
+
+#include <assert.h>
+#include <stdarg.h>
+#include <stdlib.h>
+
+// The number of application objects in the generated DCF, and the number of
+// sub-objects (excluding sub-index 0) per object. This is the size of the
+// object dictionary of a typical I/O module.
+#define NUM_OBJ 512
+#define NUM_SUB 8
+
+// The number of application objects in the DCF of a large device, such as a
+// multi-axis drive or a gateway.
+#define NUM_OBJ_LARGE 2000
+
+#define NUM_LOAD 64
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+#define TEXT_SIZE (4ul * 1024ul * 1024ul)
+
+static char *text;
+static size_t text_len;
+
+static void text_printf(const char *format, ...);
+static void text_create(int num_obj);
+
+static void bench_dcf(const char *name, size_t n);
+static void bench_dcf_cfg(const char *name, size_t n);
+#if !LELY_NO_CO_SNAP
+static void bench_snap(const char *name, size_t n);
+#endif
+static void bench_find_sub(const char *name, int frozen);
+
+int
+main(void)
+{
+	// Debug traces would dominate the measurements.
+	diag_set_handler(NULL, NULL);
+	diag_at_set_handler(NULL, NULL);
+
+	text = malloc(TEXT_SIZE);
+	assert(text);
+
+	text_create(NUM_OBJ);
+	bench_dcf("co_dev_create_from_dcf_text() [512 x 8]", NUM_LOAD);
+	bench_dcf_cfg("co_dev_create_from_dcf_cfg() [512 x 8]", NUM_LOAD);
+#if !LELY_NO_CO_SNAP
+	bench_snap("co_dev_create_from_snap() [512 x 8]", NUM_LOAD);
+#endif
+	bench_find_sub("co_dev_find_sub() [512 x 8]", 0);
+	bench_find_sub("co_dev_find_sub() [512 x 8, frozen]", 1);
+
+	text_create(NUM_OBJ_LARGE);
+	bench_dcf("co_dev_create_from_dcf_text() [2000 x 8]", NUM_LOAD / 4);
+	bench_dcf_cfg("co_dev_create_from_dcf_cfg() [2000 x 8]", NUM_LOAD / 4);
+#if !LELY_NO_CO_SNAP
+	bench_snap("co_dev_create_from_snap() [2000 x 8]", NUM_LOAD / 4);
+#endif
+
+	free(text);
+
+	return 0;
+}
+
+static void
+text_printf(const char *format, ...)
+{
+	va_list ap;
+	va_start(ap, format);
+	int result = vsnprintf(text + text_len, TEXT_SIZE - text_len, format,
+			ap);
+	va_end(ap);
+	if (result < 0 || (size_t)result >= TEXT_SIZE - text_len)
+		abort();
+	text_len += result;
+}
+
+static void
+text_create(int num_obj)
+{
+	text_len = 0;
+
+	text_printf("[DeviceInfo]\nVendorName=Lely Industries N.V.\n"
+		    "VendorNumber=0x00000360\n\n");
+	text_printf("[DeviceComissioning]\nNodeID=0x01\n\n");
+
+	text_printf("[MandatoryObjects]\nSupportedObjects=3\n1=0x1000\n"
+		    "2=0x1001\n3=0x1018\n\n");
+	text_printf("[1000]\nParameterName=Device type\nDataType=0x0007\n"
+		    "AccessType=ro\n\n");
+	text_printf("[1001]\nParameterName=Error register\n"
+		    "DataType=0x0005\nAccessType=ro\n\n");
+	text_printf("[1018]\nParameterName=Identity object\n"
+		    "ObjectType=0x09\nSubNumber=2\n\n");
+	text_printf("[1018sub0]\nParameterName=Highest sub-index supported\n"
+		    "DataType=0x0005\nAccessType=const\nDefaultValue=1\n\n");
+	text_printf("[1018sub1]\nParameterName=Vendor-ID\nDataType=0x0007\n"
+		    "AccessType=ro\nDefaultValue=0x00000360\n\n");
+
+	text_printf("[ManufacturerObjects]\nSupportedObjects=%d\n", num_obj);
+	for (int i = 0; i < num_obj; i++)
+		text_printf("%d=0x%04X\n", i + 1, 0x2000 + i);
+	text_printf("\n");
+
+	for (int i = 0; i < num_obj; i++) {
+		text_printf("[%04X]\nParameterName=Object %d\nObjectType=0x08\n"
+			    "SubNumber=%d\n\n",
+				0x2000 + i, i, NUM_SUB + 1);
+		text_printf("[%04Xsub0]\n"
+			    "ParameterName=Highest sub-index supported\n"
+			    "DataType=0x0005\nAccessType=const\n"
+			    "DefaultValue=%d\n\n",
+				0x2000 + i, NUM_SUB);
+		for (int j = 1; j <= NUM_SUB; j++)
+			text_printf("[%04Xsub%X]\nParameterName=Value %d\n"
+				    "DataType=0x0007\nAccessType=rw\n"
+				    "PDOMapping=1\nDefaultValue=%d\n\n",
+					0x2000 + i, j, j, i * NUM_SUB + j);
+	}
+}
+
+static void
+bench_dcf(const char *name, size_t n)
+{
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < n; i++) {
+		co_dev_t *dev = co_dev_create_from_dcf_text(
+				text, text + text_len, NULL);
+		if (!dev)
+			abort();
+		co_dev_destroy(dev);
+	}
+	bench_report(name, n, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+static void
+bench_dcf_cfg(const char *name, size_t n)
+{
+	// Include parsing the text into a configuration struct, since that is
+	// part of the cost of loading a DCF this way.
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < n; i++) {
+		config_t *cfg = config_create(CONFIG_CASE);
+		if (!cfg)
+			abort();
+		if (!config_parse_ini_text(cfg, text, text + text_len, NULL))
+			abort();
+		co_dev_t *dev = co_dev_create_from_dcf_cfg(cfg);
+		if (!dev)
+			abort();
+		co_dev_destroy(dev);
+		config_destroy(cfg);
+	}
+	bench_report(name, n, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+#if !LELY_NO_CO_SNAP
+static void
+bench_snap(const char *name, size_t n)
+{
+	co_dev_t *dev = co_dev_create_from_dcf_text(
+			text, text + text_len, NULL);
+	if (!dev)
+		abort();
+	size_t size = co_dev_write_snap(dev, NULL, NULL);
+	uint_least8_t *snap = malloc(size);
+	if (!snap || co_dev_write_snap(dev, snap, snap + size) != size)
+		abort();
+	co_dev_destroy(dev);
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < n; i++) {
+		dev = co_dev_create_from_snap(snap, snap + size);
+		if (!dev)
+			abort();
+		co_dev_destroy(dev);
+	}
+	bench_report(name, n, bench_now() - start, bench_nalloc() - nalloc);
+
+	free(snap);
+}
+#endif
+
+static void
+bench_find_sub(const char *name, int frozen)
+{
+	co_dev_t *dev = co_dev_create_from_dcf_text(
+			text, text + text_len, NULL);
+	if (!dev)
+		abort();
+	if (frozen && co_dev_freeze(dev) == -1)
+		abort();
+
+	// Visit the sub-objects in a pseudo-random order, like the SDO and PDO
+	// services of a busy node.
+	size_t j = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		j = (j + 7919) % (NUM_OBJ * NUM_SUB);
+		co_unsigned16_t idx = 0x2000 + j / NUM_SUB;
+		co_unsigned8_t subidx = 1 + j % NUM_SUB;
+		if (!co_dev_find_sub(dev, idx, subidx))
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	co_dev_destroy(dev);
+}
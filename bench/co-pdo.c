@@ -0,0 +1,154 @@
+#include "bench.h"
+#include <lely/co/dev.h>
+#include <lely/co/obj.h>
+#include <lely/co/pdo.h>
+#include <lely/co/sdo.h>
+#include <lely/co/type.h>
+#include <lely/util/diag.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+// The number of (16-bit) application objects mapped into the PDO.
+#define NUM_MAPS 4
+
+static co_dev_t *dev_create(void);
+
+static void bench_dn(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par);
+static void bench_up(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par);
+static void bench_plan_dn(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par);
+static void bench_plan_up(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par);
+
+int
+main(void)
+{
+	// Debug traces would dominate the measurements.
+	diag_set_handler(NULL, NULL);
+	diag_at_set_handler(NULL, NULL);
+
+	co_dev_t *dev = dev_create();
+
+	struct co_pdo_map_par par = CO_PDO_MAP_PAR_INIT;
+	par.n = NUM_MAPS;
+	for (co_unsigned8_t i = 0; i < NUM_MAPS; i++)
+		par.map[i] = ((co_unsigned32_t)(0x2000 + i) << 16) | 16;
+
+	bench_dn("co_pdo_dn() [4 x UNSIGNED16]", dev, &par);
+	bench_up("co_pdo_up() [4 x UNSIGNED16]", dev, &par);
+	bench_plan_dn("co_pdo_plan_dn() [4 x UNSIGNED16]", dev, &par);
+	bench_plan_up("co_pdo_plan_up() [4 x UNSIGNED16]", dev, &par);
+
+	co_dev_destroy(dev);
+
+	return 0;
+}
+
+static co_dev_t *
+dev_create(void)
+{
+	co_dev_t *dev = co_dev_create(1);
+	assert(dev);
+
+	for (co_unsigned8_t i = 0; i < NUM_MAPS; i++) {
+		co_obj_t *obj = co_obj_create(0x2000 + i);
+		assert(obj);
+		co_sub_t *sub = co_sub_create(0, CO_DEFTYPE_UNSIGNED16);
+		assert(sub);
+		co_sub_set_pdo_mapping(sub, 1);
+		if (co_obj_insert_sub(obj, sub) == -1)
+			abort();
+		if (co_dev_insert_obj(dev, obj) == -1)
+			abort();
+	}
+
+	return dev;
+}
+
+static void
+bench_dn(const char *name, co_dev_t *dev, const struct co_pdo_map_par *par)
+{
+	struct co_sdo_req req = CO_SDO_REQ_INIT(req);
+	uint_least8_t buf[NUM_MAPS * 2] = { 0 };
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		buf[0] = i & 0xff;
+		if (co_pdo_dn(par, dev, &req, buf, sizeof(buf)))
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	co_sdo_req_fini(&req);
+}
+
+static void
+bench_up(const char *name, co_dev_t *dev, const struct co_pdo_map_par *par)
+{
+	struct co_sdo_req req = CO_SDO_REQ_INIT(req);
+	uint_least8_t buf[NUM_MAPS * 2] = { 0 };
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		size_t n = sizeof(buf);
+		if (co_pdo_up(par, dev, &req, buf, &n) || n != sizeof(buf))
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	co_sdo_req_fini(&req);
+}
+
+static void
+bench_plan_dn(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par)
+{
+	struct co_pdo_plan plan = CO_PDO_PLAN_INIT;
+	co_pdo_plan_init(&plan, par, dev);
+	struct co_sdo_req req = CO_SDO_REQ_INIT(req);
+	uint_least8_t buf[NUM_MAPS * 2] = { 0 };
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		buf[0] = i & 0xff;
+		if (co_pdo_plan_dn(&plan, dev, &req, buf, sizeof(buf)))
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	co_sdo_req_fini(&req);
+}
+
+static void
+bench_plan_up(const char *name, co_dev_t *dev,
+		const struct co_pdo_map_par *par)
+{
+	struct co_pdo_plan plan = CO_PDO_PLAN_INIT;
+	co_pdo_plan_init(&plan, par, dev);
+	struct co_sdo_req req = CO_SDO_REQ_INIT(req);
+	uint_least8_t buf[NUM_MAPS * 2] = { 0 };
+
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		size_t n = sizeof(buf);
+		if (co_pdo_plan_up(&plan, dev, &req, buf, &n)
+				|| n != sizeof(buf))
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	co_sdo_req_fini(&req);
+}
@@ -0,0 +1,228 @@
+#include "bench.h"
+#include <lely/co/csdo.h>
+#include <lely/co/dev.h>
+#include <lely/co/obj.h>
+#include <lely/co/ssdo.h>
+#include <lely/co/type.h>
+#include <lely/ev/loop.h>
+#include <lely/io2/can_net.h>
+#include <lely/io2/ctx.h>
+#include <lely/io2/user/timer.h>
+#include <lely/io2/vcan.h>
+#include <lely/util/diag.h>
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define NUM_OP (16ul * 1024ul)
+
+// A value small enough for a single CAN frame.
+#define EXP_SIZE 4
+// A value too large for a single CAN frame.
+#define SEG_SIZE 64
+// A value spanning several (127 * 7 bytes) blocks.
+#define BLK_SIZE 4096
+
+// The node-ID of the SDO server.
+#define ID 2
+
+// A CANopen network interface on top of a virtual CAN channel.
+struct bench_net {
+	io_timer_t *timer;
+	io_can_chan_t *chan;
+	io_can_net_t *net;
+};
+
+static ev_loop_t *loop;
+static size_t nop;
+
+static void net_init(struct bench_net *net, io_ctx_t *ctx, ev_exec_t *exec,
+		io_can_ctrl_t *ctrl);
+static void net_fini(struct bench_net *net);
+
+static void dn_con(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
+		co_unsigned32_t ac, void *data);
+static void up_con(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
+		co_unsigned32_t ac, const void *ptr, size_t n, void *data);
+
+static void bench_dn(const char *name, co_csdo_t *sdo, co_unsigned16_t idx,
+		size_t size, int blk);
+static void bench_up(const char *name, co_csdo_t *sdo, co_unsigned16_t idx,
+		int blk);
+
+int
+main(void)
+{
+	// Debug traces would dominate the measurements.
+	diag_set_handler(NULL, NULL);
+	diag_at_set_handler(NULL, NULL);
+
+	io_ctx_t *ctx = io_ctx_create();
+	assert(ctx);
+	loop = ev_loop_create(NULL, 0, 0);
+	assert(loop);
+	ev_exec_t *exec = ev_loop_get_exec(loop);
+
+	// The timers of the CANopen networks are never updated, so all frames
+	// are exchanged without delay.
+	struct bench_net snet, cnet;
+	io_timer_t *timer = io_user_timer_create(ctx, exec, NULL, NULL);
+	assert(timer);
+	io_can_ctrl_t *ctrl = io_vcan_ctrl_create(io_timer_get_clock(timer), 0,
+			0, 0, CAN_STATE_ACTIVE);
+	assert(ctrl);
+	net_init(&snet, ctx, exec, ctrl);
+	net_init(&cnet, ctx, exec, ctrl);
+
+	// The server provides an expedited (UNSIGNED32) and a segmented or
+	// block (DOMAIN) value.
+	co_dev_t *dev = co_dev_create(ID);
+	assert(dev);
+	co_obj_t *obj = co_obj_create(0x2000);
+	assert(obj);
+	if (co_obj_insert_sub(obj, co_sub_create(0, CO_DEFTYPE_UNSIGNED32))
+			== -1)
+		abort();
+	if (co_dev_insert_obj(dev, obj) == -1)
+		abort();
+	obj = co_obj_create(0x2001);
+	assert(obj);
+	if (co_obj_insert_sub(obj, co_sub_create(0, CO_DEFTYPE_DOMAIN)) == -1)
+		abort();
+	if (co_dev_insert_obj(dev, obj) == -1)
+		abort();
+
+	co_ssdo_t *ssdo = co_ssdo_create(io_can_net_get_net(snet.net), dev, 1);
+	assert(ssdo);
+	if (co_ssdo_start(ssdo) == -1)
+		abort();
+
+	// A Client-SDO without an object dictionary uses the default SDO of
+	// the server.
+	co_csdo_t *csdo = co_csdo_create(
+			io_can_net_get_net(cnet.net), NULL, ID);
+	assert(csdo);
+	if (co_csdo_start(csdo) == -1)
+		abort();
+
+	bench_dn("co_csdo_dn_req() [expedited, 4 bytes]", csdo, 0x2000,
+			EXP_SIZE, 0);
+	bench_up("co_csdo_up_req() [expedited, 4 bytes]", csdo, 0x2000, 0);
+	bench_dn("co_csdo_dn_req() [segmented, 64 bytes]", csdo, 0x2001,
+			SEG_SIZE, 0);
+	bench_up("co_csdo_up_req() [segmented, 64 bytes]", csdo, 0x2001, 0);
+	bench_dn("co_csdo_blk_dn_req() [block, 4096 bytes]", csdo, 0x2001,
+			BLK_SIZE, 1);
+	bench_up("co_csdo_blk_up_req() [block, 4096 bytes]", csdo, 0x2001, 1);
+
+	co_csdo_destroy(csdo);
+	co_ssdo_destroy(ssdo);
+	co_dev_destroy(dev);
+
+	net_fini(&cnet);
+	net_fini(&snet);
+	io_vcan_ctrl_destroy(ctrl);
+	io_user_timer_destroy(timer);
+
+	ev_loop_destroy(loop);
+	io_ctx_destroy(ctx);
+
+	return 0;
+}
+
+static void
+net_init(struct bench_net *net, io_ctx_t *ctx, ev_exec_t *exec,
+		io_can_ctrl_t *ctrl)
+{
+	net->timer = io_user_timer_create(ctx, exec, NULL, NULL);
+	assert(net->timer);
+	net->chan = io_vcan_chan_create(ctx, exec, 0);
+	assert(net->chan);
+	io_vcan_chan_open(net->chan, ctrl);
+	net->net = io_can_net_create(exec, net->timer, net->chan, 0, 0);
+	assert(net->net);
+	io_can_net_start(net->net);
+}
+
+static void
+net_fini(struct bench_net *net)
+{
+	io_can_net_destroy(net->net);
+	io_vcan_chan_destroy(net->chan);
+	io_user_timer_destroy(net->timer);
+}
+
+static void
+dn_con(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
+		co_unsigned32_t ac, void *data)
+{
+	(void)sdo;
+	(void)idx;
+	(void)subidx;
+	(void)data;
+
+	if (ac)
+		abort();
+	nop++;
+}
+
+static void
+up_con(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
+		co_unsigned32_t ac, const void *ptr, size_t n, void *data)
+{
+	(void)sdo;
+	(void)idx;
+	(void)subidx;
+	(void)ptr;
+	(void)n;
+	(void)data;
+
+	if (ac)
+		abort();
+	nop++;
+}
+
+static void
+bench_dn(const char *name, co_csdo_t *sdo, co_unsigned16_t idx, size_t size,
+		int blk)
+{
+	static unsigned char buf[BLK_SIZE];
+	memset(buf, 0x55, size);
+
+	// Every operation is a complete SDO transfer. The event loop is run
+	// until the confirmation function has been invoked.
+	nop = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		// clang-format off
+		if ((blk ? co_csdo_blk_dn_req(sdo, idx, 0, buf, size, &dn_con,
+				NULL) : co_csdo_dn_req(sdo, idx, 0, buf, size,
+				&dn_con, NULL)) == -1)
+			// clang-format on
+			abort();
+		while (nop == i)
+			ev_loop_run_one(loop);
+	}
+	bench_report(name, nop, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+static void
+bench_up(const char *name, co_csdo_t *sdo, co_unsigned16_t idx, int blk)
+{
+	nop = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		// clang-format off
+		if ((blk ? co_csdo_blk_up_req(sdo, idx, 0, 0, NULL, &up_con,
+				NULL) : co_csdo_up_req(sdo, idx, 0, NULL,
+				&up_con, NULL)) == -1)
+			// clang-format on
+			abort();
+		while (nop == i)
+			ev_loop_run_one(loop);
+	}
+	bench_report(name, nop, bench_now() - start, bench_nalloc() - nalloc);
+}
@@ -0,0 +1,168 @@
+#include "bench.h"
+#include <lely/co/csdo.h>
+#include <lely/co/dev.h>
+#include <lely/co/obj.h>
+#include <lely/co/ssdo.h>
+#include <lely/co/type.h>
+#include <lely/coapp/sdo.hpp>
+#include <lely/ev/loop.h>
+#include <lely/io2/can_net.h>
+#include <lely/io2/ctx.h>
+#include <lely/io2/user/timer.h>
+#include <lely/io2/vcan.h>
+#include <lely/util/diag.h>
+
+#include <cassert>
+#include <cstdlib>
+
+#define NUM_OP (16ul * 1024ul)
+
+// The node-ID of the SDO server.
+#define ID 2
+
+using namespace lely::canopen;
+
+namespace {
+
+// A CANopen network interface on top of a virtual CAN channel.
+struct BenchNet {
+  BenchNet(io_ctx_t* ctx, ev_exec_t* exec, io_can_ctrl_t* ctrl);
+  ~BenchNet();
+
+  io_timer_t* timer;
+  io_can_chan_t* chan;
+  io_can_net_t* net;
+};
+
+ev_loop_t* loop;
+size_t nop;
+
+void
+BenchSubmitDownload(const char* name, Sdo& sdo, ev_exec_t* exec) {
+  // Every operation is a complete SDO transfer. The event loop is run until
+  // the confirmation function has been invoked.
+  nop = 0;
+  size_t nalloc = bench_nalloc();
+  int_least64_t start = bench_now();
+  for (size_t i = 0; i < NUM_OP; i++) {
+    sdo.SubmitDownload(exec, 0x2000, 0, static_cast<uint32_t>(i),
+                       [](uint8_t, uint16_t, uint8_t, ::std::error_code ec) {
+                         if (ec) ::std::abort();
+                         nop++;
+                       });
+    while (nop == i) ev_loop_run_one(loop);
+  }
+  bench_report(name, nop, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+void
+BenchSubmitUpload(const char* name, Sdo& sdo, ev_exec_t* exec) {
+  nop = 0;
+  size_t nalloc = bench_nalloc();
+  int_least64_t start = bench_now();
+  for (size_t i = 0; i < NUM_OP; i++) {
+    sdo.SubmitUpload<uint32_t>(
+        exec, 0x2000, 0,
+        [](uint8_t, uint16_t, uint8_t, ::std::error_code ec, uint32_t) {
+          if (ec) ::std::abort();
+          nop++;
+        });
+    while (nop == i) ev_loop_run_one(loop);
+  }
+  bench_report(name, nop, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+void
+BenchAsyncUpload(const char* name, Sdo& sdo, ev_exec_t* exec) {
+  nop = 0;
+  size_t nalloc = bench_nalloc();
+  int_least64_t start = bench_now();
+  for (size_t i = 0; i < NUM_OP; i++) {
+    auto f = sdo.AsyncUpload<uint32_t>(exec, 0x2000, 0);
+    while (!f.is_ready()) ev_loop_run_one(loop);
+    if (f.get().has_error()) ::std::abort();
+    nop++;
+  }
+  bench_report(name, nop, bench_now() - start, bench_nalloc() - nalloc);
+}
+
+}  // namespace
+
+int
+main() {
+  // Debug traces would dominate the measurements.
+  diag_set_handler(nullptr, nullptr);
+  diag_at_set_handler(nullptr, nullptr);
+
+  io_ctx_t* ctx = io_ctx_create();
+  assert(ctx);
+  loop = ev_loop_create(nullptr, 0, 0);
+  assert(loop);
+  ev_exec_t* exec = ev_loop_get_exec(loop);
+
+  // The timers of the CANopen networks are never updated, so all frames are
+  // exchanged without delay.
+  io_timer_t* timer = io_user_timer_create(ctx, exec, nullptr, nullptr);
+  assert(timer);
+  io_can_ctrl_t* ctrl = io_vcan_ctrl_create(io_timer_get_clock(timer), 0, 0,
+                                            0, CAN_STATE_ACTIVE);
+  assert(ctrl);
+  {
+    BenchNet snet(ctx, exec, ctrl);
+    BenchNet cnet(ctx, exec, ctrl);
+
+    // The server provides an expedited (UNSIGNED32) value.
+    co_dev_t* dev = co_dev_create(ID);
+    assert(dev);
+    co_obj_t* obj = co_obj_create(0x2000);
+    assert(obj);
+    if (co_obj_insert_sub(obj, co_sub_create(0, CO_DEFTYPE_UNSIGNED32)) == -1)
+      ::std::abort();
+    if (co_dev_insert_obj(dev, obj) == -1) ::std::abort();
+
+    co_ssdo_t* ssdo = co_ssdo_create(io_can_net_get_net(snet.net), dev, 1);
+    assert(ssdo);
+    if (co_ssdo_start(ssdo) == -1) ::std::abort();
+
+    {
+      // A Client-SDO queue for the default SDO of the server.
+      Sdo sdo(io_can_net_get_net(cnet.net), ID);
+
+      BenchSubmitDownload("Sdo::SubmitDownload() [expedited, 4 bytes]", sdo,
+                          exec);
+      BenchSubmitUpload("Sdo::SubmitUpload() [expedited, 4 bytes]", sdo, exec);
+      BenchAsyncUpload("Sdo::AsyncUpload() [expedited, 4 bytes]", sdo, exec);
+    }
+
+    co_ssdo_destroy(ssdo);
+    co_dev_destroy(dev);
+  }
+  io_vcan_ctrl_destroy(ctrl);
+  io_user_timer_destroy(timer);
+
+  ev_loop_destroy(loop);
+  io_ctx_destroy(ctx);
+
+  return 0;
+}
+
+namespace {
+
+BenchNet::BenchNet(io_ctx_t* ctx, ev_exec_t* exec, io_can_ctrl_t* ctrl) {
+  timer = io_user_timer_create(ctx, exec, nullptr, nullptr);
+  assert(timer);
+  chan = io_vcan_chan_create(ctx, exec, 0);
+  assert(chan);
+  io_vcan_chan_open(chan, ctrl);
+  net = io_can_net_create(exec, timer, chan, 0, 0);
+  assert(net);
+  io_can_net_start(net);
+}
+
+BenchNet::~BenchNet() {
+  io_can_net_destroy(net);
+  io_vcan_chan_destroy(chan);
+  io_user_timer_destroy(timer);
+}
+
+}  // namespace
@@ -0,0 +1,89 @@
+#include "bench.h"
+#include <lely/ev/future.h>
+#include <lely/util/memory.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+static void bench_promise(const char *name, alloc_t *alloc);
+
+static void *malloc_alloc(alloc_t *alloc, size_t alignment, size_t size);
+static void malloc_free(alloc_t *alloc, void *ptr);
+static size_t malloc_size(const alloc_t *alloc);
+static size_t malloc_capacity(const alloc_t *alloc);
+
+// An allocator forwarding to malloc() and free(), which is how promises were
+// allocated before the thread-local promise cache.
+static const struct alloc_vtbl malloc_vtbl = { &malloc_alloc, &malloc_free,
+	&malloc_size, &malloc_capacity };
+static alloc_t malloc_alloc_t = &malloc_vtbl;
+
+int
+main(void)
+{
+	bench_promise("ev_promise_create() + set + release [malloc]",
+			&malloc_alloc_t);
+	bench_promise("ev_promise_create() + set + release [cached]", NULL);
+
+	return 0;
+}
+
+static void
+bench_promise(const char *name, alloc_t *alloc)
+{
+	// Every operation is the complete life cycle of a promise, like a single
+	// asynchronous read.
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		ev_promise_t *promise = ev_promise_create_with_alloc(
+				alloc, sizeof(size_t), NULL);
+		assert(promise);
+		ev_future_t *future = ev_promise_get_future(promise);
+		size_t *value = ev_promise_data(promise);
+		*value = i;
+		ev_promise_set(promise, value);
+		if (*(size_t *)ev_future_get(future) != i)
+			abort();
+		ev_future_release(future);
+		ev_promise_release(promise);
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+}
+
+static void *
+malloc_alloc(alloc_t *alloc, size_t alignment, size_t size)
+{
+	(void)alloc;
+	(void)alignment;
+
+	return malloc(size);
+}
+
+static void
+malloc_free(alloc_t *alloc, void *ptr)
+{
+	(void)alloc;
+
+	free(ptr);
+}
+
+static size_t
+malloc_size(const alloc_t *alloc)
+{
+	(void)alloc;
+
+	return 0;
+}
+
+static size_t
+malloc_capacity(const alloc_t *alloc)
+{
+	(void)alloc;
+
+	return SIZE_MAX;
+}
@@ -0,0 +1,93 @@
+#include "bench.h"
+#include <lely/ev/exec.h>
+#include <lely/ev/loop.h>
+#include <lely/ev/task.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NUM_TASK 1024
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+static uint_least64_t n;
+
+static void task_func(struct ev_task *task);
+static void chain_func(struct ev_task *task);
+
+static void bench_batch(const char *name);
+static void bench_chain(const char *name);
+
+int
+main(void)
+{
+	bench_batch("ev_exec_post() + ev_loop_run() [batch]");
+	bench_chain("ev_exec_post() + ev_loop_run() [chain]");
+
+	return 0;
+}
+
+static void
+task_func(struct ev_task *task)
+{
+	(void)task;
+
+	n++;
+}
+
+static void
+chain_func(struct ev_task *task)
+{
+	// Every task reposts itself, like a handler reading a busy channel.
+	if (++n < NUM_OP)
+		ev_exec_post(task->exec, task);
+}
+
+static void
+bench_batch(const char *name)
+{
+	ev_loop_t *loop = ev_loop_create(NULL, 0, 0);
+	assert(loop);
+	ev_exec_t *exec = ev_loop_get_exec(loop);
+
+	struct ev_task task[NUM_TASK];
+	for (size_t i = 0; i < NUM_TASK; i++)
+		task[i] = (struct ev_task)EV_TASK_INIT(exec, &task_func);
+
+	// Every round submits a batch of tasks and runs the event loop until
+	// all of them have been executed.
+	n = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP / NUM_TASK; i++) {
+		for (size_t j = 0; j < NUM_TASK; j++)
+			ev_exec_post(exec, &task[j]);
+		ev_loop_restart(loop);
+		ev_loop_run(loop);
+	}
+	bench_report(name, n, bench_now() - start, bench_nalloc() - nalloc);
+	if (n != NUM_OP)
+		abort();
+
+	ev_loop_destroy(loop);
+}
+
+static void
+bench_chain(const char *name)
+{
+	ev_loop_t *loop = ev_loop_create(NULL, 0, 0);
+	assert(loop);
+	ev_exec_t *exec = ev_loop_get_exec(loop);
+
+	struct ev_task task = EV_TASK_INIT(exec, &chain_func);
+
+	n = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	ev_exec_post(exec, &task);
+	ev_loop_run(loop);
+	bench_report(name, n, bench_now() - start, bench_nalloc() - nalloc);
+	if (n != NUM_OP)
+		abort();
+
+	ev_loop_destroy(loop);
+}
@@ -0,0 +1,130 @@
+#include "bench.h"
+#include <lely/compat/stdatomic.h>
+#include <lely/compat/threads.h>
+#include <lely/ev/exec.h>
+#include <lely/ev/loop.h>
+#include <lely/ev/strand.h>
+#include <lely/ev/task.h>
+
+#include <assert.h>
+#include <stdlib.h>
+
+#define NUM_PROD 4
+#define NUM_OP (4ul * 1024ul * 1024ul)
+
+static ev_exec_t *loop_exec;
+static ev_exec_t *strand;
+static struct ev_task tasks[NUM_OP];
+static size_t nprod;
+static atomic_ulong n;
+
+static void chain_func(struct ev_task *task);
+static void prod_func(struct ev_task *task);
+static int prod_thrd(void *arg);
+
+static void bench_chain(const char *name);
+static void bench_prod(const char *name, size_t num_prod);
+
+int
+main(void)
+{
+	bench_chain("ev_exec_post() + ev_loop_run() [strand, chain]");
+	bench_prod("ev_exec_post() + ev_loop_run() [strand, 1 producer]", 1);
+	bench_prod("ev_exec_post() + ev_loop_run() [strand, 4 producers]",
+			NUM_PROD);
+
+	return 0;
+}
+
+static void
+chain_func(struct ev_task *task)
+{
+	// Every task reposts itself to the strand, like a driver callback.
+	if (atomic_fetch_add_explicit(&n, 1, memory_order_relaxed) + 1 < NUM_OP)
+		ev_exec_post(task->exec, task);
+}
+
+static void
+prod_func(struct ev_task *task)
+{
+	(void)task;
+
+	// Release the outstanding work guard once all tasks have been executed.
+	if (atomic_fetch_add_explicit(&n, 1, memory_order_relaxed) + 1
+			== NUM_OP)
+		ev_exec_on_task_fini(loop_exec);
+}
+
+static int
+prod_thrd(void *arg)
+{
+	size_t i = *(size_t *)arg;
+
+	for (size_t j = i; j < NUM_OP; j += nprod)
+		ev_exec_post(strand, &tasks[j]);
+
+	return 0;
+}
+
+static void
+bench_chain(const char *name)
+{
+	ev_loop_t *loop = ev_loop_create(NULL, 0, 0);
+	assert(loop);
+	loop_exec = ev_loop_get_exec(loop);
+	strand = ev_strand_create(loop_exec);
+	assert(strand);
+
+	struct ev_task task = EV_TASK_INIT(strand, &chain_func);
+
+	atomic_store(&n, 0);
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	ev_exec_post(strand, &task);
+	ev_loop_run(loop);
+	bench_report(name, atomic_load(&n), bench_now() - start,
+			bench_nalloc() - nalloc);
+	if (atomic_load(&n) != NUM_OP)
+		abort();
+
+	ev_strand_destroy(strand);
+	ev_loop_destroy(loop);
+}
+
+static void
+bench_prod(const char *name, size_t num_prod)
+{
+	ev_loop_t *loop = ev_loop_create(NULL, 0, 0);
+	assert(loop);
+	loop_exec = ev_loop_get_exec(loop);
+	strand = ev_strand_create(loop_exec);
+	assert(strand);
+
+	for (size_t i = 0; i < NUM_OP; i++)
+		tasks[i] = (struct ev_task)EV_TASK_INIT(strand, &prod_func);
+
+	// The producer threads post tasks to the strand, like a CAN I/O thread
+	// posting to a driver, while the current thread runs the event loop.
+	nprod = num_prod;
+	atomic_store(&n, 0);
+	ev_exec_on_task_init(loop_exec);
+	size_t args[NUM_PROD];
+	thrd_t thr[NUM_PROD];
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < nprod; i++) {
+		args[i] = i;
+		if (thrd_create(&thr[i], &prod_thrd, &args[i]) != thrd_success)
+			abort();
+	}
+	ev_loop_run(loop);
+	bench_report(name, atomic_load(&n), bench_now() - start,
+			bench_nalloc() - nalloc);
+	for (size_t i = 0; i < nprod; i++)
+		thrd_join(thr[i], NULL);
+	if (atomic_load(&n) != NUM_OP)
+		abort();
+
+	ev_strand_destroy(strand);
+	ev_loop_destroy(loop);
+}
@@ -0,0 +1,92 @@
+#include "bench.h"
+#include <lely/ev/poll.h>
+#include <lely/io2/posix/poll.h>
+#include <lely/io2/sys/io.h>
+#include <lely/util/util.h>
+
+#include <assert.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#define NUM_OP (1024ul * 1024ul)
+
+struct bench_pipe {
+	struct io_poll_watch watch;
+	int fd[2];
+	uint_least64_t n;
+};
+
+static void watch_func(struct io_poll_watch *watch, int events);
+
+static void bench_poll(const char *name, int edge);
+
+int
+main(void)
+{
+	if (io_init() == -1)
+		abort();
+
+	bench_poll("io_poll_watch() + ev_poll_wait() [oneshot]", 0);
+	bench_poll("io_poll_watch() + ev_poll_wait() [edge]", 1);
+
+	io_fini();
+
+	return 0;
+}
+
+static void
+watch_func(struct io_poll_watch *watch, int events)
+{
+	struct bench_pipe *p = structof(watch, struct bench_pipe, watch);
+
+	if (!(events & IO_EVENT_IN))
+		abort();
+
+	// Drain the pipe, like a reader would before waiting for the next
+	// event.
+	char buf[16];
+	while (read(p->fd[0], buf, sizeof(buf)) > 0)
+		p->n++;
+}
+
+static void
+bench_poll(const char *name, int edge)
+{
+	io_ctx_t *ctx = io_ctx_create();
+	assert(ctx);
+	io_poll_t *poll = io_poll_create(ctx, 0);
+	assert(poll);
+	if (io_poll_set_edge(poll, edge) == -1)
+		abort();
+	ev_poll_t *ev_poll = io_poll_get_poll(poll);
+
+	struct bench_pipe p = { .watch = IO_POLL_WATCH_INIT(&watch_func) };
+	if (pipe2(p.fd, O_CLOEXEC | O_NONBLOCK) == -1)
+		abort();
+
+	// Every operation rearms the watch, makes the file descriptor ready
+	// and processes the resulting event, like a busy CAN or timer file
+	// descriptor.
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		if (io_poll_watch(poll, p.fd[0], IO_EVENT_IN, &p.watch) == -1)
+			abort();
+		if (write(p.fd[1], "", 1) != 1)
+			abort();
+		if (ev_poll_wait(ev_poll, 0) != 1)
+			abort();
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+	if (p.n != NUM_OP)
+		abort();
+
+	io_poll_watch(poll, p.fd[0], 0, &p.watch);
+	close(p.fd[1]);
+	close(p.fd[0]);
+
+	io_poll_destroy(poll);
+	io_ctx_destroy(ctx);
+}
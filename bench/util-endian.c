@@ -0,0 +1,86 @@
+#include "bench.h"
+#include <lely/util/endian.h>
+
+#include <stdlib.h>
+
+#define NUM_OP (16ul * 1024ul * 1024ul)
+
+#define MAX_FIELDS 16
+
+static const int map_8x8[] = { 8, 8, 8, 8, 8, 8, 8, 8, 0 };
+static const int map_4x16[] = { 16, 16, 16, 16, 0 };
+// A bit-packed mapping where none of the fields are byte-aligned.
+static const int map_packed[] = { 1, 2, 5, 11, 3, 12, 7, 23, 0 };
+
+static void bench_bcpyle(const char *name, const int *map);
+static void bench_bgetle(const char *name, const int *map);
+
+int
+main(void)
+{
+	bench_bcpyle("bcpyle() [8x8]", map_8x8);
+	bench_bgetle("bgetle() + bsetle() [8x8]", map_8x8);
+	bench_bcpyle("bcpyle() [4x16]", map_4x16);
+	bench_bgetle("bgetle() + bsetle() [4x16]", map_4x16);
+	bench_bcpyle("bcpyle() [1,2,5,11,3,12,7,23]", map_packed);
+	bench_bgetle("bgetle() + bsetle() [1,2,5,11,3,12,7,23]", map_packed);
+
+	return 0;
+}
+
+static void
+bench_bcpyle(const char *name, const int *map)
+{
+	uint_least8_t frame[8] = { 0 };
+	uint_least8_t val[MAX_FIELDS][8] = { { 0 } };
+
+	// Every operation packs all fields into a frame and unpacks them again,
+	// like a TPDO on one node and an RPDO on the other.
+	uint_least64_t sum = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		val[0][0] = i & 1;
+		int offset = 0;
+		for (int j = 0; map[j]; offset += map[j++])
+			bcpyle(frame, offset, val[j], 0, map[j]);
+		offset = 0;
+		for (int j = 0; map[j]; offset += map[j++])
+			bcpyle(val[j], 0, frame, offset, map[j]);
+		sum += val[0][0];
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	if (sum != NUM_OP / 2)
+		abort();
+}
+
+static void
+bench_bgetle(const char *name, const int *map)
+{
+	uint_least8_t frame[8] = { 0 };
+	uint_least64_t val[MAX_FIELDS] = { 0 };
+	uint_least64_t w[1] = { 0 };
+
+	uint_least64_t sum = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	for (size_t i = 0; i < NUM_OP; i++) {
+		val[0] = i & 1;
+		int offset = 0;
+		for (int j = 0; map[j]; offset += map[j++])
+			bsetle(w, offset, val[j], map[j]);
+		stle_u64v(frame, w, sizeof(frame));
+		ldle_u64v(w, frame, sizeof(frame));
+		offset = 0;
+		for (int j = 0; map[j]; offset += map[j++])
+			val[j] = bgetle(w, offset, map[j]);
+		sum += val[0];
+	}
+	bench_report(name, NUM_OP, bench_now() - start,
+			bench_nalloc() - nalloc);
+
+	if (sum != NUM_OP / 2)
+		abort();
+}
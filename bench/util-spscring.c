@@ -0,0 +1,55 @@
+#include "bench.h"
+#include <lely/util/spscring.h>
+
+#include <stdlib.h>
+
+#define RING_SIZE 256
+#define NUM_OP (16ul * 1024ul * 1024ul)
+
+static void bench_spscring(const char *name, size_t burst);
+
+int
+main(void)
+{
+	bench_spscring("spscring_p_commit() + spscring_c_commit() [1]", 1);
+	bench_spscring("spscring_p_commit() + spscring_c_commit() [32]", 32);
+
+	return 0;
+}
+
+static void
+bench_spscring(const char *name, size_t burst)
+{
+	struct spscring ring;
+	spscring_init(&ring, RING_SIZE);
+	static uint_least32_t buf[RING_SIZE];
+
+	// Every round writes a burst of values to the ring buffer and reads
+	// them back, like a CAN channel buffering received frames. An
+	// operation is the transfer of a single value.
+	uint_least32_t in = 0;
+	uint_least32_t out = 0;
+	size_t nalloc = bench_nalloc();
+	int_least64_t start = bench_now();
+	while (out < NUM_OP) {
+		for (size_t n = burst; n;) {
+			size_t size = n;
+			size_t i = spscring_p_alloc_no_wrap(&ring, &size);
+			for (size_t j = 0; j < size; j++)
+				buf[i + j] = in++;
+			spscring_p_commit(&ring, size);
+			n -= size;
+		}
+		for (size_t n = burst; n;) {
+			size_t size = n;
+			size_t i = spscring_c_alloc_no_wrap(&ring, &size);
+			for (size_t j = 0; j < size; j++) {
+				if (buf[i + j] != out++)
+					abort();
+			}
+			spscring_c_commit(&ring, size);
+			n -= size;
+		}
+	}
+	bench_report(name, out, bench_now() - start, bench_nalloc() - nalloc);
+}
@@ -38,6 +38,51 @@ struct can_recv;
 /// An opaque CAN frame receiver type.
 typedef struct can_recv can_recv_t;
 
+/// The strategies used by a CAN network interface to look up frame receivers.
+enum can_net_recv_lookup {
+	/// All receivers are stored in a red-black tree (the default).
+	CAN_NET_RECV_LOOKUP_TREE,
+	/**
+	 * The receivers of data frames with an 11-bit CAN identifier are stored
+	 * in a direct-indexed table, making the lookup a single load. All other
+	 * receivers are stored in a red-black tree.
+	 */
+	CAN_NET_RECV_LOOKUP_TABLE
+};
+
+/// The data structures used by a CAN network interface to store its timers.
+enum can_net_timer_queue {
+	/// All timers are stored in a pairing heap (the default).
+	CAN_NET_TIMER_QUEUE_HEAP,
+	/**
+	 * The timers are stored in a hierarchical timing wheel, making starting
+	 * and stopping a timer O(1). Timers are moved to a pairing heap once
+	 * their tick (approximately 1 ms) is reached, so they are still invoked
+	 * in order. Note that the time passed to the callback function set with
+	 * can_net_set_next_func() MAY be earlier (but never later) than the
+	 * time at which the next timer triggers.
+	 */
+	CAN_NET_TIMER_QUEUE_WHEEL
+};
+
+/**
+ * A CAN frame filter. A frame matches the filter if
+ * `(msg->id & mask) == (id & mask)` and
+ * `(msg->flags & flags_mask) == (flags & flags_mask)`.
+ *
+ * @see can_net_get_filters()
+ */
+struct can_net_filter {
+	/// The CAN identifier.
+	uint_least32_t id;
+	/// The bits of the CAN identifier that must match #id.
+	uint_least32_t mask;
+	/// The flags.
+	uint_least8_t flags;
+	/// The flags that must match #flags.
+	uint_least8_t flags_mask;
+};
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -79,6 +124,16 @@ typedef int can_recv_func_t(const struct can_msg *msg, void *data);
  */
 typedef int can_send_func_t(const struct can_msg *msg, void *data);
 
+/**
+ * The type of a CAN filter callback function, invoked by a CAN network
+ * interface when the set of CAN frames accepted by its receivers changes.
+ *
+ * @param data a pointer to user-specified data.
+ *
+ * @see can_net_get_filters()
+ */
+typedef void can_net_filter_func_t(void *data);
+
 /// Returns the alignment (in bytes) of the #can_net_t structure.
 size_t can_net_alignof(void);
 
@@ -122,6 +177,30 @@ void can_net_get_time(const can_net_t *net, struct timespec *tp);
  */
 int can_net_set_time(can_net_t *net, const struct timespec *tp);
 
+/**
+ * Returns the data structure used by a CAN network interface to store its
+ * timers.
+ *
+ * @see can_net_set_timer_queue()
+ */
+enum can_net_timer_queue can_net_get_timer_queue(const can_net_t *net);
+
+/**
+ * Sets the data structure used by a CAN network interface to store its timers.
+ * This function is typically invoked directly after can_net_create(). Timers
+ * that are already active are moved to the new data structure.
+ *
+ * @param net   a pointer to a CAN network interface.
+ * @param queue the timer queue (#CAN_NET_TIMER_QUEUE_HEAP or
+ *              #CAN_NET_TIMER_QUEUE_WHEEL).
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ *
+ * @see can_net_get_timer_queue()
+ */
+int can_net_set_timer_queue(can_net_t *net, enum can_net_timer_queue queue);
+
 /**
  * Retrieves the callback function invoked when the time at which the next CAN
  * timer triggers is updated.
@@ -164,6 +243,30 @@ void can_net_set_next_func(can_net_t *net, can_timer_func_t *func, void *data);
  */
 int can_net_recv(can_net_t *net, const struct can_msg *msg);
 
+/**
+ * Returns the strategy used by a CAN network interface to look up the receivers
+ * of a CAN frame.
+ *
+ * @see can_net_set_recv_lookup()
+ */
+enum can_net_recv_lookup can_net_get_recv_lookup(const can_net_t *net);
+
+/**
+ * Sets the strategy used by a CAN network interface to look up the receivers
+ * of a CAN frame. Receivers that are already registered are moved to the new
+ * lookup structure.
+ *
+ * @param net    a pointer to a CAN network interface.
+ * @param lookup the lookup strategy (#CAN_NET_RECV_LOOKUP_TREE or
+ *               #CAN_NET_RECV_LOOKUP_TABLE).
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ *
+ * @see can_net_get_recv_lookup()
+ */
+int can_net_set_recv_lookup(can_net_t *net, enum can_net_recv_lookup lookup);
+
 /**
  * Sends a CAN frame from a network interface. This function invokes the
  * callback function set by can_net_set_send_func().
@@ -203,6 +306,76 @@ void can_net_get_send_func(
  */
 void can_net_set_send_func(can_net_t *net, can_send_func_t *func, void *data);
 
+/**
+ * Retrieves the callback function invoked when the set of CAN frames accepted
+ * by the receivers of a network interface changes.
+ *
+ * @param net   a pointer to a CAN network interface.
+ * @param pfunc the address at which to store a pointer to the callback function
+ *              (can be NULL).
+ * @param pdata the address at which to store a pointer to user-specified data
+ *              (can be NULL).
+ *
+ * @see can_net_set_filter_func()
+ */
+void can_net_get_filter_func(
+		const can_net_t *net, can_net_filter_func_t **pfunc, void **pdata);
+
+/**
+ * Sets the callback function invoked when the set of CAN frames accepted by the
+ * receivers of a network interface changes. This happens when the first
+ * receiver for a CAN identifier is started, the last one is stopped, or when a
+ * masked receiver is started or stopped.
+ *
+ * @param net  a pointer to a CAN network interface.
+ * @param func a pointer to the function to be invoked by can_recv_start(),
+ *             can_recv_start_mask() and can_recv_stop().
+ * @param data a pointer to user-specified data (can be NULL). <b>data</b> is
+ *             passed as the last parameter to <b>func</b>.
+ *
+ * @see can_net_get_filter_func()
+ */
+void can_net_set_filter_func(
+		can_net_t *net, can_net_filter_func_t *func, void *data);
+
+/**
+ * Obtains the CAN frame filters corresponding to the receivers registered with
+ * a network interface. Each CAN identifier for which at least one receiver was
+ * started with can_recv_start() results in one filter, as does each receiver
+ * started with can_recv_start_mask(). Use can_net_compact_filters() to reduce
+ * the number of filters.
+ *
+ * @param net     a pointer to a CAN network interface.
+ * @param filters the address at which to store the filters (can be NULL if
+ *                <b>n</b> is 0).
+ * @param n       the maximum number of filters to store at <b>filters</b>.
+ *
+ * @returns the total number of filters. If this number exceeds <b>n</b>, only
+ * the first <b>n</b> filters are stored.
+ */
+size_t can_net_get_filters(const can_net_t *net,
+		struct can_net_filter *filters, size_t n);
+
+/**
+ * Reduces the number of CAN frame filters in an array. Filters that are
+ * duplicates, are contained in another filter, or differ from another filter
+ * in a single bit, are merged without changing the set of accepted frames. If
+ * more than <b>max</b> filters remain, the pairs of filters that result in the
+ * smallest number of additional accepted bits are merged until only <b>max</b>
+ * filters are left. The resulting filters accept at least every frame accepted
+ * by the original filters.
+ *
+ * @param filters a pointer to an array of filters. The array is sorted and
+ *                modified in place.
+ * @param n       the number of filters at <b>filters</b>.
+ * @param max     the maximum number of filters. If <b>max</b> is 0, only the
+ *                lossless merges are performed.
+ *
+ * @returns the number of remaining filters.
+ */
+size_t can_net_compact_filters(
+		struct can_net_filter *filters, size_t n, size_t max);
+
 /// Returns the alignment (in bytes) of the #can_timer_t structure.
 size_t can_timer_alignof(void);
 
@@ -338,11 +511,35 @@ void can_recv_set_func(can_recv_t *recv, can_recv_func_t *func, void *data);
 void can_recv_start(can_recv_t *recv, can_net_t *net, uint_least32_t id,
 		uint_least8_t flags);
 
+/**
+ * Registers a CAN frame receiver for a range of CAN identifiers with a network
+ * interface and starts processing frames. A frame is accepted if
+ * `(msg->id & mask) == (id & mask)` and
+ * `(msg->flags & flags_mask) == (flags & flags_mask)`. Masked receivers are
+ * not indexed by CAN identifier; every received frame is compared against each
+ * of them, in the order in which they were started, after the receivers
+ * registered with can_recv_start().
+ *
+ * @param recv       a pointer to a CAN frame receiver.
+ * @param net        a pointer to a CAN network interface.
+ * @param id         the CAN identifier for which the receiver should be
+ *                   invoked.
+ * @param mask       the bits of the CAN identifier that must match <b>id</b>.
+ * @param flags      the flags that should be set in every accepted frame.
+ * @param flags_mask the flags that must match <b>flags</b>. Use 0xff to only
+ *                   accept frames with exactly the specified flags.
+ *
+ * @see can_recv_start(), can_recv_stop()
+ */
+void can_recv_start_mask(can_recv_t *recv, can_net_t *net, uint_least32_t id,
+		uint_least32_t mask, uint_least8_t flags,
+		uint_least8_t flags_mask);
+
 /**
  * Stops a CAN frame receiver from processing frames and unregisters it with the
  * network interface.
  *
- * @see can_recv_start()
+ * @see can_recv_start(), can_recv_start_mask()
  */
 void can_recv_stop(can_recv_t *recv);
 
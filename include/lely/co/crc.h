@@ -33,8 +33,11 @@ extern "C" {
 
 /**
  * Computes a CRC-16 checksum. This is an implementation of the CRC16-CCITT
- * specification based on the 0x1021 generator polynomial. It uses a table with
- * precomputed values for efficiency.
+ * specification based on the 0x1021 generator polynomial. It uses tables with
+ * precomputed values for efficiency and processes eight bytes per iteration
+ * ("slicing-by-8"). The CRC of a sequence of bytes can be computed
+ * incrementally by passing the result of the previous call as the initial
+ * value.
  *
  * As per section 7.2.4.3.16 in CiA 301 version 4.2.0, the CRC of "123456789"
  * (with an initial value of 0x0000) is 0x31c3.
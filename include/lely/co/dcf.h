@@ -27,6 +27,9 @@
 // The file location struct from <lely/util/diag.h>.
 struct floc;
 
+// The configuration struct from <lely/util/config.h>.
+struct __config;
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -58,6 +61,24 @@ co_dev_t *co_dev_init_from_dcf_text(co_dev_t *dev, const char *begin,
 co_dev_t *co_dev_create_from_dcf_text(
 		const char *begin, const char *end, struct floc *at);
 
+co_dev_t *co_dev_init_from_dcf_cfg(co_dev_t *dev, const struct __config *cfg);
+
+/**
+ * Creates a CANopen device from an EDS or DCF file that has already been parsed
+ * into a configuration struct.
+ *
+ * co_dev_create_from_dcf_file() and co_dev_create_from_dcf_text() do not build
+ * a configuration struct, but lex the file in a single pass and look up
+ * sections and keys with a binary search. This function is only useful if the
+ * configuration struct is needed anyway, or has been created or modified by
+ * other means.
+ *
+ * @returns a pointer to a new CANopen device, or NULL on error.
+ *
+ * @see config_parse_ini_file(), config_parse_ini_text()
+ */
+co_dev_t *co_dev_create_from_dcf_cfg(const struct __config *cfg);
+
 #ifdef __cplusplus
 }
 #endif
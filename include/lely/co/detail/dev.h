@@ -26,6 +26,19 @@
 #include <lely/co/dev.h>
 #include <lely/util/rbtree.h>
 
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+/**
+ * An entry in the reverse index from mapped sub-objects to valid, acyclic or
+ * event-driven Transmit-PDOs.
+ */
+struct co_dev_tpdo_ent {
+	/// The mapped sub-object (`idx << 8 | subidx`).
+	co_unsigned32_t key;
+	/// The PDO number (in the range [1..512]).
+	co_unsigned16_t num;
+};
+#endif
+
 /// A CANopen device.
 struct co_dev {
 	/// The network-ID.
@@ -34,6 +47,31 @@ struct co_dev {
 	co_unsigned8_t id;
 	/// The tree containing the object dictionary.
 	struct rbtree tree;
+	/**
+	 * A flag indicating whether the object dictionary is frozen (see
+	 * co_dev_freeze() and snprintf_c99_dev()).
+	 */
+	int frozen;
+	/// The objects in a frozen object dictionary, sorted by index.
+	co_obj_t *const *frozen_obj;
+	/// The indices of the objects in #frozen_obj.
+	const co_unsigned16_t *frozen_idx;
+	/// The number of objects in #frozen_obj.
+	size_t frozen_nobj;
+	/// The sub-objects in a frozen object dictionary, sorted by key.
+	co_sub_t *const *frozen_sub;
+	/// The keys (`idx << 8 | subidx`) of the sub-objects in #frozen_sub.
+	const co_unsigned32_t *frozen_key;
+	/// The number of sub-objects in #frozen_sub.
+	size_t frozen_nsub;
+#if !LELY_NO_MALLOC
+	/**
+	 * The memory block containing the arrays above, followed by the values
+	 * of all objects, if the object dictionary was frozen by
+	 * co_dev_freeze().
+	 */
+	void *frozen_buf;
+#endif
 #if !LELY_NO_CO_OBJ_NAME
 	/// A pointer to the name of the device.
 	char *name;
@@ -67,7 +105,78 @@ struct co_dev {
 	co_dev_tpdo_event_ind_t *tpdo_event_ind;
 	/// A pointer to user-specified data for #tpdo_event_ind.
 	void *tpdo_event_data;
+#if !LELY_NO_MALLOC
+	/**
+	 * An array containing the reverse index used by co_dev_tpdo_event(),
+	 * sorted by key and PDO number.
+	 */
+	struct co_dev_tpdo_ent *tpdo_ent;
+	/// The number of entries in #tpdo_ent.
+	size_t tpdo_nent;
+	/// A flag indicating whether #tpdo_ent needs to be rebuilt.
+	int tpdo_dirty;
+#endif
+#endif
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+	/**
+	 * A counter which is incremented whenever the COB-ID or transmission
+	 * type of a Receive- or Transmit-PDO service changes.
+	 */
+	unsigned int pdo_comm_gen;
 #endif
 };
 
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+/**
+ * Invalidates the reverse index used by co_dev_tpdo_event() if <b>idx</b> is
+ * the index of a TPDO communication (1800..19FF) or mapping (1A00..1BFF)
+ * parameter object. The index is rebuilt on the next event.
+ */
+static inline void
+co_dev_tpdo_invalidate(co_dev_t *dev, co_unsigned16_t idx)
+{
+	if (dev && idx >= 0x1800 && idx <= 0x1bff)
+		dev->tpdo_dirty = 1;
+}
+#endif
+
+/**
+ * Finds a sub-object in a frozen object dictionary with a binary search of the
+ * sorted keys.
+ *
+ * @pre the object dictionary of <b>dev</b> is frozen (see co_dev_freeze()).
+ */
+static inline co_sub_t *
+co_dev_frozen_find_sub(const co_dev_t *dev, co_unsigned16_t idx,
+		co_unsigned8_t subidx)
+{
+	const co_unsigned32_t key = ((co_unsigned32_t)idx << 8) | subidx;
+	const co_unsigned32_t *keys = dev->frozen_key;
+	size_t n = dev->frozen_nsub;
+	if (!n)
+		return NULL;
+	// Halve the range without an unpredictable branch on the comparison.
+	size_t i = 0;
+	while (n > 1) {
+		size_t half = n / 2;
+		i = keys[i + half] <= key ? i + half : i;
+		n -= half;
+	}
+	return keys[i] == key ? dev->frozen_sub[i] : NULL;
+}
+
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+/**
+ * Notifies a CANopen device that the COB-ID or transmission type of a Receive-
+ * or Transmit-PDO service has changed. This invalidates the lists of
+ * synchronous PDOs maintained by the NMT service.
+ */
+static inline void
+co_dev_pdo_comm_changed(co_dev_t *dev)
+{
+	if (dev)
+		dev->pdo_comm_gen++;
+}
+#endif
+
 #endif // LELY_CO_DETAIL_DEV_H_
@@ -258,6 +258,48 @@ co_obj_t *co_dev_find_obj(const co_dev_t *dev, co_unsigned16_t idx);
 co_sub_t *co_dev_find_sub(const co_dev_t *dev, co_unsigned16_t idx,
 		co_unsigned8_t subidx);
 
+#if !LELY_NO_MALLOC
+
+/**
+ * Freezes the object dictionary of a CANopen device. The indices of all
+ * objects and sub-objects are copied into sorted arrays, which are used by
+ * co_dev_find_obj(), co_dev_find_sub() and co_obj_find_sub() instead of the
+ * trees, and the values of all sub-objects are moved into a single memory
+ * block. Pointers to objects and sub-objects remain valid.
+ *
+ * While the object dictionary is frozen, objects and sub-objects cannot be
+ * inserted or removed; co_dev_insert_obj(), co_dev_remove_obj(),
+ * co_obj_insert_sub() and co_obj_remove_sub() fail with #ERRNUM_PERM. Objects
+ * and sub-objects MUST NOT be destroyed, except by destroying the device.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc(). This function succeeds if the object
+ * dictionary is already frozen.
+ *
+ * @see co_dev_thaw()
+ */
+int co_dev_freeze(co_dev_t *dev);
+
+/**
+ * Thaws the object dictionary of a CANopen device frozen by co_dev_freeze(),
+ * so objects and sub-objects can be inserted or removed again.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc() and the object dictionary remains frozen.
+ * This function succeeds if the object dictionary is not frozen.
+ */
+int co_dev_thaw(co_dev_t *dev);
+
+#endif // !LELY_NO_MALLOC
+
+/**
+ * Returns 1 if the object dictionary of a CANopen device is frozen, and 0 if
+ * not.
+ *
+ * @see co_dev_freeze(), snprintf_c99_dev()
+ */
+int co_dev_is_frozen(const co_dev_t *dev);
+
 /**
  * Finds the first object (with the lowest index) in the object dictionary of a
  * CANopen device.
@@ -636,6 +678,13 @@ void co_dev_set_tpdo_event_ind(
  * co_dev_set_tpdo_event_ind(). At most one event is indicated for every
  * matching TPDO.
  *
+ * The matching TPDOs are found with a reverse index from mapped sub-objects to
+ * TPDOs, which is rebuilt by the first event after a TPDO communication or
+ * mapping parameter has been changed with co_sub_set_val() or co_sub_dn() (or
+ * any of the functions based on them, such as SDO downloads and
+ * co_dev_read_dcf()). Changes made directly through the pointer returned by
+ * co_sub_addressof_val() or co_obj_addressof_val() are not detected.
+ *
  * @param dev    a pointer to a CANopen device.
  * @param idx    the object index.
  * @param subidx the object sub-index.
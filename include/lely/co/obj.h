@@ -856,6 +856,13 @@ void co_sub_get_dn_ind(
  */
 void co_sub_set_dn_ind(co_sub_t *sub, co_sub_dn_ind_t *ind, void *data);
 
+/**
+ * Returns 1 if the download indication function of a CANopen sub-object is the
+ * default indication function (which invokes co_sub_on_dn()), and 0 if a custom
+ * function was registered with co_sub_set_dn_ind().
+ */
+int co_sub_has_default_dn_ind(const co_sub_t *sub);
+
 /**
  * Implements the default behavior when a download indication is received by a
  * CANopen sub-object. For a domain value with the #CO_OBJ_FLAGS_DOWNLOAD_FILE
@@ -966,6 +973,13 @@ void co_sub_get_up_ind(
  */
 void co_sub_set_up_ind(co_sub_t *sub, co_sub_up_ind_t *ind, void *data);
 
+/**
+ * Returns 1 if the upload indication function of a CANopen sub-object is the
+ * default indication function (which invokes co_sub_on_up()), and 0 if a custom
+ * function was registered with co_sub_set_up_ind().
+ */
+int co_sub_has_default_up_ind(const co_sub_t *sub);
+
 /**
  * Implements the default behavior when an upload indication is received by a
  * CANopen sub-object. For a domain value with the #CO_OBJ_FLAGS_UPLOAD_FILE
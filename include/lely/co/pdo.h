@@ -100,6 +100,54 @@ struct co_pdo_map_par {
 	}
 // clang-format on
 
+/**
+ * An entry in a compiled PDO mapping.
+ *
+ * @see struct co_pdo_plan
+ */
+struct co_pdo_plan_ent {
+	/**
+	 * A pointer to the mapped sub-object, or NULL if the entry is a dummy
+	 * entry or the sub-object did not exist when the plan was compiled.
+	 */
+	co_sub_t *sub;
+	/// The object index.
+	co_unsigned16_t idx;
+	/// The object sub-index.
+	co_unsigned8_t subidx;
+	/// The length (in bits) of the mapped value.
+	co_unsigned8_t len;
+	/// The offset (in bits) of the mapped value in the PDO.
+	co_unsigned16_t offset;
+};
+
+/**
+ * A compiled PDO mapping. A plan caches the sub-objects and bit offsets of the
+ * mapped application objects, so a PDO can be (un)packed without looking up
+ * each mapped object in the object dictionary.
+ *
+ * @see co_pdo_plan_init()
+ */
+struct co_pdo_plan {
+	/// The number of entries in #ent.
+	co_unsigned8_t n;
+	/// The total length (in bits) of the mapped values.
+	co_unsigned16_t bits;
+	/// The (non-zero) entries of the mapping.
+	struct co_pdo_plan_ent ent[CO_PDO_NUM_MAPS];
+};
+
+/// The static initializer for struct #co_pdo_plan.
+#define CO_PDO_PLAN_INIT \
+	{ \
+		0, 0, \
+		{ \
+			{ \
+				NULL, 0, 0, 0, 0 \
+			} \
+		} \
+	}
+
 // The CANopen SDO upload/download request from lely/co/sdo.h.
 struct co_sdo_req;
 
@@ -299,6 +347,41 @@ co_unsigned32_t co_pdo_dn(const struct co_pdo_map_par *par, co_dev_t *dev,
 co_unsigned32_t co_pdo_up(const struct co_pdo_map_par *par, const co_dev_t *dev,
 		struct co_sdo_req *req, uint_least8_t *buf, size_t *pn);
 
+/**
+ * Compiles PDO mapping parameters into a plan for co_pdo_plan_dn() and
+ * co_pdo_plan_up(). The sub-objects of the mapped application objects are
+ * resolved once. The plan has to be recompiled whenever the mapping changes,
+ * and the mapped sub-objects MUST NOT be removed from the object dictionary
+ * while the plan is in use.
+ *
+ * @param plan a pointer to the plan to be initialized.
+ * @param par  a pointer to the PDO mapping parameters.
+ * @param dev  a pointer to a CANopen device.
+ */
+void co_pdo_plan_init(struct co_pdo_plan *plan,
+		const struct co_pdo_map_par *par, const co_dev_t *dev);
+
+/**
+ * Equivalent to co_pdo_dn(), except that the mapping is taken from a compiled
+ * plan. Values of basic data types of sub-objects without a custom download
+ * indication function are written directly, without an SDO download request.
+ *
+ * @see co_pdo_plan_init()
+ */
+co_unsigned32_t co_pdo_plan_dn(const struct co_pdo_plan *plan, co_dev_t *dev,
+		struct co_sdo_req *req, const uint_least8_t *buf, size_t n);
+
+/**
+ * Equivalent to co_pdo_up(), except that the mapping is taken from a compiled
+ * plan. Values of basic data types of sub-objects without a custom upload
+ * indication function are read directly, without an SDO upload request.
+ *
+ * @see co_pdo_plan_init()
+ */
+co_unsigned32_t co_pdo_plan_up(const struct co_pdo_plan *plan,
+		const co_dev_t *dev, struct co_sdo_req *req, uint_least8_t *buf,
+		size_t *pn);
+
 #ifdef __cplusplus
 }
 #endif
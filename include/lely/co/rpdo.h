@@ -195,6 +195,23 @@ void co_rpdo_set_err(co_rpdo_t *pdo, co_rpdo_err_t *err, void *data);
  */
 int co_rpdo_sync(co_rpdo_t *pdo, co_unsigned8_t cnt);
 
+/**
+ * Triggers the actuation of a received synchronous PDO. This function is
+ * equivalent to co_rpdo_sync(), except that the end of the synchronous time
+ * window is provided by the caller instead of being computed from object 1007.
+ * This allows the window to be computed once per SYNC object for all PDOs.
+ *
+ * @param pdo a pointer to a Receive-PDO service.
+ * @param cnt the counter value (in the range [0..240]).
+ * @param end a pointer to the time at which the synchronous time window
+ *            expires, or NULL if the window length is 0.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ */
+int co_rpdo_sync_swnd(co_rpdo_t *pdo, co_unsigned8_t cnt,
+		const struct timespec *end);
+
 /**
  * Requests the transmission of a PDO.
  *
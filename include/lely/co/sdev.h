@@ -150,6 +150,54 @@ int snprintf_c99_sdev(char *s, size_t n, const co_dev_t *dev);
  */
 int asprintf_c99_sdev(char **ps, const co_dev_t *dev);
 
+/**
+ * Prints C99 code defining a statically allocated CANopen device that can be
+ * used in place, without any copying or dynamic memory allocation. The device
+ * is called <b>name</b> and has external linkage; all other definitions are
+ * static and their identifiers start with <b>name</b>.
+ *
+ * The objects and sub-objects are linked into pre-built trees, the values of
+ * all sub-objects are stored in a single writable block and the object
+ * dictionary is frozen, with read-only sorted lookup tables (see
+ * co_dev_freeze()). Names are printed as `CO_DEV_STRING("...")`, so the macro
+ * `CO_DEV_STRING(s)` MUST be defined before the code is compiled.
+ *
+ * The printed code requires the private headers <lely/co/detail/dev.h> and
+ * <lely/co/detail/obj.h> and <lely/util/cmp.h>. Since strings and domains are
+ * modified in place, it can only be used if dynamic memory allocation is
+ * disabled (`LELY_NO_MALLOC`).
+ *
+ * @param s    the address of the output buffer. If <b>s</b> is not NULL, at
+ *             most `n - 1` characters are written, plus a terminating null
+ *             byte.
+ * @param n    the size (in bytes) of the buffer at <b>s</b>. If <b>n</b> is
+ *             zero, nothing is written.
+ * @param dev  a pointer to a CANopen device to be printed.
+ * @param name a pointer to the name of the C variable.
+ *
+ * @returns the number of characters that would have been written had the
+ * buffer been sufficiently large, not counting the terminating null byte, or a
+ * negative number on error. In the latter case, the error number is stored in
+ * `errno`.
+ */
+int snprintf_c99_dev(char *s, size_t n, const co_dev_t *dev, const char *name);
+
+/**
+ * Equivalent to snprintf_c99_dev(), except that it allocates a string large
+ * enough to hold the output, including the terminating null byte.
+ *
+ * @param ps   the address of a value which, on success, contains a pointer to
+ *             the allocated string. This pointer SHOULD be passed to `free()`
+ *             to release the allocated storage.
+ * @param dev  a pointer to a CANopen device to be printed.
+ * @param name a pointer to the name of the C variable.
+ *
+ * @returns the number of characters written, not counting the terminating null
+ * byte, or a negative number on error. In the latter case, the error number is
+ * stored in `errno`.
+ */
+int asprintf_c99_dev(char **ps, const co_dev_t *dev, const char *name);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,104 @@
+/**@file
+ * This header file is part of the CANopen library; it contains the binary
+ * object dictionary snapshot declarations.
+ *
+ * A snapshot is a versioned, position-independent image of a fully configured
+ * CANopen device. All multi-byte integers are stored in little-endian byte
+ * order and all references are byte offsets with respect to the beginning of
+ * the image, so a snapshot can be mapped directly from a file (see
+ * frbuf_map()) and loaded without any lexing or parsing.
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LELY_CO_SNAP_H_
+#define LELY_CO_SNAP_H_
+
+#include <lely/co/dev.h>
+
+/// The version of the object dictionary snapshot format.
+#define CO_SNAP_VERSION 1
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+co_dev_t *co_dev_init_from_snap(
+		co_dev_t *dev, const uint_least8_t *begin, const uint_least8_t *end);
+
+/**
+ * Creates a CANopen device from a binary object dictionary snapshot.
+ *
+ * @param begin a pointer to the first byte of the snapshot.
+ * @param end   a pointer to one past the last byte of the snapshot.
+ *
+ * @returns a pointer to a new CANopen device, or NULL on error. In the latter
+ * case, the error number can be obtained with get_errc().
+ *
+ * @see co_dev_write_snap()
+ */
+co_dev_t *co_dev_create_from_snap(
+		const uint_least8_t *begin, const uint_least8_t *end);
+
+co_dev_t *co_dev_init_from_snap_file(co_dev_t *dev, const char *filename);
+
+/**
+ * Creates a CANopen device from a binary object dictionary snapshot file. The
+ * file is mapped into memory, if possible, instead of being read.
+ *
+ * @returns a pointer to a new CANopen device, or NULL on error. In the latter
+ * case, the error number can be obtained with get_errc().
+ *
+ * @see co_dev_write_snap_file()
+ */
+co_dev_t *co_dev_create_from_snap_file(const char *filename);
+
+/**
+ * Writes a binary snapshot of the object dictionary of a CANopen device,
+ * including the names, data types, access types, limits, default values and
+ * current values of all sub-objects.
+ *
+ * @param dev   a pointer to a CANopen device.
+ * @param begin a pointer to the start of the buffer. If <b>begin</b> is NULL,
+ *              nothing is written.
+ * @param end   a pointer to the end of the buffer. If the buffer is too small,
+ *              nothing is written.
+ *
+ * @returns the number of bytes that would have been written had the buffer
+ * been sufficiently large, or 0 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ *
+ * @see co_dev_create_from_snap()
+ */
+size_t co_dev_write_snap(
+		const co_dev_t *dev, uint_least8_t *begin, uint_least8_t *end);
+
+/**
+ * Writes a binary snapshot of the object dictionary of a CANopen device to a
+ * file. The file is only created (or replaced) if the entire snapshot could be
+ * written.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ *
+ * @see co_dev_write_snap()
+ */
+int co_dev_write_snap_file(const co_dev_t *dev, const char *filename);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !LELY_CO_SNAP_H_
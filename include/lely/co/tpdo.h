@@ -218,6 +218,23 @@ int co_tpdo_event(co_tpdo_t *pdo);
  */
 int co_tpdo_sync(co_tpdo_t *pdo, co_unsigned8_t cnt);
 
+/**
+ * Triggers the transmission of a synchronous PDO. This function is equivalent
+ * to co_tpdo_sync(), except that the end of the synchronous time window is
+ * provided by the caller instead of being computed from object 1007. This
+ * allows the window to be computed once per SYNC object for all PDOs.
+ *
+ * @param pdo a pointer to a Transmit-PDO service.
+ * @param cnt the counter value (in the range [0..240]).
+ * @param end a pointer to the time at which the synchronous time window
+ *            expires, or NULL if the window length is 0.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ */
+int co_tpdo_sync_swnd(co_tpdo_t *pdo, co_unsigned8_t cnt,
+		const struct timespec *end);
+
 /**
  * Indicates the result of the sampling step after the reception of a SYNC
  * event. This function MUST be called upon completion.
@@ -27,6 +27,7 @@
 #include <lely/util/mutex.hpp>
 #include <lely/co/co.h>
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 #include <string>
@@ -34,11 +35,24 @@
 
 // The CANopen device from <lely/co/dev.h>.
 struct co_dev;
+// The CANopen sub-object from <lely/co/obj.h>.
+struct co_sub;
 
 namespace lely {
 
 namespace canopen {
 
+/// A remote sub-object mapped into a Receive-PDO.
+struct RpdoMappedObject {
+  /// The remote object index.
+  uint16_t idx;
+  /// The remote object sub-index.
+  uint8_t subidx;
+};
+
+template <class>
+class SubObjectRef;
+
 /**
  * The CANopen device description. This class manages the object dictionary and
  * device setttings such as the network-ID and node-ID.
@@ -218,6 +232,38 @@ class Device {
   void Write(uint16_t idx, uint8_t subidx, const void* p, ::std::size_t n,
              ::std::error_code& ec);
 
+  /**
+   * Resolves a sub-object in the local object dictionary and returns a typed
+   * handle to it. The object lookup and type check are performed once, here,
+   * instead of on every Read() or Write().
+   *
+   * @param idx    the object index.
+   * @param subidx the object sub-index.
+   *
+   * @returns a handle to the sub-object, which remains valid as long as the
+   * sub-object is not removed from the object dictionary.
+   *
+   * @throws #lely::canopen::SdoError if the sub-object does not exist or the
+   * type does not match.
+   */
+  template <class T>
+  SubObjectRef<T> GetSubObjectRef(uint16_t idx, uint8_t subidx);
+
+  /**
+   * Resolves a sub-object in the local object dictionary and returns a typed
+   * handle to it.
+   *
+   * @param idx    the object index.
+   * @param subidx the object sub-index.
+   * @param ec     if the sub-object does not exist or the type does not match,
+   *               the SDO abort code is stored in <b>ec</b>.
+   *
+   * @returns a handle to the sub-object, or an invalid handle on error.
+   */
+  template <class T>
+  SubObjectRef<T> GetSubObjectRef(uint16_t idx, uint8_t subidx,
+                                  ::std::error_code& ec) noexcept;
+
 #if !LELY_NO_STDIO
   /**
    * Submits a series of SDO download requests to the local object dictionary.
@@ -475,6 +521,34 @@ class Device {
   void OnRpdoWrite(
       ::std::function<void(uint8_t, uint16_t, uint8_t)> on_rpdo_write);
 
+  /*
+   * Registers the function to be invoked once for every Receive-PDO that is
+   * successfully written to the local object dictionary, if batched RPDO write
+   * notifications are enabled (see SetRpdoWriteBatching()). Only a single
+   * function can be registered at any one time. If <b>on_rpdo_write</b>
+   * contains a callable function target, a copy of the target is invoked
+   * _after_ OnRpdoWrite(uint8_t, int, const RpdoMappedObject*, ::std::size_t)
+   * completes.
+   */
+  void OnRpdoWrite(::std::function<void(uint8_t, int, const RpdoMappedObject*,
+                                        ::std::size_t)>
+                       on_rpdo_write);
+
+  /**
+   * Enables or disables batched RPDO write notifications. If enabled,
+   * OnRpdoWrite(uint8_t, uint16_t, uint8_t) is no longer invoked for each
+   * RPDO-mapped sub-object. Instead,
+   * OnRpdoWrite(uint8_t, int, const RpdoMappedObject*, ::std::size_t) is
+   * invoked once per received PDO, with the list of remote sub-objects resolved
+   * by UpdateRpdoMapping(). Batching is disabled by default.
+   *
+   * Note that, while batching is enabled, no RPDO write notification is issued
+   * when an RPDO-mapped sub-object is written by an SDO download, since only
+   * Receive-PDOs are batched. OnWrite(uint16_t, uint8_t) is still invoked for
+   * such writes.
+   */
+  void SetRpdoWriteBatching(bool enable);
+
  protected:
   ~Device();
 
@@ -1013,7 +1087,9 @@ class Device {
    * The function invoked when a value is successfully written to an RPDO-mapped
    * object in the local object dictionary by a Receive-PDO (or SDO download)
    * request. In the case of a PDO, this function is invoked for each sub-object
-   * in the order of the RPDO mapping.
+   * in the order of the RPDO mapping. This function is not invoked at all, not
+   * even for SDO downloads, if batched RPDO write notifications are enabled
+   * (see SetRpdoWriteBatching()).
    *
    * @param id     the node-ID.
    * @param idx    the remote object index.
@@ -1025,11 +1101,131 @@ class Device {
   virtual void
   OnRpdoWrite(uint8_t /*id*/, uint16_t /*idx*/, uint8_t /*subidx*/) noexcept {}
 
+  /*
+   * The function invoked when a Receive-PDO has been successfully written to
+   * the local object dictionary, if batched RPDO write notifications are
+   * enabled (see SetRpdoWriteBatching()). This function is invoked once per
+   * PDO, instead of invoking OnRpdoWrite(uint8_t, uint16_t, uint8_t) for each
+   * mapped sub-object.
+   *
+   * @param id  the node-ID.
+   * @param num the PDO number (in the range [1..512]).
+   * @param p   a pointer to the remote sub-objects, in the order of the RPDO
+   *            mapping. The array remains valid until the next call to
+   *            UpdateRpdoMapping().
+   * @param n   the number of sub-objects at <b>p</b>.
+   *
+   * @pre a valid mapping from remote TPDO-mapped sub-objects to local
+   * RPDO-mapped sub-objects has been generated with UpdateRpdoMapping().
+   */
+  virtual void
+  OnRpdoWrite(uint8_t /*id*/, int /*num*/, const RpdoMappedObject* /*p*/,
+              ::std::size_t /*n*/) noexcept {}
+
+  /**
+   * Issues the batched RPDO write notification for the specified Receive-PDO,
+   * if batching is enabled and the PDO maps at least one remote sub-object.
+   * This function is invoked by the node once the PDO has been written to the
+   * object dictionary.
+   *
+   * @param num the PDO number (in the range [1..512]).
+   */
+  void RpdoWriteInd(int num);
+
  private:
+  template <class>
+  friend class SubObjectRef;
+
   struct Impl_;
   ::std::unique_ptr<Impl_> impl_;
 };
 
+/**
+ * A resolved, typed handle to a sub-object in a local object dictionary,
+ * obtained with Device::GetSubObjectRef(). Read() and Write() access the value
+ * directly under the device lock, without serializing it to an SDO request or
+ * looking up the sub-object. As with Device::Read() and Device::Write(), access
+ * and range checks are honored, and so are custom upload and download
+ * indication functions; if one is installed, the handle falls back to an SDO
+ * request.
+ */
+template <class T>
+class SubObjectRef {
+  static_assert(is_canopen_basic<T>::value,
+                "SubObjectRef requires a CANopen basic type");
+
+  friend class Device;
+
+ public:
+  /// Constructs an invalid handle.
+  SubObjectRef() noexcept = default;
+
+  /// Checks whether `*this` refers to a sub-object.
+  explicit operator bool() const noexcept { return sub_ != nullptr; }
+
+  /// Returns the object index.
+  uint16_t
+  idx() const noexcept {
+    return idx_;
+  }
+
+  /// Returns the object sub-index.
+  uint8_t
+  subidx() const noexcept {
+    return subidx_;
+  }
+
+  /**
+   * Reads the value of the sub-object.
+   *
+   * @throws #lely::canopen::SdoError on error.
+   *
+   * @see Device::Read(uint16_t idx, uint8_t subidx) const
+   */
+  T Read() const;
+
+  /**
+   * Reads the value of the sub-object.
+   *
+   * @param ec on error, the SDO abort code is stored in <b>ec</b>.
+   *
+   * @returns the value of the sub-object, or an empty value on error.
+   *
+   * @see Device::Read(uint16_t idx, uint8_t subidx, ::std::error_code& ec)
+   * const
+   */
+  T Read(::std::error_code& ec) const;
+
+  /**
+   * Writes a value to the sub-object.
+   *
+   * @throws #lely::canopen::SdoError on error.
+   *
+   * @see Device::Write(uint16_t idx, uint8_t subidx, const T& value)
+   */
+  void Write(T value);
+
+  /**
+   * Writes a value to the sub-object.
+   *
+   * @param value the value to be written.
+   * @param ec    on error, the SDO abort code is stored in <b>ec</b>.
+   *
+   * @see Device::Write(uint16_t idx, uint8_t subidx, const T& value,
+   * ::std::error_code& ec)
+   */
+  void Write(T value, ::std::error_code& ec);
+
+ private:
+  SubObjectRef(Device* dev, co_sub* sub, uint16_t idx, uint8_t subidx) noexcept
+      : dev_(dev), sub_(sub), idx_(idx), subidx_(subidx) {}
+
+  Device* dev_{nullptr};
+  co_sub* sub_{nullptr};
+  uint16_t idx_{0};
+  uint8_t subidx_{0};
+};
+
 }  // namespace canopen
 
 }  // namespace lely
@@ -81,6 +81,23 @@ class DriverBase {
    */
   virtual void OnRpdoWrite(uint16_t idx, uint8_t subidx) noexcept = 0;
 
+  /*
+   * The function invoked once per Receive-PDO when batched RPDO write
+   * notifications are enabled (see Device::SetRpdoWriteBatching()).
+   *
+   * The default implementation invokes OnRpdoWrite(uint16_t, uint8_t) for each
+   * sub-object, in the order of the RPDO mapping.
+   *
+   * @param num the PDO number (in the range [1..512]).
+   * @param p   a pointer to the remote sub-objects.
+   * @param n   the number of sub-objects at <b>p</b>.
+   */
+  virtual void
+  OnRpdoWrite(int num, const RpdoMappedObject* p, ::std::size_t n) noexcept {
+    (void)num;
+    for (; n; n--, p++) OnRpdoWrite(p->idx, p->subidx);
+  }
+
   /**
    * The function invoked when an NMT state change occurs on the master.
    *
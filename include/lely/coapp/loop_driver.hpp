@@ -33,6 +33,53 @@ namespace lely {
 
 namespace canopen {
 
+/**
+ * A fixed-size pool of threads running a shared event loop. Instead of running
+ * a dedicated event loop in a separate thread for each driver, any number of
+ * #lely::canopen::LoopDriver instances can share the same pool. Each driver
+ * executes its event handlers (and SDO confirmation functions) on its own
+ * strand, so they are never executed concurrently.
+ */
+class LoopDriverPool {
+ public:
+  /**
+   * Creates a new event loop and starts <b>nthrd</b> threads to run it.
+   *
+   * @param nthrd the number of threads. If <b>nthrd</b> is 0, one thread is
+   *              started for each hardware thread (see
+   *              `std::thread::hardware_concurrency()`).
+   */
+  explicit LoopDriverPool(::std::size_t nthrd = 0);
+
+  LoopDriverPool(const LoopDriverPool&) = delete;
+  LoopDriverPool& operator=(const LoopDriverPool&) = delete;
+
+  /**
+   * Stops the event loop and terminates the threads in which it was running.
+   * All drivers using the pool MUST be destroyed (or joined) before the pool is
+   * destroyed.
+   */
+  ~LoopDriverPool();
+
+  /// Returns a reference to the shared event loop of the pool.
+  ev::Loop& GetLoop() noexcept;
+
+  /// Returns the number of threads running the event loop.
+  ::std::size_t size() const noexcept;
+
+  /**
+   * Stops the event loop and waits until all threads finish their execution.
+   *
+   * This function can be called more than once and from multiple threads, but
+   * only the first invocation waits for the threads to finish.
+   */
+  void Join();
+
+ private:
+  struct Impl_;
+  ::std::unique_ptr<Impl_> impl_;
+};
+
 namespace detail {
 
 /**
@@ -41,13 +88,20 @@ namespace detail {
  */
 class LoopDriverBase {
  protected:
-  ev::Loop loop{};
-  ev::Strand strand{loop.get_executor()};
+  LoopDriverBase();
+  explicit LoopDriverBase(LoopDriverPool& pool);
+
+  ::std::unique_ptr<ev::Loop> own_loop;
+  ev::Loop& loop;
+  ev::Strand strand;
 };
 
 }  // namespace detail
 
-/// A CANopen driver running its own dedicated event loop in a separate thread.
+/**
+ * A CANopen driver running its own dedicated event loop in a separate thread,
+ * or running on the shared event loop of a #lely::canopen::LoopDriverPool.
+ */
 class LoopDriver : detail::LoopDriverBase, public BasicDriver {
  public:
   /**
@@ -61,15 +115,32 @@ class LoopDriver : detail::LoopDriverBase, public BasicDriver {
    */
   explicit LoopDriver(AsyncMaster& master, uint8_t id);
 
+  /**
+   * Creates a new CANopen driver which executes its event handlers (and SDO
+   * confirmation functions) on a strand on the shared event loop of
+   * <b>pool</b>. The pool MUST outlive the driver.
+   *
+   * @param pool   a reference to the thread pool running the event loop.
+   * @param master a reference to a CANopen master.
+   * @param id     the node-ID of the remote node (in the range [1..127]).
+   *
+   * @throws std::out_of_range if the node-ID is invalid or already registered.
+   */
+  LoopDriver(LoopDriverPool& pool, AsyncMaster& master, uint8_t id);
+
   /**
    * Stops the event loop and terminates the thread in which it was running
-   * before destroying the driver.
+   * before destroying the driver. If the driver runs on a shared event loop,
+   * this waits for the pending tasks of the driver to finish instead.
    *
    * @see AsyncStopped()
    */
   ~LoopDriver();
 
-  /// Returns a reference to the dedicated event loop of the driver.
+  /**
+   * Returns a reference to the event loop of the driver. This is the dedicated
+   * event loop of the driver, or the shared loop of the pool it runs on.
+   */
   ev::Loop&
   GetLoop() noexcept {
     return loop;
@@ -88,6 +159,11 @@ class LoopDriver : detail::LoopDriverBase, public BasicDriver {
    * destroyed. Otherwise pending tasks for those drivers may remain on the
    * event loop.
    *
+   * If the driver runs on a shared event loop, the loop is not stopped. Instead,
+   * this function deregisters the driver and waits until the tasks queued on its
+   * strand have been executed. In that case, it MUST NOT be called from one of
+   * those tasks.
+   *
    * This function can be called more than once and from multiple threads, but
    * only the first invocation waits for the thread to finish.
    */
@@ -95,7 +171,9 @@ class LoopDriver : detail::LoopDriverBase, public BasicDriver {
 
   /**
    * Returns a future which becomes ready once the dedicated event loop of the
-   * driver is stopped and the thread is (about to be) terminated.
+   * driver is stopped and the thread is (about to be) terminated, or, if the
+   * driver runs on a shared event loop, once the driver has been deregistered
+   * and its pending tasks have been executed.
    */
   ev::Future<void, void> AsyncStoppped() noexcept;
 
@@ -111,10 +189,69 @@ class LoopDriver : detail::LoopDriverBase, public BasicDriver {
     GetStrand().post(::std::forward<F>(f), ::std::forward<Args>(args)...);
   }
 
+  /**
+   * Equivalent to BasicDriver::AsyncWait(), except that the future becomes
+   * ready on the event loop of the driver instead of on its strand. If the
+   * driver runs on a shared event loop, the event handlers of the driver are
+   * executed on its strand, and a future completed on that strand could not
+   * become ready while an event handler is blocked in Wait().
+   */
+  template <class T>
+  ev::Future<void, ::std::exception_ptr>
+  AsyncWait(const T& t) {
+    return master.AsyncWait(strand.get_inner_executor(), t);
+  }
+
+  /// @see AsyncWait()
+  template <class T, class... Args>
+  SdoFuture<T>
+  AsyncRead(uint16_t idx, uint8_t subidx, Args&&... args) {
+    return master.AsyncRead<T>(strand.get_inner_executor(), id(), idx, subidx,
+                               ::std::forward<Args>(args)...);
+  }
+
+  /// @see AsyncWait()
+  template <class T, class... Args>
+  SdoFuture<T>
+  AsyncBlockRead(uint16_t idx, uint8_t subidx, Args&&... args) {
+    return master.AsyncBlockRead<T>(strand.get_inner_executor(), id(), idx,
+                                    subidx, ::std::forward<Args>(args)...);
+  }
+
+  /// @see AsyncWait()
+  template <class T, class... Args>
+  SdoFuture<void>
+  AsyncWrite(uint16_t idx, uint8_t subidx, T&& value, Args&&... args) {
+    return master.AsyncWrite(strand.get_inner_executor(), id(), idx, subidx,
+                             ::std::forward<T>(value),
+                             ::std::forward<Args>(args)...);
+  }
+
+  /// @see AsyncWait()
+  template <class T, class... Args>
+  SdoFuture<void>
+  AsyncBlockWrite(uint16_t idx, uint8_t subidx, T&& value, Args&&... args) {
+    return master.AsyncBlockWrite(strand.get_inner_executor(), id(), idx,
+                                  subidx, ::std::forward<T>(value),
+                                  ::std::forward<Args>(args)...);
+  }
+
+  /// @see AsyncWait()
+  template <class... Args>
+  SdoFuture<void>
+  AsyncWriteDcf(Args&&... args) {
+    return master.AsyncWriteDcf(strand.get_inner_executor(), id(),
+                                ::std::forward<Args>(args)...);
+  }
+
   /**
    * Waits for the specified future to become ready by running pending tasks on
    * the dedicated event loop of the driver.
    *
+   * If the driver runs on a shared event loop, the pending tasks of other
+   * drivers on that loop may be executed by the calling thread while it waits.
+   * Tasks of this driver are not executed until the calling task completes.
+   *
    * This function MUST only be called from tasks running on that event loop.
    *
    * @returns the value stored in the future on success.
@@ -1677,6 +1677,14 @@ class BasicMaster : public Node, protected ::std::map<uint8_t, DriverBase*> {
     Node::OnRpdoWrite(on_rpdo_write);
   }
 
+  /// @see Device::OnRpdoWrite()
+  void
+  OnRpdoWrite(::std::function<void(uint8_t, int, const RpdoMappedObject*,
+                                   ::std::size_t)>
+                  on_rpdo_write) {
+    Node::OnRpdoWrite(on_rpdo_write);
+  }
+
   /// @see Node::OnCommand()
   void
   OnCommand(::std::function<void(NmtCommand)> on_command) {
@@ -1769,6 +1777,15 @@ class BasicMaster : public Node, protected ::std::map<uint8_t, DriverBase*> {
    */
   void OnRpdoWrite(uint8_t id, uint16_t idx, uint8_t subidx) noexcept override;
 
+  /**
+   * The default implementation notifies the driver registered for node
+   * <b>id</b>.
+   *
+   * @see Device::OnRpdoWrite(), DriverBase::OnRpdoWrite()
+   */
+  void OnRpdoWrite(uint8_t id, int num, const RpdoMappedObject* p,
+                   ::std::size_t n) noexcept override;
+
   /**
    * The default implementation notifies all registered drivers. Unless the
    * master enters the pre-operational or operational state, all ongoing and
@@ -1979,6 +1996,14 @@ class AsyncMaster : public BasicMaster {
     BasicMaster::OnRpdoWrite(on_rpdo_write);
   }
 
+  /// @see Device::OnRpdoWrite()
+  void
+  OnRpdoWrite(::std::function<void(uint8_t, int, const RpdoMappedObject*,
+                                   ::std::size_t)>
+                  on_rpdo_write) {
+    BasicMaster::OnRpdoWrite(on_rpdo_write);
+  }
+
   /// @see Node::OnCommand()
   void
   OnCommand(::std::function<void(NmtCommand)> on_command) {
@@ -2062,6 +2087,15 @@ class AsyncMaster : public BasicMaster {
    */
   void OnRpdoWrite(uint8_t id, uint16_t idx, uint8_t subidx) noexcept override;
 
+  /**
+   * The default implementation queues a single notification for the driver
+   * registered for node <b>id</b>, with a copy of the list of sub-objects.
+   *
+   * @see Device::OnRpdoWrite(), DriverBase::OnRpdoWrite()
+   */
+  void OnRpdoWrite(uint8_t id, int num, const RpdoMappedObject* p,
+                   ::std::size_t n) noexcept override;
+
   /**
    * The default implementation queues a notification for all registered
    * drivers. Unless the master enters the pre-operational or operational state,
@@ -27,11 +27,16 @@
 #include <lely/ev/future.hpp>
 
 #include <chrono>
+#include <functional>
 #include <limits>
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
 #include <utility>
 
+#include <cstddef>
+
 // The CAN network interface from <lely/can/net.h>.
 struct can_net;
 
@@ -159,6 +164,134 @@ to_sdo_timeout(const ::std::chrono::duration<Rep, Period>& d) {
   return timeout;
 }
 
+/**
+ * A move-only wrapper for the confirmation function of an SDO request wrapper.
+ * Unlike `std::function`, callables of at most four pointers in size which are
+ * nothrow move-constructible, such as a lambda capturing an #SdoPromise, are
+ * stored in place, so wrapping them does not allocate. Larger callables are
+ * stored on the heap.
+ */
+template <class>
+class SdoConfirmFunction;
+
+template <class... Args>
+class SdoConfirmFunction<void(Args...)> {
+ public:
+  SdoConfirmFunction() noexcept = default;
+
+  SdoConfirmFunction(::std::nullptr_t) noexcept {}
+
+  template <class F, class G = typename ::std::decay<F>::type,
+            class = typename ::std::enable_if<
+                !::std::is_same<G, SdoConfirmFunction>::value>::type>
+  SdoConfirmFunction(F&& f) {
+    if (!IsNull(f))
+      Emplace<G>(::std::forward<F>(f), IsLocal<G>());
+  }
+
+  SdoConfirmFunction(const SdoConfirmFunction&) = delete;
+
+  SdoConfirmFunction(SdoConfirmFunction&& other) noexcept
+      : vtbl_(other.vtbl_) {
+    if (vtbl_) {
+      vtbl_->move(&storage_, &other.storage_);
+      other.vtbl_ = nullptr;
+    }
+  }
+
+  SdoConfirmFunction& operator=(const SdoConfirmFunction&) = delete;
+  SdoConfirmFunction& operator=(SdoConfirmFunction&&) = delete;
+
+  ~SdoConfirmFunction() {
+    if (vtbl_) vtbl_->destroy(&storage_);
+  }
+
+  /// Checks whether `*this` stores a callable.
+  explicit operator bool() const noexcept { return vtbl_ != nullptr; }
+
+  /// Invokes the stored callable. The behavior is undefined if `!*this`.
+  void
+  operator()(Args... args) {
+    vtbl_->invoke(&storage_, ::std::forward<Args>(args)...);
+  }
+
+ private:
+  static constexpr ::std::size_t kSize = 4 * sizeof(void*);
+
+  using Storage = typename ::std::aligned_storage<kSize>::type;
+
+  template <class G>
+  using IsLocal = ::std::integral_constant<
+      bool, sizeof(G) <= sizeof(Storage) && alignof(G) <= alignof(Storage) &&
+                ::std::is_nothrow_move_constructible<G>::value>;
+
+  struct Vtbl {
+    void (*invoke)(void* ptr, Args... args);
+    void (*move)(void* dst, void* src);
+    void (*destroy)(void* ptr);
+  };
+
+  template <class G>
+  static bool
+  IsNull(const G&) noexcept {
+    return false;
+  }
+
+  template <class R, class... Params>
+  static bool
+  IsNull(R (*f)(Params...)) noexcept {
+    return !f;
+  }
+
+  template <class Signature>
+  static bool
+  IsNull(const ::std::function<Signature>& f) noexcept {
+    return !f;
+  }
+
+  template <class G, class F>
+  void
+  Emplace(F&& f, ::std::true_type) {
+    static const Vtbl vtbl = {
+        [](void* ptr, Args... args) {
+          (*static_cast<G*>(ptr))(::std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) {
+          new (dst) G(::std::move(*static_cast<G*>(src)));
+          static_cast<G*>(src)->~G();
+        },
+        [](void* ptr) { static_cast<G*>(ptr)->~G(); }};
+    new (&storage_) G(::std::forward<F>(f));
+    vtbl_ = &vtbl;
+  }
+
+  template <class G, class F>
+  void
+  Emplace(F&& f, ::std::false_type) {
+    static const Vtbl vtbl = {
+        [](void* ptr, Args... args) {
+          (**static_cast<G**>(ptr))(::std::forward<Args>(args)...);
+        },
+        [](void* dst, void* src) {
+          *static_cast<G**>(dst) = *static_cast<G**>(src);
+        },
+        [](void* ptr) { delete *static_cast<G**>(ptr); }};
+    *reinterpret_cast<G**>(&storage_) = new G(::std::forward<F>(f));
+    vtbl_ = &vtbl;
+  }
+
+  const Vtbl* vtbl_{nullptr};
+  Storage storage_;
+};
+
+/**
+ * A pool of recycled memory blocks for the SDO request wrappers created by a
+ * Client-SDO queue.
+ *
+ * @see Sdo::SubmitDownload(), Sdo::SubmitUpload()
+ */
+class SdoRequestPool;
+
 class SdoRequestBase : public ev_task {
   friend class canopen::Sdo;
 
@@ -207,10 +340,21 @@ class SdoRequestBase : public ev_task {
   /// The SDO abort code (0 on success).
   ::std::error_code ec;
 
+ protected:
+  /**
+   * Destroys an SDO request wrapper and returns its memory to the pool from
+   * which it was allocated, or deletes it if it was created with `new`.
+   */
+  template <class R>
+  static void Destroy(R* req) noexcept;
+
  private:
   virtual void operator()() noexcept = 0;
 
   virtual void OnRequest(void* data) noexcept = 0;
+
+  /// The pool from which this request was allocated, if any.
+  SdoRequestPool* pool_{nullptr};
 };
 
 template <class T>
@@ -418,7 +562,7 @@ class SdoDownloadRequestWrapper : public SdoDownloadRequestBase<T> {
 
   void OnRequest(void* data) noexcept final;
 
-  ::std::function<Signature> con_;
+  SdoConfirmFunction<Signature> con_;
 };
 
 #if !LELY_NO_STDIO
@@ -452,7 +596,7 @@ class SdoDownloadDcfRequestWrapper : public SdoDownloadDcfRequestBase {
 
   void OnRequest(void* data) noexcept final;
 
-  ::std::function<Signature> con_;
+  SdoConfirmFunction<Signature> con_;
 };
 #endif
 
@@ -474,7 +618,7 @@ class SdoUploadRequestWrapper : public SdoUploadRequestBase<T> {
 
   void OnRequest(void* data) noexcept final;
 
-  ::std::function<Signature> con_;
+  SdoConfirmFunction<Signature> con_;
 };
 
 }  // namespace detail
@@ -693,7 +837,7 @@ class Sdo {
   SubmitDownload(ev_exec_t* exec, uint16_t idx, uint8_t subidx, T&& value,
                  F&& con, bool block = false,
                  const ::std::chrono::milliseconds& timeout = {}) {
-    Submit(*make_sdo_download_request<U>(
+    Submit(*MakeRequest<detail::SdoDownloadRequestWrapper<U>>(
         exec, idx, subidx, ::std::forward<T>(value), ::std::forward<F>(con),
         block, timeout));
   }
@@ -740,8 +884,8 @@ class Sdo {
   void
   SubmitDownloadDcf(ev_exec_t* exec, const uint8_t* begin, const uint8_t* end,
                     F&& con, const ::std::chrono::milliseconds& timeout = {}) {
-    Submit(*make_sdo_download_dcf_request(exec, begin, end,
-                                          ::std::forward<F>(con), timeout));
+    Submit(*MakeRequest<detail::SdoDownloadDcfRequestWrapper>(
+        exec, begin, end, ::std::forward<F>(con), timeout));
   }
 
   /**
@@ -762,8 +906,8 @@ class Sdo {
   void
   SubmitDownloadDcf(ev_exec_t* exec, const char* path, F&& con,
                     const ::std::chrono::milliseconds& timeout = {}) {
-    Submit(*make_sdo_download_dcf_request(exec, path, ::std::forward<F>(con),
-                                          timeout));
+    Submit(*MakeRequest<detail::SdoDownloadDcfRequestWrapper>(
+        exec, path, ::std::forward<F>(con), timeout));
   }
 
   /// Cancels an SDO download request. @see Cancel()
@@ -807,8 +951,8 @@ class Sdo {
   SubmitUpload(ev_exec_t* exec, uint16_t idx, uint8_t subidx, F&& con,
                bool block = false,
                const ::std::chrono::milliseconds& timeout = {}) {
-    Submit(*make_sdo_upload_request<T>(exec, idx, subidx,
-                                       ::std::forward<F>(con), block, timeout));
+    Submit(*MakeRequest<detail::SdoUploadRequestWrapper<T>>(
+        exec, idx, subidx, ::std::forward<F>(con), block, timeout));
   }
 
   /// Cancels an SDO upload request. @see Cancel()
@@ -980,6 +1124,33 @@ class Sdo {
   ::std::size_t AbortAll();
 
  private:
+  /**
+   * Creates an SDO request wrapper in a memory block from the request pool of
+   * this queue. Once the request completes, the block is returned to the pool
+   * instead of being freed, so in the steady state submitting a request does
+   * not allocate.
+   */
+  template <class R, class... Args>
+  R*
+  MakeRequest(Args&&... args) {
+    detail::SdoRequestPool* pool = nullptr;
+    void* ptr = AllocateRequest(sizeof(R), pool);
+    R* req = nullptr;
+    try {
+      req = new (ptr) R(::std::forward<Args>(args)...);
+    } catch (...) {
+      DeallocateRequest(pool, ptr, sizeof(R));
+      throw;
+    }
+    static_cast<detail::SdoRequestBase*>(req)->pool_ = pool;
+    return req;
+  }
+
+  void* AllocateRequest(::std::size_t size, detail::SdoRequestPool*& pool);
+
+  static void DeallocateRequest(detail::SdoRequestPool* pool, void* ptr,
+                                ::std::size_t size) noexcept;
+
   struct Impl_;
   ::std::unique_ptr<Impl_> impl_;
 };
@@ -28,6 +28,7 @@
 #define LELY_EV_FUTURE_H_
 
 #include <lely/ev/ev.h>
+#include <lely/util/memory.h>
 
 #include <stdarg.h>
 #include <stddef.h>
@@ -58,6 +59,10 @@ typedef void ev_promise_dtor_t(void *ptr);
  * Constructs a new promise with an optional empty shared state. The promise is
  * destroyed once the last reference to it is released.
  *
+ * The memory of a destroyed promise is kept in a small, bounded cache local to
+ * the thread releasing the last reference, from which subsequent promises of a
+ * similar size are allocated before falling back to the heap.
+ *
  * @param size the size (in bytes) of the shared state (can be 0).
  * @param dtor a pointer to the function used to destroy the shared state (can
  *             be NULL).
@@ -69,6 +74,20 @@ typedef void ev_promise_dtor_t(void *ptr);
  */
 ev_promise_t *ev_promise_create(size_t size, ev_promise_dtor_t *dtor);
 
+/**
+ * Equivalent to ev_promise_create(), except that the promise is allocated with
+ * the specified allocator instead of from the thread-local promise cache.
+ *
+ * @param alloc a pointer to the memory allocator used to allocate (and free)
+ *              the promise. If <b>alloc</b> is NULL, this function is
+ *              equivalent to ev_promise_create().
+ * @param size  the size (in bytes) of the shared state (can be 0).
+ * @param dtor  a pointer to the function used to destroy the shared state (can
+ *              be NULL).
+ */
+ev_promise_t *ev_promise_create_with_alloc(
+		alloc_t *alloc, size_t size, ev_promise_dtor_t *dtor);
+
 /**
  * Acquires a reference to a promise. If <b>promise</b> is NULL, this function
  * has no effect.
@@ -103,6 +103,43 @@ ev_poll_t *ev_loop_get_poll(const ev_loop_t *loop);
 /// Returns a pointer to the executor corresponding to the event loop.
 ev_exec_t *ev_loop_get_exec(const ev_loop_t *loop);
 
+/**
+ * Returns the number of work-stealing queues of an event loop.
+ *
+ * @see ev_loop_set_work_stealing()
+ */
+size_t ev_loop_get_work_stealing(const ev_loop_t *loop);
+
+/**
+ * Enables (or disables) work stealing for an event loop. Each of the first
+ * <b>nthrd</b> threads calling ev_loop_wait() or ev_loop_wait_until() (or any
+ * of the run functions based on them) obtains its own bounded task queue for
+ * the duration of the call. Tasks submitted to the executor of the loop (see
+ * ev_loop_get_exec()) by such a thread are added to its own queue without
+ * locking the loop. A thread executes the tasks on its own queue without
+ * locking the loop, except when it periodically checks the shared queue. Once
+ * its own queue and the shared queue are empty, a thread steals tasks from the
+ * queues of the other threads before polling or waiting. Tasks submitted by
+ * other threads, and tasks that do not fit in the queue, are added to the
+ * shared queue.
+ *
+ * Since tasks may be executed by any thread, their execution order is only
+ * guaranteed to be the same as the order of submission if the loop is run by
+ * a single thread. Strands can be used to serialize tasks.
+ *
+ * This function MUST NOT be invoked while any thread is running the event
+ * loop.
+ *
+ * @param loop  a pointer to an event loop.
+ * @param nthrd the number of threads for which to allocate a work-stealing
+ *              queue. If <b>nthrd</b> is 0, work stealing is disabled.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error code can
+ * be obtained with get_errc(). If the platform does not support lock-free
+ * atomic operations, the error number is #ERRNUM_NOSYS.
+ */
+int ev_loop_set_work_stealing(ev_loop_t *loop, size_t nthrd);
+
 /**
  * Stops the event loop. Ongoing calls to ev_loop_run(), ev_loop_run_until(),
  * ev_loop_run_one() and ev_loop_run_one_until() will terminate and future calls
@@ -81,6 +81,19 @@ class Loop {
     return Executor(ev_loop_get_exec(*this));
   }
 
+  /// @see ev_loop_get_work_stealing()
+  ::std::size_t
+  get_work_stealing() const noexcept {
+    return ev_loop_get_work_stealing(*this);
+  }
+
+  /// @see ev_loop_set_work_stealing()
+  void
+  set_work_stealing(::std::size_t nthrd) {
+    if (ev_loop_set_work_stealing(*this, nthrd) == -1)
+      util::throw_errc("set_work_stealing");
+  }
+
   /// @see ev_loop_stop()
   void
   stop() noexcept {
@@ -52,6 +52,9 @@ enum io_can_bus_flag {
 #endif
 };
 
+// Avoid including <lely/can/net.h>.
+struct can_net_filter;
+
 /// An abstract CAN controller.
 typedef const struct io_can_ctrl_vtbl *const io_can_ctrl_t;
 
@@ -109,11 +112,16 @@ struct io_can_chan_read {
 /// A CAN channel write operation.
 struct io_can_chan_write {
 	/**
-	 * A pointer to the CAN frame to be written. It is the responsibility of
-	 * the user to ensure the buffer remains valid until the write operation
-	 * completes.
+	 * A pointer to the first of #n consecutive CAN frames to be written. It
+	 * is the responsibility of the user to ensure the buffer remains valid
+	 * until the write operation completes.
 	 */
 	const struct can_msg *msg;
+	/**
+	 * The number of CAN frames to be written (at least 1). The frames are
+	 * written in order, with as few system calls as the channel supports.
+	 */
+	size_t n;
 	/**
 	 * The task (to be) submitted upon completion (or cancellation) of the
 	 * write operation.
@@ -124,12 +132,25 @@ struct io_can_chan_write {
 	 * or the operation was canceled.
 	 */
 	int errc;
+	/**
+	 * The number of CAN frames that have been written (and confirmed, if
+	 * the channel supports write confirmations). On success, this is equal
+	 * to #n.
+	 */
+	size_t nwritten;
 };
 
 /// The static initializer for #io_can_chan_write.
 #define IO_CAN_CHAN_WRITE_INIT(msg, exec, func) \
+	IO_CAN_CHAN_WRITEV_INIT(msg, 1, exec, func)
+
+/**
+ * The static initializer for an #io_can_chan_write operation writing <b>n</b>
+ * consecutive CAN frames.
+ */
+#define IO_CAN_CHAN_WRITEV_INIT(msg, n, exec, func) \
 	{ \
-		(msg), EV_TASK_INIT(exec, func), 0 \
+		(msg), (n), EV_TASK_INIT(exec, func), 0, 0 \
 	}
 
 #ifdef __cplusplus
@@ -156,6 +177,8 @@ struct io_can_chan_vtbl {
 			int timeout);
 	void (*submit_write)(
 			io_can_chan_t *chan, struct io_can_chan_write *write);
+	int (*set_filters)(io_can_chan_t *chan,
+			const struct can_net_filter *filters, size_t n);
 };
 
 /**
@@ -346,7 +369,9 @@ LELY_IO_CAN_INLINE int io_can_chan_write(
 
 /**
  * Submits a write operation to a CAN channel. The completion task is submitted
- * for execution once the CAN frame is written or a write error occurs.
+ * for execution once all CAN frames are written or a write error occurs. In the
+ * latter case, the number of frames that were written before the error is
+ * stored in the <b>nwritten</b> member of the operation.
  */
 LELY_IO_CAN_INLINE void io_can_chan_submit_write(
 		io_can_chan_t *chan, struct io_can_chan_write *write);
@@ -393,6 +418,24 @@ static inline size_t io_can_chan_abort_write(
 ev_future_t *io_can_chan_async_write(io_can_chan_t *chan, ev_exec_t *exec,
 		const struct can_msg *msg, struct io_can_chan_write **pwrite);
 
+/**
+ * Sets the CAN frame filters of a CAN channel. Filters are a hint: the channel
+ * SHOULD NOT deliver frames that do not match any of the filters, but it MAY
+ * do so if the filters are not supported, or only partially. Error frames are
+ * not affected by the filters.
+ *
+ * @param chan    a pointer to a CAN channel.
+ * @param filters a pointer to an array of filters (can be NULL if <b>n</b> is
+ *                0).
+ * @param n       the number of filters at <b>filters</b>. If <b>n</b> is 0,
+ *                all frames are accepted.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ */
+LELY_IO_CAN_INLINE int io_can_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n);
+
 /**
  * Obtains a pointer to a CAN channel read operation from a pointer to its
  * completion task.
@@ -526,6 +569,13 @@ io_can_chan_abort_write(io_can_chan_t *chan, struct io_can_chan_write *write)
 	return io_can_chan_abort(chan, &write->task);
 }
 
+inline int
+io_can_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n)
+{
+	return (*chan)->set_filters(chan, filters, n);
+}
+
 #ifdef __cplusplus
 }
 #endif
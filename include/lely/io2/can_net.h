@@ -292,6 +292,41 @@ void io_can_net_get_on_can_error_func(const io_can_net_t *net,
 void io_can_net_set_on_can_error_func(io_can_net_t *net,
 		io_can_net_on_can_error_func_t *func, void *arg);
 
+/**
+ * Returns the maximum number of CAN frame filters set on the CAN channel of a
+ * CAN network interface, or 0 if frame filtering by the channel is disabled.
+ *
+ * @see io_can_net_set_max_filters()
+ */
+size_t io_can_net_get_max_filters(const io_can_net_t *net);
+
+/**
+ * Enables or disables the filtering of CAN frames by the CAN channel of a CAN
+ * network interface. If enabled, the filters are computed from the receivers
+ * registered with the internal interface (see can_net_get_filters()) and the
+ * frames sent by the network interface, which are needed for the write
+ * confirmations. If necessary, filters are merged with
+ * can_net_compact_filters(), so that at most <b>max</b> filters are set.
+ *
+ * The filters are updated whenever a receiver is started or stopped, once the
+ * mutex protecting the CAN network interface is unlocked. If the filters
+ * cannot be set, all frames are accepted. With SocketCAN, this allows the
+ * kernel to drop frames for which no receiver exists, instead of waking up the
+ * process.
+ *
+ * This function locks the mutex protecting the CAN network interface.
+ *
+ * @param net a pointer to a CAN network interface.
+ * @param max the maximum number of filters. If <b>max</b> is 0, filtering is
+ *            disabled and all frames are accepted (the default).
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc().
+ *
+ * @see io_can_net_get_max_filters(), io_can_chan_set_filters()
+ */
+int io_can_net_set_max_filters(io_can_net_t *net, size_t max);
+
 /**
  * Locks the mutex protecting the CAN network interface.
  *
@@ -99,6 +99,32 @@ class CanNet : protected util::BasicLockable {
     return Clock(io_can_net_get_clock(*this));
   }
 
+  /// @see io_can_net_get_max_filters()
+  ::std::size_t
+  get_max_filters() const noexcept {
+    return io_can_net_get_max_filters(*this);
+  }
+
+  /// @see io_can_net_set_max_filters()
+  void
+  set_max_filters(::std::size_t max, ::std::error_code& ec) noexcept {
+    int errsv = get_errc();
+    set_errc(0);
+    if (!io_can_net_set_max_filters(*this, max))
+      ec.clear();
+    else
+      ec = util::make_error_code();
+    set_errc(errsv);
+  }
+
+  /// @see io_can_net_set_max_filters()
+  void
+  set_max_filters(::std::size_t max) {
+    ::std::error_code ec;
+    set_max_filters(max, ec);
+    if (ec) throw ::std::system_error(ec, "set_max_filters");
+  }
+
  protected:
   void
   lock() final {
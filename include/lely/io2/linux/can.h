@@ -158,8 +158,10 @@ int io_can_chan_open(io_can_chan_t *chan, const io_can_ctrl_t *ctrl, int flags);
  * Assigns an existing SocketCAN file descriptor to a CAN channel. Before being
  * assigned, the file descriptor will be modified in the following way:
  * - reception of CAN frames sent by the socket is enabled with the
- *   `CAN_RAW_LOOPBACK` and `CAN_RAW_RECV_OWN_MSGS` socket options, and
- * - the size of the kernel send buffer is set to its minimum value.
+ *   `CAN_RAW_LOOPBACK` and `CAN_RAW_RECV_OWN_MSGS` socket options,
+ * - the size of the kernel send buffer is set to its minimum value, and
+ * - the reception of timestamps and of the number of dropped frames is
+ *   enabled with the `SO_TIMESTAMP` and `SO_RXQ_OVFL` socket options.
  *
  * If the channel was already open, it is first closed as if by
  * io_can_chan_close().
@@ -201,6 +203,36 @@ int io_can_chan_is_open(const io_can_chan_t *chan);
  */
 int io_can_chan_close(io_can_chan_t *chan);
 
+/**
+ * Returns the maximum number of CAN frames read from the SocketCAN file
+ * descriptor with a single system call when filling the receive queue of a CAN
+ * channel.
+ *
+ * @see io_can_chan_set_rxbatch()
+ */
+size_t io_can_chan_get_rxbatch(const io_can_chan_t *chan);
+
+/**
+ * Sets the maximum number of CAN frames read from the SocketCAN file descriptor
+ * with a single system call (`recvmmsg()`) when filling the receive queue of a
+ * CAN channel. Larger batches reduce the number of system calls at high bus
+ * loads. The frames are stored directly in the receive queue, together with
+ * their timestamps. Frames dropped by the kernel are reported as a warning with
+ * diag().
+ *
+ * @param chan    a pointer to a CAN channel.
+ * @param rxbatch the maximum number of frames per system call. If
+ *                <b>rxbatch</b> is 0, the default value #LELY_IO_CAN_RXBATCH
+ *                is used. A value of 1 disables batching.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained with get_errc(). It is an error to specify a value larger
+ * than #LELY_IO_CAN_RXBATCH.
+ *
+ * @see io_can_chan_get_rxbatch()
+ */
+int io_can_chan_set_rxbatch(io_can_chan_t *chan, size_t rxbatch);
+
 #ifdef __cplusplus
 }
 #endif
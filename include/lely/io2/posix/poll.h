@@ -59,12 +59,14 @@ struct io_poll_watch {
 	int _fd;
 	struct rbnode _node;
 	int _events;
+	int _mask;
+	int _revents;
 };
 
 /// The static initializer for #io_poll_watch.
 #define IO_POLL_WATCH_INIT(func) \
 	{ \
-		(func), -1, RBNODE_INIT, 0 \
+		(func), -1, RBNODE_INIT, 0, 0, 0 \
 	}
 
 void *io_poll_alloc(void);
@@ -124,6 +126,39 @@ ev_poll_t *io_poll_get_poll(const io_poll_t *poll);
 int io_poll_watch(io_poll_t *poll, int fd, int events,
 		struct io_poll_watch *watch);
 
+/**
+ * Returns 1 if an I/O polling instance keeps file descriptors registered
+ * persistently in edge-triggered mode, and 0 if they are registered for a
+ * single event at a time (the default).
+ *
+ * @see io_poll_set_edge()
+ */
+int io_poll_get_edge(const io_poll_t *poll);
+
+/**
+ * Enables or disables edge-triggered mode for an I/O polling instance. This
+ * mode is only supported on Linux.
+ *
+ * By default, a file descriptor is registered with the kernel for a single
+ * event, and every call to io_poll_watch() after an event has been reported
+ * requires a system call to rearm it. In edge-triggered mode, the file
+ * descriptor remains registered until it is unregistered with io_poll_watch(),
+ * and the I/O events are tracked in user space. Rearming a file descriptor then
+ * only requires a system call if the set of monitored events grows, or if an
+ * event occurred while the file descriptor was not being monitored. The
+ * reporting semantics of io_poll_watch() are the same in both modes.
+ *
+ * @param poll a pointer to an I/O polling instance.
+ * @param edge a flag specifying whether to enable (if non-zero) or disable (if
+ *             0) edge-triggered mode.
+ *
+ * @returns 0 on success, or -1 on error. In the latter case, the error number
+ * can be obtained from `errno`. The mode cannot be changed while any file
+ * descriptors are registered (`EBUSY`). If edge-triggered mode is not
+ * supported, enabling it fails with `ENOTSUP`.
+ */
+int io_poll_set_edge(io_poll_t *poll, int edge);
+
 #ifdef __cplusplus
 }
 #endif
@@ -97,6 +97,32 @@ class Poll {
     if (ec) throw ::std::system_error(ec, "watch");
   }
 
+  /// @see io_poll_get_edge()
+  bool
+  get_edge() const noexcept {
+    return io_poll_get_edge(*this) != 0;
+  }
+
+  /// @see io_poll_set_edge()
+  void
+  set_edge(bool edge, ::std::error_code& ec) noexcept {
+    int errsv = errno;
+    errno = 0;
+    if (!io_poll_set_edge(*this, edge))
+      ec.clear();
+    else
+      ec = util::make_error_code();
+    errno = errsv;
+  }
+
+  /// @see io_poll_set_edge()
+  void
+  set_edge(bool edge) {
+    ::std::error_code ec;
+    set_edge(edge, ec);
+    if (ec) throw ::std::system_error(ec, "set_edge");
+  }
+
  protected:
   io_poll_t* poll_{nullptr};
 };
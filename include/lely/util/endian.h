@@ -330,6 +330,104 @@ void bcpybe(uint_least8_t *dst, int dstbit, const uint_least8_t *src,
 void bcpyle(uint_least8_t *dst, int dstbit, const uint_least8_t *src,
 		int srcbit, size_t n);
 
+/**
+ * Loads <b>n</b> bytes into an array of `(n + 7) / 8` 64-bit words in
+ * big-endian byte order, such that bit 0 of the buffer (in the sense of
+ * bcpybe()) is the most significant bit of the first word. The unused bits of
+ * the last word are set to 0. The resulting words can be accessed with
+ * bgetbe() and bsetbe().
+ *
+ * @see stbe_u64v()
+ */
+void ldbe_u64v(uint_least64_t *dst, const uint_least8_t *src, size_t n);
+
+/**
+ * Stores the first <b>n</b> bytes of an array of 64-bit words in big-endian
+ * byte order.
+ *
+ * @see ldbe_u64v()
+ */
+void stbe_u64v(uint_least8_t *dst, const uint_least64_t *src, size_t n);
+
+/**
+ * Loads <b>n</b> bytes into an array of `(n + 7) / 8` 64-bit words in
+ * little-endian byte order, such that bit 0 of the buffer (in the sense of
+ * bcpyle()) is the least significant bit of the first word. The unused bits of
+ * the last word are set to 0. The resulting words can be accessed with
+ * bgetle() and bsetle().
+ *
+ * @see stle_u64v()
+ */
+void ldle_u64v(uint_least64_t *dst, const uint_least8_t *src, size_t n);
+
+/**
+ * Stores the first <b>n</b> bytes of an array of 64-bit words in little-endian
+ * byte order.
+ *
+ * @see ldle_u64v()
+ */
+void stle_u64v(uint_least8_t *dst, const uint_least64_t *src, size_t n);
+
+/**
+ * Extracts a bit field from an array of 64-bit words loaded with ldbe_u64v().
+ * This function assumes a big-endian bit ordering (i.e., bit 0 is the most
+ * significant bit of the first word).
+ *
+ * @param src a pointer to the words.
+ * @param bit the offset (in bits) of the field with respect to <b>src</b>.
+ * @param n   the number of bits in the field (in the range [0..64]).
+ *
+ * @returns the field, with the last bit as the least significant bit.
+ */
+LELY_UTIL_ENDIAN_INLINE uint_least64_t bgetbe(
+		const uint_least64_t *src, size_t bit, size_t n);
+
+/**
+ * Inserts a bit field into an array of 64-bit words. The other bits are not
+ * modified. This function assumes a big-endian bit ordering (i.e., bit 0 is
+ * the most significant bit of the first word).
+ *
+ * @param dst a pointer to the words.
+ * @param bit the offset (in bits) of the field with respect to <b>dst</b>.
+ * @param x   the value of the field. Only the <b>n</b> least significant bits
+ *            are used.
+ * @param n   the number of bits in the field (in the range [0..64]).
+ *
+ * @see stbe_u64v()
+ */
+LELY_UTIL_ENDIAN_INLINE void bsetbe(
+		uint_least64_t *dst, size_t bit, uint_least64_t x, size_t n);
+
+/**
+ * Extracts a bit field from an array of 64-bit words loaded with ldle_u64v().
+ * This function assumes a little-endian bit ordering (i.e., bit 0 is the least
+ * significant bit of the first word).
+ *
+ * @param src a pointer to the words.
+ * @param bit the offset (in bits) of the field with respect to <b>src</b>.
+ * @param n   the number of bits in the field (in the range [0..64]).
+ *
+ * @returns the field, with the first bit as the least significant bit.
+ */
+LELY_UTIL_ENDIAN_INLINE uint_least64_t bgetle(
+		const uint_least64_t *src, size_t bit, size_t n);
+
+/**
+ * Inserts a bit field into an array of 64-bit words. The other bits are not
+ * modified. This function assumes a little-endian bit ordering (i.e., bit 0 is
+ * the least significant bit of the first word).
+ *
+ * @param dst a pointer to the words.
+ * @param bit the offset (in bits) of the field with respect to <b>dst</b>.
+ * @param x   the value of the field. Only the <b>n</b> least significant bits
+ *            are used.
+ * @param n   the number of bits in the field (in the range [0..64]).
+ *
+ * @see stle_u64v()
+ */
+LELY_UTIL_ENDIAN_INLINE void bsetle(
+		uint_least64_t *dst, size_t bit, uint_least64_t x, size_t n);
+
 #ifndef htobe16
 LELY_UTIL_ENDIAN_INLINE uint_least16_t
 htobe16(uint_least16_t x)
@@ -851,6 +949,78 @@ ldle_flt64(const uint_least8_t src[8])
 
 #endif // LELY_FLT64_TYPE
 
+LELY_UTIL_ENDIAN_INLINE uint_least64_t
+bgetbe(const uint_least64_t *src, size_t bit, size_t n)
+{
+	if (!n)
+		return 0;
+
+	src += bit / 64;
+	unsigned int shift = bit % 64;
+
+	uint_least64_t x = *src << shift;
+	if (shift + n > 64)
+		x |= src[1] >> (64 - shift);
+	return (x & UINT64_C(0xffffffffffffffff)) >> (64 - n);
+}
+
+LELY_UTIL_ENDIAN_INLINE void
+bsetbe(uint_least64_t *dst, size_t bit, uint_least64_t x, size_t n)
+{
+	if (!n)
+		return;
+
+	dst += bit / 64;
+	unsigned int shift = bit % 64;
+
+	uint_least64_t mask = UINT64_C(0xffffffffffffffff) >> (64 - n);
+	x &= mask;
+	if (shift + n <= 64) {
+		unsigned int left = 64 - shift - n;
+		*dst = (*dst & ~(mask << left)) | (x << left);
+	} else {
+		// The field straddles two words.
+		unsigned int right = shift + n - 64;
+		*dst = (*dst & ~(mask >> right)) | (x >> right);
+		dst[1] = (dst[1] & ~(mask << (64 - right)))
+				| (x << (64 - right));
+	}
+}
+
+LELY_UTIL_ENDIAN_INLINE uint_least64_t
+bgetle(const uint_least64_t *src, size_t bit, size_t n)
+{
+	if (!n)
+		return 0;
+
+	src += bit / 64;
+	unsigned int shift = bit % 64;
+
+	uint_least64_t x = *src >> shift;
+	if (shift + n > 64)
+		x |= src[1] << (64 - shift);
+	return x & (UINT64_C(0xffffffffffffffff) >> (64 - n));
+}
+
+LELY_UTIL_ENDIAN_INLINE void
+bsetle(uint_least64_t *dst, size_t bit, uint_least64_t x, size_t n)
+{
+	if (!n)
+		return;
+
+	dst += bit / 64;
+	unsigned int shift = bit % 64;
+
+	uint_least64_t mask = UINT64_C(0xffffffffffffffff) >> (64 - n);
+	x &= mask;
+	*dst = (*dst & ~(mask << shift)) | (x << shift);
+	// Store the remaining bits if the field straddles two words.
+	if (shift + n > 64) {
+		unsigned int right = 64 - shift;
+		dst[1] = (dst[1] & ~(mask >> right)) | (x >> right);
+	}
+}
+
 #ifdef __cplusplus
 }
 #endif
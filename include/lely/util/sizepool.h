@@ -0,0 +1,158 @@
+/**@file
+ * This header file is part of the utilities library; it contains the size-class
+ * memory pool allocator declarations.
+ *
+ * A size-class memory pool divides a caller-supplied memory region into a fixed
+ * number of blocks for each of a set of size classes. Each allocation is served
+ * from a free list of the smallest class that fits the requested size and still
+ * has a block available. Allocating and freeing a block is O(1) in the number
+ * of blocks and does not require any per-block header. Unlike #mempool, memory
+ * that is freed can be reused, which makes this allocator suitable for objects
+ * that are created and destroyed continuously.
+ *
+ * The pool keeps track of the current and the maximum number of blocks in use
+ * for each class, as well as the number of failed allocations. These statistics
+ * can be used to determine the size of each class offline.
+ *
+ * This allocator is not thread-safe.
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LELY_UTIL_SIZEPOOL_H_
+#define LELY_UTIL_SIZEPOOL_H_
+
+#include <lely/util/memory.h>
+
+/**
+ * A size class of a #sizepool. The #size and #num members are specified by the
+ * user; the other members are initialized by sizepool_init() and MUST NOT be
+ * modified while the class is in use.
+ */
+struct sizepool_class {
+	/**
+	 * The size (in bytes) of each block in this class. The size is rounded
+	 * up to a multiple of the fundamental alignment by sizepool_init().
+	 */
+	size_t size;
+	/// The number of blocks in this class.
+	size_t num;
+	/// A pointer to the first block of this class.
+	char *beg;
+	/// A pointer one past the last block of this class.
+	char *end;
+	/// A pointer to the first block that has never been allocated.
+	char *cur;
+	/// A pointer to the first block in the free list.
+	void *free;
+	/// The number of blocks currently in use.
+	size_t used;
+	/// The maximum number of blocks in use since the pool was initialized.
+	size_t max_used;
+	/**
+	 * The number of allocations which fit this class, but could not be
+	 * served by it because all its blocks were in use.
+	 */
+	size_t nfail;
+};
+
+/**
+ * The static initializer for #sizepool_class.
+ *
+ * @param size the size (in bytes) of each block.
+ * @param num  the number of blocks.
+ */
+#define SIZEPOOL_CLASS_INIT(size, num) \
+	{ \
+		(size), (num), NULL, NULL, NULL, NULL, 0, 0, 0 \
+	}
+
+/// A size-class memory pool.
+struct sizepool {
+	/// Pointer to 'virtual table' of the allocator. Must be first field.
+	const struct alloc_vtbl *vtbl;
+	/// A pointer to the size classes, sorted by block size.
+	struct sizepool_class *classes;
+	/// The number of size classes.
+	size_t nclasses;
+	/// The total number of bytes in the blocks of all classes.
+	size_t total;
+	/// The number of bytes in the blocks currently in use.
+	size_t used;
+	/// The maximum number of bytes in use since the pool was initialized.
+	size_t max_used;
+	/**
+	 * The number of allocations which could not be served by any class,
+	 * either because the requested size exceeds the largest class, or
+	 * because all blocks of the fitting classes were in use.
+	 */
+	size_t nfail;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Returns the number of bytes required by a size-class memory pool for the
+ * blocks of the specified size classes. Use this function to determine the
+ * size of the memory region passed to sizepool_init().
+ *
+ * @param classes  a pointer to an array of <b>nclasses</b> size classes, of
+ *                 which only the <b>size</b> and <b>num</b> members are used.
+ * @param nclasses the number of size classes.
+ */
+size_t sizepool_sizeof(const struct sizepool_class *classes, size_t nclasses);
+
+/**
+ * Initializes a size-class memory pool allocator. The memory region is divided
+ * into consecutive blocks for each class, in the order in which they are
+ * specified.
+ *
+ * @param pool     a pointer to the memory pool.
+ * @param memory   a pointer to the memory region to be used by the pool. The
+ *                 region MUST be suitably aligned for any object type.
+ * @param size     the number of bytes available at <b>memory</b>. This MUST be
+ *                 at least the value returned by sizepool_sizeof() for the
+ *                 specified classes.
+ * @param classes  a pointer to an array of <b>nclasses</b> size classes, with
+ *                 the <b>size</b> and <b>num</b> members set, sorted by
+ *                 increasing block size. The array is used by the pool to track
+ *                 the usage of each class and MUST remain valid as long as the
+ *                 pool is in use.
+ * @param nclasses the number of size classes.
+ *
+ * @returns a pointer to the allocator interface, or NULL on error. In the
+ * latter case, the error number can be obtained with get_errc().
+ *
+ * @see mem_alloc()
+ * @see mem_free()
+ * @see mem_size()
+ * @see mem_capacity()
+ */
+alloc_t *sizepool_init(struct sizepool *pool, void *memory, size_t size,
+		struct sizepool_class *classes, size_t nclasses);
+
+/**
+ * Resets the high-water marks (<b>max_used</b>) and the number of failed
+ * allocations (<b>nfail</b>) of a size-class memory pool and all its classes.
+ */
+void sizepool_reset_stats(struct sizepool *pool);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !LELY_UTIL_SIZEPOOL_H_
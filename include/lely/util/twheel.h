@@ -0,0 +1,208 @@
+/**@file
+ * This header file is part of the utilities library; it contains the
+ * hierarchical timing wheel declarations.
+ *
+ * A hierarchical timing wheel stores nodes keyed by an unsigned 64-bit
+ * expiration time, expressed in ticks. Each level of the wheel consists of
+ * #TWHEEL_SIZE slots, each containing an unsorted list of nodes. A node is
+ * stored at the lowest level in which its key and the current time of the wheel
+ * differ, in the slot corresponding to the bits of the key at that level.
+ * Inserting and removing a node is O(1). When the time is advanced, the nodes
+ * in the slots that have been passed are either reported as expired or moved to
+ * a lower level. Each node is moved at most once per level, making expiry O(1)
+ * amortized, regardless of the size of the time step.
+ *
+ * Compared to a pairing heap, a timing wheel does not keep the nodes sorted.
+ * Nodes that expire during the same call to twheel_advance() are reported in
+ * unspecified order.
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LELY_UTIL_TWHEEL_H_
+#define LELY_UTIL_TWHEEL_H_
+
+#include <lely/util/dllist.h>
+
+#include <stdint.h>
+
+#ifndef LELY_UTIL_TWHEEL_INLINE
+#define LELY_UTIL_TWHEEL_INLINE static inline
+#endif
+
+/// The number of bits of a key resolved by each level of a timing wheel.
+#define TWHEEL_BITS 6
+
+/// The number of slots in each level of a timing wheel.
+#define TWHEEL_SIZE (1 << TWHEEL_BITS)
+
+/// The number of levels of a timing wheel, enough to store any 64-bit key.
+#define TWHEEL_LEVELS ((64 + TWHEEL_BITS - 1) / TWHEEL_BITS)
+
+/**
+ * A node in a timing wheel. To associate a value with a node, embed the node in
+ * a struct containing the value and use structof() to obtain the struct from
+ * the node.
+ *
+ * @see twheel
+ */
+struct twnode {
+	/**
+	 * The expiration time (in ticks) of this node. The key MUST be set
+	 * before the node is inserted into a wheel and MUST NOT be modified
+	 * while the node is part of the wheel.
+	 */
+	uint_least64_t key;
+	/// The node in the list of the slot containing this node.
+	struct dlnode list;
+};
+
+/// The static initializer for #twnode.
+#define TWNODE_INIT \
+	{ \
+		0, DLNODE_INIT \
+	}
+
+/// A hierarchical timing wheel.
+struct twheel {
+	/// The current time (in ticks).
+	uint_least64_t now;
+	/// The bit masks indicating which slots of each level are non-empty.
+	uint_least64_t mask[TWHEEL_LEVELS];
+	/// The slots of each level.
+	struct dllist slots[TWHEEL_LEVELS][TWHEEL_SIZE];
+	/// The list of nodes that have expired but have not yet been reported.
+	struct dllist expired;
+	/// The number of nodes stored in the wheel.
+	size_t num_nodes;
+};
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initializes a node in a timing wheel.
+ *
+ * @param node a pointer to the node to be initialized.
+ * @param key  the expiration time (in ticks) of the node.
+ */
+LELY_UTIL_TWHEEL_INLINE void twnode_init(
+		struct twnode *node, uint_least64_t key);
+
+/**
+ * Initializes a timing wheel.
+ *
+ * @param wheel a pointer to the wheel to be initialized.
+ * @param now   the current time (in ticks).
+ */
+void twheel_init(struct twheel *wheel, uint_least64_t now);
+
+/// Returns the current time (in ticks) of a timing wheel.
+LELY_UTIL_TWHEEL_INLINE uint_least64_t twheel_now(const struct twheel *wheel);
+
+/// Returns 1 if the timing wheel is empty, and 0 if not.
+LELY_UTIL_TWHEEL_INLINE int twheel_empty(const struct twheel *wheel);
+
+/// Returns the size (in number of nodes) of a timing wheel.
+LELY_UTIL_TWHEEL_INLINE size_t twheel_size(const struct twheel *wheel);
+
+/**
+ * Inserts a node into a timing wheel. If the key of the node is not later than
+ * the current time of the wheel, the node is reported as expired by the next
+ * call to twheel_advance().
+ *
+ * @see twheel_remove()
+ */
+void twheel_insert(struct twheel *wheel, struct twnode *node);
+
+/**
+ * Removes a node from a timing wheel.
+ *
+ * @see twheel_insert()
+ */
+void twheel_remove(struct twheel *wheel, struct twnode *node);
+
+/**
+ * Sets the current time of a timing wheel and removes all expired nodes, i.e.,
+ * the nodes whose key is not later than the new time.
+ *
+ * If the time is moved backwards, all nodes are redistributed over the wheel.
+ * This is an O(n) operation.
+ *
+ * @param wheel   a pointer to a timing wheel.
+ * @param now     the new time (in ticks).
+ * @param expired a pointer to the list to which the expired nodes are appended
+ *                (in unspecified order).
+ */
+void twheel_advance(struct twheel *wheel, uint_least64_t now,
+		struct dllist *expired);
+
+/**
+ * Returns the time (in ticks) at which the next node in a timing wheel expires
+ * or has to be moved to a lower level, or UINT64_MAX if the wheel is empty.
+ * This is the earliest time at which twheel_advance() has any effect. If the
+ * wheel contains expired nodes, this is the current time. Otherwise, if the
+ * node with the smallest key is at the lowest level, the time is equal to its
+ * key, and if not, it is a lower bound.
+ */
+uint_least64_t twheel_next(const struct twheel *wheel);
+
+/**
+ * Returns a pointer to the node with the smallest key in a timing wheel, or
+ * NULL if the wheel is empty. If multiple nodes have the same key, it is
+ * unspecified which one is returned. This function searches the (unsorted) list
+ * of the first non-empty slot.
+ *
+ * @see twheel_next()
+ */
+struct twnode *twheel_first(const struct twheel *wheel);
+
+LELY_UTIL_TWHEEL_INLINE void
+twnode_init(struct twnode *node, uint_least64_t key)
+{
+	assert(node);
+
+	node->key = key;
+	dlnode_init(&node->list);
+}
+
+LELY_UTIL_TWHEEL_INLINE uint_least64_t
+twheel_now(const struct twheel *wheel)
+{
+	assert(wheel);
+
+	return wheel->now;
+}
+
+LELY_UTIL_TWHEEL_INLINE int
+twheel_empty(const struct twheel *wheel)
+{
+	return !twheel_size(wheel);
+}
+
+LELY_UTIL_TWHEEL_INLINE size_t
+twheel_size(const struct twheel *wheel)
+{
+	assert(wheel);
+
+	return wheel->num_nodes;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !LELY_UTIL_TWHEEL_H_
@@ -23,21 +23,47 @@
 
 #include "can.h"
 #include <lely/can/net.h>
+#include <lely/util/bits.h>
 #include <lely/util/cmp.h>
 #include <lely/util/dllist.h>
 #include <lely/util/error.h>
 #include <lely/util/pheap.h>
 #include <lely/util/rbtree.h>
 #include <lely/util/time.h>
+#include <lely/util/twheel.h>
 
 #include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * The number of entries in the direct-indexed table of CAN frame receivers. The
+ * table contains one entry for each 11-bit CAN identifier.
+ */
+#define CAN_NET_RECV_TABLE_SIZE (CAN_MASK_BID + 1)
+
+/**
+ * The binary logarithm of the duration (in nanoseconds) of a tick of the timing
+ * wheel of a CAN network interface. A tick is approximately 1 ms.
+ */
+#define CAN_NET_TIMER_TICK_SHIFT 20
 
 /// A CAN network interface.
 struct can_net {
 	/// A pointer to the memory allocator used to allocate this struct.
 	alloc_t *alloc;
-	/// The heap containing all timers.
+	/**
+	 * The heap containing all timers not stored in #timer_wheel. If
+	 * #timer_wheel is not NULL, these are the timers whose tick has been
+	 * reached.
+	 */
 	struct pheap timer_heap;
+	/**
+	 * A pointer to the timing wheel containing the timers that will trigger
+	 * after the current tick, or NULL if all timers are stored in
+	 * #timer_heap.
+	 */
+	struct twheel *timer_wheel;
 	/// The current time.
 	struct timespec time;
 	/// The time at which the next timer triggers.
@@ -46,12 +72,27 @@ struct can_net {
 	can_timer_func_t *next_func;
 	/// A pointer to user-specified data for #next_func.
 	void *next_data;
-	/// The tree containing all receivers.
+	/// The tree containing all receivers not stored in #recv_table.
 	struct rbtree recv_tree;
+	/**
+	 * A pointer to the direct-indexed table containing the receivers of
+	 * data frames with an 11-bit CAN identifier, or NULL if all receivers
+	 * are stored in #recv_tree.
+	 */
+	can_recv_t **recv_table;
+	/**
+	 * The list of receivers started with can_recv_start_mask(), in the
+	 * order in which they were started.
+	 */
+	struct dllist recv_mask;
 	/// A pointer to the callback function invoked by can_net_send().
 	can_send_func_t *send_func;
 	/// A pointer to the user-specified data for #send_func.
 	void *send_data;
+	/// A pointer to the callback function invoked by can_net_set_filter().
+	can_net_filter_func_t *filter_func;
+	/// A pointer to the user-specified data for #filter_func.
+	void *filter_data;
 };
 
 /**
@@ -60,6 +101,46 @@ struct can_net {
  */
 static void can_net_set_next(can_net_t *net);
 
+/**
+ * Invokes the callback function if the set of CAN frames accepted by the
+ * receivers of a CAN network interface has changed.
+ */
+static inline void can_net_set_filter(can_net_t *net);
+
+/// Returns the tick of the timing wheel of a CAN network interface of a time.
+static inline uint_least64_t can_net_tick(const struct timespec *tp);
+
+/**
+ * Inserts a CAN timer into the heap or, if its tick has not yet been reached,
+ * the timing wheel of a CAN network interface.
+ */
+static void can_net_insert_timer(can_net_t *net, can_timer_t *timer);
+
+/**
+ * Removes a CAN timer from the heap or timing wheel of a CAN network interface.
+ */
+static void can_net_remove_timer(can_net_t *net, can_timer_t *timer);
+
+/**
+ * Moves all timers in the heap of a CAN network interface to a list, using the
+ * #twnode member of each timer.
+ */
+static void can_net_take_timers(can_net_t *net, struct dllist *list);
+
+/**
+ * Moves all timers in a list to the heap or timing wheel of a CAN network
+ * interface.
+ *
+ * @see can_net_take_timers(), can_net_insert_timer()
+ */
+static void can_net_insert_timers(can_net_t *net, struct dllist *list);
+
+/**
+ * Advances the timing wheel of a CAN network interface to the current time and
+ * moves the timers whose tick has been reached to the heap.
+ */
+static void can_net_advance_timers(can_net_t *net);
+
 /// Allocates the #can_net_t structure using the provided allocator.
 static can_net_t *can_net_alloc(alloc_t *alloc);
 
@@ -77,8 +158,13 @@ static void can_net_fini(can_net_t *net);
 struct can_timer {
 	/// A pointer to the memory allocator used to allocate this struct.
 	alloc_t *alloc;
-	/// The node of this timer in the tree of timers.
+	/// The node of this timer in the heap of timers.
 	struct pnode node;
+	/**
+	 * The node of this timer in the timing wheel. The key is the tick of
+	 * #start.
+	 */
+	struct twnode twnode;
 	/**
 	 * A pointer to the network interface with which this timer is
 	 * registered.
@@ -123,7 +209,10 @@ struct can_recv {
 	alloc_t *alloc;
 	/// The node of this receiver in the tree of receivers.
 	struct rbnode node;
-	/// The list of CAN frame receivers with the same key.
+	/**
+	 * The list of CAN frame receivers with the same key or, if #masked is
+	 * set, the node of this receiver in the list of masked receivers.
+	 */
 	struct dlnode list;
 	/**
 	 * A pointer to the network interface with which this receiver is
@@ -132,6 +221,13 @@ struct can_recv {
 	can_net_t *net;
 	/// The key used in #node.
 	can_recv_key_t key;
+	/**
+	 * The bits of the key of a CAN frame that are compared with #key (only
+	 * used if #masked is set).
+	 */
+	can_recv_key_t mask;
+	/// A flag indicating whether the receiver was started with a mask.
+	int masked;
 	/// A pointer to the callback function invoked by can_net_recv().
 	can_recv_func_t *func;
 	/// A pointer to the user-specified data for #func.
@@ -145,6 +241,20 @@ static inline can_recv_key_t can_recv_key(
 /// The function used to compare to CAN receiver keys.
 static int can_recv_key_cmp(const void *p1, const void *p2);
 
+/**
+ * Computes the key and mask of a CAN frame filter, in the same way as for a
+ * masked CAN frame receiver.
+ */
+static inline can_recv_key_t can_net_filter_key(
+		const struct can_net_filter *filter, can_recv_key_t *pmask);
+
+/// Constructs a CAN frame filter from a key and mask.
+static inline struct can_net_filter can_net_filter_from_key(
+		can_recv_key_t key, can_recv_key_t mask);
+
+/// The function used to sort CAN frame filters by key and mask.
+static int can_net_filter_cmp(const void *p1, const void *p2);
+
 /// Allocates the #can_recv_t structure using the provided allocator.
 static can_recv_t *can_recv_alloc(alloc_t *alloc);
 
@@ -158,6 +268,22 @@ static void can_recv_init(can_recv_t *recv);
 /// Finalizes the #can_recv_t structure.
 static void can_recv_fini(can_recv_t *recv);
 
+/// Returns the first CAN frame receiver with the specified key, if any.
+static inline can_recv_t *can_net_find_recv(
+		const can_net_t *net, can_recv_key_t key);
+
+/**
+ * Inserts a CAN frame receiver, which MUST be the first with its key, into the
+ * table or tree of a CAN network interface.
+ */
+static void can_net_insert_recv(can_net_t *net, can_recv_t *recv);
+
+/**
+ * Removes the first CAN frame receiver with a specific key from the table or
+ * tree of a CAN network interface.
+ */
+static void can_net_remove_recv(can_net_t *net, can_recv_t *recv);
+
 size_t
 can_net_alignof(void)
 {
@@ -215,6 +341,8 @@ can_net_set_time(can_net_t *net, const struct timespec *tp)
 	assert(tp);
 
 	net->time = *tp;
+	if (net->timer_wheel)
+		can_net_advance_timers(net);
 
 	int errc = get_errc();
 	int result = 0;
@@ -234,7 +362,7 @@ can_net_set_time(can_net_t *net, const struct timespec *tp)
 		if (timer->interval.tv_sec || timer->interval.tv_nsec) {
 			timespec_add(&timer->start, &timer->interval);
 			timer->net = net;
-			pheap_insert(&net->timer_heap, &timer->node);
+			can_net_insert_timer(net, timer);
 		}
 
 		// Invoke the callback function and check the result.
@@ -252,6 +380,54 @@ can_net_set_time(can_net_t *net, const struct timespec *tp)
 	return result;
 }
 
+enum can_net_timer_queue
+can_net_get_timer_queue(const can_net_t *net)
+{
+	assert(net);
+
+	return net->timer_wheel ? CAN_NET_TIMER_QUEUE_WHEEL
+				: CAN_NET_TIMER_QUEUE_HEAP;
+}
+
+int
+can_net_set_timer_queue(can_net_t *net, enum can_net_timer_queue queue)
+{
+	assert(net);
+
+	struct dllist list;
+	dllist_init(&list);
+
+	switch (queue) {
+	case CAN_NET_TIMER_QUEUE_HEAP:
+		if (!net->timer_wheel)
+			return 0;
+		can_net_take_timers(net, &list);
+		// Since no tick exceeds the maximum, all timers in the wheel
+		// expire.
+		twheel_advance(net->timer_wheel, UINT64_MAX, &list);
+		mem_free(net->alloc, net->timer_wheel);
+		net->timer_wheel = NULL;
+		break;
+	case CAN_NET_TIMER_QUEUE_WHEEL: {
+		if (net->timer_wheel)
+			return 0;
+		struct twheel *wheel = mem_alloc(net->alloc,
+				_Alignof(struct twheel), sizeof(struct twheel));
+		if (!wheel)
+			return -1;
+		twheel_init(wheel, can_net_tick(&net->time));
+		can_net_take_timers(net, &list);
+		net->timer_wheel = wheel;
+		break;
+	}
+	default: set_errnum(ERRNUM_INVAL); return -1;
+	}
+
+	can_net_insert_timers(net, &list);
+
+	return 0;
+}
+
 void
 can_net_get_next_func(
 		const can_net_t *net, can_timer_func_t **pfunc, void **pdata)
@@ -283,10 +459,9 @@ can_net_recv(can_net_t *net, const struct can_msg *msg)
 	int result = 0;
 
 	can_recv_key_t key = can_recv_key(msg->id, msg->flags);
-	struct rbnode *node = rbtree_find(&net->recv_tree, &key);
-	if (node) {
+	can_recv_t *recv = can_net_find_recv(net, key);
+	if (recv) {
 		// Loop over all matching receivers.
-		can_recv_t *recv = structof(node, can_recv_t, node);
 		dlnode_foreach (&recv->list, node) { // LCOV_EXCL_BR_LINE
 			recv = structof(node, can_recv_t, list);
 			// Invoke the callback function and check the result.
@@ -299,6 +474,17 @@ can_net_recv(can_net_t *net, const struct can_msg *msg)
 		}
 	}
 
+	// Loop over all masked receivers.
+	dllist_foreach (&net->recv_mask, node) {
+		recv = structof(node, can_recv_t, list);
+		if ((key & recv->mask) != recv->key)
+			continue;
+		if (recv->func && recv->func(msg, recv->data) && !result) {
+			errc = get_errc();
+			result = -1;
+		}
+	}
+
 	set_errc(errc);
 	return result;
 }
@@ -317,6 +503,60 @@ can_net_send(can_net_t *net, const struct can_msg *msg)
 	return net->send_func(msg, net->send_data);
 }
 
+enum can_net_recv_lookup
+can_net_get_recv_lookup(const can_net_t *net)
+{
+	assert(net);
+
+	return net->recv_table ? CAN_NET_RECV_LOOKUP_TABLE
+			       : CAN_NET_RECV_LOOKUP_TREE;
+}
+
+int
+can_net_set_recv_lookup(can_net_t *net, enum can_net_recv_lookup lookup)
+{
+	assert(net);
+
+	switch (lookup) {
+	case CAN_NET_RECV_LOOKUP_TREE:
+		if (!net->recv_table)
+			return 0;
+		// Move the receivers from the table to the tree.
+		for (size_t i = 0; i < CAN_NET_RECV_TABLE_SIZE; i++) {
+			can_recv_t *recv = net->recv_table[i];
+			if (recv)
+				rbtree_insert(&net->recv_tree, &recv->node);
+		}
+		mem_free(net->alloc, net->recv_table);
+		net->recv_table = NULL;
+		return 0;
+	case CAN_NET_RECV_LOOKUP_TABLE: {
+		if (net->recv_table)
+			return 0;
+		can_recv_t **table = mem_alloc(net->alloc,
+				_Alignof(can_recv_t *),
+				CAN_NET_RECV_TABLE_SIZE * sizeof(can_recv_t *));
+		if (!table)
+			return -1;
+		for (size_t i = 0; i < CAN_NET_RECV_TABLE_SIZE; i++)
+			table[i] = NULL;
+		// Move the receivers from the tree to the table. Since the
+		// tree is sorted by key, these are the first nodes.
+		struct rbnode *node;
+		while ((node = rbtree_first(&net->recv_tree)) != NULL) {
+			can_recv_t *recv = structof(node, can_recv_t, node);
+			if (recv->key >= CAN_NET_RECV_TABLE_SIZE)
+				break;
+			rbtree_remove(&net->recv_tree, node);
+			table[recv->key] = recv;
+		}
+		net->recv_table = table;
+		return 0;
+	}
+	default: set_errnum(ERRNUM_INVAL); return -1;
+	}
+}
+
 void
 can_net_get_send_func(
 		const can_net_t *net, can_send_func_t **pfunc, void **pdata)
@@ -338,6 +578,147 @@ can_net_set_send_func(can_net_t *net, can_send_func_t *func, void *data)
 	net->send_data = data;
 }
 
+void
+can_net_get_filter_func(
+		const can_net_t *net, can_net_filter_func_t **pfunc, void **pdata)
+{
+	assert(net);
+
+	if (pfunc)
+		*pfunc = net->filter_func;
+	if (pdata)
+		*pdata = net->filter_data;
+}
+
+void
+can_net_set_filter_func(can_net_t *net, can_net_filter_func_t *func, void *data)
+{
+	assert(net);
+
+	net->filter_func = func;
+	net->filter_data = data;
+}
+
+size_t
+can_net_get_filters(const can_net_t *net, struct can_net_filter *filters,
+		size_t n)
+{
+	assert(net);
+	assert(filters || !n);
+
+	size_t i = 0;
+
+	// Every receiver in the table and tree represents a unique key.
+	if (net->recv_table) {
+		for (size_t j = 0; j < CAN_NET_RECV_TABLE_SIZE; j++) {
+			can_recv_t *recv = net->recv_table[j];
+			if (recv && i++ < n)
+				filters[i - 1] = can_net_filter_from_key(
+						recv->key, ~(can_recv_key_t)0);
+		}
+	}
+	rbtree_foreach (&net->recv_tree, node) {
+		can_recv_t *recv = structof(node, can_recv_t, node);
+		if (i++ < n)
+			filters[i - 1] = can_net_filter_from_key(
+					recv->key, ~(can_recv_key_t)0);
+	}
+
+	dllist_foreach (&net->recv_mask, node) {
+		can_recv_t *recv = structof(node, can_recv_t, list);
+		if (i++ < n)
+			filters[i - 1] = can_net_filter_from_key(
+					recv->key, recv->mask);
+	}
+
+	return i;
+}
+
+size_t
+can_net_compact_filters(struct can_net_filter *filters, size_t n, size_t max)
+{
+	assert(filters || !n);
+
+	if (n < 2)
+		return n;
+
+	// Perform the lossless merges until nothing changes. Since the filters
+	// are sorted by key, candidates for merging are likely to be adjacent.
+	int changed;
+	do {
+		changed = 0;
+		qsort(filters, n, sizeof(*filters), &can_net_filter_cmp);
+		size_t j = 0;
+		for (size_t i = 1; i < n; i++) {
+			can_recv_key_t mask1;
+			can_recv_key_t key1 =
+					can_net_filter_key(&filters[j], &mask1);
+			can_recv_key_t mask2;
+			can_recv_key_t key2 =
+					can_net_filter_key(&filters[i], &mask2);
+			can_recv_key_t diff = key1 ^ key2;
+			if (mask1 == mask2 && !(diff & (diff - 1))) {
+				// Drop duplicates and merge filters differing
+				// in a single bit.
+				if (diff) {
+					filters[j] = can_net_filter_from_key(
+							key1 & ~diff,
+							mask1 & ~diff);
+					changed = 1;
+				}
+			} else if ((key2 & mask1) == key1
+					&& (mask1 & mask2) == mask1) {
+				// The second filter is contained in the first.
+			} else if ((key1 & mask2) == key2
+					&& (mask1 & mask2) == mask2) {
+				// The first filter is contained in the second.
+				filters[j] = filters[i];
+			} else {
+				filters[++j] = filters[i];
+			}
+		}
+		n = j + 1;
+	} while (changed && n > 1);
+
+	while (max && n > max) {
+		// Find the adjacent pair of filters whose merged mask retains
+		// the most bits.
+		size_t k = 0;
+		int best = -1;
+		for (size_t i = 0; i + 1 < n; i++) {
+			can_recv_key_t mask1;
+			can_recv_key_t key1 =
+					can_net_filter_key(&filters[i], &mask1);
+			can_recv_key_t mask2;
+			can_recv_key_t key2 = can_net_filter_key(
+					&filters[i + 1], &mask2);
+			can_recv_key_t mask = mask1 & mask2 & ~(key1 ^ key2);
+#if LELY_NO_CANFD
+			int bits = popcount32(mask);
+#else
+			int bits = popcount64(mask);
+#endif
+			if (bits > best) {
+				k = i;
+				best = bits;
+			}
+		}
+
+		can_recv_key_t mask1;
+		can_recv_key_t key1 = can_net_filter_key(&filters[k], &mask1);
+		can_recv_key_t mask2;
+		can_recv_key_t key2 =
+				can_net_filter_key(&filters[k + 1], &mask2);
+		can_recv_key_t mask = mask1 & mask2 & ~(key1 ^ key2);
+		filters[k] = can_net_filter_from_key(key1 & mask, mask);
+		memmove(filters + k + 1, filters + k + 2,
+				(n - k - 2) * sizeof(*filters));
+		n--;
+	}
+
+	return n;
+}
+
 size_t
 can_timer_alignof(void)
 {
@@ -426,7 +807,7 @@ can_timer_start(can_timer_t *timer, can_net_t *net,
 
 	timer->net = net;
 
-	pheap_insert(&timer->net->timer_heap, &timer->node);
+	can_net_insert_timer(net, timer);
 
 	can_net_set_next(net);
 }
@@ -440,7 +821,7 @@ can_timer_stop(can_timer_t *timer)
 	if (!net)
 		return;
 
-	pheap_remove(&timer->net->timer_heap, &timer->node);
+	can_net_remove_timer(net, timer);
 
 	timer->net = NULL;
 
@@ -534,38 +915,71 @@ can_recv_start(can_recv_t *recv, can_net_t *net, uint_least32_t id,
 	recv->net = net;
 
 	recv->key = can_recv_key(id, flags);
-	struct rbnode *node = rbtree_find(&recv->net->recv_tree, &recv->key);
-	if (node) {
-		can_recv_t *prev = structof(node, can_recv_t, node);
+	can_recv_t *prev = can_net_find_recv(recv->net, recv->key);
+	if (prev) {
 		dlnode_insert_after(&prev->list, &recv->list);
 	} else {
-		rbtree_insert(&recv->net->recv_tree, &recv->node);
+		can_net_insert_recv(recv->net, recv);
 		dlnode_init(&recv->list);
+		can_net_set_filter(net);
 	}
 }
 
+void
+can_recv_start_mask(can_recv_t *recv, can_net_t *net, uint_least32_t id,
+		uint_least32_t mask, uint_least8_t flags,
+		uint_least8_t flags_mask)
+{
+	assert(recv);
+	assert(net);
+
+	can_recv_stop(recv);
+
+	recv->net = net;
+
+	// The identifier and flags are combined in the same way as the key of
+	// a CAN frame, so both can be matched with a single comparison.
+	recv->mask = ((can_recv_key_t)(mask & CAN_MASK_EID))
+			| ((can_recv_key_t)flags_mask << 29);
+	recv->key = can_recv_key(id, flags) & recv->mask;
+	recv->masked = 1;
+	dllist_push_back(&net->recv_mask, &recv->list);
+
+	can_net_set_filter(net);
+}
+
 void
 can_recv_stop(can_recv_t *recv)
 {
 	assert(recv);
 
-	if (!recv->net)
+	can_net_t *net = recv->net;
+	if (!net)
+		return;
+
+	if (recv->masked) {
+		dllist_remove(&net->recv_mask, &recv->list);
+		dlnode_init(&recv->list);
+		recv->masked = 0;
+		recv->net = NULL;
+		can_net_set_filter(net);
 		return;
+	}
 
 	struct dlnode *prev = recv->list.prev;
 	struct dlnode *next = recv->list.next;
 
 	if (!prev)
-		rbtree_remove(&recv->net->recv_tree, &recv->node);
+		can_net_remove_recv(net, recv);
 	dlnode_remove(&recv->list);
 	dlnode_init(&recv->list);
 
 	recv->net = NULL;
 
-	if (!prev && next) {
-		recv = structof(next, can_recv_t, list);
-		rbtree_insert(&recv->net->recv_tree, &recv->node);
-	}
+	if (!prev && next)
+		can_net_insert_recv(net, structof(next, can_recv_t, list));
+	else if (!prev)
+		can_net_set_filter(net);
 }
 
 static void
@@ -574,15 +988,169 @@ can_net_set_next(can_net_t *net)
 	assert(net);
 
 	struct pnode *node = pheap_first(&net->timer_heap);
-	if (!node)
+	if (node) {
+		// The timers in the heap trigger before those in the wheel.
+		net->next = structof(node, can_timer_t, node)->start;
+	} else if (net->timer_wheel && !twheel_empty(net->timer_wheel)) {
+		// Use the start of the first tick in which the wheel needs to
+		// be advanced as a lower bound, instead of searching the
+		// (unsorted) timers in that tick. Once the tick is reached, the
+		// timers are moved to the heap.
+		uint_least64_t nsec = twheel_next(net->timer_wheel)
+				<< CAN_NET_TIMER_TICK_SHIFT;
+		net->next = (struct timespec){ (time_t)(nsec / 1000000000),
+			(long)(nsec % 1000000000) };
+	} else {
 		return;
-	can_timer_t *timer = structof(node, can_timer_t, node);
+	}
 
-	net->next = timer->start;
 	if (net->next_func)
 		net->next_func(&net->next, net->next_data);
 }
 
+static inline void
+can_net_set_filter(can_net_t *net)
+{
+	assert(net);
+
+	if (net->filter_func)
+		net->filter_func(net->filter_data);
+}
+
+static inline uint_least64_t
+can_net_tick(const struct timespec *tp)
+{
+	assert(tp);
+
+	if (tp->tv_sec < 0)
+		return 0;
+	// Saturate instead of overflowing for times beyond the year 2554.
+	if ((uint_least64_t)tp->tv_sec >= UINT64_C(18446744073))
+		return UINT64_MAX >> CAN_NET_TIMER_TICK_SHIFT;
+	return ((uint_least64_t)tp->tv_sec * 1000000000 + tp->tv_nsec)
+			>> CAN_NET_TIMER_TICK_SHIFT;
+}
+
+static void
+can_net_insert_timer(can_net_t *net, can_timer_t *timer)
+{
+	assert(net);
+	assert(timer);
+
+	if (net->timer_wheel) {
+		timer->twnode.key = can_net_tick(&timer->start);
+		if (timer->twnode.key > twheel_now(net->timer_wheel)) {
+			twheel_insert(net->timer_wheel, &timer->twnode);
+			return;
+		}
+	}
+	pheap_insert(&net->timer_heap, &timer->node);
+}
+
+static void
+can_net_remove_timer(can_net_t *net, can_timer_t *timer)
+{
+	assert(net);
+	assert(timer);
+
+	// A timer is only stored in the wheel if its tick has not yet been
+	// reached.
+	if (net->timer_wheel
+			&& timer->twnode.key > twheel_now(net->timer_wheel))
+		twheel_remove(net->timer_wheel, &timer->twnode);
+	else
+		pheap_remove(&net->timer_heap, &timer->node);
+}
+
+static void
+can_net_take_timers(can_net_t *net, struct dllist *list)
+{
+	assert(net);
+	assert(list);
+
+	struct pnode *node;
+	while ((node = pheap_first(&net->timer_heap)) != NULL) {
+		pheap_remove(&net->timer_heap, node);
+		can_timer_t *timer = structof(node, can_timer_t, node);
+		dllist_push_back(list, &timer->twnode.list);
+	}
+}
+
+static void
+can_net_insert_timers(can_net_t *net, struct dllist *list)
+{
+	assert(net);
+	assert(list);
+
+	struct dlnode *node;
+	while ((node = dllist_pop_front(list)) != NULL) {
+		struct twnode *twnode = structof(node, struct twnode, list);
+		can_timer_t *timer = structof(twnode, can_timer_t, twnode);
+		can_net_insert_timer(net, timer);
+	}
+}
+
+static void
+can_net_advance_timers(can_net_t *net)
+{
+	assert(net);
+	struct twheel *wheel = net->timer_wheel;
+	assert(wheel);
+
+	uint_least64_t now = can_net_tick(&net->time);
+	if (now == twheel_now(wheel))
+		return;
+
+	struct dllist list;
+	dllist_init(&list);
+	// If the time is moved backwards, the tick of the timers in the heap
+	// may no longer have been reached.
+	if (now < twheel_now(wheel))
+		can_net_take_timers(net, &list);
+	twheel_advance(wheel, now, &list);
+	can_net_insert_timers(net, &list);
+}
+
+static inline can_recv_t *
+can_net_find_recv(const can_net_t *net, can_recv_key_t key)
+{
+	assert(net);
+
+	if (net->recv_table && key < CAN_NET_RECV_TABLE_SIZE)
+		return net->recv_table[key];
+
+	struct rbnode *node = rbtree_find(&net->recv_tree, &key);
+	return node ? structof(node, can_recv_t, node) : NULL;
+}
+
+static void
+can_net_insert_recv(can_net_t *net, can_recv_t *recv)
+{
+	assert(net);
+	assert(recv);
+
+	if (net->recv_table && recv->key < CAN_NET_RECV_TABLE_SIZE) {
+		assert(!net->recv_table[recv->key]);
+		net->recv_table[recv->key] = recv;
+	} else {
+		rbtree_insert(&net->recv_tree, &recv->node);
+	}
+}
+
+static void
+can_net_remove_recv(can_net_t *net, can_recv_t *recv)
+{
+	assert(net);
+	assert(recv);
+
+	if (net->recv_table && recv->key < CAN_NET_RECV_TABLE_SIZE) {
+		assert(net->recv_table[recv->key] == recv);
+		net->recv_table[recv->key] = NULL;
+	} else {
+		rbtree_remove(&net->recv_tree, &recv->node);
+	}
+}
+
 static inline can_recv_key_t
 can_recv_key(uint_least32_t id, uint_least8_t flags)
 {
@@ -600,6 +1168,43 @@ can_recv_key_cmp(const void *p1, const void *p2)
 #endif
 }
 
+static inline can_recv_key_t
+can_net_filter_key(const struct can_net_filter *filter, can_recv_key_t *pmask)
+{
+	assert(filter);
+	assert(pmask);
+
+	*pmask = ((can_recv_key_t)(filter->mask & CAN_MASK_EID))
+			| ((can_recv_key_t)filter->flags_mask << 29);
+	return (((can_recv_key_t)(filter->id & CAN_MASK_EID))
+				       | ((can_recv_key_t)filter->flags << 29))
+			& *pmask;
+}
+
+static inline struct can_net_filter
+can_net_filter_from_key(can_recv_key_t key, can_recv_key_t mask)
+{
+	key &= mask;
+	return (struct can_net_filter){ .id = key & CAN_MASK_EID,
+		.mask = mask & CAN_MASK_EID,
+		.flags = (uint_least8_t)(key >> 29),
+		.flags_mask = (uint_least8_t)(mask >> 29) };
+}
+
+static int
+can_net_filter_cmp(const void *p1, const void *p2)
+{
+	can_recv_key_t mask1;
+	can_recv_key_t key1 = can_net_filter_key(p1, &mask1);
+	can_recv_key_t mask2;
+	can_recv_key_t key2 = can_net_filter_key(p2, &mask2);
+
+	int cmp = (key2 < key1) - (key1 < key2);
+	if (!cmp)
+		cmp = (mask2 < mask1) - (mask1 < mask2);
+	return cmp;
+}
+
 static can_net_t *
 can_net_alloc(alloc_t *alloc)
 {
@@ -625,6 +1230,7 @@ can_net_init(can_net_t *net)
 	assert(net);
 
 	pheap_init(&net->timer_heap, &timespec_cmp);
+	net->timer_wheel = NULL;
 
 	net->time = (struct timespec){ 0, 0 };
 	net->next = (struct timespec){ 0, 0 };
@@ -633,9 +1239,14 @@ can_net_init(can_net_t *net)
 	net->next_data = NULL;
 
 	rbtree_init(&net->recv_tree, &can_recv_key_cmp);
+	net->recv_table = NULL;
+	dllist_init(&net->recv_mask);
 
 	net->send_func = NULL;
 	net->send_data = NULL;
+
+	net->filter_func = NULL;
+	net->filter_data = NULL;
 }
 
 static void
@@ -649,6 +1260,22 @@ can_net_fini(can_net_t *net)
 			can_recv_stop(structof(node, can_recv_t, list));
 	}
 
+	if (net->recv_table) {
+		for (size_t i = 0; i < CAN_NET_RECV_TABLE_SIZE; i++) {
+			can_recv_t *recv;
+			while ((recv = net->recv_table[i]) != NULL)
+				can_recv_stop(recv);
+		}
+		mem_free(net->alloc, net->recv_table);
+		net->recv_table = NULL;
+	}
+
+	struct dlnode *first;
+	while ((first = dllist_first(&net->recv_mask)) != NULL)
+		can_recv_stop(structof(first, can_recv_t, list));
+
+	// Move all timers to the heap before stopping them.
+	can_net_set_timer_queue(net, CAN_NET_TIMER_QUEUE_HEAP);
 	struct pnode *node;
 	while ((node = pheap_first(&net->timer_heap)) != NULL)
 		can_timer_stop(structof(node, can_timer_t, node));
@@ -679,6 +1306,7 @@ can_timer_init(can_timer_t *timer)
 	assert(timer);
 
 	timer->node.key = &timer->start;
+	twnode_init(&timer->twnode, 0);
 
 	timer->net = NULL;
 
@@ -725,6 +1353,8 @@ can_recv_init(can_recv_t *recv)
 	recv->net = NULL;
 
 	recv->key = 0;
+	recv->mask = 0;
+	recv->masked = 0;
 
 	recv->func = NULL;
 	recv->data = NULL;
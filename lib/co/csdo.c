@@ -97,8 +97,10 @@ struct co_csdo {
 	co_unsigned8_t blksize;
 	/// The sequence number of the last successfully received segment.
 	co_unsigned8_t ackseq;
+	/// The generated CRC.
+	co_unsigned16_t crc;
 	/// A flag indicating whether a CRC should be generated.
-	unsigned crc : 1;
+	unsigned gencrc : 1;
 	/// The memory buffer used for download requests.
 	struct membuf dn_buf;
 	/// A pointer to the memory buffer used for upload requests.
@@ -1842,7 +1844,8 @@ co_csdo_blk_dn_ini_on_recv(co_csdo_t *sdo, const struct can_msg *msg)
 		return co_csdo_abort_res(sdo, CO_SDO_AC_NO_CS);
 
 	// Check if the server supports generating a CRC.
-	sdo->crc = !!(cs & CO_SDO_BLK_CRC);
+	sdo->crc = 0;
+	sdo->gencrc = !!(cs & CO_SDO_BLK_CRC);
 
 	// Check the object index and sub-index.
 	if (msg->len < 4)
@@ -1929,15 +1932,22 @@ co_csdo_blk_dn_sub_on_recv(co_csdo_t *sdo, const struct can_msg *msg)
 	if (msg->len < 2)
 		return co_csdo_abort_res(sdo, CO_SDO_AC_BLK_SEQ);
 	co_unsigned8_t ackseq = msg->data[1];
+	size_t n = (membuf_size(buf) + 6) / 7;
+	assert(n >= sdo->blksize);
+	// The offset of the first byte in the current block.
+	size_t begin = (n - sdo->blksize) * 7;
 	if (ackseq < sdo->blksize) {
 		// If the sequence number of the last segment that was
 		// successfully received is smaller than the number of segments
 		// in the block, resend the missing segments.
-		size_t n = (membuf_size(buf) + 6) / 7;
-		assert(n >= sdo->blksize);
 		n -= sdo->blksize - ackseq;
 		buf->cur = buf->begin + n * 7;
 	}
+	// Update the CRC with the segments that were received successfully, so
+	// it does not have to be computed over the entire value at the end.
+	if (sdo->gencrc)
+		sdo->crc = co_crc(sdo->crc, (uint_least8_t *)buf->begin + begin,
+				membuf_size(buf) - begin);
 
 	// Read the number of segments in the next block.
 	if (msg->len < 3)
@@ -2033,7 +2043,8 @@ co_csdo_blk_up_ini_on_recv(co_csdo_t *sdo, const struct can_msg *msg)
 		return co_csdo_abort_res(sdo, CO_SDO_AC_NO_CS);
 
 	// Check if the server supports generating a CRC.
-	sdo->crc = !!(cs & CO_SDO_BLK_CRC);
+	sdo->crc = 0;
+	sdo->gencrc = !!(cs & CO_SDO_BLK_CRC);
 
 	// Check the object index and sub-index.
 	if (msg->len < 4)
@@ -2113,6 +2124,8 @@ co_csdo_blk_up_sub_on_recv(co_csdo_t *sdo, const struct can_msg *msg)
 		// Copy the data to the buffer.
 		assert(membuf_capacity(buf) >= n);
 		membuf_write(buf, msg->data + 1, n);
+		if (sdo->gencrc)
+			sdo->crc = co_crc(sdo->crc, msg->data + 1, n);
 	}
 
 	// If this is the last segment in the block, send a confirmation.
@@ -2176,9 +2189,9 @@ co_csdo_blk_up_end_on_recv(co_csdo_t *sdo, const struct can_msg *msg)
 		return co_csdo_abort_res(sdo, CO_SDO_AC_NO_CS);
 
 	// Check the CRC.
-	if (sdo->crc) {
+	if (sdo->gencrc) {
 		co_unsigned16_t crc = ldle_u16(msg->data + 1);
-		if (crc != co_crc(0, (uint_least8_t *)buf->begin, sdo->size))
+		if (sdo->crc != crc)
 			return co_csdo_abort_res(sdo, CO_SDO_AC_BLK_CRC);
 	}
 
@@ -2223,6 +2236,7 @@ co_csdo_dn_ind(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
 	sdo->blksize = 0;
 	sdo->ackseq = 0;
 	sdo->crc = 0;
+	sdo->gencrc = 0;
 
 	// Casting away const is safe here since a download (write) request only
 	// reads from the provided buffer.
@@ -2258,6 +2272,7 @@ co_csdo_up_ind(co_csdo_t *sdo, co_unsigned16_t idx, co_unsigned8_t subidx,
 	sdo->blksize = 0;
 	sdo->ackseq = 0;
 	sdo->crc = 0;
+	sdo->gencrc = 0;
 
 	sdo->up_buf = buf ? buf : &sdo->buf;
 	membuf_clear(sdo->up_buf);
@@ -2407,7 +2422,6 @@ static void
 co_csdo_send_blk_dn_end_req(co_csdo_t *sdo)
 {
 	assert(sdo);
-	struct membuf *buf = &sdo->dn_buf;
 
 	// Compute the number of bytes in the last segment containing data.
 	co_unsigned8_t n = sdo->size ? (sdo->size - 1) % 7 + 1 : 0;
@@ -2415,13 +2429,9 @@ co_csdo_send_blk_dn_end_req(co_csdo_t *sdo)
 	co_unsigned8_t cs = CO_SDO_CCS_BLK_DN_REQ | CO_SDO_SC_END_BLK
 			| CO_SDO_BLK_SIZE_SET(n);
 
-	co_unsigned16_t crc = sdo->crc
-			? co_crc(0, (uint_least8_t *)buf->begin, sdo->size)
-			: 0;
-
 	struct can_msg msg;
 	co_csdo_init_seg_req(sdo, &msg, cs);
-	stle_u16(msg.data + 1, crc);
+	stle_u16(msg.data + 1, sdo->gencrc ? sdo->crc : 0);
 	can_net_send(sdo->net, &msg);
 }
 
@@ -2661,6 +2671,7 @@ co_csdo_init(co_csdo_t *sdo, can_net_t *net, co_dev_t *dev, co_unsigned8_t num)
 	sdo->blksize = 0;
 	sdo->ackseq = 0;
 	sdo->crc = 0;
+	sdo->gencrc = 0;
 
 	membuf_init(&sdo->dn_buf, NULL, 0);
 	sdo->up_buf = NULL;
@@ -33,26 +33,126 @@
 #include <lely/compat/strings.h>
 #include <lely/util/config.h>
 #include <lely/util/diag.h>
+#include <lely/util/frbuf.h>
 #include <lely/util/lex.h>
+#include <lely/util/membuf.h>
 
 #include <assert.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
-static co_dev_t *co_dev_init_from_dcf_cfg(co_dev_t *dev, const config_t *cfg);
-
-static int co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg);
-
-static int co_obj_parse_cfg(
-		co_obj_t *obj, const config_t *cfg, const char *section);
+/// The kinds of sections with a name derived from an object index.
+enum {
+	/// An object section ("%X").
+	CO_DCF_OBJ = 1,
+	/// A sub-object section ("%Xsub%X").
+	CO_DCF_SUB,
+	/// A section with the names of compact sub-objects ("%XName").
+	CO_DCF_NAME,
+	/// A section with the values of compact sub-objects ("%XValue").
+	CO_DCF_VALUE
+};
+
+/**
+ * Returns the numeric identifier of a section of the specified kind for the
+ * specified (sub-)index. Sections are sorted by identifier, so all sub-object
+ * sections of an object are adjacent and in order of their sub-index.
+ */
+#define CO_DCF_ID(kind, idx, subidx) \
+	(((uint_least32_t)(kind) << 24) | ((uint_least32_t)(idx) << 8) \
+			| (uint_least32_t)(subidx))
+
+/// The numeric identifier of a section whose name is not an object index.
+#define CO_DCF_ID_NONE UINT32_C(0xffffffff)
+
+/// A key-value pair in a section of an EDS/DCF file.
+struct co_dcf_key {
+	/// A pointer to the name of the key.
+	const char *key;
+	/// A pointer to the value of the key.
+	const char *val;
+};
+
+/// A section of an EDS/DCF file.
+struct co_dcf_section {
+	/// A pointer to the name of the section.
+	const char *name;
+	/// The identifier of the section (see #CO_DCF_ID()).
+	uint_least32_t id;
+	/**
+	 * A pointer to the key-value pairs in the section, sorted by key. For
+	 * duplicate keys, the last occurrence in the file is sorted last.
+	 */
+	struct co_dcf_key *keys;
+	/// The number of key-value pairs at <b>keys</b>.
+	size_t nkeys;
+};
+
+/**
+ * An EDS/DCF file. The file is either lexed in a single pass by
+ * co_dcf_init(), in which case the sections and keys can be found with a
+ * binary search, or represented by a parsed configuration struct.
+ */
+struct co_dcf {
+	/// A pointer to the configuration struct, or NULL if the file was lexed.
+	const config_t *cfg;
+	/// The buffer containing the section names, keys and values.
+	struct membuf buf;
+	/// An array of unique sections, sorted by identifier and name.
+	struct co_dcf_section *sections;
+	/// The number of sections at <b>sections</b>.
+	size_t nsections;
+	/// The array of key-value pairs referenced by <b>sections</b>.
+	struct co_dcf_key *keys;
+};
+
+/// A section of an EDS/DCF file, as encountered by co_dcf_init().
+struct co_dcf_lex_section {
+	/// The offset of the name of the section in the string buffer.
+	size_t name;
+	/// The number of key-value pairs in the section.
+	size_t nkeys;
+	/// The index of the section in the array of unique sections.
+	size_t rank;
+};
+
+/// A key-value pair in an EDS/DCF file, as encountered by co_dcf_init().
+struct co_dcf_lex_key {
+	/// The index of the section containing the key.
+	size_t section;
+	/// The offset of the name of the key in the string buffer.
+	size_t key;
+	/// The offset of the value of the key in the string buffer.
+	size_t val;
+};
+
+/// A handle to a section of a #co_dcf struct.
+struct co_dcf_sec {
+	/// A pointer to the name of the section.
+	const char *name;
+	/// The buffer used to print the name of the section.
+	char buf[10];
+	/// A pointer to the key-value pairs in the section, sorted by key.
+	const struct co_dcf_key *keys;
+	/// The number of key-value pairs at <b>keys</b>.
+	size_t nkeys;
+};
+
+static co_dev_t *co_dev_init_from_dcf(co_dev_t *dev, const struct co_dcf *dcf);
+
+static int co_dev_parse_dcf(co_dev_t *dev, const struct co_dcf *dcf);
+
+static int co_obj_parse_dcf(co_obj_t *obj, const struct co_dcf *dcf,
+		const struct co_dcf_sec *sec);
 #if !LELY_NO_CO_OBJ_NAME
-static int co_obj_parse_names(co_obj_t *obj, const config_t *cfg);
+static int co_obj_parse_names(co_obj_t *obj, const struct co_dcf *dcf);
 #endif
-static int co_obj_parse_values(co_obj_t *obj, const config_t *cfg);
+static int co_obj_parse_values(co_obj_t *obj, const struct co_dcf *dcf);
 static co_obj_t *co_obj_build(co_dev_t *dev, co_unsigned16_t idx);
 
-static int co_sub_parse_cfg(
-		co_sub_t *sub, const config_t *cfg, const char *section);
+static int co_sub_parse_dcf(co_sub_t *sub, const struct co_dcf *dcf,
+		const struct co_dcf_sec *sec);
 static co_sub_t *co_sub_build(co_obj_t *obj, co_unsigned8_t subidx,
 		co_unsigned16_t type, const char *name);
 
@@ -65,33 +165,81 @@ static size_t co_val_lex_id(
 		const char *begin, const char *end, struct floc *at);
 static void co_val_set_id(co_unsigned16_t type, void *val, co_unsigned8_t id);
 
-static co_unsigned16_t config_get_idx(const config_t *cfg, const char *section,
-		co_unsigned16_t maxidx, co_unsigned16_t *idx);
+static int co_dcf_init(struct co_dcf *dcf, const char *begin, const char *end,
+		struct floc *at);
+static void co_dcf_fini(struct co_dcf *dcf);
+
+static void co_dcf_find_name(const struct co_dcf *dcf, struct co_dcf_sec *sec,
+		const char *name);
+static void co_dcf_find(const struct co_dcf *dcf, struct co_dcf_sec *sec,
+		int kind, co_unsigned16_t idx, co_unsigned8_t subidx);
+static size_t co_dcf_find_sub(const struct co_dcf *dcf, struct co_dcf_sec *sec,
+		co_unsigned16_t idx, size_t subidx);
+static const char *co_dcf_get(const struct co_dcf *dcf,
+		const struct co_dcf_sec *sec, const char *key);
+static co_unsigned16_t co_dcf_get_idx(const struct co_dcf *dcf,
+		const char *section, co_unsigned16_t maxidx,
+		co_unsigned16_t *idx);
+
+static int co_dcf_add_section(struct membuf *sections, struct membuf *buf,
+		const char *s, size_t n);
+static int co_dcf_add_key(struct membuf *sections, struct membuf *keys,
+		size_t key, size_t val);
+static int co_dcf_add_str(
+		struct membuf *buf, const char *s, size_t n, size_t *poff);
+static int co_dcf_sort(struct co_dcf *dcf, struct membuf *sections,
+		const struct membuf *keys);
+static size_t co_dcf_skip(const char *begin, const char *end, struct floc *at);
+
+static uint_least32_t co_dcf_section_id(const char *name);
+static size_t co_dcf_lex_hex(const char *s, size_t n, co_unsigned16_t *pval);
+static size_t co_dcf_lower_bound(
+		const struct co_dcf *dcf, uint_least32_t id, const char *name);
+
+static int co_dcf_section_cmp(const void *p1, const void *p2);
+static int co_dcf_section_ptr_cmp(const void *p1, const void *p2);
+static int co_dcf_key_cmp(const void *p1, const void *p2);
+
+static int co_dcf_issection(int c);
+static int co_dcf_iskey(int c);
+static int co_dcf_isvalue(int c);
 
 co_dev_t *
 co_dev_init_from_dcf_file(co_dev_t *dev, const char *filename)
 {
-	config_t *cfg = config_create(CONFIG_CASE);
-	if (!cfg) {
-		diag(DIAG_ERROR, get_errc(),
-				"unable to create configuration struct");
-		goto error_create_cfg;
+	int errc = 0;
+
+	frbuf_t *buf = frbuf_create(filename);
+	if (!buf) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s", filename);
+		goto error_create_buf;
 	}
 
-	if (!config_parse_ini_file(cfg, filename))
-		goto error_parse_ini_file;
+	size_t size = 0;
+	const void *map = frbuf_map(buf, 0, &size);
+	if (!map) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to map file", filename);
+		goto error_map_buf;
+	}
 
-	if (!co_dev_init_from_dcf_cfg(dev, cfg))
+	const char *begin = map;
+	struct floc at = { filename, 1, 1 };
+	if (!co_dev_init_from_dcf_text(dev, begin, begin + size, &at)) {
+		errc = get_errc();
 		goto error_init_dev;
+	}
 
-	config_destroy(cfg);
+	frbuf_destroy(buf);
 
 	return dev;
 
 error_init_dev:
-error_parse_ini_file:
-	config_destroy(cfg);
-error_create_cfg:
+error_map_buf:
+	frbuf_destroy(buf);
+error_create_buf:
+	set_errc(errc);
 	return NULL;
 }
 
@@ -124,27 +272,28 @@ co_dev_t *
 co_dev_init_from_dcf_text(co_dev_t *dev, const char *begin, const char *end,
 		struct floc *at)
 {
-	config_t *cfg = config_create(CONFIG_CASE);
-	if (!cfg) {
-		diag(DIAG_ERROR, get_errc(),
-				"unable to create configuration struct");
-		goto error_create_cfg;
-	}
+	int errc = 0;
 
-	if (!config_parse_ini_text(cfg, begin, end, at))
-		goto error_parse_ini_text;
+	struct co_dcf dcf;
+	if (co_dcf_init(&dcf, begin, end, at) == -1) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "unable to lex EDS/DCF text");
+		goto error_init_dcf;
+	}
 
-	if (!co_dev_init_from_dcf_cfg(dev, cfg))
+	if (!co_dev_init_from_dcf(dev, &dcf)) {
+		errc = get_errc();
 		goto error_init_dev;
+	}
 
-	config_destroy(cfg);
+	co_dcf_fini(&dcf);
 
 	return dev;
 
 error_init_dev:
-error_parse_ini_text:
-	config_destroy(cfg);
-error_create_cfg:
+	co_dcf_fini(&dcf);
+error_init_dcf:
+	set_errc(errc);
 	return NULL;
 }
 
@@ -173,101 +322,143 @@ error_alloc_dev:
 	return NULL;
 }
 
-static co_dev_t *
+co_dev_t *
 co_dev_init_from_dcf_cfg(co_dev_t *dev, const config_t *cfg)
 {
-	assert(dev);
 	assert(cfg);
 
+	struct co_dcf dcf = { .cfg = cfg };
+
+	return co_dev_init_from_dcf(dev, &dcf);
+}
+
+co_dev_t *
+co_dev_create_from_dcf_cfg(const config_t *cfg)
+{
+	int errc = 0;
+
+	co_dev_t *dev = co_dev_alloc();
+	if (!dev) {
+		errc = get_errc();
+		goto error_alloc_dev;
+	}
+
+	if (!co_dev_init_from_dcf_cfg(dev, cfg)) {
+		errc = get_errc();
+		goto error_init_dev;
+	}
+
+	return dev;
+
+error_init_dev:
+	co_dev_free(dev);
+error_alloc_dev:
+	set_errc(errc);
+	return NULL;
+}
+
+static co_dev_t *
+co_dev_init_from_dcf(co_dev_t *dev, const struct co_dcf *dcf)
+{
+	assert(dev);
+	assert(dcf);
+
 	if (!co_dev_init(dev, 0xff)) {
 		diag(DIAG_ERROR, get_errc(),
 				"unable to initialize device description");
 		goto error_init_dev;
 	}
 
-	if (co_dev_parse_cfg(dev, cfg) == -1)
-		goto error_parse_cfg;
+	if (co_dev_parse_dcf(dev, dcf) == -1)
+		goto error_parse_dcf;
 
 	return dev;
 
-error_parse_cfg:
+error_parse_dcf:
 	co_dev_fini(dev);
 error_init_dev:
 	return NULL;
 }
 
 static int
-co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
+co_dev_parse_dcf(co_dev_t *dev, const struct co_dcf *dcf)
 {
 	assert(dev);
-	assert(cfg);
+	assert(dcf);
 
 	const char *val;
 
+	struct co_dcf_sec info;
+	co_dcf_find_name(dcf, &info, "DeviceInfo");
+	struct co_dcf_sec dummy_usage;
+	co_dcf_find_name(dcf, &dummy_usage, "DummyUsage");
+	struct co_dcf_sec comissioning;
+	co_dcf_find_name(dcf, &comissioning, "DeviceComissioning");
+
 	// clang-format off
 	if (co_dev_set_vendor_name(dev,
-			config_get(cfg, "DeviceInfo", "VendorName")) == -1) {
+			co_dcf_get(dcf, &info, "VendorName")) == -1) {
 		// clang-format on
 		diag(DIAG_ERROR, get_errc(), "unable to set vendor name");
 		goto error_parse_dev;
 	}
 
-	val = config_get(cfg, "DeviceInfo", "VendorNumber");
+	val = co_dcf_get(dcf, &info, "VendorNumber");
 	if (val && *val)
 		co_dev_set_vendor_id(dev, strtoul(val, NULL, 0));
 
 	// clang-format off
 	if (co_dev_set_product_name(dev,
-			config_get(cfg, "DeviceInfo", "ProductName")) == -1) {
+			co_dcf_get(dcf, &info, "ProductName")) == -1) {
 		// clang-format on
 		diag(DIAG_ERROR, get_errc(), "unable to set product name");
 		goto error_parse_dev;
 	}
 
-	val = config_get(cfg, "DeviceInfo", "ProductNumber");
+	val = co_dcf_get(dcf, &info, "ProductNumber");
 	if (val && *val)
 		co_dev_set_product_code(dev, strtoul(val, NULL, 0));
 
-	val = config_get(cfg, "DeviceInfo", "RevisionNumber");
+	val = co_dcf_get(dcf, &info, "RevisionNumber");
 	if (val && *val)
 		co_dev_set_revision(dev, strtoul(val, NULL, 0));
 
 	// clang-format off
 	if (co_dev_set_order_code(dev,
-			config_get(cfg, "DeviceInfo", "OrderCode")) == -1) {
+			co_dcf_get(dcf, &info, "OrderCode")) == -1) {
 		diag(DIAG_ERROR, get_errc(), "unable to set order code");
 		goto error_parse_dev;
 		// clang-format on
 	}
 
 	unsigned int baud = 0;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_10");
+	val = co_dcf_get(dcf, &info, "BaudRate_10");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_10;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_20");
+	val = co_dcf_get(dcf, &info, "BaudRate_20");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_20;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_50");
+	val = co_dcf_get(dcf, &info, "BaudRate_50");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_50;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_125");
+	val = co_dcf_get(dcf, &info, "BaudRate_125");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_125;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_250");
+	val = co_dcf_get(dcf, &info, "BaudRate_250");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_250;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_500");
+	val = co_dcf_get(dcf, &info, "BaudRate_500");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_500;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_800");
+	val = co_dcf_get(dcf, &info, "BaudRate_800");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_800;
-	val = config_get(cfg, "DeviceInfo", "BaudRate_1000");
+	val = co_dcf_get(dcf, &info, "BaudRate_1000");
 	if (val && *val && strtoul(val, NULL, 0))
 		baud |= CO_BAUD_1000;
 	co_dev_set_baud(dev, baud);
 
-	val = config_get(cfg, "DeviceInfo", "LSS_Supported");
+	val = co_dcf_get(dcf, &info, "LSS_Supported");
 	if (val && *val)
 		co_dev_set_lss(dev, strtoul(val, NULL, 0));
 
@@ -279,7 +470,7 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 		char key[10];
 		snprintf(key, sizeof(key), "Dummy%04X", (co_unsigned16_t)i);
 
-		val = config_get(cfg, "DummyUsage", key);
+		val = co_dcf_get(dcf, &dummy_usage, key);
 		if (val && *val && strtoul(val, NULL, 0))
 			dummy |= 1u << i;
 	}
@@ -287,9 +478,9 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 
 	// Count the total number of objects.
 	co_unsigned16_t n = 0;
-	n += config_get_idx(cfg, "MandatoryObjects", 0, NULL);
-	n += config_get_idx(cfg, "OptionalObjects", 0, NULL);
-	n += config_get_idx(cfg, "ManufacturerObjects", 0, NULL);
+	n += co_dcf_get_idx(dcf, "MandatoryObjects", 0, NULL);
+	n += co_dcf_get_idx(dcf, "OptionalObjects", 0, NULL);
+	n += co_dcf_get_idx(dcf, "ManufacturerObjects", 0, NULL);
 
 	// Parse the object indices.
 	co_unsigned16_t *idx = malloc(n * sizeof(co_unsigned16_t));
@@ -303,9 +494,9 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 		goto error_parse_idx;
 	}
 	co_unsigned16_t i = 0;
-	i += config_get_idx(cfg, "MandatoryObjects", n - i, idx + i);
-	i += config_get_idx(cfg, "OptionalObjects", n - i, idx + i);
-	config_get_idx(cfg, "ManufacturerObjects", n - i, idx + i);
+	i += co_dcf_get_idx(dcf, "MandatoryObjects", n - i, idx + i);
+	i += co_dcf_get_idx(dcf, "OptionalObjects", n - i, idx + i);
+	co_dcf_get_idx(dcf, "ManufacturerObjects", n - i, idx + i);
 
 	for (i = 0; i < n; i++) {
 		if (!idx[i]) {
@@ -314,9 +505,9 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 			goto error_parse_obj;
 		}
 
-		// Create the section name for the object.
-		char section[5];
-		snprintf(section, sizeof(section), "%X", idx[i]);
+		// Find the section for the object.
+		struct co_dcf_sec sec;
+		co_dcf_find(dcf, &sec, CO_DCF_OBJ, idx[i], 0);
 
 		// Create the object and add it to the dictionary.
 		co_obj_t *obj = co_obj_build(dev, idx[i]);
@@ -324,7 +515,7 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 			goto error_parse_obj;
 
 		// Parse the configuration section for the object.
-		if (co_obj_parse_cfg(obj, cfg, section) == -1)
+		if (co_obj_parse_dcf(obj, dcf, &sec) == -1)
 			goto error_parse_obj;
 	}
 
@@ -337,11 +528,11 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 
 	// Parse compact PDO definitions after the explicit object definitions
 	// to prevent overwriting PDOs.
-	val = config_get(cfg, "DeviceInfo", "CompactPDO");
+	val = co_dcf_get(dcf, &info, "CompactPDO");
 	unsigned int mask = val && *val ? strtoul(val, NULL, 0) : 0;
 	if (mask) {
 		co_unsigned16_t nrpdo = 0;
-		val = config_get(cfg, "DeviceInfo", "NrOfRxPDO");
+		val = co_dcf_get(dcf, &info, "NrOfRxPDO");
 		if (val && *val)
 			nrpdo = (co_unsigned16_t)strtoul(val, NULL, 0);
 		// Count the number of implicit RPDOs.
@@ -363,7 +554,7 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 		}
 
 		co_unsigned16_t ntpdo = 0;
-		val = config_get(cfg, "DeviceInfo", "NrOfTxPDO");
+		val = co_dcf_get(dcf, &info, "NrOfTxPDO");
 		if (val && *val)
 			ntpdo = (co_unsigned16_t)strtoul(val, NULL, 0);
 		// Count the number of implicit TPDOs.
@@ -385,7 +576,7 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 		}
 	}
 
-	val = config_get(cfg, "DeviceComissioning", "NodeID");
+	val = co_dcf_get(dcf, &comissioning, "NodeID");
 	// clang-format off
 	if (val && *val && co_dev_set_id(dev,
 			(co_unsigned8_t)strtoul(val, NULL, 0)) == -1) {
@@ -395,7 +586,7 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 		goto error_parse_dcf;
 	}
 
-	val = config_get(cfg, "DeviceComissioning", "NetNumber");
+	val = co_dcf_get(dcf, &comissioning, "NetNumber");
 	// clang-format off
 	if (val && *val && co_dev_set_netid(dev,
 			(co_unsigned32_t)strtoul(val, NULL, 0)) == -1) {
@@ -407,18 +598,18 @@ co_dev_parse_cfg(co_dev_t *dev, const config_t *cfg)
 
 	// clang-format off
 	if (co_dev_set_name(dev,
-			config_get(cfg, "DeviceComissioning", "NodeName"))
+			co_dcf_get(dcf, &comissioning, "NodeName"))
 			== -1) {
 		// clang-format on
 		diag(DIAG_ERROR, get_errc(), "unable to set node name");
 		goto error_parse_dcf;
 	}
 
-	val = config_get(cfg, "DeviceComissioning", "Baudrate");
+	val = co_dcf_get(dcf, &comissioning, "Baudrate");
 	if (val && *val)
 		co_dev_set_rate(dev, (co_unsigned16_t)strtoul(val, NULL, 0));
 
-	val = config_get(cfg, "DeviceComissioning", "LSS_SerialNumber");
+	val = co_dcf_get(dcf, &comissioning, "LSS_SerialNumber");
 	// clang-format off
 	if (val && *val && !co_dev_set_val_u32(dev, 0x1018, 0x04,
 			strtoul(val, NULL, 0))) {
@@ -441,17 +632,19 @@ error_parse_dev:
 }
 
 static int
-co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
+co_obj_parse_dcf(co_obj_t *obj, const struct co_dcf *dcf,
+		const struct co_dcf_sec *sec)
 {
 	assert(obj);
-	assert(cfg);
+	assert(dcf);
+	assert(sec);
 
 	const char *val;
-	struct floc at = { section, 0, 0 };
+	struct floc at = { sec->name, 0, 0 };
 
 	co_unsigned16_t idx = co_obj_get_idx(obj);
 
-	const char *name = config_get(cfg, section, "ParameterName");
+	const char *name = co_dcf_get(dcf, sec, "ParameterName");
 	if (!name) {
 		diag(DIAG_ERROR, 0,
 				"ParameterName not specified for object 0x%04X",
@@ -459,7 +652,7 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 		return -1;
 	}
 #if !LELY_NO_CO_OBJ_NAME
-	val = config_get(cfg, section, "Denotation");
+	val = co_dcf_get(dcf, sec, "Denotation");
 	if (val && *val)
 		name = val;
 	if (co_obj_set_name(obj, name) == -1) {
@@ -470,7 +663,7 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 #endif
 
 	co_unsigned8_t code = co_obj_get_code(obj);
-	val = config_get(cfg, section, "ObjectType");
+	val = co_dcf_get(dcf, sec, "ObjectType");
 	if (val && *val) {
 		code = (co_unsigned8_t)strtoul(val, NULL, 0);
 		if (co_obj_set_code(obj, code) == -1) {
@@ -484,11 +677,11 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 	if (code == CO_OBJECT_DEFSTRUCT || code == CO_OBJECT_ARRAY
 			|| code == CO_OBJECT_RECORD) {
 		co_unsigned8_t subnum = 0;
-		val = config_get(cfg, section, "SubNumber");
+		val = co_dcf_get(dcf, sec, "SubNumber");
 		if (val && *val)
 			subnum = (co_unsigned8_t)strtoul(val, NULL, 0);
 		co_unsigned8_t subobj = 0;
-		val = config_get(cfg, section, "CompactSubObj");
+		val = co_dcf_get(dcf, sec, "CompactSubObj");
 		if (val && *val)
 			subobj = (co_unsigned8_t)strtoul(val, NULL, 0);
 		if (!subnum && !subobj) {
@@ -506,28 +699,29 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 
 		// Parse the sub-objects specified by SubNumber.
 		for (size_t subidx = 0; subnum && subidx < 0xff; subidx++) {
-			// Create section name for the sub-object.
-			char section[10];
-			snprintf(section, sizeof(section), "%Xsub%X",
-					(co_unsigned16_t)idx,
-					(co_unsigned8_t)subidx);
+			// Find the section for the sub-object, skipping the
+			// sub-indices without a section, if possible.
+			struct co_dcf_sec subsec;
+			subidx = co_dcf_find_sub(dcf, &subsec, idx, subidx);
+			if (subidx >= 0xff)
+				break;
 
 			// Check whether the sub-index exists by checking the
 			// presence of the mandatory ParameterName keyword.
-			const char *name = config_get(
-					cfg, section, "ParameterName");
+			const char *name = co_dcf_get(
+					dcf, &subsec, "ParameterName");
 			if (!name)
 				continue;
 			subnum--;
 
 			// The Denonation entry, if it exists, overrides
 			// ParameterName.
-			val = config_get(cfg, section, "Denotation");
+			val = co_dcf_get(dcf, &subsec, "Denotation");
 			if (val && *val)
 				name = val;
 
 			// Obtain the data type of the sub-object.
-			val = config_get(cfg, section, "DataType");
+			val = co_dcf_get(dcf, &subsec, "DataType");
 			if (!val || !*val) {
 				diag_at(DIAG_ERROR, 0, &at,
 						"DataType not specified");
@@ -543,7 +737,7 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 				return -1;
 
 			// Parse the configuration section for the sub-object.
-			if (co_sub_parse_cfg(sub, cfg, section) == -1)
+			if (co_sub_parse_dcf(sub, dcf, &subsec) == -1)
 				return -1;
 		}
 
@@ -560,10 +754,10 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 #endif
 			co_sub_set_access(sub, CO_ACCESS_RO);
 
-			name = config_get(cfg, section, "ParameterName");
+			name = co_dcf_get(dcf, sec, "ParameterName");
 
 			// Obtain the data type of the sub-object.
-			val = config_get(cfg, section, "DataType");
+			val = co_dcf_get(dcf, sec, "DataType");
 			if (!val || !*val) {
 				diag_at(DIAG_ERROR, 0, &at,
 						"DataType not specified");
@@ -591,18 +785,18 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 
 				// Parse the configuration section for the
 				// sub-object.
-				if (co_sub_parse_cfg(sub, cfg, section) == -1)
+				if (co_sub_parse_dcf(sub, dcf, sec) == -1)
 					return -1;
 			}
 
 #if !LELY_NO_CO_OBJ_NAME
 			// Parse the names of the sub-objects.
-			if (co_obj_parse_names(obj, cfg) == -1)
+			if (co_obj_parse_names(obj, dcf) == -1)
 				return -1;
 #endif
 
 			// Parse the values of the sub-objects.
-			if (co_obj_parse_values(obj, cfg) == -1)
+			if (co_obj_parse_values(obj, dcf) == -1)
 				return -1;
 		}
 
@@ -617,7 +811,7 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 		co_unsigned16_t type = code == CO_OBJECT_DOMAIN
 				? CO_DEFTYPE_DOMAIN
 				: 0;
-		val = config_get(cfg, section, "DataType");
+		val = co_dcf_get(dcf, sec, "DataType");
 		if (val && *val)
 			type = (co_unsigned16_t)strtoul(val, NULL, 0);
 		if (!type) {
@@ -631,7 +825,7 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 			return -1;
 
 		// Parse the configuration section for the sub-object.
-		if (co_sub_parse_cfg(sub, cfg, section) == -1)
+		if (co_sub_parse_dcf(sub, dcf, sec) == -1)
 			return -1;
 	}
 
@@ -640,18 +834,18 @@ co_obj_parse_cfg(co_obj_t *obj, const config_t *cfg, const char *section)
 
 #if !LELY_NO_CO_OBJ_NAME
 static int
-co_obj_parse_names(co_obj_t *obj, const config_t *cfg)
+co_obj_parse_names(co_obj_t *obj, const struct co_dcf *dcf)
 {
 	assert(obj);
-	assert(cfg);
+	assert(dcf);
 
 	co_unsigned16_t idx = co_obj_get_idx(obj);
 
-	// Create the section name for the explicit names of the sub-objects.
-	char section[9];
-	snprintf(section, sizeof(section), "%XName", idx);
+	// Find the section with the explicit names of the sub-objects.
+	struct co_dcf_sec sec;
+	co_dcf_find(dcf, &sec, CO_DCF_NAME, idx, 0);
 
-	const char *val = config_get(cfg, section, "NrOfEntries");
+	const char *val = co_dcf_get(dcf, &sec, "NrOfEntries");
 	if (!val || !*val)
 		return 0;
 
@@ -660,7 +854,7 @@ co_obj_parse_names(co_obj_t *obj, const config_t *cfg)
 		char key[4];
 		snprintf(key, sizeof(key), "%u", (co_unsigned8_t)subidx);
 
-		val = config_get(cfg, section, key);
+		val = co_dcf_get(dcf, &sec, key);
 		if (val && *val) {
 			n--;
 			co_sub_t *sub = co_obj_find_sub(
@@ -680,20 +874,20 @@ co_obj_parse_names(co_obj_t *obj, const config_t *cfg)
 #endif // LELY_NO_CO_OBJ_NAME
 
 static int
-co_obj_parse_values(co_obj_t *obj, const config_t *cfg)
+co_obj_parse_values(co_obj_t *obj, const struct co_dcf *dcf)
 {
 	assert(obj);
-	assert(cfg);
+	assert(dcf);
 
 	co_unsigned8_t id = co_dev_get_id(co_obj_get_dev(obj));
 	co_unsigned16_t idx = co_obj_get_idx(obj);
 
-	// Create the section name for the explicit values of the sub-objects.
-	char section[10];
-	snprintf(section, sizeof(section), "%XValue", (co_unsigned16_t)idx);
-	struct floc at = { section, 0, 0 };
+	// Find the section with the explicit values of the sub-objects.
+	struct co_dcf_sec sec;
+	co_dcf_find(dcf, &sec, CO_DCF_VALUE, idx, 0);
+	struct floc at = { sec.name, 0, 0 };
 
-	const char *val = config_get(cfg, section, "NrOfEntries");
+	const char *val = co_dcf_get(dcf, &sec, "NrOfEntries");
 	if (!val || !*val)
 		return 0;
 
@@ -702,7 +896,7 @@ co_obj_parse_values(co_obj_t *obj, const config_t *cfg)
 		char key[4];
 		snprintf(key, sizeof(key), "%u", (co_unsigned8_t)subidx);
 
-		val = config_get(cfg, section, key);
+		val = co_dcf_get(dcf, &sec, key);
 		if (val && *val) {
 			n--;
 			co_sub_t *sub = co_obj_find_sub(
@@ -753,15 +947,17 @@ co_obj_build(co_dev_t *dev, co_unsigned16_t idx)
 }
 
 static int
-co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
+co_sub_parse_dcf(co_sub_t *sub, const struct co_dcf *dcf,
+		const struct co_dcf_sec *sec)
 {
 	assert(sub);
-	assert(cfg);
+	assert(dcf);
+	assert(sec);
 
 	int result = -1;
 
 	const char *val;
-	struct floc at = { section, 0, 0 };
+	struct floc at = { sec->name, 0, 0 };
 
 	co_unsigned8_t id = co_dev_get_id(co_obj_get_dev(co_sub_get_obj(sub)));
 	co_unsigned16_t type = co_sub_get_type(sub);
@@ -772,7 +968,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 #endif
 
 #if !LELY_NO_CO_OBJ_LIMITS
-	val = config_get(cfg, section, "LowLimit");
+	val = co_dcf_get(dcf, sec, "LowLimit");
 	if (val && *val) {
 		size_t chars = co_val_lex_id(val, NULL, &at);
 		if (chars) {
@@ -788,7 +984,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 			co_val_set_id(type, &sub->min, id);
 	}
 
-	val = config_get(cfg, section, "HighLimit");
+	val = co_dcf_get(dcf, sec, "HighLimit");
 	if (val && *val) {
 		size_t chars = co_val_lex_id(val, NULL, &at);
 		if (chars) {
@@ -806,7 +1002,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 #endif // LELY_NO_CO_OBJ_LIMITS
 
 	unsigned int access = co_sub_get_access(sub);
-	val = config_get(cfg, section, "AccessType");
+	val = co_dcf_get(dcf, sec, "AccessType");
 	if (val && *val) {
 		if (!strcasecmp(val, "ro")) {
 			access = CO_ACCESS_RO;
@@ -830,7 +1026,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 		goto error;
 	}
 
-	val = config_get(cfg, section, "DefaultValue");
+	val = co_dcf_get(dcf, sec, "DefaultValue");
 	if (val && *val) {
 		size_t chars = co_val_lex_id(val, NULL, &at);
 		if (chars) {
@@ -854,15 +1050,15 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 #endif
 	}
 
-	val = config_get(cfg, section, "PDOMapping");
+	val = co_dcf_get(dcf, sec, "PDOMapping");
 	if (val && *val)
 		co_sub_set_pdo_mapping(sub, strtoul(val, NULL, 0));
 
-	val = config_get(cfg, section, "ObjFlags");
+	val = co_dcf_get(dcf, sec, "ObjFlags");
 	if (val && *val)
 		sub->flags |= strtoul(val, NULL, 0);
 
-	val = config_get(cfg, section, "ParameterValue");
+	val = co_dcf_get(dcf, sec, "ParameterValue");
 	if (val && *val) {
 		sub->flags |= CO_OBJ_FLAGS_PARAMETER_VALUE;
 		size_t chars = co_val_lex_id(val, NULL, &at);
@@ -879,7 +1075,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 			co_val_set_id(type, sub->val, id);
 #if !LELY_NO_CO_OBJ_FILE
 	} else if (type == CO_DEFTYPE_DOMAIN
-			&& (val = config_get(cfg, section, "UploadFile"))
+			&& (val = co_dcf_get(dcf, sec, "UploadFile"))
 					!= NULL) {
 		if (!(access & CO_ACCESS_READ) || (access & CO_ACCESS_WRITE)) {
 			diag_at(DIAG_WARNING, 0, &at,
@@ -898,7 +1094,7 @@ co_sub_parse_cfg(co_sub_t *sub, const config_t *cfg, const char *section)
 			goto error;
 		}
 	} else if (type == CO_DEFTYPE_DOMAIN
-			&& (val = config_get(cfg, section, "DownloadFile"))
+			&& (val = co_dcf_get(dcf, sec, "DownloadFile"))
 					!= NULL) {
 		if ((access & CO_ACCESS_READ) || !(access & CO_ACCESS_WRITE)) {
 			diag_at(DIAG_WARNING, 0, &at,
@@ -1383,16 +1579,292 @@ co_val_set_id(co_unsigned16_t type, void *val, co_unsigned8_t id)
 	}
 }
 
+static int
+co_dcf_init(struct co_dcf *dcf, const char *begin, const char *end,
+		struct floc *at)
+{
+	assert(dcf);
+	assert(begin);
+
+	int errc = 0;
+
+	dcf->cfg = NULL;
+	membuf_init(&dcf->buf, NULL, 0);
+	dcf->sections = NULL;
+	dcf->nsections = 0;
+	dcf->keys = NULL;
+
+	struct membuf sections = MEMBUF_INIT;
+	struct membuf keys = MEMBUF_INIT;
+
+	// Unless the text contains escape sequences, the section names, keys
+	// and values, including their terminating null bytes, fit in a buffer
+	// the size of the text (plus the terminator of the last line).
+	size_t size = end ? (size_t)(end - begin) : strlen(begin);
+	if (!membuf_reserve(&dcf->buf, size + 2))
+		goto error;
+
+	// Keys preceding the first section belong to the unnamed root section.
+	if (co_dcf_add_section(&sections, &dcf->buf, "", 0) == -1)
+		goto error;
+
+	const char *cp = begin;
+	size_t chars = 0;
+
+	for (;;) {
+		// Skip comments and empty lines.
+		for (;;) {
+			cp += co_dcf_skip(cp, end, at);
+			if ((chars = lex_break(cp, end, at)) > 0)
+				cp += chars;
+			else
+				break;
+		}
+		if ((end && cp >= end) || !*cp)
+			break;
+
+		if ((chars = lex_char('[', cp, end, at)) > 0) {
+			cp += chars;
+			cp += co_dcf_skip(cp, end, at);
+			// clang-format off
+			if ((chars = lex_ctype(&co_dcf_issection, cp, end, at))
+					> 0) {
+				// clang-format on
+				if (co_dcf_add_section(&sections, &dcf->buf, cp,
+						    chars)
+						== -1)
+					goto error;
+				cp += chars;
+				cp += co_dcf_skip(cp, end, at);
+				if ((chars = lex_char(']', cp, end, at)) > 0)
+					cp += chars;
+				else
+					diag_if(DIAG_ERROR, 0, at,
+							"expected ']' after section name");
+			} else {
+				diag_if(DIAG_ERROR, 0, at,
+						"expected section name after '['");
+			}
+			cp += lex_line_comment(NULL, cp, end, at);
+		} else if ((chars = lex_ctype(&co_dcf_iskey, cp, end, at))
+				> 0) {
+			size_t key = 0;
+			if (co_dcf_add_str(&dcf->buf, cp, chars, &key) == -1)
+				goto error;
+			cp += chars;
+			cp += co_dcf_skip(cp, end, at);
+			if ((chars = lex_char('=', cp, end, at)) > 0) {
+				cp += chars;
+				cp += co_dcf_skip(cp, end, at);
+				size_t val = membuf_size(&dcf->buf);
+				if ((chars = lex_char('\"', cp, end, at)) > 0) {
+					cp += chars;
+					size_t n = 0;
+					lex_c99_str(cp, end, at, NULL, &n);
+					if (!membuf_reserve(&dcf->buf, n + 1))
+						goto error;
+					char *s = membuf_alloc(&dcf->buf, &n);
+					cp += lex_c99_str(cp, end, NULL, s, &n);
+					membuf_write(&dcf->buf, "", 1);
+					// clang-format off
+					if ((chars = lex_char('\"', cp, end,
+							at)) > 0)
+						// clang-format on
+						cp += chars;
+					else
+						diag_if(DIAG_ERROR, 0, at,
+								"expected '\"' after string");
+				} else {
+					chars = lex_ctype(&co_dcf_isvalue, cp,
+							end, at);
+					// clang-format off
+					if (co_dcf_add_str(&dcf->buf, cp, chars,
+							&val) == -1)
+						// clang-format on
+						goto error;
+					cp += chars;
+				}
+				// clang-format off
+				if (co_dcf_add_key(&sections, &keys, key, val)
+						== -1)
+					// clang-format on
+					goto error;
+			} else {
+				// Discard the key.
+				size_t n = membuf_size(&dcf->buf) - key;
+				membuf_seek(&dcf->buf, -(ptrdiff_t)n);
+				diag_if(DIAG_ERROR, 0, at,
+						"expected '=' after key");
+			}
+			cp += lex_line_comment(NULL, cp, end, at);
+		} else {
+			if (isgraph((unsigned char)*cp))
+				diag_if(DIAG_ERROR, 0, at,
+						"unknown character '%c'", *cp);
+			else
+				diag_if(DIAG_ERROR, 0, at,
+						"unknown character '\\%o'",
+						*cp);
+			// Skip the offending character.
+			cp += lex_char(*cp, cp, end, at);
+		}
+	}
+
+	if (co_dcf_sort(dcf, &sections, &keys) == -1)
+		goto error;
+
+	membuf_fini(&keys);
+	membuf_fini(&sections);
+
+	return 0;
+
+error:
+	errc = get_errc();
+	membuf_fini(&keys);
+	membuf_fini(&sections);
+	co_dcf_fini(dcf);
+	set_errc(errc);
+	return -1;
+}
+
+static void
+co_dcf_fini(struct co_dcf *dcf)
+{
+	assert(dcf);
+	assert(!dcf->cfg);
+
+	free(dcf->keys);
+	free(dcf->sections);
+	membuf_fini(&dcf->buf);
+}
+
+static void
+co_dcf_find_name(const struct co_dcf *dcf, struct co_dcf_sec *sec,
+		const char *name)
+{
+	assert(dcf);
+	assert(sec);
+	assert(name);
+
+	sec->name = name;
+	sec->keys = NULL;
+	sec->nkeys = 0;
+
+	if (dcf->cfg)
+		return;
+
+	size_t i = co_dcf_lower_bound(dcf, CO_DCF_ID_NONE, name);
+	if (i < dcf->nsections && dcf->sections[i].id == CO_DCF_ID_NONE
+			&& !strcasecmp(dcf->sections[i].name, name)) {
+		sec->keys = dcf->sections[i].keys;
+		sec->nkeys = dcf->sections[i].nkeys;
+	}
+}
+
+static void
+co_dcf_find(const struct co_dcf *dcf, struct co_dcf_sec *sec, int kind,
+		co_unsigned16_t idx, co_unsigned8_t subidx)
+{
+	assert(dcf);
+	assert(sec);
+
+	sec->name = sec->buf;
+	sec->keys = NULL;
+	sec->nkeys = 0;
+
+	if (!dcf->cfg) {
+		uint_least32_t id = CO_DCF_ID(kind, idx, subidx);
+		size_t i = co_dcf_lower_bound(dcf, id, NULL);
+		if (i < dcf->nsections && dcf->sections[i].id == id) {
+			sec->name = dcf->sections[i].name;
+			sec->keys = dcf->sections[i].keys;
+			sec->nkeys = dcf->sections[i].nkeys;
+			return;
+		}
+	}
+
+	switch (kind) {
+	case CO_DCF_OBJ: snprintf(sec->buf, sizeof(sec->buf), "%X", idx); break;
+	case CO_DCF_SUB:
+		snprintf(sec->buf, sizeof(sec->buf), "%Xsub%X", idx, subidx);
+		break;
+	case CO_DCF_NAME:
+		snprintf(sec->buf, sizeof(sec->buf), "%XName", idx);
+		break;
+	case CO_DCF_VALUE:
+		snprintf(sec->buf, sizeof(sec->buf), "%XValue", idx);
+		break;
+	default: *sec->buf = '\0'; break;
+	}
+}
+
+static size_t
+co_dcf_find_sub(const struct co_dcf *dcf, struct co_dcf_sec *sec,
+		co_unsigned16_t idx, size_t subidx)
+{
+	assert(dcf);
+	assert(sec);
+
+	if (subidx >= 0xff)
+		return 0xff;
+
+	if (!dcf->cfg) {
+		// The sub-object sections of an object are adjacent, so we can
+		// skip to the next one instead of trying every sub-index.
+		size_t i = co_dcf_lower_bound(dcf,
+				CO_DCF_ID(CO_DCF_SUB, idx, subidx), NULL);
+		if (i >= dcf->nsections
+				|| dcf->sections[i].id
+						> CO_DCF_ID(CO_DCF_SUB, idx, 0xfe))
+			return 0xff;
+		subidx = dcf->sections[i].id & 0xff;
+	}
+
+	co_dcf_find(dcf, sec, CO_DCF_SUB, idx, (co_unsigned8_t)subidx);
+
+	return subidx;
+}
+
+static const char *
+co_dcf_get(const struct co_dcf *dcf, const struct co_dcf_sec *sec,
+		const char *key)
+{
+	assert(dcf);
+	assert(sec);
+	assert(key);
+
+	if (dcf->cfg)
+		return config_get(dcf->cfg, sec->name, key);
+
+	// Find the last occurrence of the key, since later values override
+	// earlier ones.
+	size_t lo = 0;
+	size_t hi = sec->nkeys;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (strcasecmp(key, sec->keys[mid].key) < 0)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	if (!lo || strcasecmp(key, sec->keys[lo - 1].key))
+		return NULL;
+	return sec->keys[lo - 1].val;
+}
+
 static co_unsigned16_t
-config_get_idx(const config_t *cfg, const char *section, co_unsigned16_t maxidx,
-		co_unsigned16_t *idx)
+co_dcf_get_idx(const struct co_dcf *dcf, const char *section,
+		co_unsigned16_t maxidx, co_unsigned16_t *idx)
 {
-	assert(cfg);
+	assert(dcf);
 
 	if (!idx)
 		maxidx = 0;
 
-	const char *val = config_get(cfg, section, "SupportedObjects");
+	struct co_dcf_sec sec;
+	co_dcf_find_name(dcf, &sec, section);
+
+	const char *val = co_dcf_get(dcf, &sec, "SupportedObjects");
 	if (!val || !*val)
 		return 0;
 
@@ -1401,7 +1873,7 @@ config_get_idx(const config_t *cfg, const char *section, co_unsigned16_t maxidx,
 		char key[6];
 		snprintf(key, sizeof(key), "%u", (co_unsigned16_t)(i + 1));
 
-		val = config_get(cfg, section, key);
+		val = co_dcf_get(dcf, &sec, key);
 		// clang-format off
 		idx[i] = val && *val
 				? (co_unsigned16_t)strtoul(val, NULL, 0) : 0;
@@ -1411,4 +1883,306 @@ config_get_idx(const config_t *cfg, const char *section, co_unsigned16_t maxidx,
 	return n;
 }
 
+static int
+co_dcf_add_section(struct membuf *sections, struct membuf *buf, const char *s,
+		size_t n)
+{
+	assert(sections);
+
+	struct co_dcf_lex_section section = { .nkeys = 0, .rank = 0 };
+	if (co_dcf_add_str(buf, s, n, &section.name) == -1)
+		return -1;
+
+	if (!membuf_reserve(sections, sizeof(section)))
+		return -1;
+	membuf_write(sections, &section, sizeof(section));
+
+	return 0;
+}
+
+static int
+co_dcf_add_key(struct membuf *sections, struct membuf *keys, size_t key,
+		size_t val)
+{
+	assert(sections);
+	assert(membuf_size(sections) >= sizeof(struct co_dcf_lex_section));
+	assert(keys);
+
+	// Keys belong to the most recent section.
+	struct co_dcf_lex_section *begin = membuf_begin(sections);
+	size_t n = membuf_size(sections) / sizeof(*begin);
+	struct co_dcf_lex_key lkey = { .section = n - 1, .key = key, .val = val };
+
+	if (!membuf_reserve(keys, sizeof(lkey)))
+		return -1;
+	membuf_write(keys, &lkey, sizeof(lkey));
+	begin[n - 1].nkeys++;
+
+	return 0;
+}
+
+static int
+co_dcf_add_str(struct membuf *buf, const char *s, size_t n, size_t *poff)
+{
+	assert(buf);
+	assert(s || !n);
+	assert(poff);
+
+	// Remove trailing whitespace.
+	while (n && isspace((unsigned char)s[n - 1]))
+		n--;
+
+	if (!membuf_reserve(buf, n + 1))
+		return -1;
+	// Store the offset instead of a pointer, since the buffer may still
+	// be reallocated.
+	*poff = membuf_size(buf);
+	membuf_write(buf, s, n);
+	membuf_write(buf, "", 1);
+
+	return 0;
+}
+
+static int
+co_dcf_sort(struct co_dcf *dcf, struct membuf *sections,
+		const struct membuf *keys)
+{
+	assert(dcf);
+	assert(sections);
+	assert(keys);
+
+	const char *buf = membuf_begin(&dcf->buf);
+	struct co_dcf_lex_section *lsec = membuf_begin(sections);
+	size_t nlsec = membuf_size(sections) / sizeof(*lsec);
+	assert(nlsec);
+	const struct co_dcf_lex_key *lkey = membuf_begin(keys);
+	size_t nkeys = membuf_size(keys) / sizeof(*lkey);
+
+	struct co_dcf_section *tmp = malloc(nlsec * sizeof(*tmp));
+	if (!tmp) {
+		set_errc_from_errno();
+		goto error_alloc_tmp;
+	}
+
+	struct co_dcf_section **order = malloc(nlsec * sizeof(*order));
+	if (!order) {
+		set_errc_from_errno();
+		goto error_alloc_order;
+	}
+
+	dcf->sections = malloc(nlsec * sizeof(*dcf->sections));
+	if (!dcf->sections) {
+		set_errc_from_errno();
+		goto error_alloc_sections;
+	}
+
+	dcf->keys = malloc(MAX(nkeys, 1) * sizeof(*dcf->keys));
+	if (!dcf->keys) {
+		set_errc_from_errno();
+		goto error_alloc_keys;
+	}
+
+	// Sort the sections by identifier and name.
+	for (size_t i = 0; i < nlsec; i++) {
+		const char *name = buf + lsec[i].name;
+		tmp[i] = (struct co_dcf_section){ .name = name,
+			.id = co_dcf_section_id(name),
+			.keys = NULL,
+			.nkeys = lsec[i].nkeys };
+		order[i] = &tmp[i];
+	}
+	qsort(order, nlsec, sizeof(*order), &co_dcf_section_ptr_cmp);
+
+	// Merge the sections that occur more than once.
+	size_t n = 0;
+	for (size_t i = 0; i < nlsec; i++) {
+		if (n && !co_dcf_section_cmp(&dcf->sections[n - 1], order[i]))
+			dcf->sections[n - 1].nkeys += order[i]->nkeys;
+		else
+			dcf->sections[n++] = *order[i];
+		lsec[order[i] - tmp].rank = n - 1;
+	}
+	dcf->nsections = n;
+
+	// Distribute the keys over the sections. This preserves the order in
+	// which duplicate keys occur in the file.
+	struct co_dcf_key *key = dcf->keys;
+	for (size_t i = 0; i < n; i++) {
+		dcf->sections[i].keys = key;
+		key += dcf->sections[i].nkeys;
+		dcf->sections[i].nkeys = 0;
+	}
+	for (size_t i = 0; i < nkeys; i++) {
+		struct co_dcf_section *section =
+				&dcf->sections[lsec[lkey[i].section].rank];
+		section->keys[section->nkeys++] = (struct co_dcf_key){
+			.key = buf + lkey[i].key, .val = buf + lkey[i].val
+		};
+	}
+
+	// Sort the keys in each section.
+	for (size_t i = 0; i < n; i++)
+		qsort(dcf->sections[i].keys, dcf->sections[i].nkeys,
+				sizeof(struct co_dcf_key), &co_dcf_key_cmp);
+
+	free(order);
+	free(tmp);
+
+	return 0;
+
+error_alloc_keys:
+	free(dcf->sections);
+	dcf->sections = NULL;
+error_alloc_sections:
+	free(order);
+error_alloc_order:
+	free(tmp);
+error_alloc_tmp:
+	return -1;
+}
+
+static size_t
+co_dcf_skip(const char *begin, const char *end, struct floc *at)
+{
+	assert(begin);
+
+	const char *cp = begin;
+
+	cp += lex_ctype(&isblank, cp, end, at);
+	cp += lex_line_comment("#", cp, end, at);
+	cp += lex_line_comment(";", cp, end, at);
+
+	return cp - begin;
+}
+
+static uint_least32_t
+co_dcf_section_id(const char *name)
+{
+	assert(name);
+
+	// Only accept names as they would be printed by co_dcf_find(), since
+	// only those are found by a configuration struct.
+	co_unsigned16_t idx = 0;
+	size_t chars = co_dcf_lex_hex(name, 4, &idx);
+	if (!chars)
+		return CO_DCF_ID_NONE;
+	name += chars;
+
+	if (!*name)
+		return CO_DCF_ID(CO_DCF_OBJ, idx, 0);
+	if (!strncasecmp(name, "sub", 3)) {
+		co_unsigned16_t subidx = 0;
+		chars = co_dcf_lex_hex(name + 3, 2, &subidx);
+		if (chars && !name[3 + chars])
+			return CO_DCF_ID(CO_DCF_SUB, idx, subidx);
+	} else if (!strcasecmp(name, "Name")) {
+		return CO_DCF_ID(CO_DCF_NAME, idx, 0);
+	} else if (!strcasecmp(name, "Value")) {
+		return CO_DCF_ID(CO_DCF_VALUE, idx, 0);
+	}
+
+	return CO_DCF_ID_NONE;
+}
+
+static size_t
+co_dcf_lex_hex(const char *s, size_t n, co_unsigned16_t *pval)
+{
+	assert(s);
+	assert(pval);
+
+	// Leading zeros are not allowed.
+	if (*s == '0' && isxdigit((unsigned char)s[1]))
+		return 0;
+
+	size_t chars = 0;
+	co_unsigned16_t val = 0;
+	for (; chars < n && isxdigit((unsigned char)s[chars]); chars++)
+		val = (val << 4) | ctox((unsigned char)s[chars]);
+	if (chars == n && isxdigit((unsigned char)s[chars]))
+		return 0;
+
+	*pval = val;
+	return chars;
+}
+
+static size_t
+co_dcf_lower_bound(const struct co_dcf *dcf, uint_least32_t id,
+		const char *name)
+{
+	assert(dcf);
+
+	const struct co_dcf_section key = { .name = name, .id = id };
+
+	size_t lo = 0;
+	size_t hi = dcf->nsections;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (co_dcf_section_cmp(&dcf->sections[mid], &key) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return lo;
+}
+
+static int
+co_dcf_section_cmp(const void *p1, const void *p2)
+{
+	assert(p1);
+	const struct co_dcf_section *s1 = p1;
+	assert(p2);
+	const struct co_dcf_section *s2 = p2;
+
+	if (s1->id != s2->id)
+		return s1->id < s2->id ? -1 : 1;
+	// Sections whose name is not an object index are sorted by name.
+	if (s1->id == CO_DCF_ID_NONE)
+		return strcasecmp(s1->name, s2->name);
+	return 0;
+}
+
+static int
+co_dcf_section_ptr_cmp(const void *p1, const void *p2)
+{
+	assert(p1);
+	assert(p2);
+
+	return co_dcf_section_cmp(*(const struct co_dcf_section *const *)p1,
+			*(const struct co_dcf_section *const *)p2);
+}
+
+static int
+co_dcf_key_cmp(const void *p1, const void *p2)
+{
+	assert(p1);
+	const struct co_dcf_key *k1 = p1;
+	assert(p2);
+	const struct co_dcf_key *k2 = p2;
+
+	int cmp = strcasecmp(k1->key, k2->key);
+	// Duplicate keys are sorted in the order in which they occur in the
+	// file, which is also the order of their names in the string buffer.
+	if (!cmp)
+		cmp = (k1->key > k2->key) - (k1->key < k2->key);
+	return cmp;
+}
+
+static int
+co_dcf_issection(int c)
+{
+	return isgraph(c) && c != '#' && c != ';' && c != '[' && c != ']';
+}
+
+static int
+co_dcf_iskey(int c)
+{
+	return isgraph(c) && c != '#' && c != ';' && c != '=';
+}
+
+static int
+co_dcf_isvalue(int c)
+{
+	return isprint(c) && c != '#' && c != ';';
+}
+
 #endif // !LELY_NO_CO_DCF
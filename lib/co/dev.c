@@ -26,6 +26,7 @@
 #include <lely/co/detail/obj.h>
 #include <lely/util/cmp.h>
 #include <lely/util/diag.h>
+#include <lely/util/util.h>
 #if !LELY_NO_CO_TPDO
 #include <lely/co/pdo.h>
 #endif
@@ -33,6 +34,7 @@
 #include <assert.h>
 #if !LELY_NO_MALLOC
 #include <stdlib.h>
+#include <string.h>
 #endif
 
 static void co_obj_set_id(
@@ -42,6 +44,39 @@ static void co_sub_set_id(
 static void co_val_set_id(co_unsigned16_t type, void *val,
 		co_unsigned8_t new_id, co_unsigned8_t old_id);
 
+/// Finds an object in a frozen object dictionary. @see co_dev_freeze()
+static co_obj_t *co_dev_frozen_find_obj(
+		const co_dev_t *dev, co_unsigned16_t idx);
+#if !LELY_NO_MALLOC
+/**
+ * Moves the values of the sub-objects of a CANopen object to the memory block
+ * at <b>val</b>, which MUST be at least `obj->size` bytes and suitably aligned.
+ * The old memory block is not freed.
+ */
+static void co_obj_move_val(co_obj_t *obj, void *val);
+#endif
+
+#if !LELY_NO_CO_TPDO
+/**
+ * Invokes the Transmit-PDO event indication function for every valid, acyclic
+ * or event-driven TPDO into which the specified sub-object is mapped, by
+ * scanning all TPDO communication and mapping parameters.
+ */
+static void co_dev_tpdo_event_scan(
+		co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx);
+#if !LELY_NO_MALLOC
+/**
+ * Rebuilds the reverse index from mapped sub-objects to valid, acyclic or
+ * event-driven Transmit-PDOs.
+ *
+ * @returns 0 on success, or -1 on error.
+ */
+static int co_dev_tpdo_update(co_dev_t *dev);
+/// Compares two entries in the reverse index of Transmit-PDOs.
+static int co_dev_tpdo_ent_cmp(const void *p1, const void *p2);
+#endif
+#endif
+
 #if !LELY_NO_MALLOC
 
 void *
@@ -76,6 +111,17 @@ co_dev_init(co_dev_t *dev, co_unsigned8_t id)
 
 	rbtree_init(&dev->tree, &uint16_cmp);
 
+	dev->frozen = 0;
+	dev->frozen_obj = NULL;
+	dev->frozen_idx = NULL;
+	dev->frozen_nobj = 0;
+	dev->frozen_sub = NULL;
+	dev->frozen_key = NULL;
+	dev->frozen_nsub = 0;
+#if !LELY_NO_MALLOC
+	dev->frozen_buf = NULL;
+#endif
+
 #if !LELY_NO_CO_OBJ_NAME
 	dev->name = NULL;
 
@@ -101,6 +147,14 @@ co_dev_init(co_dev_t *dev, co_unsigned8_t id)
 #if !LELY_NO_CO_TPDO
 	dev->tpdo_event_ind = NULL;
 	dev->tpdo_event_data = NULL;
+#if !LELY_NO_MALLOC
+	dev->tpdo_ent = NULL;
+	dev->tpdo_nent = 0;
+	dev->tpdo_dirty = 1;
+#endif
+#endif
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+	dev->pdo_comm_gen = 0;
 #endif
 
 	return dev;
@@ -113,9 +167,20 @@ co_dev_fini(co_dev_t *dev)
 #if LELY_NO_MALLOC
 	(void)dev;
 #else
+	if (dev->frozen) {
+		// The values of the objects are stored in the frozen memory
+		// block. They are moved out, if necessary, when the sub-objects
+		// are destroyed, after which the block can be freed.
+		rbtree_foreach (&dev->tree, node)
+			structof(node, co_obj_t, node)->val = NULL;
+		dev->frozen = 0;
+	}
+
 	rbtree_foreach (&dev->tree, node)
 		co_obj_destroy(structof(node, co_obj_t, node));
 
+	free(dev->frozen_buf);
+
 #if !LELY_NO_CO_OBJ_NAME
 	free(dev->vendor_name);
 	free(dev->product_name);
@@ -123,6 +188,10 @@ co_dev_fini(co_dev_t *dev)
 
 	free(dev->name);
 #endif
+
+#if !LELY_NO_CO_TPDO
+	free(dev->tpdo_ent);
+#endif
 #endif // LELY_NO_MALLOC
 }
 
@@ -222,6 +291,13 @@ co_dev_get_idx(const co_dev_t *dev, co_unsigned16_t maxidx,
 	if (!idx)
 		maxidx = 0;
 
+	if (dev->frozen) {
+		maxidx = MIN(maxidx, dev->frozen_nobj);
+		if (maxidx)
+			memcpy(idx, dev->frozen_idx, maxidx * sizeof(*idx));
+		return (co_unsigned16_t)dev->frozen_nobj;
+	}
+
 	if (maxidx) {
 		struct rbnode *node = rbtree_first(&dev->tree);
 		for (size_t i = 0; node && i < maxidx;
@@ -244,12 +320,21 @@ co_dev_insert_obj(co_dev_t *dev, co_obj_t *obj)
 	if (obj->dev == dev)
 		return 0;
 
+	if (dev->frozen) {
+		set_errnum(ERRNUM_PERM);
+		return -1;
+	}
+
 	if (rbtree_find(&dev->tree, obj->node.key))
 		return -1;
 
 	obj->dev = dev;
 	rbtree_insert(&obj->dev->tree, &obj->node);
 
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+	co_dev_tpdo_invalidate(dev, obj->idx);
+#endif
+
 	return 0;
 }
 
@@ -262,10 +347,19 @@ co_dev_remove_obj(co_dev_t *dev, co_obj_t *obj)
 	if (obj->dev != dev)
 		return -1;
 
+	if (dev->frozen) {
+		set_errnum(ERRNUM_PERM);
+		return -1;
+	}
+
 	rbtree_remove(&obj->dev->tree, &obj->node);
 	rbnode_init(&obj->node, &obj->idx);
 	obj->dev = NULL;
 
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+	co_dev_tpdo_invalidate(dev, obj->idx);
+#endif
+
 	return 0;
 }
 
@@ -274,6 +368,9 @@ co_dev_find_obj(const co_dev_t *dev, co_unsigned16_t idx)
 {
 	assert(dev);
 
+	if (dev->frozen)
+		return co_dev_frozen_find_obj(dev, idx);
+
 	struct rbnode *node = rbtree_find(&dev->tree, &idx);
 	if (!node)
 		return NULL;
@@ -283,10 +380,152 @@ co_dev_find_obj(const co_dev_t *dev, co_unsigned16_t idx)
 co_sub_t *
 co_dev_find_sub(const co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx)
 {
+	assert(dev);
+
+	if (dev->frozen)
+		return co_dev_frozen_find_sub(dev, idx, subidx);
+
 	co_obj_t *obj = co_dev_find_obj(dev, idx);
 	return obj ? co_obj_find_sub(obj, subidx) : NULL;
 }
 
+#if !LELY_NO_MALLOC
+
+int
+co_dev_freeze(co_dev_t *dev)
+{
+	assert(dev);
+
+	if (dev->frozen)
+		return 0;
+
+	size_t nobj = 0;
+	size_t nsub = 0;
+	size_t size = 0;
+	rbtree_foreach (&dev->tree, node) {
+		co_obj_t *obj = structof(node, co_obj_t, node);
+		nobj++;
+		nsub += rbtree_size(&obj->tree);
+		size = ALIGN(size, _Alignof(union co_val)) + obj->size;
+	}
+
+	// Allocate the sorted arrays and the values in a single block, with the
+	// arrays of pointers first to guarantee proper alignment.
+	size_t off_sub = nobj * sizeof(co_obj_t *);
+	size_t off_key = off_sub + nsub * sizeof(co_sub_t *);
+	size_t off_idx = off_key + nsub * sizeof(co_unsigned32_t);
+	size_t off_val = ALIGN(off_idx + nobj * sizeof(co_unsigned16_t),
+			_Alignof(union co_val));
+	char *buf = NULL;
+	if (off_val + size) {
+		buf = malloc(off_val + size);
+		if (!buf) {
+			set_errc_from_errno();
+			return -1;
+		}
+	}
+
+	co_obj_t **objs = (co_obj_t **)buf;
+	co_unsigned16_t *idx = (co_unsigned16_t *)(buf + off_idx);
+	co_sub_t **subs = (co_sub_t **)(buf + off_sub);
+	co_unsigned32_t *keys = (co_unsigned32_t *)(buf + off_key);
+
+	// The trees are already sorted, so the arrays are filled in order.
+	size_t i = 0;
+	size_t j = 0;
+	size_t off = off_val;
+	rbtree_foreach (&dev->tree, node) {
+		co_obj_t *obj = structof(node, co_obj_t, node);
+		objs[i] = obj;
+		idx[i] = obj->idx;
+		i++;
+		rbtree_foreach (&obj->tree, node) {
+			co_sub_t *sub = structof(node, co_sub_t, node);
+			subs[j] = sub;
+			keys[j] = ((co_unsigned32_t)obj->idx << 8)
+					| sub->subidx;
+			j++;
+		}
+		off = ALIGN(off, _Alignof(union co_val));
+		void *val = obj->val;
+		co_obj_move_val(obj, obj->size ? buf + off : NULL);
+		free(val);
+		off += obj->size;
+	}
+
+	dev->frozen_obj = objs;
+	dev->frozen_idx = idx;
+	dev->frozen_nobj = nobj;
+	dev->frozen_sub = subs;
+	dev->frozen_key = keys;
+	dev->frozen_nsub = nsub;
+	dev->frozen_buf = buf;
+
+	dev->frozen = 1;
+
+	return 0;
+}
+
+int
+co_dev_thaw(co_dev_t *dev)
+{
+	assert(dev);
+
+	if (!dev->frozen)
+		return 0;
+
+	// Allocate the new values of all objects before modifying any of them,
+	// so the object dictionary remains frozen on error.
+	size_t nobj = dev->frozen_nobj;
+	void **val = NULL;
+	if (nobj) {
+		val = calloc(nobj, sizeof(*val));
+		if (!val)
+			goto error_alloc_val;
+	}
+	for (size_t i = 0; i < nobj; i++) {
+		size_t size = dev->frozen_obj[i]->size;
+		if (size && !(val[i] = malloc(size)))
+			goto error_alloc_val;
+	}
+
+	for (size_t i = 0; i < nobj; i++)
+		co_obj_move_val(dev->frozen_obj[i], val[i]);
+	free(val);
+
+	free(dev->frozen_buf);
+	dev->frozen_obj = NULL;
+	dev->frozen_idx = NULL;
+	dev->frozen_nobj = 0;
+	dev->frozen_sub = NULL;
+	dev->frozen_key = NULL;
+	dev->frozen_nsub = 0;
+	dev->frozen_buf = NULL;
+
+	dev->frozen = 0;
+
+	return 0;
+
+error_alloc_val:
+	set_errc_from_errno();
+	if (val) {
+		for (size_t i = 0; i < nobj; i++)
+			free(val[i]);
+		free(val);
+	}
+	return -1;
+}
+
+#endif // !LELY_NO_MALLOC
+
+int
+co_dev_is_frozen(const co_dev_t *dev)
+{
+	assert(dev);
+
+	return dev->frozen;
+}
+
 co_obj_t *
 co_dev_first_obj(const co_dev_t *dev)
 {
@@ -850,44 +1089,84 @@ co_dev_tpdo_event(co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx)
 	if (co_dev_chk_tpdo(dev, idx, subidx))
 		return;
 
-	const co_obj_t *obj_1800 = NULL;
-	// Find the first TPDO.
-	for (co_unsigned16_t i = 0; i < CO_NUM_PDOS && !obj_1800; i++)
-		obj_1800 = co_dev_find_obj(dev, 0x1800 + i);
-	for (; obj_1800; obj_1800 = co_obj_next(obj_1800)) {
-		co_unsigned16_t i = co_obj_get_idx(obj_1800) - 0x1800;
-		if (i >= CO_NUM_PDOS)
-			break;
-		// Check if this is a valid acyclic or event-driven PDO.
-		const struct co_pdo_comm_par *comm =
-				co_obj_addressof_val(obj_1800);
-		assert(comm);
-		if (comm->n < 2 || (comm->cobid & CO_PDO_COBID_VALID)
-				|| !(!comm->trans || comm->trans >= 0xfe))
-			continue;
-		// Check if the sub-object is mapped into this PDO.
-		const co_obj_t *obj_1a00 = co_dev_find_obj(dev, 0x1a00 + i);
-		if (!obj_1a00)
-			continue;
-		const struct co_pdo_map_par *map =
-				co_obj_addressof_val(obj_1a00);
-		assert(map);
-		for (size_t j = 0; j < map->n; j++) {
-			if (((map->map[j] >> 16) & 0xffff) != idx)
-				continue;
-			if (((map->map[j] >> 8) & 0xff) != subidx)
-				continue;
-			// Issue a single indication for this PDO.
-			if (dev->tpdo_event_ind)
-				dev->tpdo_event_ind(
-						i + 1, dev->tpdo_event_data);
-			break;
-		}
+	if (!dev->tpdo_event_ind)
+		return;
+
+#if LELY_NO_MALLOC
+	co_dev_tpdo_event_scan(dev, idx, subidx);
+#else
+	// Fall back to scanning the TPDO parameters if the reverse index
+	// cannot be rebuilt.
+	if (dev->tpdo_dirty && co_dev_tpdo_update(dev) == -1) {
+		co_dev_tpdo_event_scan(dev, idx, subidx);
+		return;
+	}
+
+	// Find the first entry for the sub-object with a binary search. The
+	// entries for the same sub-object are sorted by PDO number and unique.
+	co_unsigned32_t key = ((co_unsigned32_t)idx << 8) | subidx;
+	size_t lo = 0;
+	size_t hi = dev->tpdo_nent;
+	while (lo < hi) {
+		size_t mid = lo + (hi - lo) / 2;
+		if (dev->tpdo_ent[mid].key < key)
+			lo = mid + 1;
+		else
+			hi = mid;
 	}
+	// Issue a single indication for every matching PDO. The index is
+	// accessed through the device, in case it is rebuilt by a recursive
+	// event from the indication function.
+	for (; lo < dev->tpdo_nent && dev->tpdo_ent[lo].key == key; lo++) {
+		co_unsigned16_t num = dev->tpdo_ent[lo].num;
+		dev->tpdo_event_ind(num, dev->tpdo_event_data);
+	}
+#endif
 }
 
 #endif // !LELY_NO_CO_TPDO
 
+static co_obj_t *
+co_dev_frozen_find_obj(const co_dev_t *dev, co_unsigned16_t idx)
+{
+	assert(dev);
+	assert(dev->frozen);
+
+	const co_unsigned16_t *keys = dev->frozen_idx;
+	size_t n = dev->frozen_nobj;
+	if (!n)
+		return NULL;
+	size_t i = 0;
+	while (n > 1) {
+		size_t half = n / 2;
+		i = keys[i + half] <= idx ? i + half : i;
+		n -= half;
+	}
+	return keys[i] == idx ? dev->frozen_obj[i] : NULL;
+}
+
+#if !LELY_NO_MALLOC
+
+static void
+co_obj_move_val(co_obj_t *obj, void *val)
+{
+	assert(obj);
+
+	if (obj->size)
+		memcpy(val, obj->val, obj->size);
+	// The offsets of the values of the sub-objects do not change. Values
+	// containing pointers (strings and domains) are moved bitwise.
+	rbtree_foreach (&obj->tree, node) {
+		co_sub_t *sub = structof(node, co_sub_t, node);
+		if (sub->val)
+			sub->val = (char *)val
+					+ ((char *)sub->val - (char *)obj->val);
+	}
+	obj->val = val;
+}
+
+#endif // !LELY_NO_MALLOC
+
 static void
 co_obj_set_id(co_obj_t *obj, co_unsigned8_t new_id, co_unsigned8_t old_id)
 {
@@ -934,3 +1213,131 @@ co_val_set_id(co_unsigned16_t type, void *val, co_unsigned8_t new_id,
 #undef LELY_CO_DEFINE_TYPE
 	}
 }
+
+#if !LELY_NO_CO_TPDO
+
+static void
+co_dev_tpdo_event_scan(
+		co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx)
+{
+	assert(dev);
+	assert(dev->tpdo_event_ind);
+
+	const co_obj_t *obj_1800 = NULL;
+	// Find the first TPDO.
+	for (co_unsigned16_t i = 0; i < CO_NUM_PDOS && !obj_1800; i++)
+		obj_1800 = co_dev_find_obj(dev, 0x1800 + i);
+	for (; obj_1800; obj_1800 = co_obj_next(obj_1800)) {
+		co_unsigned16_t i = co_obj_get_idx(obj_1800) - 0x1800;
+		if (i >= CO_NUM_PDOS)
+			break;
+		// Check if this is a valid acyclic or event-driven PDO.
+		const struct co_pdo_comm_par *comm =
+				co_obj_addressof_val(obj_1800);
+		assert(comm);
+		if (comm->n < 2 || (comm->cobid & CO_PDO_COBID_VALID)
+				|| !(!comm->trans || comm->trans >= 0xfe))
+			continue;
+		// Check if the sub-object is mapped into this PDO.
+		const co_obj_t *obj_1a00 = co_dev_find_obj(dev, 0x1a00 + i);
+		if (!obj_1a00)
+			continue;
+		const struct co_pdo_map_par *map =
+				co_obj_addressof_val(obj_1a00);
+		assert(map);
+		for (size_t j = 0; j < map->n; j++) {
+			if (((map->map[j] >> 16) & 0xffff) != idx)
+				continue;
+			if (((map->map[j] >> 8) & 0xff) != subidx)
+				continue;
+			// Issue a single indication for this PDO.
+			dev->tpdo_event_ind(i + 1, dev->tpdo_event_data);
+			break;
+		}
+	}
+}
+
+#if !LELY_NO_MALLOC
+
+static int
+co_dev_tpdo_update(co_dev_t *dev)
+{
+	assert(dev);
+
+	struct co_dev_tpdo_ent *ent = NULL;
+	size_t nent = 0;
+
+	const co_obj_t *obj_1800 = NULL;
+	// Find the first TPDO.
+	for (co_unsigned16_t i = 0; i < CO_NUM_PDOS && !obj_1800; i++)
+		obj_1800 = co_dev_find_obj(dev, 0x1800 + i);
+	for (; obj_1800; obj_1800 = co_obj_next(obj_1800)) {
+		co_unsigned16_t i = co_obj_get_idx(obj_1800) - 0x1800;
+		if (i >= CO_NUM_PDOS)
+			break;
+		// Only valid acyclic or event-driven PDOs are indexed.
+		const struct co_pdo_comm_par *comm =
+				co_obj_addressof_val(obj_1800);
+		assert(comm);
+		if (comm->n < 2 || (comm->cobid & CO_PDO_COBID_VALID)
+				|| !(!comm->trans || comm->trans >= 0xfe))
+			continue;
+		const co_obj_t *obj_1a00 = co_dev_find_obj(dev, 0x1a00 + i);
+		if (!obj_1a00)
+			continue;
+		const struct co_pdo_map_par *map =
+				co_obj_addressof_val(obj_1a00);
+		assert(map);
+		if (!map->n)
+			continue;
+
+		size_t n = MIN(map->n, CO_PDO_NUM_MAPS);
+		void *ptr = realloc(ent, (nent + n) * sizeof(*ent));
+		if (!ptr) {
+			set_errc_from_errno();
+			free(ent);
+			return -1;
+		}
+		ent = ptr;
+
+		for (size_t j = 0; j < n; j++) {
+			ent[nent].key = (map->map[j] >> 8) & 0xffffff;
+			ent[nent].num = i + 1;
+			nent++;
+		}
+	}
+
+	// Sort the entries by sub-object and PDO number and remove duplicates,
+	// so at most one event is indicated for every PDO.
+	if (nent)
+		qsort(ent, nent, sizeof(*ent), &co_dev_tpdo_ent_cmp);
+	size_t n = 0;
+	for (size_t i = 0; i < nent; i++) {
+		if (n && !co_dev_tpdo_ent_cmp(&ent[n - 1], &ent[i]))
+			continue;
+		ent[n++] = ent[i];
+	}
+
+	free(dev->tpdo_ent);
+	dev->tpdo_ent = ent;
+	dev->tpdo_nent = n;
+	dev->tpdo_dirty = 0;
+
+	return 0;
+}
+
+static int
+co_dev_tpdo_ent_cmp(const void *p1, const void *p2)
+{
+	const struct co_dev_tpdo_ent *e1 = p1;
+	const struct co_dev_tpdo_ent *e2 = p2;
+
+	int cmp = (e2->key < e1->key) - (e1->key < e2->key);
+	if (!cmp)
+		cmp = (e2->num < e1->num) - (e1->num < e2->num);
+	return cmp;
+}
+
+#endif // !LELY_NO_MALLOC
+
+#endif // !LELY_NO_CO_TPDO
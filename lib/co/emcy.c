@@ -68,20 +68,13 @@ struct co_emcy_msg {
 	co_unsigned8_t er;
 };
 
-/// A remote CANopen EMCY producer node.
-struct co_emcy_node {
-	/// The node-ID.
-	co_unsigned8_t id;
-	/// A pointer to the CAN frame receiver.
-	can_recv_t *recv;
-};
-
 /**
- * The CAN receive callback function for a remote CANopen EMCY producer node.
+ * The CAN receive callback function for the remote CANopen EMCY producer
+ * nodes.
  *
  * @see can_recv_func_t
  */
-static int co_emcy_node_recv(const struct can_msg *msg, void *data);
+static int co_emcy_recv(const struct can_msg *msg, void *data);
 
 /// A CANopen EMCY producer/consumer service.
 struct co_emcy {
@@ -116,8 +109,22 @@ struct co_emcy {
 	can_timer_t *timer;
 	/// The time at which the next EMCY message may be sent.
 	struct timespec inhibit;
-	/// An array of pointers to remote nodes.
-	struct co_emcy_node nodes[CO_NUM_NODES];
+	/**
+	 * A pointer to the CAN frame receiver for the EMCY messages of all
+	 * remote nodes.
+	 */
+	can_recv_t *recv;
+	/**
+	 * A flag indicating whether the CAN-ID of every valid EMCY COB-ID in
+	 * #cobids ends with the node-ID (as in the pre-defined connection
+	 * set). If so, the node of a received frame can be found by index.
+	 */
+	int recv_by_id;
+	/**
+	 * The EMCY COB-IDs of the remote nodes, as configured in the emergency
+	 * consumer object (object 1028).
+	 */
+	co_unsigned32_t cobids[CO_NUM_NODES];
 	/// A pointer to the indication function.
 	co_emcy_ind_t *ind;
 	/// A pointer to user-specified data for #ind.
@@ -170,6 +177,14 @@ static co_unsigned32_t co_1003_dn_ind(co_sub_t *sub, struct co_sdo_req *req,
 static co_unsigned32_t co_1014_dn_ind(co_sub_t *sub, struct co_sdo_req *req,
 		co_unsigned32_t ac, void *data);
 
+/**
+ * Starts or stops the CAN frame receiver of an EMCY consumer service, depending
+ * on the EMCY COB-IDs in the emergency consumer object (object 1028). The
+ * identifier and mask of the receiver are chosen such that it accepts the
+ * frames of all valid COB-IDs.
+ */
+static void co_emcy_update_recv(co_emcy_t *emcy);
+
 /**
  * Sets the value of CANopen object 1028 (Emergency consumer object).
  *
@@ -288,15 +303,15 @@ co_emcy_start(co_emcy_t *emcy)
 		// Set the download indication function for the emergency
 		// consumer object.
 		co_obj_set_dn_ind(obj_1028, &co_1028_dn_ind, emcy);
-		// Start the CAN frame receivers for the nodes.
+		// Start the CAN frame receiver for the nodes.
 		co_unsigned8_t maxid = MIN(co_obj_get_val_u8(obj_1028, 0x00),
 				CO_NUM_NODES);
 		for (co_unsigned8_t id = 1; id <= maxid; id++) {
 			co_sub_t *sub = co_obj_find_sub(obj_1028, id);
 			if (sub)
-				co_emcy_set_1028(emcy, id,
-						co_sub_get_val_u32(sub));
+				emcy->cobids[id - 1] = co_sub_get_val_u32(sub);
 		}
+		co_emcy_update_recv(emcy);
 	}
 
 	emcy->stopped = 0;
@@ -316,12 +331,10 @@ co_emcy_stop(co_emcy_t *emcy)
 
 	co_obj_t *obj_1028 = co_dev_find_obj(emcy->dev, 0x1028);
 	if (obj_1028) {
-		// Stop all CAN frame receivers.
-		for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
-			co_sub_t *sub = co_obj_find_sub(obj_1028, id);
-			if (sub)
-				can_recv_stop(emcy->nodes[id - 1].recv);
-		}
+		// Stop the CAN frame receiver.
+		for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++)
+			emcy->cobids[id - 1] = CO_EMCY_COBID_VALID;
+		can_recv_stop(emcy->recv);
 		// Remove the download indication function for the emergency
 		// consumer object.
 		co_obj_set_dn_ind(obj_1028, NULL, NULL);
@@ -507,13 +520,10 @@ co_emcy_set_ind(co_emcy_t *emcy, co_emcy_ind_t *ind, void *data)
 }
 
 static int
-co_emcy_node_recv(const struct can_msg *msg, void *data)
+co_emcy_recv(const struct can_msg *msg, void *data)
 {
 	assert(msg);
-	struct co_emcy_node *node = data;
-	assert(node);
-	assert(node->id > 0 && node->id <= CO_NUM_NODES);
-	co_emcy_t *emcy = structof(node, co_emcy_t, nodes[node->id - 1]);
+	co_emcy_t *emcy = data;
 	assert(emcy);
 
 	// Ignore remote frames.
@@ -526,6 +536,29 @@ co_emcy_node_recv(const struct can_msg *msg, void *data)
 		return 0;
 #endif
 
+	// Convert the CAN-ID and format of the frame to a COB-ID.
+	co_unsigned32_t cobid = msg->id;
+	if (msg->flags & CAN_FLAG_IDE)
+		cobid = (cobid & CAN_MASK_EID) | CO_EMCY_COBID_FRAME;
+	else
+		cobid &= CAN_MASK_BID;
+
+	// The receiver accepts a range of CAN-IDs, which may include those of
+	// other services, so find the node to which the COB-ID belongs. The
+	// node-ID is tried first, since it is part of the pre-defined
+	// COB-IDs.
+	co_unsigned8_t id = msg->id & 0x7f;
+	if (!id || id > CO_NUM_NODES || emcy->cobids[id - 1] != cobid) {
+		if (emcy->recv_by_id)
+			return 0;
+		for (id = 1; id <= CO_NUM_NODES; id++) {
+			if (emcy->cobids[id - 1] == cobid)
+				break;
+		}
+		if (id > CO_NUM_NODES)
+			return 0;
+	}
+
 	// Extract the parameters from the frame.
 	co_unsigned16_t eec = 0;
 	if (msg->len >= 2)
@@ -539,7 +572,7 @@ co_emcy_node_recv(const struct can_msg *msg, void *data)
 	// Notify the user.
 	trace("EMCY: received %04X %02X", eec, er);
 	if (emcy->ind)
-		emcy->ind(emcy, node->id, eec, er, msef, emcy->data);
+		emcy->ind(emcy, id, eec, er, msef, emcy->data);
 
 	return 0;
 }
@@ -648,27 +681,59 @@ co_1014_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 }
 
 static void
-co_emcy_set_1028(co_emcy_t *emcy, co_unsigned8_t id, co_unsigned32_t cobid)
+co_emcy_update_recv(co_emcy_t *emcy)
 {
 	assert(emcy);
-	assert(id && id <= CO_NUM_NODES);
-	struct co_emcy_node *node = &emcy->nodes[id - 1];
-
-	if (!(cobid & CO_EMCY_COBID_VALID)) {
-		// Register the receiver under the specified CAN-ID.
-		uint_least32_t id = cobid;
-		uint_least8_t flags = 0;
-		if (id & CO_EMCY_COBID_FRAME) {
-			id &= CAN_MASK_EID;
-			flags |= CAN_FLAG_IDE;
+
+	if (!emcy->recv)
+		return;
+
+	int valid = 0;
+	uint_least32_t id = 0;
+	uint_least32_t mask = CAN_MASK_EID;
+	uint_least8_t flags = 0;
+	uint_least8_t flags_mask = 0xff;
+	emcy->recv_by_id = 1;
+	for (co_unsigned8_t i = 1; i <= CO_NUM_NODES; i++) {
+		co_unsigned32_t cobid = emcy->cobids[i - 1];
+		if (cobid & CO_EMCY_COBID_VALID)
+			continue;
+		uint_least32_t canid = cobid;
+		uint_least8_t canflags = 0;
+		if (canid & CO_EMCY_COBID_FRAME) {
+			canid &= CAN_MASK_EID;
+			canflags |= CAN_FLAG_IDE;
 		} else {
-			id &= CAN_MASK_BID;
+			canid &= CAN_MASK_BID;
 		}
-		can_recv_start(node->recv, emcy->net, id, flags);
-	} else {
-		// Stop the receiver unless the EMCY COB-ID is valid.
-		can_recv_stop(node->recv);
+		if (!valid) {
+			valid = 1;
+			id = canid;
+			flags = canflags;
+		}
+		// Clear the bits in which the CAN-IDs differ from the mask.
+		mask &= ~(canid ^ id);
+		flags_mask &= ~(canflags ^ flags);
+		if ((canid & 0x7f) != i)
+			emcy->recv_by_id = 0;
 	}
+
+	// Stop the receiver if none of the EMCY COB-IDs is valid.
+	if (valid)
+		can_recv_start_mask(emcy->recv, emcy->net, id, mask, flags,
+				flags_mask);
+	else
+		can_recv_stop(emcy->recv);
+}
+
+static void
+co_emcy_set_1028(co_emcy_t *emcy, co_unsigned8_t id, co_unsigned32_t cobid)
+{
+	assert(emcy);
+	assert(id && id <= CO_NUM_NODES);
+
+	emcy->cobids[id - 1] = cobid;
+	co_emcy_update_recv(emcy);
 }
 
 static co_unsigned32_t
@@ -877,34 +942,25 @@ co_emcy_init(co_emcy_t *emcy, can_net_t *net, co_dev_t *dev)
 	emcy->ind = NULL;
 	emcy->data = NULL;
 
-	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
-		struct co_emcy_node *node = &emcy->nodes[id - 1];
-		node->id = id;
-		node->recv = NULL;
-	}
-
-	co_obj_t *obj_1028 = co_dev_find_obj(emcy->dev, 0x1028);
-	if (obj_1028) {
-		// Initialize the nodes.
-		for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
-			co_sub_t *sub = co_obj_find_sub(obj_1028, id);
-			if (!sub)
-				continue;
-			struct co_emcy_node *node = &emcy->nodes[id - 1];
-			node->recv = can_recv_create(co_emcy_get_alloc(emcy));
-			if (!node->recv) {
-				errc = get_errc();
-				goto error_create_recv;
-			}
-			can_recv_set_func(node->recv, &co_emcy_node_recv, node);
+	emcy->recv = NULL;
+	emcy->recv_by_id = 1;
+	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++)
+		emcy->cobids[id - 1] = CO_EMCY_COBID_VALID;
+
+	// A single CAN frame receiver is shared by all remote nodes.
+	if (co_dev_find_obj(emcy->dev, 0x1028)) {
+		emcy->recv = can_recv_create(co_emcy_get_alloc(emcy));
+		if (!emcy->recv) {
+			errc = get_errc();
+			goto error_create_recv;
 		}
+		can_recv_set_func(emcy->recv, &co_emcy_recv, emcy);
 	}
 
 	return emcy;
 
+	// can_recv_destroy(emcy->recv);
 error_create_recv:
-	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++)
-		can_recv_destroy(emcy->nodes[id - 1].recv);
 	can_timer_destroy(emcy->timer);
 error_create_timer:
 	can_buf_fini(&emcy->buf);
@@ -920,8 +976,7 @@ co_emcy_fini(co_emcy_t *emcy)
 
 	co_emcy_stop(emcy);
 
-	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++)
-		can_recv_destroy(emcy->nodes[id - 1].recv);
+	can_recv_destroy(emcy->recv);
 
 	can_timer_destroy(emcy->timer);
 
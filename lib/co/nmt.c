@@ -90,11 +90,6 @@ typedef const struct co_nmt_state co_nmt_state_t;
 struct co_nmt_slave {
 	/// A pointer to the NMT master service.
 	co_nmt_t *nmt;
-	/**
-	 * A pointer to the CAN frame receiver for the boot-up event and node
-	 * guarding messages.
-	 */
-	can_recv_t *recv;
 #if !LELY_NO_CO_NG
 	/// A pointer to the CAN timer for node guarding.
 	can_timer_t *timer;
@@ -198,6 +193,11 @@ struct co_nmt {
 	void *cs_data;
 	/// A pointer to the CAN frame receiver for NMT error control messages.
 	can_recv_t *recv_700;
+	/**
+	 * A pointer to the CAN frame receiver for the heartbeat, boot-up and
+	 * node guarding messages of all remote nodes.
+	 */
+	can_recv_t *recv_ec;
 #if !LELY_NO_CO_MASTER && !LELY_NO_CO_NG
 	/// A pointer to the node guarding event indication function.
 	co_nmt_ng_ind_t *ng_ind;
@@ -268,6 +268,11 @@ struct co_nmt {
 	 * mandatory slave boot failure.
 	 */
 	int halt;
+	/**
+	 * A flag indicating whether the error control messages of the slaves
+	 * are processed (see co_nmt_slaves_init()).
+	 */
+	int ec_slaves;
 	/// An array containing the state of each NMT slave.
 	struct co_nmt_slave slaves[CO_NUM_NODES];
 	/**
@@ -412,13 +417,30 @@ static int co_nmt_recv_000(const struct can_msg *msg, void *data);
 
 /**
  * The CAN receive callback function for NMT error control (node guarding RTR)
- * messages. In case of an NMT master, this function also receives and processes
- * the boot-up events (see Fig. 13 in CiA 302-2 version 4.1.0).
+ * messages. In case of an NMT master, this function also processes the boot-up
+ * events (see Fig. 13 in CiA 302-2 version 4.1.0) forwarded by
+ * co_nmt_recv_ec().
  *
  * @see can_recv_func_t
  */
 static int co_nmt_recv_700(const struct can_msg *msg, void *data);
 
+/**
+ * The CAN receive callback function for the error control messages of remote
+ * nodes (CAN-IDs 0x701..0x77F). Every frame is passed to the heartbeat
+ * consumers and, in case of an NMT master, to co_nmt_recv_700().
+ *
+ * @see can_recv_func_t
+ */
+static int co_nmt_recv_ec(const struct can_msg *msg, void *data);
+
+/**
+ * Starts the CAN frame receiver for the error control messages of remote nodes
+ * if there are any heartbeat consumers or, in case of an NMT master, if slave
+ * management is enabled, and stops it otherwise.
+ */
+static void co_nmt_recv_ec_update(co_nmt_t *nmt);
+
 #if !LELY_NO_CO_MASTER && !LELY_NO_CO_NG
 /// The CAN timer callback function for node guarding. @see can_timer_func_t
 static int co_nmt_ng_timer(const struct timespec *tp, void *data);
@@ -1237,21 +1259,9 @@ co_nmt_on_sync(co_nmt_t *nmt, co_unsigned8_t cnt)
 {
 	assert(nmt);
 
-	// Handle TPDOs before RPDOs. This prevents a possible race condition if
-	// the same object is mapped to both an RPDO and a TPDO. In accordance
-	// with CiA 301 v4.2.0 we transmit the value from the previous
-	// synchronous window before updating it with a received PDO.
-#if !LELY_NO_CO_TPDO
-	for (co_unsigned16_t i = 0; i < nmt->srv.ntpdo; i++) {
-		if (nmt->srv.tpdos[i])
-			co_tpdo_sync(nmt->srv.tpdos[i], cnt);
-	}
-#endif
-#if !LELY_NO_CO_RPDO
-	for (co_unsigned16_t i = 0; i < nmt->srv.nrpdo; i++) {
-		if (nmt->srv.rpdos[i])
-			co_rpdo_sync(nmt->srv.rpdos[i], cnt);
-	}
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+	// Only trigger the valid synchronous PDOs.
+	co_nmt_srv_sync_pdo(&nmt->srv, cnt);
 #endif
 
 	if (nmt->sync_ind)
@@ -2611,6 +2621,54 @@ co_nmt_recv_700(const struct can_msg *msg, void *data)
 	return 0;
 }
 
+static int
+co_nmt_recv_ec(const struct can_msg *msg, void *data)
+{
+	assert(msg);
+	co_nmt_t *nmt = data;
+	assert(nmt);
+
+	co_unsigned8_t id = msg->id & 0x7f;
+	if (!id)
+		return 0;
+
+	// Heartbeat consumers are usually configured in order of node-ID, so
+	// try the one at the index of the node-ID first. Since the node-ID of
+	// an active consumer is unique, at most one consumer accepts the frame.
+	co_nmt_hb_t *hb = id <= nmt->nhb ? nmt->hbs[id - 1] : NULL;
+	if (!hb || !co_nmt_hb_recv(hb, msg)) {
+		for (co_unsigned8_t i = 0; i < nmt->nhb; i++) {
+			if (nmt->hbs[i] && nmt->hbs[i] != hb
+					&& co_nmt_hb_recv(nmt->hbs[i], msg))
+				break;
+		}
+	}
+
+#if !LELY_NO_CO_MASTER
+	if (nmt->ec_slaves)
+		co_nmt_recv_700(msg, nmt);
+#endif
+
+	return 0;
+}
+
+static void
+co_nmt_recv_ec_update(co_nmt_t *nmt)
+{
+	assert(nmt);
+
+	int start = nmt->nhb != 0;
+#if !LELY_NO_CO_MASTER
+	start = start || nmt->ec_slaves;
+#endif
+	if (start)
+		// Accept all base-format data frames with CAN-IDs 0x700..0x77F.
+		can_recv_start_mask(nmt->recv_ec, nmt->net, CO_NMT_EC_CANID(0),
+				0x780, 0, 0xff);
+	else
+		can_recv_stop(nmt->recv_ec);
+}
+
 #if !LELY_NO_CO_MASTER && !LELY_NO_CO_NG
 static int
 co_nmt_ng_timer(const struct timespec *tp, void *data)
@@ -3461,6 +3519,8 @@ co_nmt_hb_init(co_nmt_t *nmt)
 		co_unsigned16_t ms = val & 0xffff;
 		co_nmt_hb_set_1016(nmt->hbs[i], id, ms);
 	}
+
+	co_nmt_recv_ec_update(nmt);
 }
 
 static void
@@ -3478,6 +3538,8 @@ co_nmt_hb_fini(co_nmt_t *nmt)
 	nmt->hbs = NULL;
 #endif
 	nmt->nhb = 0;
+
+	co_nmt_recv_ec_update(nmt);
 }
 
 #if !LELY_NO_CO_MASTER
@@ -3513,10 +3575,9 @@ co_nmt_slaves_init(co_nmt_t *nmt)
 
 	co_nmt_slaves_fini(nmt);
 
-	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++)
-		// Start listening for boot-up notifications.
-		can_recv_start(nmt->slaves[id - 1].recv, nmt->net,
-				CO_NMT_EC_CANID(id), 0);
+	// Start listening for boot-up notifications.
+	nmt->ec_slaves = 1;
+	co_nmt_recv_ec_update(nmt);
 
 	co_obj_t *obj_1f81 = co_dev_find_obj(nmt->dev, 0x1f81);
 	if (!obj_1f81)
@@ -3532,10 +3593,13 @@ co_nmt_slaves_fini(co_nmt_t *nmt)
 {
 	assert(nmt);
 
+	// Stop listening for boot-up notifications.
+	nmt->ec_slaves = 0;
+	co_nmt_recv_ec_update(nmt);
+
 	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
 		struct co_nmt_slave *slave = &nmt->slaves[id - 1];
 
-		can_recv_stop(slave->recv);
 #if !LELY_NO_CO_NG
 		can_timer_stop(slave->timer);
 #endif
@@ -3734,6 +3798,15 @@ co_nmt_init(co_nmt_t *nmt, can_net_t *net, co_dev_t *dev)
 	}
 	can_recv_set_func(nmt->recv_700, &co_nmt_recv_700, nmt);
 
+	// Create the CAN frame receiver for the heartbeat and boot-up messages
+	// of all remote nodes.
+	nmt->recv_ec = can_recv_create(alloc);
+	if (!nmt->recv_ec) {
+		errc = get_errc();
+		goto error_create_recv_ec;
+	}
+	can_recv_set_func(nmt->recv_ec, &co_nmt_recv_ec, nmt);
+
 #if !LELY_NO_CO_MASTER && !LELY_NO_CO_NG
 	nmt->ng_ind = &default_ng_ind;
 	nmt->ng_data = NULL;
@@ -3806,12 +3879,12 @@ co_nmt_init(co_nmt_t *nmt, can_net_t *net, co_dev_t *dev)
 #endif
 
 	nmt->halt = 0;
+	nmt->ec_slaves = 0;
 
 	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
 		struct co_nmt_slave *slave = &nmt->slaves[id - 1];
 		slave->nmt = nmt;
 
-		slave->recv = NULL;
 #if !LELY_NO_CO_NG
 		slave->timer = NULL;
 #endif
@@ -3846,16 +3919,12 @@ co_nmt_init(co_nmt_t *nmt, can_net_t *net, co_dev_t *dev)
 #endif
 	}
 
+#if !LELY_NO_CO_NG \
+		|| (LELY_NO_MALLOC \
+				&& (!LELY_NO_CO_NMT_BOOT || !LELY_NO_CO_NMT_CFG))
 	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
 		struct co_nmt_slave *slave = &nmt->slaves[id - 1];
 
-		slave->recv = can_recv_create(alloc);
-		if (!slave->recv) {
-			errc = get_errc();
-			goto error_init_slave;
-		}
-		can_recv_set_func(slave->recv, &co_nmt_recv_700, nmt);
-
 #if !LELY_NO_CO_NG
 		slave->timer = can_timer_create(alloc);
 		if (!slave->timer) {
@@ -3889,6 +3958,7 @@ co_nmt_init(co_nmt_t *nmt, can_net_t *net, co_dev_t *dev)
 #endif
 #endif // LELY_NO_MALLOC
 	}
+#endif
 
 #if !LELY_NO_CO_NMT_BOOT || !LELY_NO_CO_NMT_CFG
 	nmt->timeout = LELY_CO_NMT_TIMEOUT;
@@ -3999,6 +4069,9 @@ co_nmt_init(co_nmt_t *nmt, can_net_t *net, co_dev_t *dev)
 // 	co_dev_set_tpdo_event_ind(nmt->dev, NULL, NULL);
 // #endif
 #if !LELY_NO_CO_MASTER
+#if !LELY_NO_CO_NG \
+		|| (LELY_NO_MALLOC \
+				&& (!LELY_NO_CO_NMT_BOOT || !LELY_NO_CO_NMT_CFG))
 error_init_slave:
 	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
 		struct co_nmt_slave *slave = &nmt->slaves[id - 1];
@@ -4011,11 +4084,11 @@ error_init_slave:
 		co_nmt_boot_destroy(slave->boot);
 #endif
 #endif
-		can_recv_destroy(slave->recv);
 #if !LELY_NO_CO_NG
 		can_timer_destroy(slave->timer);
 #endif
 	}
+#endif
 	can_timer_destroy(nmt->cs_timer);
 error_create_cs_timer:
 	can_buf_fini(&nmt->buf);
@@ -4027,6 +4100,8 @@ error_create_hb:
 #endif
 	can_timer_destroy(nmt->ec_timer);
 error_create_ec_timer:
+	can_recv_destroy(nmt->recv_ec);
+error_create_recv_ec:
 	can_recv_destroy(nmt->recv_700);
 error_create_recv_700:
 	can_recv_destroy(nmt->recv_000);
@@ -4112,7 +4187,6 @@ co_nmt_fini(co_nmt_t *nmt)
 	for (co_unsigned8_t id = 1; id <= CO_NUM_NODES; id++) {
 		struct co_nmt_slave *slave = &nmt->slaves[id - 1];
 
-		can_recv_destroy(slave->recv);
 #if !LELY_NO_CO_NG
 		can_timer_destroy(slave->timer);
 #endif
@@ -4133,6 +4207,7 @@ co_nmt_fini(co_nmt_t *nmt)
 	co_nmt_ec_fini(nmt);
 
 	can_timer_destroy(nmt->ec_timer);
+	can_recv_destroy(nmt->recv_ec);
 	can_recv_destroy(nmt->recv_700);
 
 	can_recv_destroy(nmt->recv_000);
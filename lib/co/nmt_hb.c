@@ -34,8 +34,6 @@ struct co_nmt_hb {
 	can_net_t *net;
 	/// A pointer to an NMT master/slave service.
 	co_nmt_t *nmt;
-	/// A pointer to the CAN frame receiver.
-	can_recv_t *recv;
 	/// A pointer to the CAN timer.
 	can_timer_t *timer;
 	/// The node-ID.
@@ -64,13 +62,6 @@ static co_nmt_hb_t *co_nmt_hb_init(
 /// Finalizes #co_nmt_hb_t object.
 static void co_nmt_hb_fini(co_nmt_hb_t *hb);
 
-/**
- * The CAN receive callback function for a heartbeat consumer.
- *
- * @see can_recv_func_t
- */
-static int co_nmt_hb_recv(const struct can_msg *msg, void *data);
-
 /**
  * The CAN timer callback function for a heartbeat consumer.
  *
@@ -137,7 +128,6 @@ co_nmt_hb_set_1016(co_nmt_hb_t *hb, co_unsigned8_t id, co_unsigned16_t ms)
 {
 	assert(hb);
 
-	can_recv_stop(hb->recv);
 	can_timer_stop(hb->timer);
 
 	hb->id = id;
@@ -145,12 +135,8 @@ co_nmt_hb_set_1016(co_nmt_hb_t *hb, co_unsigned8_t id, co_unsigned16_t ms)
 	hb->ms = ms;
 	hb->state = CO_NMT_EC_RESOLVED;
 
-	if (hb->id && hb->id <= CO_NUM_NODES && hb->ms) {
-		can_recv_start(hb->recv, hb->net, CO_NMT_EC_CANID(hb->id), 0);
-	} else {
-		can_recv_stop(hb->recv);
+	if (!hb->id || hb->id > CO_NUM_NODES || !hb->ms)
 		can_timer_stop(hb->timer);
-	}
 }
 
 void
@@ -166,28 +152,27 @@ co_nmt_hb_set_st(co_nmt_hb_t *hb, co_unsigned8_t st)
 	}
 }
 
-static int
-co_nmt_hb_recv(const struct can_msg *msg, void *data)
+int
+co_nmt_hb_recv(co_nmt_hb_t *hb, const struct can_msg *msg)
 {
-	assert(msg);
-	co_nmt_hb_t *hb = data;
 	assert(hb);
-	assert(hb->id && hb->id <= CO_NUM_NODES);
-	assert(msg->id == (uint_least32_t)CO_NMT_EC_CANID(hb->id));
+	assert(msg);
+
+	// Ignore messages from other nodes and inactive consumers. This might
+	// also happen upon receipt of a boot-up message, if the 'boot slave'
+	// process has just disabled the heartbeat consumer.
+	if (!hb->id || hb->id > CO_NUM_NODES || !hb->ms
+			|| msg->id != (uint_least32_t)CO_NMT_EC_CANID(hb->id)
+			|| (msg->flags & CAN_FLAG_IDE))
+		return 0;
 
 	// Obtain the node status from the CAN frame. Ignore if the toggle bit
 	// is set, since then it is not a heartbeat message.
 	if (msg->len < 1)
-		return 0;
+		return 1;
 	co_unsigned8_t st = msg->data[0];
 	if (st & CO_NMT_ST_TOGGLE)
-		return 0;
-
-	// This might happen upon receipt of a boot-up message. The 'boot slave'
-	// process has disabled the heartbeat consumer, but the event has
-	// already been scheduled.
-	if (!hb->ms)
-		return 0;
+		return 1;
 
 	// Update the state.
 	co_unsigned8_t old_st = hb->st;
@@ -212,7 +197,7 @@ co_nmt_hb_recv(const struct can_msg *msg, void *data)
 				CO_NMT_EC_STATE, st);
 	}
 
-	return 0;
+	return 1;
 }
 
 static int
@@ -263,13 +248,6 @@ co_nmt_hb_init(co_nmt_hb_t *hb, can_net_t *net, co_nmt_t *nmt)
 	hb->net = net;
 	hb->nmt = nmt;
 
-	hb->recv = can_recv_create(co_nmt_hb_get_alloc(hb));
-	if (!hb->recv) {
-		errc = get_errc();
-		goto error_create_recv;
-	}
-	can_recv_set_func(hb->recv, &co_nmt_hb_recv, hb);
-
 	hb->timer = can_timer_create(co_nmt_hb_get_alloc(hb));
 	if (!hb->timer) {
 		errc = get_errc();
@@ -286,8 +264,6 @@ co_nmt_hb_init(co_nmt_hb_t *hb, can_net_t *net, co_nmt_t *nmt)
 
 	// can_timer_destroy(hb->timer);
 error_create_timer:
-	can_recv_destroy(hb->recv);
-error_create_recv:
 	set_errc(errc);
 	return NULL;
 }
@@ -298,5 +274,4 @@ co_nmt_hb_fini(co_nmt_hb_t *hb)
 	assert(hb);
 
 	can_timer_destroy(hb->timer);
-	can_recv_destroy(hb->recv);
 }
@@ -86,9 +86,9 @@ alloc_t *co_nmt_hb_get_alloc(const co_nmt_hb_t *hb);
  * Processes the value of CANopen object 1016 (Consumer heartbeat time) for the
  * specified heartbeat consumer. If the node-ID is valid and the heartbeat time
  * is non-zero, the heartbeat consumer is activated. Note that this only
- * activates the CAN frame receiver for heartbeat messages. The CAN timer for
- * heartbeat events is not activated until the first heartbeat message is
- * received or co_nmt_hb_set_st() is invoked.
+ * enables the processing of heartbeat messages by co_nmt_hb_recv(). The CAN
+ * timer for heartbeat events is not activated until the first heartbeat message
+ * is received or co_nmt_hb_set_st() is invoked.
  *
  * @param hb a pointer to a heartbeat consumer service.
  * @param id the node-ID.
@@ -107,6 +107,20 @@ void co_nmt_hb_set_1016(co_nmt_hb_t *hb, co_unsigned8_t id, co_unsigned16_t ms);
  */
 void co_nmt_hb_set_st(co_nmt_hb_t *hb, co_unsigned8_t st);
 
+/**
+ * Processes a CAN frame received by the NMT service. The heartbeat consumers do
+ * not register their own CAN frame receivers; instead, the NMT service
+ * registers a single receiver for the error control messages of all nodes and
+ * passes each frame to the consumers with this function.
+ *
+ * @param hb  a pointer to a heartbeat consumer service.
+ * @param msg a pointer to the received CAN frame.
+ *
+ * @returns 1 if the frame is a heartbeat or boot-up message for the node
+ * monitored by this (active) consumer, and 0 if not.
+ */
+int co_nmt_hb_recv(co_nmt_hb_t *hb, const struct can_msg *msg);
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,7 @@
 #if !LELY_NO_CO_CSDO
 #include <lely/co/csdo.h>
 #endif
+#include <lely/co/detail/dev.h>
 #include <lely/co/dev.h>
 #if !LELY_NO_CO_EMCY
 #include <lely/co/emcy.h>
@@ -46,6 +47,7 @@
 #if !LELY_NO_CO_TPDO
 #include <lely/co/tpdo.h>
 #endif
+#include <lely/util/time.h>
 #include "nmt_srv.h"
 
 #include <assert.h>
@@ -59,6 +61,12 @@ static void co_nmt_srv_fini_pdo(struct co_nmt_srv *srv);
 static int co_nmt_srv_start_pdo(struct co_nmt_srv *srv);
 /// Stops all Receive/Transmit-PDO services. @see co_nmt_srv_start_pdo()
 static void co_nmt_srv_stop_pdo(struct co_nmt_srv *srv);
+/**
+ * Rebuilds the lists of valid synchronous Receive/Transmit-PDO services. This
+ * function is invoked by co_nmt_srv_sync_pdo() when the COB-ID or transmission
+ * type of a PDO has changed.
+ */
+static void co_nmt_srv_update_pdo(struct co_nmt_srv *srv);
 #if !LELY_NO_CO_RPDO
 /// Invokes co_nmt_err() to handle Receive-PDO errors. @see co_rpdo_err_t
 static void co_nmt_srv_rpdo_err(co_rpdo_t *pdo, co_unsigned16_t eec,
@@ -138,10 +146,17 @@ co_nmt_srv_init(struct co_nmt_srv *srv, co_nmt_t *nmt)
 #if !LELY_NO_CO_RPDO
 	srv->rpdos = NULL;
 	srv->nrpdo = 0;
+	srv->rpdos_sync = NULL;
+	srv->nrpdo_sync = 0;
 #endif
 #if !LELY_NO_CO_TPDO
 	srv->tpdos = NULL;
 	srv->ntpdo = 0;
+	srv->tpdos_sync = NULL;
+	srv->ntpdo_sync = 0;
+#endif
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+	srv->pdo_comm_gen = 0;
 #endif
 
 	srv->ssdos = NULL;
@@ -355,6 +370,42 @@ co_nmt_srv_set(struct co_nmt_srv *srv, int set)
 
 #if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
 
+void
+co_nmt_srv_sync_pdo(struct co_nmt_srv *srv, co_unsigned8_t cnt)
+{
+	assert(srv);
+	can_net_t *net = co_nmt_get_net(srv->nmt);
+	co_dev_t *dev = co_nmt_get_dev(srv->nmt);
+
+	// Rebuild the lists of synchronous PDOs if the COB-ID or transmission
+	// type of a PDO has changed since the last SYNC object.
+	if (srv->pdo_comm_gen != dev->pdo_comm_gen)
+		co_nmt_srv_update_pdo(srv);
+
+	// Compute the end of the synchronous time window once for all PDOs.
+	struct timespec end = { 0, 0 };
+	co_unsigned32_t swnd = co_dev_get_val_u32(dev, 0x1007, 0x00);
+	if (swnd) {
+		can_net_get_time(net, &end);
+		timespec_add_usec(&end, swnd);
+	}
+
+	// Handle TPDOs before RPDOs. This prevents a possible race condition if
+	// the same object is mapped to both an RPDO and a TPDO. In accordance
+	// with CiA 301 v4.2.0 we transmit the value from the previous
+	// synchronous window before updating it with a received PDO.
+	// The number of PDOs is re-read on every iteration, since the
+	// indication functions may reset the PDO services.
+#if !LELY_NO_CO_TPDO
+	for (co_unsigned16_t i = 0; i < srv->ntpdo_sync; i++)
+		co_tpdo_sync_swnd(srv->tpdos_sync[i], cnt, swnd ? &end : NULL);
+#endif
+#if !LELY_NO_CO_RPDO
+	for (co_unsigned16_t i = 0; i < srv->nrpdo_sync; i++)
+		co_rpdo_sync_swnd(srv->rpdos_sync[i], cnt, swnd ? &end : NULL);
+#endif
+}
+
 static int
 co_nmt_srv_init_pdo(struct co_nmt_srv *srv)
 {
@@ -377,12 +428,14 @@ co_nmt_srv_init_pdo(struct co_nmt_srv *srv)
 		nrpdo = i + 1;
 	}
 
-	// Create the Receive-PDOs.
+	// Create the Receive-PDOs. The second half of the array is used for
+	// the list of synchronous RPDOs.
 	if (nrpdo) {
 		srv->rpdos = mem_alloc(alloc, _Alignof(co_rpdo_t *),
-				nrpdo * sizeof(co_rpdo_t *));
+				2 * nrpdo * sizeof(co_rpdo_t *));
 		if (!srv->rpdos)
 			goto error;
+		srv->rpdos_sync = srv->rpdos + nrpdo;
 
 		for (co_unsigned16_t i = 0; i < nrpdo; i++) {
 			co_rpdo_t **ppdo = &srv->rpdos[srv->nrpdo++];
@@ -413,12 +466,14 @@ co_nmt_srv_init_pdo(struct co_nmt_srv *srv)
 		ntpdo = i + 1;
 	}
 
-	// Create the Transmit-PDOs.
+	// Create the Transmit-PDOs. The second half of the array is used for
+	// the list of synchronous TPDOs.
 	if (ntpdo) {
 		srv->tpdos = mem_alloc(alloc, _Alignof(co_tpdo_t *),
-				ntpdo * sizeof(co_tpdo_t *));
+				2 * ntpdo * sizeof(co_tpdo_t *));
 		if (!srv->tpdos)
 			goto error;
+		srv->tpdos_sync = srv->tpdos + ntpdo;
 
 		for (co_unsigned16_t i = 0; i < ntpdo; i++) {
 			co_tpdo_t **ppdo = &srv->tpdos[srv->ntpdo++];
@@ -435,6 +490,8 @@ co_nmt_srv_init_pdo(struct co_nmt_srv *srv)
 	}
 #endif // !LELY_NO_CO_TPDO
 
+	co_nmt_srv_update_pdo(srv);
+
 	return 0;
 
 error:
@@ -457,6 +514,8 @@ co_nmt_srv_fini_pdo(struct co_nmt_srv *srv)
 	mem_free(alloc, srv->tpdos);
 	srv->tpdos = NULL;
 	srv->ntpdo = 0;
+	srv->tpdos_sync = NULL;
+	srv->ntpdo_sync = 0;
 #endif
 
 #if !LELY_NO_CO_RPDO
@@ -466,6 +525,8 @@ co_nmt_srv_fini_pdo(struct co_nmt_srv *srv)
 	mem_free(alloc, srv->rpdos);
 	srv->rpdos = NULL;
 	srv->nrpdo = 0;
+	srv->rpdos_sync = NULL;
+	srv->nrpdo_sync = 0;
 #endif
 }
 
@@ -524,6 +585,44 @@ co_nmt_srv_stop_pdo(struct co_nmt_srv *srv)
 	srv->set &= ~CO_NMT_SRV_PDO;
 }
 
+static void
+co_nmt_srv_update_pdo(struct co_nmt_srv *srv)
+{
+	assert(srv);
+	co_dev_t *dev = co_nmt_get_dev(srv->nmt);
+
+	srv->pdo_comm_gen = dev->pdo_comm_gen;
+
+#if !LELY_NO_CO_TPDO
+	srv->ntpdo_sync = 0;
+	for (size_t i = 0; i < srv->ntpdo; i++) {
+		co_tpdo_t *pdo = srv->tpdos[i];
+		if (!pdo)
+			continue;
+		// Only valid TPDOs with a synchronous (acyclic, cyclic or
+		// RTR-only) transmission type process SYNC objects.
+		const struct co_pdo_comm_par *comm = co_tpdo_get_comm_par(pdo);
+		if (!(comm->cobid & CO_PDO_COBID_VALID)
+				&& (comm->trans <= 0xf0 || comm->trans == 0xfc))
+			srv->tpdos_sync[srv->ntpdo_sync++] = pdo;
+	}
+#endif
+
+#if !LELY_NO_CO_RPDO
+	srv->nrpdo_sync = 0;
+	for (size_t i = 0; i < srv->nrpdo; i++) {
+		co_rpdo_t *pdo = srv->rpdos[i];
+		if (!pdo)
+			continue;
+		// Only valid RPDOs with a synchronous transmission type process
+		// SYNC objects.
+		const struct co_pdo_comm_par *comm = co_rpdo_get_comm_par(pdo);
+		if (!(comm->cobid & CO_PDO_COBID_VALID) && comm->trans <= 0xf0)
+			srv->rpdos_sync[srv->nrpdo_sync++] = pdo;
+	}
+#endif
+}
+
 #if !LELY_NO_CO_RPDO
 static void
 co_nmt_srv_rpdo_err(co_rpdo_t *pdo, co_unsigned16_t eec, co_unsigned8_t er,
@@ -41,12 +41,36 @@ struct co_nmt_srv {
 	co_rpdo_t **rpdos;
 	/// The number of Receive-PDO services.
 	co_unsigned16_t nrpdo;
+	/**
+	 * An array of pointers to the valid synchronous Receive-PDO services,
+	 * in order of increasing PDO number. This array shares its memory
+	 * with #rpdos.
+	 */
+	co_rpdo_t **rpdos_sync;
+	/// The number of valid synchronous Receive-PDO services.
+	co_unsigned16_t nrpdo_sync;
 #endif
 #if !LELY_NO_CO_TPDO
 	/// An array of pointers to the Transmit-PDO services.
 	co_tpdo_t **tpdos;
 	/// The number of Transmit-PDO services.
 	co_unsigned16_t ntpdo;
+	/**
+	 * An array of pointers to the valid synchronous Transmit-PDO services,
+	 * in order of increasing PDO number. This array shares its memory
+	 * with #tpdos.
+	 */
+	co_tpdo_t **tpdos_sync;
+	/// The number of valid synchronous Transmit-PDO services.
+	co_unsigned16_t ntpdo_sync;
+#endif
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+	/**
+	 * The value of the PDO communication parameter counter of the device
+	 * (see co_dev_pdo_comm_changed()) when #rpdos_sync and #tpdos_sync
+	 * were last updated.
+	 */
+	unsigned int pdo_comm_gen;
 #endif
 	/// An array of pointers to the Server-SDO services.
 	co_ssdo_t **ssdos;
@@ -122,6 +146,21 @@ void co_nmt_srv_fini(struct co_nmt_srv *srv);
  */
 void co_nmt_srv_set(struct co_nmt_srv *srv, int set);
 
+#if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
+/**
+ * Triggers all valid synchronous Transmit-PDOs, followed by all valid
+ * synchronous Receive-PDOs, after the reception or transmission of a SYNC
+ * object. The synchronous time window (object 1007) is computed once and shared
+ * by all PDOs.
+ *
+ * @param srv a pointer to a CANopen NMT service manager.
+ * @param cnt the counter value (in the range [0..240]).
+ *
+ * @see co_tpdo_sync_swnd(), co_rpdo_sync_swnd()
+ */
+void co_nmt_srv_sync_pdo(struct co_nmt_srv *srv, co_unsigned8_t cnt);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
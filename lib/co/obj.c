@@ -22,6 +22,7 @@
  */
 
 #include "co.h"
+#include <lely/co/detail/dev.h>
 #include <lely/co/detail/obj.h>
 #include <lely/co/dev.h>
 #include <lely/co/sdo.h>
@@ -93,6 +94,10 @@ void
 co_obj_fini(co_obj_t *obj)
 {
 	assert(obj);
+#if !LELY_NO_MALLOC
+	// Objects in a frozen object dictionary cannot be removed.
+	assert(!obj->dev || !obj->dev->frozen);
+#endif
 
 	if (obj->dev)
 		co_dev_remove_obj(obj->dev, obj);
@@ -198,6 +203,11 @@ co_obj_insert_sub(co_obj_t *obj, co_sub_t *sub)
 	if (sub->obj == obj)
 		return 0;
 
+	if (obj->dev && obj->dev->frozen) {
+		set_errnum(ERRNUM_PERM);
+		return -1;
+	}
+
 	if (rbtree_find(&obj->tree, sub->node.key))
 		return -1;
 
@@ -206,6 +216,9 @@ co_obj_insert_sub(co_obj_t *obj, co_sub_t *sub)
 
 #if !LELY_NO_MALLOC
 	co_obj_update(obj);
+#if !LELY_NO_CO_TPDO
+	co_dev_tpdo_invalidate(obj->dev, obj->idx);
+#endif
 #endif
 
 	return 0;
@@ -220,6 +233,11 @@ co_obj_remove_sub(co_obj_t *obj, co_sub_t *sub)
 	if (sub->obj != obj)
 		return -1;
 
+	if (obj->dev && obj->dev->frozen) {
+		set_errnum(ERRNUM_PERM);
+		return -1;
+	}
+
 	rbtree_remove(&sub->obj->tree, &sub->node);
 	rbnode_init(&sub->node, &sub->subidx);
 	sub->obj = NULL;
@@ -229,6 +247,9 @@ co_obj_remove_sub(co_obj_t *obj, co_sub_t *sub)
 	sub->val = NULL;
 
 	co_obj_update(obj);
+#if !LELY_NO_CO_TPDO
+	co_dev_tpdo_invalidate(obj->dev, obj->idx);
+#endif
 #endif
 
 	return 0;
@@ -239,6 +260,9 @@ co_obj_find_sub(const co_obj_t *obj, co_unsigned8_t subidx)
 {
 	assert(obj);
 
+	if (obj->dev && obj->dev->frozen)
+		return co_dev_frozen_find_sub(obj->dev, obj->idx, subidx);
+
 	struct rbnode *node = rbtree_find(&obj->tree, &subidx);
 	return node ? structof(node, co_sub_t, node) : NULL;
 }
@@ -711,6 +735,11 @@ co_sub_set_val(co_sub_t *sub, const void *ptr, size_t n)
 {
 	assert(sub);
 
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+	if (sub->obj)
+		co_dev_tpdo_invalidate(sub->obj->dev, sub->obj->idx);
+#endif
+
 	co_val_fini(sub->type, sub->val);
 	return co_val_make(sub->type, sub->val, ptr, n);
 }
@@ -900,6 +929,14 @@ co_sub_set_dn_ind(co_sub_t *sub, co_sub_dn_ind_t *ind, void *data)
 	sub->dn_data = ind ? data : NULL;
 }
 
+int
+co_sub_has_default_dn_ind(const co_sub_t *sub)
+{
+	assert(sub);
+
+	return sub->dn_ind == &co_sub_default_dn_ind;
+}
+
 int
 co_sub_on_dn(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t *pac)
 {
@@ -999,6 +1036,10 @@ co_sub_dn(co_sub_t *sub, void *val)
 		co_val_fini(sub->type, sub->val);
 		if (!co_val_move(sub->type, sub->val, val))
 			return -1;
+#endif
+#if !LELY_NO_CO_TPDO && !LELY_NO_MALLOC
+		if (sub->obj)
+			co_dev_tpdo_invalidate(sub->obj->dev, sub->obj->idx);
 #endif
 	}
 
@@ -1027,6 +1068,14 @@ co_sub_set_up_ind(co_sub_t *sub, co_sub_up_ind_t *ind, void *data)
 	sub->up_data = ind ? data : NULL;
 }
 
+int
+co_sub_has_default_up_ind(const co_sub_t *sub)
+{
+	assert(sub);
+
+	return sub->up_ind == &co_sub_default_up_ind;
+}
+
 #endif // !LELY_NO_CO_OBJ_UPLOAD
 
 int
@@ -26,20 +26,83 @@
 #if !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
 
 #include <lely/can/msg.h>
+#include <lely/co/detail/obj.h>
 #include <lely/co/dev.h>
-#include <lely/co/obj.h>
 #include <lely/co/pdo.h>
 #include <lely/co/sdo.h>
+#include <lely/co/val.h>
 #include <lely/util/endian.h>
 
 #include <assert.h>
 
+/**
+ * The number of 64-bit words used to hold the payload of a PDO. bgetle() and
+ * bsetle() only access the next word for fields straddling a word boundary,
+ * and such a word exists for every field that fits in the payload.
+ */
+#define CO_PDO_NUM_WORDS ((CAN_MAX_LEN + 7) / 8)
+
 static co_unsigned32_t co_dev_cfg_pdo_comm(const co_dev_t *dev,
 		co_unsigned16_t idx, const struct co_pdo_comm_par *par);
 
 static co_unsigned32_t co_dev_cfg_pdo_map(const co_dev_t *dev,
 		co_unsigned16_t num, const struct co_pdo_map_par *par);
 
+#if !LELY_NO_CO_RPDO
+/**
+ * Checks if the specified sub-object can be mapped into a Receive-PDO.
+ *
+ * @returns 0 on success, or an SDO abort code on error.
+ */
+static co_unsigned32_t co_sub_chk_rpdo(const co_sub_t *sub);
+
+/**
+ * Writes a value of a basic data type to a sub-object with the default
+ * download indication function, bypassing the SDO download request.
+ *
+ * @see co_sub_on_dn()
+ */
+static co_unsigned32_t co_sub_dn_basic(
+		co_sub_t *sub, const uint_least8_t *buf, size_t nbyte);
+
+/**
+ * Returns a pointer to the bytes of a mapped value in a received PDO. If the
+ * value is byte-aligned, this is a pointer into the PDO itself. Otherwise, the
+ * value is extracted from the PDO, loaded into the words at <b>w</b>, and
+ * stored at <b>tmp</b>.
+ *
+ * @param w      a pointer to the PDO, loaded with ldle_u64v().
+ * @param buf    a pointer to the PDO.
+ * @param offset the offset (in bits) of the value in the PDO.
+ * @param len    the length (in bits, at most 64) of the value.
+ * @param tmp    the buffer for a value that is not byte-aligned.
+ */
+static inline const uint_least8_t *co_pdo_get_val(const uint_least64_t *w,
+		const uint_least8_t *buf, size_t offset, size_t len,
+		uint_least8_t tmp[8]);
+#endif
+
+#if !LELY_NO_CO_TPDO
+/**
+ * Checks if the specified sub-object can be mapped into a Transmit-PDO.
+ *
+ * @returns 0 on success, or an SDO abort code on error.
+ */
+static co_unsigned32_t co_sub_chk_tpdo(const co_sub_t *sub);
+
+/**
+ * Inserts an uploaded value into a PDO.
+ *
+ * @param w      a pointer to the PDO, loaded with ldle_u64v().
+ * @param offset the offset (in bits) of the value in the PDO.
+ * @param len    the length (in bits, at most 64) of the value.
+ * @param ptr    a pointer to the bytes of the value.
+ * @param n      the number of bytes at <b>ptr</b>.
+ */
+static inline void co_pdo_set_val(uint_least64_t *w, size_t offset, size_t len,
+		const void *ptr, size_t n);
+#endif
+
 #if !LELY_NO_CO_RPDO
 
 co_unsigned32_t
@@ -60,12 +123,7 @@ co_dev_chk_rpdo(const co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx)
 		if (!sub)
 			return CO_SDO_AC_NO_SUB;
 
-		unsigned int access = co_sub_get_access(sub);
-		if (!(access & CO_ACCESS_WRITE))
-			return CO_SDO_AC_NO_WRITE;
-
-		if (!co_sub_get_pdo_mapping(sub) || !(access & CO_ACCESS_RPDO))
-			return CO_SDO_AC_NO_PDO;
+		return co_sub_chk_rpdo(sub);
 	}
 
 	return 0;
@@ -134,14 +192,7 @@ co_dev_chk_tpdo(const co_dev_t *dev, co_unsigned16_t idx, co_unsigned8_t subidx)
 	if (!sub)
 		return CO_SDO_AC_NO_SUB;
 
-	unsigned int access = co_sub_get_access(sub);
-	if (!(access & CO_ACCESS_READ))
-		return CO_SDO_AC_NO_READ;
-
-	if (!co_sub_get_pdo_mapping(sub) || !(access & CO_ACCESS_TPDO))
-		return CO_SDO_AC_NO_PDO;
-
-	return 0;
+	return co_sub_chk_tpdo(sub);
 }
 
 co_unsigned32_t
@@ -202,6 +253,12 @@ co_pdo_map(const struct co_pdo_map_par *par, const co_unsigned64_t *val,
 	if (par->n > CO_PDO_NUM_MAPS || n != par->n)
 		return CO_SDO_AC_PDO_LEN;
 
+	// Pack the values into 64-bit words and store them in one go. The bits
+	// that are not mapped keep their value.
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	size_t nbyte = buf && pn ? MIN(*pn, CAN_MAX_LEN) : 0;
+	ldle_u64v(w, buf, nbyte);
+
 	size_t offset = 0;
 	for (size_t i = 0; i < par->n; i++) {
 		co_unsigned32_t map = par->map[i];
@@ -212,14 +269,14 @@ co_pdo_map(const struct co_pdo_map_par *par, const co_unsigned64_t *val,
 		if (offset + len > CAN_MAX_LEN * 8)
 			return CO_SDO_AC_PDO_LEN;
 
-		uint_least8_t tmp[sizeof(co_unsigned64_t)] = { 0 };
-		stle_u64(tmp, val[i]);
-		if (buf && pn && offset + len <= *pn * 8)
-			bcpyle(buf, offset, tmp, 0, len);
+		if (offset + len <= nbyte * 8)
+			bsetle(w, offset, val[i], len);
 
 		offset += len;
 	}
 
+	stle_u64v(buf, w, nbyte);
+
 	if (pn)
 		*pn = (offset + 7) / 8;
 
@@ -233,9 +290,12 @@ co_pdo_unmap(const struct co_pdo_map_par *par, const uint_least8_t *buf,
 	assert(par);
 	assert(buf);
 
-	if (par->n > CO_PDO_NUM_MAPS)
+	if (par->n > CO_PDO_NUM_MAPS || n > CAN_MAX_LEN)
 		return CO_SDO_AC_PDO_LEN;
 
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	ldle_u64v(w, buf, n);
+
 	size_t offset = 0;
 	for (size_t i = 0; i < par->n; i++) {
 		co_unsigned32_t map = par->map[i];
@@ -246,10 +306,8 @@ co_pdo_unmap(const struct co_pdo_map_par *par, const uint_least8_t *buf,
 		if (offset + len > n * 8)
 			return CO_SDO_AC_PDO_LEN;
 
-		uint_least8_t tmp[sizeof(co_unsigned64_t)] = { 0 };
-		bcpyle(tmp, 0, buf, offset, len);
 		if (val && pn && i < *pn)
-			val[i] = ldle_u64(tmp);
+			val[i] = bgetle(w, offset, len);
 
 		offset += len;
 	}
@@ -273,6 +331,9 @@ co_pdo_dn(const struct co_pdo_map_par *par, co_dev_t *dev,
 	if (n > CAN_MAX_LEN)
 		return CO_SDO_AC_PDO_LEN;
 
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	ldle_u64v(w, buf, n);
+
 	size_t offset = 0;
 	for (size_t i = 0; i < MIN(par->n, CO_PDO_NUM_MAPS); i++) {
 		co_unsigned32_t map = par->map[i];
@@ -296,11 +357,10 @@ co_pdo_dn(const struct co_pdo_map_par *par, co_dev_t *dev,
 		co_sub_t *sub = co_dev_find_sub(dev, idx, subidx);
 		if (sub) {
 			// Copy the value and download it into the sub-object.
-			uint_least8_t tmp[CAN_MAX_LEN] = { 0 };
-			bcpyle(tmp, 0, buf, offset, len);
+			uint_least8_t tmp[sizeof(co_unsigned64_t)];
 			co_sdo_req_clear(req);
 			req->size = (len + 7) / 8;
-			req->buf = tmp;
+			req->buf = co_pdo_get_val(w, buf, offset, len, tmp);
 			req->nbyte = req->size;
 			ac = co_sub_dn_ind(sub, req, 0);
 			if (ac)
@@ -323,6 +383,10 @@ co_pdo_up(const struct co_pdo_map_par *par, const co_dev_t *dev,
 	assert(dev);
 	assert(req);
 
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	size_t nbyte = buf && pn ? MIN(*pn, CAN_MAX_LEN) : 0;
+	ldle_u64v(w, buf, nbyte);
+
 	size_t offset = 0;
 	for (size_t i = 0; i < MIN(par->n, CO_PDO_NUM_MAPS); i++) {
 		co_unsigned32_t map = par->map[i];
@@ -350,12 +414,14 @@ co_pdo_up(const struct co_pdo_map_par *par, const co_dev_t *dev,
 			return ac;
 		if (!co_sdo_req_first(req) || !co_sdo_req_last(req))
 			return CO_SDO_AC_PDO_LEN;
-		if (buf && pn && offset + len <= *pn * 8)
-			bcpyle(buf, offset, req->buf, 0, len);
+		if (offset + len <= nbyte * 8)
+			co_pdo_set_val(w, offset, len, req->buf, req->nbyte);
 
 		offset += len;
 	}
 
+	stle_u64v(buf, w, nbyte);
+
 	if (pn)
 		*pn = (offset + 7) / 8;
 
@@ -363,6 +429,173 @@ co_pdo_up(const struct co_pdo_map_par *par, const co_dev_t *dev,
 }
 #endif // !LELY_NO_CO_TPDO
 
+void
+co_pdo_plan_init(struct co_pdo_plan *plan, const struct co_pdo_map_par *par,
+		const co_dev_t *dev)
+{
+	assert(plan);
+	assert(par);
+	assert(dev);
+
+	plan->n = 0;
+	co_unsigned16_t offset = 0;
+	for (size_t i = 0; i < MIN(par->n, CO_PDO_NUM_MAPS); i++) {
+		co_unsigned32_t map = par->map[i];
+		if (!map)
+			continue;
+
+		struct co_pdo_plan_ent *ent = &plan->ent[plan->n++];
+		ent->idx = (map >> 16) & 0xffff;
+		ent->subidx = (map >> 8) & 0xff;
+		ent->len = map & 0xff;
+		ent->offset = offset;
+
+		// Dummy entries are always looked up when the PDO is processed,
+		// since the dummy mapping can be changed at any time.
+		if (co_type_is_basic(ent->idx) && !ent->subidx)
+			ent->sub = NULL;
+		else
+			ent->sub = co_dev_find_sub(dev, ent->idx, ent->subidx);
+
+		offset += ent->len;
+	}
+	plan->bits = offset;
+}
+
+#if !LELY_NO_CO_RPDO
+co_unsigned32_t
+co_pdo_plan_dn(const struct co_pdo_plan *plan, co_dev_t *dev,
+		struct co_sdo_req *req, const uint_least8_t *buf, size_t n)
+{
+	assert(plan);
+	assert(dev);
+	assert(req);
+	assert(buf);
+
+	if (n > CAN_MAX_LEN)
+		return CO_SDO_AC_PDO_LEN;
+
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	ldle_u64v(w, buf, n);
+
+	for (size_t i = 0; i < plan->n; i++) {
+		const struct co_pdo_plan_ent *ent = &plan->ent[i];
+
+		// Check the PDO length.
+		if ((size_t)ent->offset + ent->len > n * 8)
+			return CO_SDO_AC_PDO_LEN;
+
+		co_sub_t *sub = ent->sub;
+		co_unsigned32_t ac = 0;
+		if (sub) {
+			ac = co_sub_chk_rpdo(sub);
+		} else {
+			// Fall back to a lookup for dummy entries and objects
+			// that did not exist when the plan was compiled.
+			ac = co_dev_chk_rpdo(dev, ent->idx, ent->subidx);
+			if (!ac)
+				sub = co_dev_find_sub(dev, ent->idx, ent->subidx);
+		}
+		if (ac)
+			return ac;
+		if (!sub)
+			continue;
+
+		uint_least8_t tmp[sizeof(co_unsigned64_t)];
+		const uint_least8_t *val = co_pdo_get_val(
+				w, buf, ent->offset, ent->len, tmp);
+		size_t nbyte = (ent->len + 7) / 8;
+		if (sub->dn_ind == &co_sub_default_dn_ind
+				&& co_type_is_basic(sub->type)) {
+			ac = co_sub_dn_basic(sub, val, nbyte);
+		} else {
+			co_sdo_req_clear(req);
+			req->size = nbyte;
+			req->buf = val;
+			req->nbyte = req->size;
+			ac = co_sub_dn_ind(sub, req, 0);
+		}
+		if (ac)
+			return ac;
+	}
+
+	return 0;
+}
+#endif // !LELY_NO_CO_RPDO
+
+#if !LELY_NO_CO_TPDO
+co_unsigned32_t
+co_pdo_plan_up(const struct co_pdo_plan *plan, const co_dev_t *dev,
+		struct co_sdo_req *req, uint_least8_t *buf, size_t *pn)
+{
+	assert(plan);
+	assert(dev);
+	assert(req);
+
+	uint_least64_t w[CO_PDO_NUM_WORDS] = { 0 };
+	size_t nbyte = buf && pn ? MIN(*pn, CAN_MAX_LEN) : 0;
+	ldle_u64v(w, buf, nbyte);
+
+	for (size_t i = 0; i < plan->n; i++) {
+		const struct co_pdo_plan_ent *ent = &plan->ent[i];
+
+		// Check the PDO length.
+		if ((size_t)ent->offset + ent->len > CAN_MAX_LEN * 8)
+			return CO_SDO_AC_PDO_LEN;
+
+		const co_sub_t *sub = ent->sub;
+		co_unsigned32_t ac = 0;
+		if (sub) {
+			ac = co_sub_chk_tpdo(sub);
+		} else {
+			ac = co_dev_chk_tpdo(dev, ent->idx, ent->subidx);
+			if (!ac)
+				sub = co_dev_find_sub(dev, ent->idx, ent->subidx);
+		}
+		if (ac)
+			return ac;
+		assert(sub);
+
+		int copy = (size_t)ent->offset + ent->len <= nbyte * 8;
+#if LELY_NO_CO_OBJ_UPLOAD
+		if (sub->val && co_type_is_basic(sub->type)) {
+#else
+		if (sub->up_ind == &co_sub_default_up_ind && sub->val
+				&& co_type_is_basic(sub->type)) {
+#endif
+			// Copy the value directly from the sub-object.
+			if (copy) {
+				uint_least8_t tmp[sizeof(co_unsigned64_t)] = {
+					0
+				};
+				co_val_write(sub->type, sub->val, tmp,
+						tmp + sizeof(tmp));
+				bsetle(w, ent->offset, ldle_u64(tmp), ent->len);
+			}
+			continue;
+		}
+
+		// Upload the value of the sub-object and copy the value.
+		co_sdo_req_clear(req);
+		ac = co_sub_up_ind(sub, req, 0);
+		if (ac)
+			return ac;
+		if (!co_sdo_req_first(req) || !co_sdo_req_last(req))
+			return CO_SDO_AC_PDO_LEN;
+		if (copy)
+			co_pdo_set_val(w, ent->offset, ent->len, req->buf,
+					req->nbyte);
+	}
+
+	stle_u64v(buf, w, nbyte);
+
+	if (pn)
+		*pn = (plan->bits + 7) / 8;
+
+	return 0;
+}
+#endif // !LELY_NO_CO_TPDO
+
 static co_unsigned32_t
 co_dev_cfg_pdo_comm(const co_dev_t *dev, co_unsigned16_t idx,
 		const struct co_pdo_comm_par *par)
@@ -467,4 +700,92 @@ co_dev_cfg_pdo_map(const co_dev_t *dev, co_unsigned16_t idx,
 	return co_sub_dn_ind_val(sub_00, CO_DEFTYPE_UNSIGNED8, &par->n, NULL);
 }
 
+#if !LELY_NO_CO_RPDO
+
+static co_unsigned32_t
+co_sub_chk_rpdo(const co_sub_t *sub)
+{
+	assert(sub);
+
+	unsigned int access = co_sub_get_access(sub);
+	if (!(access & CO_ACCESS_WRITE))
+		return CO_SDO_AC_NO_WRITE;
+
+	if (!co_sub_get_pdo_mapping(sub) || !(access & CO_ACCESS_RPDO))
+		return CO_SDO_AC_NO_PDO;
+
+	return 0;
+}
+
+static co_unsigned32_t
+co_sub_dn_basic(co_sub_t *sub, const uint_least8_t *buf, size_t nbyte)
+{
+	assert(sub);
+	assert(buf);
+
+	co_unsigned16_t type = co_sub_get_type(sub);
+	assert(co_type_is_basic(type));
+
+	// Read the value and check its size, as co_sdo_req_dn_val() would.
+	union co_val val;
+	size_t size = co_val_read(type, &val, buf, buf + nbyte);
+	if (!size)
+		return CO_SDO_AC_TYPE_LEN_LO;
+	else if (size < nbyte)
+		return CO_SDO_AC_TYPE_LEN_HI;
+
+#if !LELY_NO_CO_OBJ_LIMITS
+	// Accept the value if it is within bounds.
+	co_unsigned32_t ac = co_sub_chk_val(sub, type, &val);
+	if (ac)
+		return ac;
+#endif
+
+	co_sub_dn(sub, &val);
+
+	return 0;
+}
+
+static inline const uint_least8_t *
+co_pdo_get_val(const uint_least64_t *w, const uint_least8_t *buf,
+		size_t offset, size_t len, uint_least8_t tmp[8])
+{
+	// Byte-aligned values can be read in place.
+	if (!(offset % 8) && !(len % 8))
+		return buf + offset / 8;
+
+	stle_u64(tmp, bgetle(w, offset, len));
+	return tmp;
+}
+
+#endif // !LELY_NO_CO_RPDO
+
+#if !LELY_NO_CO_TPDO
+
+static co_unsigned32_t
+co_sub_chk_tpdo(const co_sub_t *sub)
+{
+	assert(sub);
+
+	unsigned int access = co_sub_get_access(sub);
+	if (!(access & CO_ACCESS_READ))
+		return CO_SDO_AC_NO_READ;
+
+	if (!co_sub_get_pdo_mapping(sub) || !(access & CO_ACCESS_TPDO))
+		return CO_SDO_AC_NO_PDO;
+
+	return 0;
+}
+
+static inline void
+co_pdo_set_val(uint_least64_t *w, size_t offset, size_t len, const void *ptr,
+		size_t n)
+{
+	uint_least64_t x = 0;
+	ldle_u64v(&x, ptr, MIN(n, sizeof(x)));
+	bsetle(w, offset, x, len);
+}
+
+#endif // !LELY_NO_CO_TPDO
+
 #endif // !LELY_NO_CO_RPDO || !LELY_NO_CO_TPDO
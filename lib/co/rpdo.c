@@ -25,6 +25,7 @@
 
 #if !LELY_NO_CO_RPDO
 
+#include <lely/co/detail/dev.h>
 #include <lely/co/dev.h>
 #include <lely/co/obj.h>
 #include <lely/co/rpdo.h>
@@ -52,16 +53,20 @@ struct co_rpdo {
 	struct co_pdo_comm_par comm;
 	/// The PDO mapping parameter.
 	struct co_pdo_map_par map;
+	/// The compiled PDO mapping.
+	struct co_pdo_plan plan;
 	/// A pointer to the CAN frame receiver.
 	can_recv_t *recv;
 	/// A pointer to the CAN timer for deadline monitoring.
 	can_timer_t *timer_event;
-	/// A pointer to the CAN timer for the synchronous time window.
-	can_timer_t *timer_swnd;
 	/// A flag indicating we're waiting for a SYNC object to process #msg.
 	unsigned int sync : 1;
 	/// A flag indicating the synchronous time window has expired.
 	unsigned int swnd : 1;
+	/// A flag indicating whether #swnd_end is valid.
+	unsigned int swnd_dl : 1;
+	/// The time at which the synchronous time window expires.
+	struct timespec swnd_end;
 	/// A CAN frame waiting for a SYNC object to be processed.
 	struct can_msg msg;
 	/// The CANopen SDO download request used for writing sub-objects.
@@ -103,11 +108,10 @@ static void co_rpdo_init_recv(co_rpdo_t *pdo);
 static void co_rpdo_init_timer_event(co_rpdo_t *pdo);
 
 /**
- * Initializes the CAN timer for the synchronous time window of a Receive-PDO
- * service. This function is invoked by co_rpdo_sync() or when one of the RPDO
- * communication parameters (objects 1400..15FF) is updated.
+ * Returns 1 if the synchronous time window of a Receive-PDO service has
+ * expired, and 0 if not.
  */
-static void co_rpdo_init_timer_swnd(co_rpdo_t *pdo);
+static int co_rpdo_swnd_expired(co_rpdo_t *pdo);
 
 /**
  * The download indication function for (all sub-objects of) CANopen objects
@@ -142,14 +146,6 @@ static int co_rpdo_recv(const struct can_msg *msg, void *data);
  */
 static int co_rpdo_timer_event(const struct timespec *tp, void *data);
 
-/**
- * The CAN timer callback function for the synchronous time window of a
- * Receive-PDO service.
- *
- * @see can_timer_func_t
- */
-static int co_rpdo_timer_swnd(const struct timespec *tp, void *data);
-
 /**
  * Parses a CAN frame received by a Receive-PDO service and updates the
  * corresponding objects in the object dictionary.
@@ -233,16 +229,20 @@ co_rpdo_start(co_rpdo_t *pdo)
 	// Copy the PDO mapping parameter record.
 	memcpy(&pdo->map, co_obj_addressof_val(obj_1600),
 			MIN(co_obj_sizeof_val(obj_1600), sizeof(pdo->map)));
+	co_pdo_plan_init(&pdo->plan, &pdo->map, pdo->dev);
 	// Set the download indication functions PDO mapping parameter record.
 	co_obj_set_dn_ind(obj_1600, &co_1600_dn_ind, pdo);
 
 	pdo->sync = 0;
 	pdo->swnd = 0;
+	pdo->swnd_dl = 0;
 
 	co_rpdo_init_recv(pdo);
 
 	pdo->stopped = 0;
 
+	co_dev_pdo_comm_changed(pdo->dev);
+
 	return 0;
 }
 
@@ -254,7 +254,7 @@ co_rpdo_stop(co_rpdo_t *pdo)
 	if (pdo->stopped)
 		return;
 
-	can_timer_stop(pdo->timer_swnd);
+	pdo->swnd_dl = 0;
 	can_timer_stop(pdo->timer_event);
 
 	can_recv_stop(pdo->recv);
@@ -396,6 +396,27 @@ co_rpdo_sync(co_rpdo_t *pdo, co_unsigned8_t cnt)
 {
 	assert(pdo);
 
+	// Ignore the synchronous window length unless the RPDO is valid and
+	// synchronous.
+	if ((pdo->comm.cobid & CO_PDO_COBID_VALID) || pdo->comm.trans > 0xf0)
+		return co_rpdo_sync_swnd(pdo, cnt, NULL);
+
+	co_unsigned32_t swnd = co_dev_get_val_u32(pdo->dev, 0x1007, 0x00);
+	if (!swnd)
+		return co_rpdo_sync_swnd(pdo, cnt, NULL);
+
+	struct timespec end = { 0, 0 };
+	can_net_get_time(pdo->net, &end);
+	timespec_add_usec(&end, swnd);
+	return co_rpdo_sync_swnd(pdo, cnt, &end);
+}
+
+int
+co_rpdo_sync_swnd(co_rpdo_t *pdo, co_unsigned8_t cnt,
+		const struct timespec *end)
+{
+	assert(pdo);
+
 	if (cnt > 240) {
 		set_errnum(ERRNUM_INVAL);
 		return -1;
@@ -411,7 +432,9 @@ co_rpdo_sync(co_rpdo_t *pdo, co_unsigned8_t cnt)
 
 	// Reset the time window for synchronous PDOs.
 	pdo->swnd = 0;
-	co_rpdo_init_timer_swnd(pdo);
+	pdo->swnd_dl = !!end;
+	if (end)
+		pdo->swnd_end = *end;
 
 	// Check if we have a CAN frame waiting for a SYNC object.
 	if (!pdo->sync)
@@ -453,23 +476,19 @@ co_rpdo_init_timer_event(co_rpdo_t *pdo)
 		can_timer_timeout(pdo->timer_event, pdo->net, pdo->comm.event);
 }
 
-static void
-co_rpdo_init_timer_swnd(co_rpdo_t *pdo)
+static int
+co_rpdo_swnd_expired(co_rpdo_t *pdo)
 {
 	assert(pdo);
-	assert(pdo->comm.trans <= 0xf0);
-	assert(!(pdo->comm.cobid & CO_PDO_COBID_VALID));
 
-	can_timer_stop(pdo->timer_swnd);
-	// Ignore the synchronous window length unless the RPDO is valid and
-	// synchronous.
-	co_unsigned32_t swnd = co_dev_get_val_u32(pdo->dev, 0x1007, 0x00);
-	if (swnd) {
-		struct timespec start = { 0, 0 };
-		can_net_get_time(pdo->net, &start);
-		timespec_add_usec(&start, swnd);
-		can_timer_start(pdo->timer_swnd, pdo->net, &start, NULL);
+	if (!pdo->swnd && pdo->swnd_dl) {
+		struct timespec now = { 0, 0 };
+		can_net_get_time(pdo->net, &now);
+		if (timespec_cmp(&now, &pdo->swnd_end) >= 0)
+			pdo->swnd = 1;
 	}
+
+	return pdo->swnd;
 }
 
 static co_unsigned32_t
@@ -519,10 +538,11 @@ co_1400_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 
 		pdo->sync = 0;
 		pdo->swnd = 0;
+		pdo->swnd_dl = 0;
 
 		co_rpdo_init_recv(pdo);
 		co_rpdo_init_timer_event(pdo);
-		can_timer_stop(pdo->timer_swnd);
+		co_dev_pdo_comm_changed(pdo->dev);
 		break;
 	}
 	case 2: {
@@ -538,6 +558,7 @@ co_1400_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 
 		pdo->comm.trans = trans;
 
+		co_dev_pdo_comm_changed(pdo->dev);
 		break;
 	}
 	case 3: {
@@ -629,6 +650,7 @@ co_1600_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 		}
 
 		pdo->map.n = n;
+		co_pdo_plan_init(&pdo->plan, &pdo->map, pdo->dev);
 	} else {
 		assert(type == CO_DEFTYPE_UNSIGNED32);
 		co_unsigned32_t map = val.u32;
@@ -676,7 +698,7 @@ co_rpdo_recv(const struct can_msg *msg, void *data)
 	if (pdo->comm.trans <= 0xf0) {
 		// In case of a synchronous RPDO, save the frame to be processed
 		// after the next SYNC object.
-		if (!pdo->swnd) {
+		if (!co_rpdo_swnd_expired(pdo)) {
 			pdo->sync = 1;
 			pdo->msg = *msg;
 		}
@@ -704,19 +726,6 @@ co_rpdo_timer_event(const struct timespec *tp, void *data)
 	return 0;
 }
 
-static int
-co_rpdo_timer_swnd(const struct timespec *tp, void *data)
-{
-	(void)tp;
-	co_rpdo_t *pdo = data;
-	assert(pdo);
-
-	// The synchronous time window has expired.
-	pdo->swnd = 1;
-
-	return 0;
-}
-
 static co_unsigned32_t
 co_rpdo_read_frame(co_rpdo_t *pdo, const struct can_msg *msg)
 {
@@ -724,8 +733,8 @@ co_rpdo_read_frame(co_rpdo_t *pdo, const struct can_msg *msg)
 	assert(msg);
 
 	size_t n = MIN(msg->len, CAN_MAX_LEN);
-	co_unsigned32_t ac =
-			co_pdo_dn(&pdo->map, pdo->dev, &pdo->req, msg->data, n);
+	co_unsigned32_t ac = co_pdo_plan_dn(
+			&pdo->plan, pdo->dev, &pdo->req, msg->data, n);
 
 #if !defined(NDEBUG) && !LELY_NO_STDIO && !LELY_NO_DIAG
 	if (ac)
@@ -742,15 +751,10 @@ co_rpdo_read_frame(co_rpdo_t *pdo, const struct can_msg *msg)
 			// Generate an error message if the PDO was not
 			// processed because too few bytes were available.
 			pdo->err(pdo, 0x8210, 0x10, pdo->err_data);
-		} else if (!ac) {
-			size_t offset = 0;
-			for (size_t i = 0; i < MIN(pdo->map.n, CO_PDO_NUM_MAPS);
-					i++)
-				offset += (pdo->map.map[i]) & 0xff;
-			if ((offset + 7) / 8 < n)
-				// Generate an error message if the PDO length
-				// exceeds the mapping.
-				pdo->err(pdo, 0x8220, 0x10, pdo->err_data);
+		} else if (!ac && (size_t)(pdo->plan.bits + 7) / 8 < n) {
+			// Generate an error message if the PDO length exceeds
+			// the mapping.
+			pdo->err(pdo, 0x8220, 0x10, pdo->err_data);
 		}
 	}
 
@@ -808,6 +812,7 @@ co_rpdo_init(co_rpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 
 	memset(&pdo->comm, 0, sizeof(pdo->comm));
 	memset(&pdo->map, 0, sizeof(pdo->map));
+	memset(&pdo->plan, 0, sizeof(pdo->plan));
 
 	pdo->recv = can_recv_create(co_rpdo_get_alloc(pdo));
 	if (!pdo->recv) {
@@ -823,15 +828,10 @@ co_rpdo_init(co_rpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 	}
 	can_timer_set_func(pdo->timer_event, &co_rpdo_timer_event, pdo);
 
-	pdo->timer_swnd = can_timer_create(co_rpdo_get_alloc(pdo));
-	if (!pdo->timer_swnd) {
-		errc = get_errc();
-		goto error_create_timer_swnd;
-	}
-	can_timer_set_func(pdo->timer_swnd, &co_rpdo_timer_swnd, pdo);
-
 	pdo->sync = 0;
 	pdo->swnd = 0;
+	pdo->swnd_dl = 0;
+	pdo->swnd_end = (struct timespec){ 0, 0 };
 	pdo->msg = (struct can_msg)CAN_MSG_INIT;
 
 	co_sdo_req_init(&pdo->req, NULL);
@@ -843,9 +843,7 @@ co_rpdo_init(co_rpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 
 	return pdo;
 
-	// can_timer_destroy(pdo->timer_swnd);
-error_create_timer_swnd:
-	can_timer_destroy(pdo->timer_event);
+	// can_timer_destroy(pdo->timer_event);
 error_create_timer_event:
 	can_recv_destroy(pdo->recv);
 error_create_recv:
@@ -864,7 +862,6 @@ co_rpdo_fini(co_rpdo_t *pdo)
 
 	co_sdo_req_fini(&pdo->req);
 
-	can_timer_destroy(pdo->timer_swnd);
 	can_timer_destroy(pdo->timer_event);
 	can_recv_destroy(pdo->recv);
 }
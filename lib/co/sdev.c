@@ -25,6 +25,10 @@
 
 #if !LELY_NO_CO_SDEV
 
+#if !LELY_NO_STDIO
+#include <lely/co/detail/dev.h>
+#include <lely/co/detail/obj.h>
+#endif
 #include <lely/co/sdev.h>
 #include <lely/compat/stdio.h>
 #include <lely/util/error.h>
@@ -48,9 +52,29 @@ static int co_ssub_load(const struct co_ssub *ssub, co_sub_t *sub);
 #if !LELY_NO_STDIO
 static int snprintf_c99_sobj(char *s, size_t n, const co_obj_t *obj);
 static int snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub);
+static int snprintf_c99_code(char *s, size_t n, co_unsigned8_t code);
+static int snprintf_c99_type(char *s, size_t n, co_unsigned16_t type);
+static int snprintf_c99_access(char *s, size_t n, unsigned int access);
+static int snprintf_c99_flags(
+		char *s, size_t n, unsigned int flags, const char *indent);
 static int snprintf_c99_sval(
 		char *s, size_t n, co_unsigned16_t type, const void *val);
+static int snprintf_c99_val(
+		char *s, size_t n, co_unsigned16_t type, const void *val);
 static int snprintf_c99_esc(char *s, size_t n, const char *esc);
+static int snprintf_c99_dev_obj(
+		char *s, size_t n, const co_obj_t *obj, const char *name);
+static int snprintf_c99_dev_sub(
+		char *s, size_t n, const co_sub_t *sub, const char *name);
+static int snprintf_c99_dev_rbnode(char *s, size_t n,
+		const struct rbnode *node, const char *name, const char *key,
+		int is_sub);
+static int snprintf_c99_dev_node(char *s, size_t n, const struct rbnode *node,
+		const char *name, int is_sub);
+static int snprintf_c99_dev_str(
+		char *s, size_t n, const char *member, const char *str);
+/// Returns 1 if at least one of the sub-objects of <b>obj</b> has a value.
+static int co_obj_has_c99_val(const co_obj_t *obj);
 #endif
 
 co_dev_t *
@@ -433,393 +457,348 @@ asprintf_c99_sdev(char **ps, const co_dev_t *dev)
 	return n;
 }
 
-#endif // !LELY_NO_STDIO
-
-static int
-co_sdev_load(const struct co_sdev *sdev, co_dev_t *dev)
-{
-	assert(sdev);
-	assert(dev);
-
-#if !LELY_NO_CO_OBJ_NAME
-	if (co_dev_set_name(dev, sdev->name) == -1)
-		return -1;
-
-	if (co_dev_set_vendor_name(dev, sdev->vendor_name) == -1)
-		return -1;
-#endif
-
-	co_dev_set_vendor_id(dev, sdev->vendor_id);
-
-#if !LELY_NO_CO_OBJ_NAME
-	if (co_dev_set_product_name(dev, sdev->product_name) == -1)
-		return -1;
-#endif
-
-	co_dev_set_product_code(dev, sdev->product_code);
-	co_dev_set_revision(dev, sdev->revision);
-
-#if !LELY_NO_CO_OBJ_NAME
-	if (co_dev_set_order_code(dev, sdev->order_code) == -1)
-		return -1;
-#endif
-
-	co_dev_set_baud(dev, sdev->baud);
-	co_dev_set_rate(dev, sdev->rate);
-
-	co_dev_set_lss(dev, sdev->lss);
-
-	co_dev_set_dummy(dev, sdev->dummy);
-
-	for (size_t i = 0; i < sdev->nobj; i++) {
-		const struct co_sobj *sobj = &sdev->objs[i];
-		co_obj_t *obj = co_obj_create(sobj->idx);
-		if (!obj)
-			return -1;
-		if (co_dev_insert_obj(dev, obj) == -1) {
-			int errc = get_errc();
-			co_obj_destroy(obj);
-			set_errc(errc);
-			return -1;
-		}
-		if (co_sobj_load(sobj, obj) == -1)
-			return -1;
-	}
-
-	return 0;
-}
-
-static int
-co_sobj_load(const struct co_sobj *sobj, co_obj_t *obj)
-{
-	assert(sobj);
-	assert(obj);
-
-#if !LELY_NO_CO_OBJ_NAME
-	if (co_obj_set_name(obj, sobj->name) == -1)
-		return -1;
-#endif
-
-	if (co_obj_set_code(obj, sobj->code) == -1)
-		return -1;
-
-	for (size_t i = 0; i < sobj->nsub; i++) {
-		const struct co_ssub *ssub = &sobj->subs[i];
-		co_sub_t *sub = co_sub_create(ssub->subidx, ssub->type);
-		if (!sub)
-			return -1;
-		if (co_obj_insert_sub(obj, sub) == -1) {
-			int errc = get_errc();
-			co_sub_destroy(sub);
-			set_errc(errc);
-			return -1;
-		}
-		if (co_ssub_load(ssub, sub) == -1)
-			return -1;
-	}
-
-	return 0;
-}
-
-static int
-co_ssub_load(const struct co_ssub *ssub, co_sub_t *sub)
-{
-	assert(ssub);
-	assert(sub);
-
-#if !LELY_NO_CO_OBJ_NAME
-	if (co_sub_set_name(sub, ssub->name) == -1)
-		return -1;
-#endif
-
-	if (co_sub_set_access(sub, ssub->access) == -1)
-		return -1;
-
-	const void *ptr;
-	size_t n;
-
-#if !LELY_NO_CO_OBJ_LIMITS
-	ptr = co_val_addressof(ssub->type, &ssub->min);
-	n = co_val_sizeof(ssub->type, &ssub->min);
-	if (n && !co_sub_set_min(sub, ptr, n))
-		return -1;
-
-	ptr = co_val_addressof(ssub->type, &ssub->max);
-	n = co_val_sizeof(ssub->type, &ssub->max);
-	if (n && !co_sub_set_max(sub, ptr, n))
-		return -1;
-#endif
-
-#if !LELY_NO_CO_OBJ_DEFAULT
-	ptr = co_val_addressof(ssub->type, &ssub->def);
-	n = co_val_sizeof(ssub->type, &ssub->def);
-	if (n && !co_sub_set_def(sub, ptr, n))
-		return -1;
-#endif
-
-	ptr = co_val_addressof(ssub->type, &ssub->val);
-	n = co_val_sizeof(ssub->type, &ssub->val);
-	if (n && !co_sub_set_val(sub, ptr, n))
-		return -1;
-
-	co_sub_set_pdo_mapping(sub, ssub->pdo_mapping);
-	co_sub_set_flags(sub, ssub->flags);
-
-	return 0;
-}
-
-#if !LELY_NO_STDIO
-
-static int
-snprintf_c99_sobj(char *s, size_t n, const co_obj_t *obj)
+int
+snprintf_c99_dev(char *s, size_t n, const co_dev_t *dev, const char *name)
 {
 	if (!s)
 		n = 0;
 
-	if (!obj)
+	if (!dev || !name)
 		return 0;
 
 	int r, t = 0;
+	const char *str;
 
-#if !LELY_NO_CO_OBJ_NAME
-	const char *name = co_obj_get_name(obj);
-	if (name) {
-		r = snprintf(s, n,
-				"#if !LELY_NO_CO_OBJ_NAME\n\t\t.name = CO_SDEV_STRING(\"");
-		if (r < 0)
-			return r;
-		t += r;
-		r = MIN((size_t)r, n);
-		s += r;
-		n -= r;
-		r = snprintf_c99_esc(s, n, name);
-		if (r < 0)
-			return r;
-		t += r;
-		r = MIN((size_t)r, n);
-		s += r;
-		n -= r;
-		r = snprintf(s, n, "\"),\n");
-	} else {
-#endif
-		r = snprintf(s, n,
-				"#if !LELY_NO_CO_OBJ_NAME\n\t\t.name = NULL,\n");
-#if !LELY_NO_CO_OBJ_NAME
-	}
-#endif
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	r = snprintf(s, n, "#endif\n\t\t.idx = 0x%04x,\n\t\t.code = ",
-			co_obj_get_idx(obj));
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	co_unsigned8_t code = co_obj_get_code(obj);
-	switch (code) {
-	case CO_OBJECT_NULL: r = snprintf(s, n, "CO_OBJECT_NULL,\n"); break;
-	case CO_OBJECT_DOMAIN: r = snprintf(s, n, "CO_OBJECT_DOMAIN,\n"); break;
-	case CO_OBJECT_DEFTYPE:
-		r = snprintf(s, n, "CO_OBJECT_DEFTYPE,\n");
-		break;
-	case CO_OBJECT_DEFSTRUCT:
-		r = snprintf(s, n, "CO_OBJECT_DEFSTRUCT,\n");
-		break;
-	case CO_OBJECT_VAR: r = snprintf(s, n, "CO_OBJECT_VAR,\n"); break;
-	case CO_OBJECT_ARRAY: r = snprintf(s, n, "CO_OBJECT_ARRAY,\n"); break;
-	case CO_OBJECT_RECORD: r = snprintf(s, n, "CO_OBJECT_RECORD,\n"); break;
-	default: r = snprintf(s, n, "0x%02x,\n", code); break;
-	}
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	co_unsigned8_t subidx[0xff];
-	co_unsigned8_t maxsubidx = co_obj_get_subidx(obj, 0xff, subidx);
-
-	r = snprintf(s, n,
-			"\t\t.nsub = %d,\n\t\t.subs = (const struct co_ssub[]){",
-			maxsubidx);
+	// All objects and sub-objects are declared up front, since the
+	// pre-linked trees refer to them in arbitrary order.
+	r = snprintf(s, n, "extern co_dev_t %s;\n\n", name);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-
-	for (size_t i = 0; i < maxsubidx; i++) {
-		r = snprintf(s, n, i ? ", {\n" : "{\n");
+	size_t nobj = 0;
+	size_t nsub = 0;
+	size_t nval = 0;
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj)) {
+		r = snprintf(s, n, "static co_obj_t %s_%04X;\n", name,
+				obj->idx);
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
-		r = snprintf_c99_ssub(s, n, co_obj_find_sub(obj, subidx[i]));
+		nobj++;
+		for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+				sub = co_sub_next(sub)) {
+			r = snprintf(s, n, "static co_sub_t %s_%04Xsub%X;\n",
+					name, obj->idx, sub->subidx);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+			nsub++;
+			if (co_type_sizeof(sub->type))
+				nval++;
+		}
+	}
+
+	// The values of all sub-objects are stored in a single writable block,
+	// with the same layout as the one generated by co_obj_update().
+	if (nval) {
+		r = snprintf(s, n, "\nstatic struct {\n");
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
-		r = snprintf(s, n, "\t\t}");
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			if (!co_obj_has_c99_val(obj))
+				continue;
+			r = snprintf(s, n, "\tstruct {\n");
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+			for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+					sub = co_sub_next(sub)) {
+				switch (sub->type) {
+#define LELY_CO_DEFINE_TYPE(a, b, c, d) \
+	case CO_DEFTYPE_##a: \
+		r = snprintf(s, n, "\t\tco_" #b "_t sub%X;\n", sub->subidx); \
+		break;
+#include <lely/co/def/type.def>
+#undef LELY_CO_DEFINE_TYPE
+				default: r = 0; break;
+				}
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+			}
+			r = snprintf(s, n, "\t} obj%04X;\n", obj->idx);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+		}
+		r = snprintf(s, n, "} %s_val = {\n", name);
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
-	}
-
-	r = snprintf(s, n, "}\n");
-	if (r < 0)
-		return r;
-	t += r;
-
-	return t;
-}
-
-static int
-snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
-{
-	if (!s)
-		n = 0;
-
-	if (!sub)
-		return 0;
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			if (!co_obj_has_c99_val(obj))
+				continue;
+			r = snprintf(s, n, "\t.obj%04X = {\n", obj->idx);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+			for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+					sub = co_sub_next(sub)) {
+				if (!co_type_sizeof(sub->type))
+					continue;
+				r = snprintf(s, n, "\t\t.sub%X = ",
+						sub->subidx);
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+#if !LELY_NO_CO_OBJ_FILE
+				// clang-format off
+				if (sub->type == CO_DEFTYPE_DOMAIN
+						&& (sub->flags & (CO_OBJ_FLAGS_UPLOAD_FILE
+						| CO_OBJ_FLAGS_DOWNLOAD_FILE)))
+					// clang-format on
+					r = snprintf_c99_val(s, n,
+							CO_DEFTYPE_VISIBLE_STRING,
+							sub->val);
+				else
+#endif
+					r = snprintf_c99_val(s, n, sub->type,
+							sub->val);
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+				r = snprintf(s, n, ",\n");
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+			}
+			r = snprintf(s, n, "\t},\n");
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+		}
+		r = snprintf(s, n, "};\n");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+	}
 
-	int r, t = 0;
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj)) {
+		r = snprintf(s, n, "\n");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf_c99_dev_obj(s, n, obj, name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+				sub = co_sub_next(sub)) {
+			r = snprintf(s, n, "\n");
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+			r = snprintf_c99_dev_sub(s, n, sub, name);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+		}
+	}
 
-#if !LELY_NO_CO_OBJ_NAME
-	const char *name = co_sub_get_name(sub);
-	if (name) {
+	// The sorted lookup tables of a frozen object dictionary (see
+	// co_dev_freeze()) are read-only.
+	if (nobj) {
+		r = snprintf(s, n, "\nstatic co_obj_t *const %s_obj[] = {\n",
+				name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			r = snprintf(s, n, "\t&%s_%04X,\n", name, obj->idx);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+		}
 		r = snprintf(s, n,
-				"#if !LELY_NO_CO_OBJ_NAME\n\t\t\t.name = CO_SDEV_STRING(\"");
+				"};\n\nstatic const co_unsigned16_t %s_idx[] = {\n",
+				name);
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
-		r = snprintf_c99_esc(s, n, name);
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			r = snprintf(s, n, "\t0x%04x,\n", obj->idx);
+			if (r < 0)
+				return r;
+			t += r;
+			r = MIN((size_t)r, n);
+			s += r;
+			n -= r;
+		}
+		r = snprintf(s, n, "};\n");
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
-		r = snprintf(s, n, "\"),\n");
-	} else {
-#endif
-		r = snprintf(s, n,
-				"#if !LELY_NO_CO_OBJ_NAME\n\t\t\t.name = NULL,\n");
-#if !LELY_NO_CO_OBJ_NAME
 	}
-#endif
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	r = snprintf(s, n, "#endif\n\t\t\t.subidx = 0x%02x,\n\t\t\t.type = ",
-			co_sub_get_subidx(sub));
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	co_unsigned16_t type = co_sub_get_type(sub);
-	switch (type) {
-#define LELY_CO_DEFINE_TYPE(a, b, c, d) \
-	case CO_DEFTYPE_##a: \
-		r = snprintf(s, n, "CO_DEFTYPE_" #a ",\n"); \
-		break;
-#include <lely/co/def/type.def>
-#undef LELY_CO_DEFINE_TYPE
-	default: r = snprintf(s, n, "0x%04x,\n", type); break;
+	if (nsub) {
+		r = snprintf(s, n, "\nstatic co_sub_t *const %s_sub[] = {\n",
+				name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+					sub = co_sub_next(sub)) {
+				r = snprintf(s, n, "\t&%s_%04Xsub%X,\n", name,
+						obj->idx, sub->subidx);
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+			}
+		}
+		r = snprintf(s, n,
+				"};\n\nstatic const co_unsigned32_t %s_key[] = {\n",
+				name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+				obj = co_obj_next(obj)) {
+			for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+					sub = co_sub_next(sub)) {
+				r = snprintf(s, n, "\t0x%04x%02xlu,\n",
+						obj->idx, sub->subidx);
+				if (r < 0)
+					return r;
+				t += r;
+				r = MIN((size_t)r, n);
+				s += r;
+				n -= r;
+			}
+		}
+		r = snprintf(s, n, "};\n");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
 	}
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-
-	r = snprintf(s, n, "#if !LELY_NO_CO_OBJ_LIMITS\n\t\t\t.min = ");
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-#if !LELY_NO_CO_OBJ_LIMITS
-	r = snprintf_c99_sval(s, n, type, co_sub_get_min(sub));
-#else
-	union co_val min;
-	co_val_init_min(type, &min);
-	r = snprintf_c99_sval(s, n, type, &min);
-	co_val_fini(type, &min);
-#endif
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
 
-	r = snprintf(s, n, ",\n\t\t\t.max = ");
+	r = snprintf(s, n,
+			"\nco_dev_t %s = {\n\t.netid = 0x%02x,\n\t.id = 0x%02x,\n"
+			"\t.tree = {\n\t\t.cmp = &uint16_cmp,\n\t\t.root = ",
+			name, dev->netid, dev->id);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-#if !LELY_NO_CO_OBJ_LIMITS
-	r = snprintf_c99_sval(s, n, type, co_sub_get_max(sub));
-#else
-	union co_val max;
-	co_val_init_max(type, &max);
-	r = snprintf_c99_sval(s, n, type, &max);
-	co_val_fini(type, &max);
-#endif
+	r = snprintf_c99_dev_node(s, n, dev->tree.root, name, 0);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-
+	// clang-format off
 	r = snprintf(s, n,
-			",\n#endif\n#if !LELY_NO_CO_OBJ_DEFAULT\n\t\t\t.def = ");
-	if (r < 0)
-		return r;
-	t += r;
-	r = MIN((size_t)r, n);
-	s += r;
-	n -= r;
-#if !LELY_NO_CO_OBJ_DEFAULT
-	r = snprintf_c99_sval(s, n, type, co_sub_get_def(sub));
-#else
-	union co_val def;
-	co_val_init_min(type, &def);
-	r = snprintf_c99_sval(s, n, type, &def);
-	co_val_fini(type, &def);
-#endif
+			",\n\t\t.num_nodes = %zu\n\t},\n\t.frozen = 1,\n"
+			"\t.frozen_obj = %s%s,\n\t.frozen_idx = %s%s,\n"
+			"\t.frozen_nobj = %zu,\n"
+			"\t.frozen_sub = %s%s,\n\t.frozen_key = %s%s,\n"
+			"\t.frozen_nsub = %zu,\n",
+			nobj,
+			nobj ? name : "NULL", nobj ? "_obj" : "",
+			nobj ? name : "NULL", nobj ? "_idx" : "",
+			nobj,
+			nsub ? name : "NULL", nsub ? "_sub" : "",
+			nsub ? name : "NULL", nsub ? "_key" : "",
+			nsub);
+	// clang-format on
 	if (r < 0)
 		return r;
 	t += r;
@@ -827,58 +806,39 @@ snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
 	s += r;
 	n -= r;
 
-	r = snprintf(s, n, ",\n#endif\n\t\t\t.val = ");
+	r = snprintf(s, n, "#if !LELY_NO_CO_OBJ_NAME\n");
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-#if !LELY_NO_CO_OBJ_FILE
-	// clang-format off
-	if (type == CO_DEFTYPE_DOMAIN
-			&& ((co_sub_get_flags(sub) & CO_OBJ_FLAGS_UPLOAD_FILE)
-			|| (co_sub_get_flags(sub)
-					& CO_OBJ_FLAGS_DOWNLOAD_FILE)))
-		// clang-format on
-		r = snprintf_c99_sval(s, n, CO_DEFTYPE_VISIBLE_STRING,
-				co_sub_get_val(sub));
-	else
-#endif
-		r = snprintf_c99_sval(s, n, type, co_sub_get_val(sub));
+	str = co_dev_get_name(dev);
+	r = snprintf_c99_dev_str(s, n, "\t.name = ", str);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-
-	r = snprintf(s, n, ",\n\t\t\t.access = ");
+	str = co_dev_get_vendor_name(dev);
+	r = snprintf_c99_dev_str(s, n, "\t.vendor_name = ", str);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-	unsigned int access = co_sub_get_access(sub);
-	switch (access) {
-	case CO_ACCESS_RO: r = snprintf(s, n, "CO_ACCESS_RO,\n"); break;
-	case CO_ACCESS_WO: r = snprintf(s, n, "CO_ACCESS_WO,\n"); break;
-	case CO_ACCESS_RW: r = snprintf(s, n, "CO_ACCESS_RW,\n"); break;
-	case CO_ACCESS_RWR: r = snprintf(s, n, "CO_ACCESS_RWR,\n"); break;
-	case CO_ACCESS_RWW: r = snprintf(s, n, "CO_ACCESS_RWW,\n"); break;
-	case CO_ACCESS_CONST: r = snprintf(s, n, "CO_ACCESS_CONST,\n"); break;
-	default: r = snprintf(s, n, "0x%x,\n", access); break;
-	}
+	str = co_dev_get_product_name(dev);
+	r = snprintf_c99_dev_str(s, n, "\t.product_name = ", str);
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-
-	r = snprintf(s, n, "\t\t\t.pdo_mapping = %d,\n",
-			co_sub_get_pdo_mapping(sub));
+	str = co_dev_get_order_code(dev);
+	r = snprintf_c99_dev_str(s, n, "\t.order_code = ", str);
 	if (r < 0)
 		return r;
 	t += r;
@@ -886,17 +846,22 @@ snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
 	s += r;
 	n -= r;
 
-	r = snprintf(s, n, "\t\t\t.flags = 0\n");
+	r = snprintf(s, n,
+			"#endif\n\t.vendor_id = 0x%08" PRIx32
+			",\n\t.product_code = 0x%08" PRIx32
+			",\n\t.revision = 0x%08" PRIx32 ",\n\t.baud = 0",
+			co_dev_get_vendor_id(dev), co_dev_get_product_code(dev),
+			co_dev_get_revision(dev));
 	if (r < 0)
 		return r;
 	t += r;
 	r = MIN((size_t)r, n);
 	s += r;
 	n -= r;
-	unsigned int flags = co_sub_get_flags(sub);
-#define LELY_CO_DEFINE_FLAGS(x) \
-	if (flags & CO_OBJ_FLAGS_##x) { \
-		r = snprintf(s, n, "\t\t\t\t| CO_OBJ_FLAGS_" #x "\n"); \
+	unsigned int baud = co_dev_get_baud(dev);
+#define LELY_CO_DEFINE_BAUD(x) \
+	if (baud & CO_BAUD_##x) { \
+		r = snprintf(s, n, "\n\t\t| CO_BAUD_" #x); \
 		if (r < 0) \
 			return r; \
 		t += r; \
@@ -905,18 +870,587 @@ snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
 		n -= r; \
 	}
 
-	LELY_CO_DEFINE_FLAGS(READ)
-	LELY_CO_DEFINE_FLAGS(WRITE)
-#if !LELY_NO_CO_OBJ_FILE
-	LELY_CO_DEFINE_FLAGS(UPLOAD_FILE)
-	LELY_CO_DEFINE_FLAGS(DOWNLOAD_FILE)
-#endif
-	LELY_CO_DEFINE_FLAGS(MIN_NODEID)
-	LELY_CO_DEFINE_FLAGS(MAX_NODEID)
-	LELY_CO_DEFINE_FLAGS(DEF_NODEID)
-	LELY_CO_DEFINE_FLAGS(VAL_NODEID)
-	// cppcheck-suppress uselessAssignmentArg
-	// cppcheck-suppress uselessAssignmentPtrArg
+	LELY_CO_DEFINE_BAUD(1000)
+	LELY_CO_DEFINE_BAUD(800)
+	LELY_CO_DEFINE_BAUD(500)
+	LELY_CO_DEFINE_BAUD(250)
+	LELY_CO_DEFINE_BAUD(125)
+	LELY_CO_DEFINE_BAUD(50)
+	LELY_CO_DEFINE_BAUD(20)
+	LELY_CO_DEFINE_BAUD(10)
+	LELY_CO_DEFINE_BAUD(AUTO)
+
+#undef LELY_CO_DEFINE_BAUD
+
+	r = snprintf(s, n,
+			",\n\t.rate = %d,\n\t.lss = %d,\n\t.dummy = 0x%08" PRIx32
+			"\n};\n",
+			co_dev_get_rate(dev), co_dev_get_lss(dev),
+			co_dev_get_dummy(dev));
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+int
+asprintf_c99_dev(char **ps, const co_dev_t *dev, const char *name)
+{
+	int n = snprintf_c99_dev(NULL, 0, dev, name);
+	if (n < 0)
+		return n;
+
+	char *s = malloc(n + 1);
+	if (!s)
+		return -1;
+
+	n = snprintf_c99_dev(s, n + 1, dev, name);
+	if (n < 0) {
+		int errsv = errno;
+		free(s);
+		errno = errsv;
+		return n;
+	}
+
+	*ps = s;
+	return n;
+}
+
+#endif // !LELY_NO_STDIO
+
+static int
+co_sdev_load(const struct co_sdev *sdev, co_dev_t *dev)
+{
+	assert(sdev);
+	assert(dev);
+
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_dev_set_name(dev, sdev->name) == -1)
+		return -1;
+
+	if (co_dev_set_vendor_name(dev, sdev->vendor_name) == -1)
+		return -1;
+#endif
+
+	co_dev_set_vendor_id(dev, sdev->vendor_id);
+
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_dev_set_product_name(dev, sdev->product_name) == -1)
+		return -1;
+#endif
+
+	co_dev_set_product_code(dev, sdev->product_code);
+	co_dev_set_revision(dev, sdev->revision);
+
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_dev_set_order_code(dev, sdev->order_code) == -1)
+		return -1;
+#endif
+
+	co_dev_set_baud(dev, sdev->baud);
+	co_dev_set_rate(dev, sdev->rate);
+
+	co_dev_set_lss(dev, sdev->lss);
+
+	co_dev_set_dummy(dev, sdev->dummy);
+
+	for (size_t i = 0; i < sdev->nobj; i++) {
+		const struct co_sobj *sobj = &sdev->objs[i];
+		co_obj_t *obj = co_obj_create(sobj->idx);
+		if (!obj)
+			return -1;
+		if (co_dev_insert_obj(dev, obj) == -1) {
+			int errc = get_errc();
+			co_obj_destroy(obj);
+			set_errc(errc);
+			return -1;
+		}
+		if (co_sobj_load(sobj, obj) == -1)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+co_sobj_load(const struct co_sobj *sobj, co_obj_t *obj)
+{
+	assert(sobj);
+	assert(obj);
+
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_obj_set_name(obj, sobj->name) == -1)
+		return -1;
+#endif
+
+	if (co_obj_set_code(obj, sobj->code) == -1)
+		return -1;
+
+	for (size_t i = 0; i < sobj->nsub; i++) {
+		const struct co_ssub *ssub = &sobj->subs[i];
+		co_sub_t *sub = co_sub_create(ssub->subidx, ssub->type);
+		if (!sub)
+			return -1;
+		if (co_obj_insert_sub(obj, sub) == -1) {
+			int errc = get_errc();
+			co_sub_destroy(sub);
+			set_errc(errc);
+			return -1;
+		}
+		if (co_ssub_load(ssub, sub) == -1)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+co_ssub_load(const struct co_ssub *ssub, co_sub_t *sub)
+{
+	assert(ssub);
+	assert(sub);
+
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_sub_set_name(sub, ssub->name) == -1)
+		return -1;
+#endif
+
+	if (co_sub_set_access(sub, ssub->access) == -1)
+		return -1;
+
+	const void *ptr;
+	size_t n;
+
+#if !LELY_NO_CO_OBJ_LIMITS
+	ptr = co_val_addressof(ssub->type, &ssub->min);
+	n = co_val_sizeof(ssub->type, &ssub->min);
+	if (n && !co_sub_set_min(sub, ptr, n))
+		return -1;
+
+	ptr = co_val_addressof(ssub->type, &ssub->max);
+	n = co_val_sizeof(ssub->type, &ssub->max);
+	if (n && !co_sub_set_max(sub, ptr, n))
+		return -1;
+#endif
+
+#if !LELY_NO_CO_OBJ_DEFAULT
+	ptr = co_val_addressof(ssub->type, &ssub->def);
+	n = co_val_sizeof(ssub->type, &ssub->def);
+	if (n && !co_sub_set_def(sub, ptr, n))
+		return -1;
+#endif
+
+	ptr = co_val_addressof(ssub->type, &ssub->val);
+	n = co_val_sizeof(ssub->type, &ssub->val);
+	if (n && !co_sub_set_val(sub, ptr, n))
+		return -1;
+
+	co_sub_set_pdo_mapping(sub, ssub->pdo_mapping);
+	co_sub_set_flags(sub, ssub->flags);
+
+	return 0;
+}
+
+#if !LELY_NO_STDIO
+
+static int
+snprintf_c99_sobj(char *s, size_t n, const co_obj_t *obj)
+{
+	if (!s)
+		n = 0;
+
+	if (!obj)
+		return 0;
+
+	int r, t = 0;
+
+#if !LELY_NO_CO_OBJ_NAME
+	const char *name = co_obj_get_name(obj);
+	if (name) {
+		r = snprintf(s, n,
+				"#if !LELY_NO_CO_OBJ_NAME\n\t\t.name = CO_SDEV_STRING(\"");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf_c99_esc(s, n, name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf(s, n, "\"),\n");
+	} else {
+#endif
+		r = snprintf(s, n,
+				"#if !LELY_NO_CO_OBJ_NAME\n\t\t.name = NULL,\n");
+#if !LELY_NO_CO_OBJ_NAME
+	}
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "#endif\n\t\t.idx = 0x%04x,\n\t\t.code = ",
+			co_obj_get_idx(obj));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_code(s, n, co_obj_get_code(obj));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	co_unsigned8_t subidx[0xff];
+	co_unsigned8_t maxsubidx = co_obj_get_subidx(obj, 0xff, subidx);
+
+	r = snprintf(s, n,
+			"\t\t.nsub = %d,\n\t\t.subs = (const struct co_ssub[]){",
+			maxsubidx);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	for (size_t i = 0; i < maxsubidx; i++) {
+		r = snprintf(s, n, i ? ", {\n" : "{\n");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf_c99_ssub(s, n, co_obj_find_sub(obj, subidx[i]));
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf(s, n, "\t\t}");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+	}
+
+	r = snprintf(s, n, "}\n");
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
+{
+	if (!s)
+		n = 0;
+
+	if (!sub)
+		return 0;
+
+	int r, t = 0;
+
+#if !LELY_NO_CO_OBJ_NAME
+	const char *name = co_sub_get_name(sub);
+	if (name) {
+		r = snprintf(s, n,
+				"#if !LELY_NO_CO_OBJ_NAME\n\t\t\t.name = CO_SDEV_STRING(\"");
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf_c99_esc(s, n, name);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+		r = snprintf(s, n, "\"),\n");
+	} else {
+#endif
+		r = snprintf(s, n,
+				"#if !LELY_NO_CO_OBJ_NAME\n\t\t\t.name = NULL,\n");
+#if !LELY_NO_CO_OBJ_NAME
+	}
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "#endif\n\t\t\t.subidx = 0x%02x,\n\t\t\t.type = ",
+			co_sub_get_subidx(sub));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	co_unsigned16_t type = co_sub_get_type(sub);
+	r = snprintf_c99_type(s, n, type);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "#if !LELY_NO_CO_OBJ_LIMITS\n\t\t\t.min = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_LIMITS
+	r = snprintf_c99_sval(s, n, type, co_sub_get_min(sub));
+#else
+	union co_val min;
+	co_val_init_min(type, &min);
+	r = snprintf_c99_sval(s, n, type, &min);
+	co_val_fini(type, &min);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t\t\t.max = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_LIMITS
+	r = snprintf_c99_sval(s, n, type, co_sub_get_max(sub));
+#else
+	union co_val max;
+	co_val_init_max(type, &max);
+	r = snprintf_c99_sval(s, n, type, &max);
+	co_val_fini(type, &max);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n,
+			",\n#endif\n#if !LELY_NO_CO_OBJ_DEFAULT\n\t\t\t.def = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_DEFAULT
+	r = snprintf_c99_sval(s, n, type, co_sub_get_def(sub));
+#else
+	union co_val def;
+	co_val_init_min(type, &def);
+	r = snprintf_c99_sval(s, n, type, &def);
+	co_val_fini(type, &def);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n#endif\n\t\t\t.val = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_FILE
+	// clang-format off
+	if (type == CO_DEFTYPE_DOMAIN
+			&& ((co_sub_get_flags(sub) & CO_OBJ_FLAGS_UPLOAD_FILE)
+			|| (co_sub_get_flags(sub)
+					& CO_OBJ_FLAGS_DOWNLOAD_FILE)))
+		// clang-format on
+		r = snprintf_c99_sval(s, n, CO_DEFTYPE_VISIBLE_STRING,
+				co_sub_get_val(sub));
+	else
+#endif
+		r = snprintf_c99_sval(s, n, type, co_sub_get_val(sub));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t\t\t.access = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+	r = snprintf_c99_access(s, n, co_sub_get_access(sub));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t\t\t.pdo_mapping = %d,\n\t\t\t.flags = ",
+			co_sub_get_pdo_mapping(sub));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_flags(s, n, co_sub_get_flags(sub), "\t\t\t\t");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\n");
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_code(char *s, size_t n, co_unsigned8_t code)
+{
+	switch (code) {
+	case CO_OBJECT_NULL: return snprintf(s, n, "CO_OBJECT_NULL");
+	case CO_OBJECT_DOMAIN: return snprintf(s, n, "CO_OBJECT_DOMAIN");
+	case CO_OBJECT_DEFTYPE: return snprintf(s, n, "CO_OBJECT_DEFTYPE");
+	case CO_OBJECT_DEFSTRUCT: return snprintf(s, n, "CO_OBJECT_DEFSTRUCT");
+	case CO_OBJECT_VAR: return snprintf(s, n, "CO_OBJECT_VAR");
+	case CO_OBJECT_ARRAY: return snprintf(s, n, "CO_OBJECT_ARRAY");
+	case CO_OBJECT_RECORD: return snprintf(s, n, "CO_OBJECT_RECORD");
+	default: return snprintf(s, n, "0x%02x", code);
+	}
+}
+
+static int
+snprintf_c99_type(char *s, size_t n, co_unsigned16_t type)
+{
+	switch (type) {
+#define LELY_CO_DEFINE_TYPE(a, b, c, d) \
+	case CO_DEFTYPE_##a: return snprintf(s, n, "CO_DEFTYPE_" #a);
+#include <lely/co/def/type.def>
+#undef LELY_CO_DEFINE_TYPE
+	default: return snprintf(s, n, "0x%04x", type);
+	}
+}
+
+static int
+snprintf_c99_access(char *s, size_t n, unsigned int access)
+{
+	switch (access) {
+	case CO_ACCESS_RO: return snprintf(s, n, "CO_ACCESS_RO");
+	case CO_ACCESS_WO: return snprintf(s, n, "CO_ACCESS_WO");
+	case CO_ACCESS_RW: return snprintf(s, n, "CO_ACCESS_RW");
+	case CO_ACCESS_RWR: return snprintf(s, n, "CO_ACCESS_RWR");
+	case CO_ACCESS_RWW: return snprintf(s, n, "CO_ACCESS_RWW");
+	case CO_ACCESS_CONST: return snprintf(s, n, "CO_ACCESS_CONST");
+	default: return snprintf(s, n, "0x%x", access);
+	}
+}
+
+static int
+snprintf_c99_flags(char *s, size_t n, unsigned int flags, const char *indent)
+{
+	if (!s)
+		n = 0;
+
+	int r, t = 0;
+
+	r = snprintf(s, n, "0");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+#define LELY_CO_DEFINE_FLAGS(x) \
+	if (flags & CO_OBJ_FLAGS_##x) { \
+		r = snprintf(s, n, "\n%s| CO_OBJ_FLAGS_" #x, indent); \
+		if (r < 0) \
+			return r; \
+		t += r; \
+		r = MIN((size_t)r, n); \
+		s += r; \
+		n -= r; \
+	}
+
+	LELY_CO_DEFINE_FLAGS(READ)
+	LELY_CO_DEFINE_FLAGS(WRITE)
+#if !LELY_NO_CO_OBJ_FILE
+	LELY_CO_DEFINE_FLAGS(UPLOAD_FILE)
+	LELY_CO_DEFINE_FLAGS(DOWNLOAD_FILE)
+#endif
+	LELY_CO_DEFINE_FLAGS(MIN_NODEID)
+	LELY_CO_DEFINE_FLAGS(MAX_NODEID)
+	LELY_CO_DEFINE_FLAGS(DEF_NODEID)
+	LELY_CO_DEFINE_FLAGS(VAL_NODEID)
+	// cppcheck-suppress uselessAssignmentArg
+	// cppcheck-suppress uselessAssignmentPtrArg
 	LELY_CO_DEFINE_FLAGS(PARAMETER_VALUE)
 
 #undef LELY_CO_DEFINE_FLAGS
@@ -926,6 +1460,50 @@ snprintf_c99_ssub(char *s, size_t n, const co_sub_t *sub)
 
 static int
 snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
+{
+	if (!s)
+		n = 0;
+
+	if (!val)
+		return 0;
+
+	const char *member = NULL;
+	switch (type) {
+#define LELY_CO_DEFINE_TYPE(a, b, c, d) \
+	case CO_DEFTYPE_##a: member = #c; break;
+#include <lely/co/def/type.def>
+#undef LELY_CO_DEFINE_TYPE
+	default: return 0;
+	}
+
+	int r, t = 0;
+
+	r = snprintf(s, n, "{ .%s = ", member);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_val(s, n, type, val);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, " }");
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_val(char *s, size_t n, co_unsigned16_t type, const void *val)
 {
 	if (!s)
 		n = 0;
@@ -938,77 +1516,77 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 	const union co_val *u = val;
 	switch (type) {
 	case CO_DEFTYPE_BOOLEAN:
-		r = snprintf(s, n, "{ .b = %d }", !!u->b);
+		r = snprintf(s, n, "%d", !!u->b);
 		break;
 	case CO_DEFTYPE_INTEGER8:
 		if (u->i8 == CO_INTEGER8_MIN) {
-			r = snprintf(s, n, "{ .i8 = CO_INTEGER8_MIN }");
+			r = snprintf(s, n, "CO_INTEGER8_MIN");
 		} else if (u->i8 == CO_INTEGER8_MAX) {
-			r = snprintf(s, n, "{ .i8 = CO_INTEGER8_MAX }");
+			r = snprintf(s, n, "CO_INTEGER8_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i8 = %" PRIi8 " }", u->i8);
+			r = snprintf(s, n, "%" PRIi8, u->i8);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER16:
 		if (u->i16 == CO_INTEGER16_MIN) {
-			r = snprintf(s, n, "{ .i16 = CO_INTEGER16_MIN }");
+			r = snprintf(s, n, "CO_INTEGER16_MIN");
 		} else if (u->i16 == CO_INTEGER16_MAX) {
-			r = snprintf(s, n, "{ .i16 = CO_INTEGER16_MAX }");
+			r = snprintf(s, n, "CO_INTEGER16_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i16 = %" PRIi16 " }", u->i16);
+			r = snprintf(s, n, "%" PRIi16, u->i16);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER32:
 		if (u->i32 == CO_INTEGER32_MIN) {
-			r = snprintf(s, n, "{ .i32 = CO_INTEGER32_MIN }");
+			r = snprintf(s, n, "CO_INTEGER32_MIN");
 		} else if (u->i32 == CO_INTEGER32_MAX) {
-			r = snprintf(s, n, "{ .i32 = CO_INTEGER32_MAX }");
+			r = snprintf(s, n, "CO_INTEGER32_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i32 = %" PRIi32 "l }", u->i32);
+			r = snprintf(s, n, "%" PRIi32 "l", u->i32);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED8:
 		if (u->u8 == CO_UNSIGNED8_MIN) {
-			r = snprintf(s, n, "{ .u8 = CO_UNSIGNED8_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED8_MIN");
 		} else if (u->u8 == CO_UNSIGNED8_MAX) {
-			r = snprintf(s, n, "{ .u8 = CO_UNSIGNED8_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED8_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u8 = 0x%02" PRIx8 " }", u->u8);
+			r = snprintf(s, n, "0x%02" PRIx8, u->u8);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED16:
 		if (u->u16 == CO_UNSIGNED16_MIN) {
-			r = snprintf(s, n, "{ .u16 = CO_UNSIGNED16_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED16_MIN");
 		} else if (u->u16 == CO_UNSIGNED16_MAX) {
-			r = snprintf(s, n, "{ .u16 = CO_UNSIGNED16_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED16_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u16 = 0x%04" PRIx16 "u }",
+			r = snprintf(s, n, "0x%04" PRIx16 "u",
 					u->u16);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED32:
 		if (u->u32 == CO_UNSIGNED32_MIN) {
-			r = snprintf(s, n, "{ .u32 = CO_UNSIGNED32_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED32_MIN");
 		} else if (u->u32 == CO_UNSIGNED32_MAX) {
-			r = snprintf(s, n, "{ .u32 = CO_UNSIGNED32_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED32_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u32 = 0x%08" PRIx32 "lu }",
+			r = snprintf(s, n, "0x%08" PRIx32 "lu",
 					u->u32);
 		}
 		break;
 	case CO_DEFTYPE_REAL32:
 		if (u->r32 == CO_REAL32_MIN) {
-			r = snprintf(s, n, "{ .r32 = CO_REAL32_MIN }");
+			r = snprintf(s, n, "CO_REAL32_MIN");
 		} else if (u->r32 == CO_REAL32_MAX) {
-			r = snprintf(s, n, "{ .r32 = CO_REAL32_MAX }");
+			r = snprintf(s, n, "CO_REAL32_MAX");
 		} else {
-			r = snprintf(s, n, "{ .r32 = %.*g }", DECIMAL_DIG,
+			r = snprintf(s, n, "%.*g", DECIMAL_DIG,
 					(double)u->r32);
 		}
 		break;
 	case CO_DEFTYPE_VISIBLE_STRING:
 		if (u->vs) {
-			r = snprintf(s, n, "{ .vs = CO_VISIBLE_STRING_C(\"");
+			r = snprintf(s, n, "CO_VISIBLE_STRING_C(\"");
 			if (r < 0)
 				return r;
 			t += r;
@@ -1022,15 +1600,15 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 			r = MIN((size_t)r, n);
 			s += r;
 			n -= r;
-			r = snprintf(s, n, "\") }");
+			r = snprintf(s, n, "\")");
 		} else {
-			r = snprintf(s, n, "{ .vs = NULL }");
+			r = snprintf(s, n, "NULL");
 		}
 		break;
 	case CO_DEFTYPE_OCTET_STRING:
 		if (u->os) {
 			r = snprintf(s, n,
-					"{ .os = CO_OCTET_STRING_C(\n\t\t\t\t\"");
+					"CO_OCTET_STRING_C(\n\t\t\t\t\"");
 			if (r < 0)
 				return r;
 			t += r;
@@ -1052,15 +1630,15 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 				s += r;
 				n -= r;
 			}
-			r = snprintf(s, n, "\"\n\t\t\t) }");
+			r = snprintf(s, n, "\"\n\t\t\t)");
 		} else {
-			r = snprintf(s, n, "{ .vs = NULL }");
+			r = snprintf(s, n, "NULL");
 		}
 		break;
 	case CO_DEFTYPE_UNICODE_STRING:
 		if (u->us) {
 			r = snprintf(s, n,
-					"{ .us = CO_UNICODE_STRING_C({\n\t\t\t\t");
+					"CO_UNICODE_STRING_C({\n\t\t\t\t");
 			if (r < 0)
 				return r;
 			t += r;
@@ -1082,31 +1660,31 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 				s += r;
 				n -= r;
 			}
-			r = snprintf(s, n, "\n\t\t\t}) }");
+			r = snprintf(s, n, "\n\t\t\t})");
 		} else {
-			r = snprintf(s, n, "{ .us = NULL }");
+			r = snprintf(s, n, "NULL");
 		}
 		break;
 	case CO_DEFTYPE_TIME_OF_DAY:
 		r = snprintf(s, n,
-				"{ .t = { "
+				"{ "
 				".ms = 0x%08" PRIx32 ", "
 				".days = 0x%04" PRIx16 " "
-				"} }",
+				"}",
 				u->t.ms, u->t.days);
 		break;
 	case CO_DEFTYPE_TIME_DIFF:
 		r = snprintf(s, n,
-				"{ .t = { "
+				"{ "
 				".ms = 0x%08" PRIx32 ", "
 				".days = 0x%04" PRIx16 " "
-				"} }",
+				"}",
 				u->td.ms, u->td.days);
 		break;
 	case CO_DEFTYPE_DOMAIN:
 		if (u->dom) {
 			r = snprintf(s, n,
-					"{ .dom = CO_DOMAIN_C(co_unsigned8_t, {\n\t\t\t\t");
+					"CO_DOMAIN_C(co_unsigned8_t, {\n\t\t\t\t");
 			if (r < 0)
 				return r;
 			t += r;
@@ -1129,113 +1707,113 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 				s += r;
 				n -= r;
 			}
-			r = snprintf(s, n, "\n\t\t\t}) }");
+			r = snprintf(s, n, "\n\t\t\t})");
 		} else {
-			r = snprintf(s, n, "{ .dom = NULL }");
+			r = snprintf(s, n, "NULL");
 		}
 		break;
 	case CO_DEFTYPE_INTEGER24:
 		if (u->i24 == CO_INTEGER24_MIN) {
-			r = snprintf(s, n, "{ .i24 = CO_INTEGER24_MIN }");
+			r = snprintf(s, n, "CO_INTEGER24_MIN");
 		} else if (u->i24 == CO_INTEGER24_MAX) {
-			r = snprintf(s, n, "{ .i24 = CO_INTEGER24_MAX }");
+			r = snprintf(s, n, "CO_INTEGER24_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i24 = %" PRIi32 "l }", u->i24);
+			r = snprintf(s, n, "%" PRIi32 "l", u->i24);
 		}
 		break;
 	case CO_DEFTYPE_REAL64:
 		if (u->r64 == CO_REAL64_MIN) {
-			r = snprintf(s, n, "{ .r64 = CO_REAL64_MIN }");
+			r = snprintf(s, n, "CO_REAL64_MIN");
 		} else if (u->r64 == CO_REAL64_MAX) {
-			r = snprintf(s, n, "{ .r64 = CO_REAL64_MAX }");
+			r = snprintf(s, n, "CO_REAL64_MAX");
 		} else {
-			r = snprintf(s, n, "{ .r64 = %.*g }", DECIMAL_DIG,
+			r = snprintf(s, n, "%.*g", DECIMAL_DIG,
 					u->r64);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER40:
 		if (u->i40 == CO_INTEGER40_MIN) {
-			r = snprintf(s, n, "{ CO_INTEGER40_MIN }");
+			r = snprintf(s, n, "CO_INTEGER40_MIN");
 		} else if (u->i40 == CO_INTEGER40_MAX) {
-			r = snprintf(s, n, "{ CO_INTEGER40_MAX }");
+			r = snprintf(s, n, "CO_INTEGER40_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i40 = %" PRIi64 "ll }", u->i40);
+			r = snprintf(s, n, "%" PRIi64 "ll", u->i40);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER48:
 		if (u->i48 == CO_INTEGER48_MIN) {
-			r = snprintf(s, n, "{ .i48 = CO_INTEGER48_MIN }");
+			r = snprintf(s, n, "CO_INTEGER48_MIN");
 		} else if (u->i48 == CO_INTEGER48_MAX) {
-			r = snprintf(s, n, "{ .i48 = CO_INTEGER48_MAX }");
+			r = snprintf(s, n, "CO_INTEGER48_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i48 = %" PRIi64 "ll }", u->i48);
+			r = snprintf(s, n, "%" PRIi64 "ll", u->i48);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER56:
 		if (u->i56 == CO_INTEGER56_MIN) {
-			r = snprintf(s, n, "{ .i56 = CO_INTEGER56_MIN }");
+			r = snprintf(s, n, "CO_INTEGER56_MIN");
 		} else if (u->i56 == CO_INTEGER56_MAX) {
-			r = snprintf(s, n, "{ .i56 = CO_INTEGER56_MAX }");
+			r = snprintf(s, n, "CO_INTEGER56_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i56 = %" PRIi64 "ll }", u->i56);
+			r = snprintf(s, n, "%" PRIi64 "ll", u->i56);
 		}
 		break;
 	case CO_DEFTYPE_INTEGER64:
 		if (u->i64 == CO_INTEGER64_MIN) {
-			r = snprintf(s, n, "{ .i64 = CO_INTEGER64_MIN }");
+			r = snprintf(s, n, "CO_INTEGER64_MIN");
 		} else if (u->i64 == CO_INTEGER64_MAX) {
-			r = snprintf(s, n, "{ .i64 = CO_INTEGER64_MAX }");
+			r = snprintf(s, n, "CO_INTEGER64_MAX");
 		} else {
-			r = snprintf(s, n, "{ .i64 = %" PRIi64 "ll }", u->i64);
+			r = snprintf(s, n, "%" PRIi64 "ll", u->i64);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED24:
 		if (u->u24 == CO_UNSIGNED24_MIN) {
-			r = snprintf(s, n, "{ .u24 = CO_UNSIGNED24_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED24_MIN");
 		} else if (u->u24 == CO_UNSIGNED24_MAX) {
-			r = snprintf(s, n, "{ .u24 = CO_UNSIGNED24_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED24_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u24 = 0x%06" PRIx32 "lu }",
+			r = snprintf(s, n, "0x%06" PRIx32 "lu",
 					u->u24);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED40:
 		if (u->u40 == CO_UNSIGNED40_MIN) {
-			r = snprintf(s, n, "{ .u40 = CO_UNSIGNED40_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED40_MIN");
 		} else if (u->u40 == CO_UNSIGNED40_MAX) {
-			r = snprintf(s, n, "{ .u40 = CO_UNSIGNED40_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED40_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u40 = 0x%010" PRIx64 "llu }",
+			r = snprintf(s, n, "0x%010" PRIx64 "llu",
 					u->u40);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED48:
 		if (u->u48 == CO_UNSIGNED48_MIN) {
-			r = snprintf(s, n, "{ .u48 = CO_UNSIGNED48_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED48_MIN");
 		} else if (u->u48 == CO_UNSIGNED48_MAX) {
-			r = snprintf(s, n, "{ .u48 = CO_UNSIGNED48_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED48_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u48 = 0x%012" PRIx64 "llu }",
+			r = snprintf(s, n, "0x%012" PRIx64 "llu",
 					u->u48);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED56:
 		if (u->u56 == CO_UNSIGNED56_MIN) {
-			r = snprintf(s, n, "{ .u56 = CO_UNSIGNED56_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED56_MIN");
 		} else if (u->u56 == CO_UNSIGNED56_MAX) {
-			r = snprintf(s, n, "{ .u56 = CO_UNSIGNED56_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED56_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u56 = 0x%014" PRIx64 "llu }",
+			r = snprintf(s, n, "0x%014" PRIx64 "llu",
 					u->u56);
 		}
 		break;
 	case CO_DEFTYPE_UNSIGNED64:
 		if (u->u64 == CO_UNSIGNED64_MIN) {
-			r = snprintf(s, n, "{ .u64 = CO_UNSIGNED64_MIN }");
+			r = snprintf(s, n, "CO_UNSIGNED64_MIN");
 		} else if (u->u64 == CO_UNSIGNED64_MAX) {
-			r = snprintf(s, n, "{ .u64 = CO_UNSIGNED64_MAX }");
+			r = snprintf(s, n, "CO_UNSIGNED64_MAX");
 		} else {
-			r = snprintf(s, n, "{ .u64 = 0x%016" PRIx64 "llu }",
+			r = snprintf(s, n, "0x%016" PRIx64 "llu",
 					u->u64);
 		}
 		break;
@@ -1249,40 +1827,457 @@ snprintf_c99_sval(char *s, size_t n, co_unsigned16_t type, const void *val)
 }
 
 static int
-snprintf_c99_esc(char *s, size_t n, const char *esc)
+snprintf_c99_esc(char *s, size_t n, const char *esc)
+{
+	if (!s)
+		n = 0;
+
+	if (!esc)
+		return 0;
+
+	int t = 0;
+
+	for (;;) {
+		// Read the next UTF-8 encoded Unicode character.
+		char32_t c32;
+		size_t chars = lex_utf8(esc, NULL, NULL, &c32);
+		if (!chars || !c32)
+			break;
+		esc += chars;
+		// Print the C99 escape sequence to a temporary buffer.
+		char buf[12] = { '\0' };
+		char *cp = buf;
+		print_c99_esc(&cp, buf + sizeof(buf), c32);
+		// Print the character to the string.
+		int r = snprintf(s, n, "%s", buf);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+	}
+
+	return t;
+}
+
+static int
+snprintf_c99_dev_obj(char *s, size_t n, const co_obj_t *obj, const char *name)
+{
+	if (!s)
+		n = 0;
+
+	int r, t = 0;
+	char key[32];
+
+	r = snprintf(s, n, "static co_obj_t %s_%04X = {\n", name, obj->idx);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	snprintf(key, sizeof(key), "_%04X.idx", obj->idx);
+	r = snprintf_c99_dev_rbnode(s, n, &obj->node, name, key, 0);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\t.dev = &%s,\n\t.idx = 0x%04x,\n\t.code = ", name,
+			obj->idx);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_code(s, n, obj->code);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_dev_str(s, n, ",\n#if !LELY_NO_CO_OBJ_NAME\n\t.name = ",
+			co_obj_get_name(obj));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "#endif\n\t.tree = {\n\t\t.cmp = &uint8_cmp,\n"
+			   "\t\t.root = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_dev_node(s, n, obj->tree.root, name, 1);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	if (co_obj_has_c99_val(obj))
+		r = snprintf(s, n,
+				",\n\t\t.num_nodes = %zu\n\t},\n"
+				"\t.val = &%s_val.obj%04X,\n"
+				"\t.size = sizeof(%s_val.obj%04X)\n};\n",
+				rbtree_size(&obj->tree), name, obj->idx, name,
+				obj->idx);
+	else
+		r = snprintf(s, n,
+				",\n\t\t.num_nodes = %zu\n\t},\n"
+				"\t.val = NULL,\n\t.size = 0\n};\n",
+				rbtree_size(&obj->tree));
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_dev_sub(char *s, size_t n, const co_sub_t *sub, const char *name)
 {
 	if (!s)
 		n = 0;
 
-	if (!esc)
-		return 0;
+	int r, t = 0;
+	char key[32];
 
-	int t = 0;
+	co_unsigned16_t idx = sub->obj->idx;
+	r = snprintf(s, n, "static co_sub_t %s_%04Xsub%X = {\n", name, idx,
+			sub->subidx);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
 
-	for (;;) {
-		// Read the next UTF-8 encoded Unicode character.
-		char32_t c32;
-		size_t chars = lex_utf8(esc, NULL, NULL, &c32);
-		if (!chars || !c32)
-			break;
-		esc += chars;
-		// Print the C99 escape sequence to a temporary buffer.
-		char buf[12] = { '\0' };
-		char *cp = buf;
-		print_c99_esc(&cp, buf + sizeof(buf), c32);
-		// Print the character to the string.
-		int r = snprintf(s, n, "%s", buf);
+	snprintf(key, sizeof(key), "_%04Xsub%X.subidx", idx, sub->subidx);
+	r = snprintf_c99_dev_rbnode(s, n, &sub->node, name, key, 1);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\t.obj = &%s_%04X,\n\t.subidx = 0x%02x,\n\t.type = ",
+			name, idx, sub->subidx);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_type(s, n, sub->type);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_dev_str(s, n, ",\n#if !LELY_NO_CO_OBJ_NAME\n\t.name = ",
+			co_sub_get_name(sub));
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "#endif\n#if !LELY_NO_CO_OBJ_LIMITS\n\t.min = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_LIMITS
+	r = snprintf_c99_sval(s, n, sub->type, &sub->min);
+#else
+	union co_val min;
+	co_val_init_min(sub->type, &min);
+	r = snprintf_c99_sval(s, n, sub->type, &min);
+	co_val_fini(sub->type, &min);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t.max = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_LIMITS
+	r = snprintf_c99_sval(s, n, sub->type, &sub->max);
+#else
+	union co_val max;
+	co_val_init_max(sub->type, &max);
+	r = snprintf_c99_sval(s, n, sub->type, &max);
+	co_val_fini(sub->type, &max);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n#endif\n#if !LELY_NO_CO_OBJ_DEFAULT\n\t.def = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+#if !LELY_NO_CO_OBJ_DEFAULT
+	r = snprintf_c99_sval(s, n, sub->type, &sub->def);
+#else
+	union co_val def;
+	co_val_init_min(sub->type, &def);
+	r = snprintf_c99_sval(s, n, sub->type, &def);
+	co_val_fini(sub->type, &def);
+#endif
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	if (co_type_sizeof(sub->type))
+		r = snprintf(s, n, ",\n#endif\n\t.val = &%s_val.obj%04X.sub%X,\n",
+				name, idx, sub->subidx);
+	else
+		r = snprintf(s, n, ",\n#endif\n\t.val = NULL,\n");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\t.access = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_access(s, n, sub->access);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t.pdo_mapping = %d,\n\t.flags = ",
+			sub->pdo_mapping);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_flags(s, n, sub->flags, "\t\t");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n,
+			",\n\t.dn_ind = &co_sub_default_dn_ind,\n"
+			"#if !LELY_NO_CO_OBJ_UPLOAD\n"
+			"\t.up_ind = &co_sub_default_up_ind\n#endif\n};\n");
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_dev_rbnode(char *s, size_t n, const struct rbnode *node,
+		const char *name, const char *key, int is_sub)
+{
+	if (!s)
+		n = 0;
+
+	int r, t = 0;
+
+	// The least significant bit of the parent pointer contains the color of
+	// the node.
+	const struct rbnode *parent =
+			(const struct rbnode *)(node->parent & ~(uintptr_t)1);
+	int color = node->parent & 1;
+
+	r = snprintf(s, n, "\t.node = {\n\t\t.key = &%s%s,\n\t\t.parent = ",
+			name, key);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	if (parent) {
+		r = snprintf(s, n, "(uintptr_t)");
 		if (r < 0)
 			return r;
 		t += r;
 		r = MIN((size_t)r, n);
 		s += r;
 		n -= r;
+
+		r = snprintf_c99_dev_node(s, n, parent, name, is_sub);
+		if (r < 0)
+			return r;
+		t += r;
+		r = MIN((size_t)r, n);
+		s += r;
+		n -= r;
+
+		r = snprintf(s, n, color ? " + 1" : "");
+	} else {
+		r = snprintf(s, n, "%d", color);
+	}
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t\t.left = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_dev_node(s, n, node->left, name, is_sub);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, ",\n\t\t.right = ");
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_dev_node(s, n, node->right, name, is_sub);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\n\t},\n");
+	if (r < 0)
+		return r;
+	t += r;
+
+	return t;
+}
+
+static int
+snprintf_c99_dev_node(char *s, size_t n, const struct rbnode *node,
+		const char *name, int is_sub)
+{
+	if (!node)
+		return snprintf(s, n, "NULL");
+
+	if (is_sub) {
+		const co_sub_t *sub = structof(node, co_sub_t, node);
+		return snprintf(s, n, "&%s_%04Xsub%X.node", name,
+				sub->obj->idx, sub->subidx);
+	} else {
+		const co_obj_t *obj = structof(node, co_obj_t, node);
+		return snprintf(s, n, "&%s_%04X.node", name, obj->idx);
 	}
+}
+
+static int
+snprintf_c99_dev_str(char *s, size_t n, const char *member, const char *str)
+{
+	if (!s)
+		n = 0;
+
+	if (!str)
+		return snprintf(s, n, "%sNULL,\n", member);
+
+	int r, t = 0;
+
+	r = snprintf(s, n, "%sCO_DEV_STRING(\"", member);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf_c99_esc(s, n, str);
+	if (r < 0)
+		return r;
+	t += r;
+	r = MIN((size_t)r, n);
+	s += r;
+	n -= r;
+
+	r = snprintf(s, n, "\"),\n");
+	if (r < 0)
+		return r;
+	t += r;
 
 	return t;
 }
 
+static int
+co_obj_has_c99_val(const co_obj_t *obj)
+{
+	for (co_sub_t *sub = co_obj_first_sub(obj); sub; sub = co_sub_next(sub))
+		if (co_type_sizeof(sub->type))
+			return 1;
+	return 0;
+}
+
 #endif // !LELY_NO_STDIO
 
 #endif // !LELY_NO_CO_SDEV
@@ -0,0 +1,706 @@
+/**@file
+ * This file is part of the CANopen library; it contains the implementation of
+ * the binary object dictionary snapshot functions.
+ *
+ * @see lely/co/snap.h
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "co.h"
+
+#if !LELY_NO_CO_SNAP
+
+#include <lely/co/crc.h>
+#include <lely/co/detail/obj.h>
+#include <lely/co/snap.h>
+#include <lely/util/diag.h>
+#include <lely/util/endian.h>
+#include <lely/util/frbuf.h>
+#include <lely/util/fwbuf.h>
+
+#include <assert.h>
+#include <stdint.h>
+#include <string.h>
+
+/*
+ * The layout of a snapshot is as follows (all offsets are in bytes):
+ *
+ * header (64 bytes):
+ *   0  magic ("CODS")
+ *   4  version (16-bit)
+ *   6  number of objects (16-bit)
+ *   8  number of sub-objects (32-bit)
+ *  12  total size of the snapshot (32-bit)
+ *  16  CRC of bytes 18 to the end of the snapshot (16-bit, see co_crc())
+ *  18  node-ID (8-bit)
+ *  19  network-ID (8-bit)
+ *  20  default heartbeat rate (16-bit)
+ *  22  LSS support (8-bit)
+ *  24  vendor ID, product code, revision number, dummy mask and baud rates
+ *      (5 x 32-bit)
+ *  44  offsets of the device, vendor and product name and the order code
+ *      (4 x 32-bit)
+ *
+ * objects (12 bytes each, in ascending order of the index):
+ *   0  index (16-bit)
+ *   2  object code (8-bit)
+ *   4  number of sub-objects (16-bit)
+ *   8  offset of the name (32-bit)
+ *
+ * sub-objects (32 bytes each, grouped by object, in ascending order of the
+ * sub-index):
+ *   0  sub-index (8-bit)
+ *   1  access type (8-bit)
+ *   2  PDO mapping (8-bit)
+ *   4  data type (16-bit)
+ *   8  object flags (32-bit)
+ *  12  offset of the name (32-bit)
+ *  16  offsets of the lower limit, upper limit, default value and current
+ *      value (4 x 32-bit)
+ *
+ * The remainder of the snapshot contains the null-terminated names and the
+ * values. Each value is stored as a 32-bit size followed by the value in the
+ * format of co_val_write(). An offset of 0 denotes a NULL name or an empty
+ * value.
+ */
+
+/// The magic number at the start of each snapshot.
+#define CO_SNAP_MAGIC "CODS"
+
+/// The size (in bytes) of the header of a snapshot.
+#define CO_SNAP_HDR_SIZE 64
+
+/// The size (in bytes) of an object in a snapshot.
+#define CO_SNAP_OBJ_SIZE 12
+
+/// The size (in bytes) of a sub-object in a snapshot.
+#define CO_SNAP_SUB_SIZE 32
+
+/// The offset (in bytes) of the first byte covered by the CRC.
+#define CO_SNAP_CRC_BEGIN 18
+
+/// The loading context of a snapshot.
+struct co_snap {
+	/// A pointer to the first byte of the snapshot.
+	const uint_least8_t *begin;
+	/// The size (in bytes) of the snapshot.
+	size_t size;
+	/// The offset of the first name or value.
+	size_t heap;
+};
+
+static int co_snap_init(struct co_snap *snap, const uint_least8_t *begin,
+		const uint_least8_t *end);
+static int co_snap_load_dev(const struct co_snap *snap, co_dev_t *dev);
+static int co_snap_load_obj(const struct co_snap *snap, co_obj_t *obj,
+		const uint_least8_t *op, const uint_least8_t **psp);
+static int co_snap_load_sub(const struct co_snap *snap, co_sub_t *sub,
+		const uint_least8_t *sp);
+static int co_snap_get_str(const struct co_snap *snap, uint_least32_t off,
+		const char **pstr);
+static int co_snap_get_val(const struct co_snap *snap, uint_least32_t off,
+		co_unsigned16_t type, void *val);
+
+static size_t co_snap_write_dev(const co_dev_t *dev, uint_least8_t *begin);
+static uint_least32_t co_snap_write_str(
+		uint_least8_t *begin, size_t *pheap, const char *s);
+static uint_least32_t co_snap_write_val(uint_least8_t *begin, size_t *pheap,
+		co_unsigned16_t type, const void *val);
+
+co_dev_t *
+co_dev_init_from_snap(
+		co_dev_t *dev, const uint_least8_t *begin, const uint_least8_t *end)
+{
+	assert(dev);
+
+	int errc = 0;
+
+	struct co_snap snap;
+	if (co_snap_init(&snap, begin, end) == -1) {
+		errc = get_errc();
+		goto error_init_snap;
+	}
+
+	if (!co_dev_init(dev, begin[18])) {
+		errc = get_errc();
+		goto error_init_dev;
+	}
+
+	if (co_snap_load_dev(&snap, dev) == -1) {
+		errc = get_errc();
+		goto error_load_dev;
+	}
+
+	return dev;
+
+error_load_dev:
+	co_dev_fini(dev);
+error_init_dev:
+error_init_snap:
+	set_errc(errc);
+	return NULL;
+}
+
+co_dev_t *
+co_dev_create_from_snap(const uint_least8_t *begin, const uint_least8_t *end)
+{
+	int errc = 0;
+
+	co_dev_t *dev = co_dev_alloc();
+	if (!dev) {
+		errc = get_errc();
+		goto error_alloc_dev;
+	}
+
+	if (!co_dev_init_from_snap(dev, begin, end)) {
+		errc = get_errc();
+		goto error_init_dev;
+	}
+
+	return dev;
+
+error_init_dev:
+	co_dev_free(dev);
+error_alloc_dev:
+	set_errc(errc);
+	return NULL;
+}
+
+co_dev_t *
+co_dev_init_from_snap_file(co_dev_t *dev, const char *filename)
+{
+	int errc = 0;
+
+	frbuf_t *buf = frbuf_create(filename);
+	if (!buf) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s", filename);
+		goto error_create_buf;
+	}
+
+	size_t size = 0;
+	const uint_least8_t *begin = frbuf_map(buf, 0, &size);
+	if (!begin) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to map file", filename);
+		goto error_map_buf;
+	}
+
+	if (!co_dev_init_from_snap(dev, begin, begin + size)) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to load snapshot", filename);
+		goto error_init_dev;
+	}
+
+	frbuf_destroy(buf);
+
+	return dev;
+
+error_init_dev:
+error_map_buf:
+	frbuf_destroy(buf);
+error_create_buf:
+	set_errc(errc);
+	return NULL;
+}
+
+co_dev_t *
+co_dev_create_from_snap_file(const char *filename)
+{
+	int errc = 0;
+
+	co_dev_t *dev = co_dev_alloc();
+	if (!dev) {
+		errc = get_errc();
+		goto error_alloc_dev;
+	}
+
+	if (!co_dev_init_from_snap_file(dev, filename)) {
+		errc = get_errc();
+		goto error_init_dev;
+	}
+
+	return dev;
+
+error_init_dev:
+	co_dev_free(dev);
+error_alloc_dev:
+	set_errc(errc);
+	return NULL;
+}
+
+size_t
+co_dev_write_snap(const co_dev_t *dev, uint_least8_t *begin, uint_least8_t *end)
+{
+	assert(dev);
+
+	// Compute the size of the snapshot before writing anything, since all
+	// offsets have to fit in 32 bits.
+	size_t size = co_snap_write_dev(dev, NULL);
+	if (size > UINT32_MAX) {
+		set_errnum(ERRNUM_OVERFLOW);
+		return 0;
+	}
+
+	if (begin && (!end || end - begin >= (ptrdiff_t)size))
+		co_snap_write_dev(dev, begin);
+
+	return size;
+}
+
+int
+co_dev_write_snap_file(const co_dev_t *dev, const char *filename)
+{
+	assert(dev);
+
+	int errc = 0;
+
+	size_t size = co_dev_write_snap(dev, NULL, NULL);
+	if (!size) {
+		errc = get_errc();
+		goto error_write_snap;
+	}
+
+	fwbuf_t *buf = fwbuf_create(filename);
+	if (!buf) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s", filename);
+		goto error_create_buf;
+	}
+
+	if (fwbuf_set_size(buf, size) == -1) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to resize file", filename);
+		goto error_set_size;
+	}
+
+	uint_least8_t *begin = fwbuf_map(buf, 0, &size);
+	if (!begin) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to map file", filename);
+		goto error_map_buf;
+	}
+
+	co_dev_write_snap(dev, begin, begin + size);
+
+	if (fwbuf_commit(buf) == -1) {
+		errc = get_errc();
+		diag(DIAG_ERROR, errc, "%s: unable to commit file", filename);
+		goto error_commit_buf;
+	}
+
+	fwbuf_destroy(buf);
+
+	return 0;
+
+error_commit_buf:
+error_map_buf:
+error_set_size:
+	fwbuf_destroy(buf);
+error_create_buf:
+error_write_snap:
+	set_errc(errc);
+	return -1;
+}
+
+static int
+co_snap_init(struct co_snap *snap, const uint_least8_t *begin,
+		const uint_least8_t *end)
+{
+	assert(snap);
+
+	// clang-format off
+	if (!begin || end - begin < CO_SNAP_HDR_SIZE
+			|| memcmp(begin, CO_SNAP_MAGIC, 4)) {
+		// clang-format on
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	if (ldle_u16(begin + 4) != CO_SNAP_VERSION) {
+		set_errnum(ERRNUM_NOTSUP);
+		return -1;
+	}
+
+	size_t nobj = ldle_u16(begin + 6);
+	size_t nsub = ldle_u32(begin + 8);
+	size_t size = ldle_u32(begin + 12);
+	// Check the number of sub-objects before computing the size of the
+	// records, to prevent an overflow on 32-bit platforms.
+	size_t heap = CO_SNAP_HDR_SIZE + nobj * CO_SNAP_OBJ_SIZE;
+	// clang-format off
+	if (size > (size_t)(end - begin) || heap > size
+			|| nsub > (size - heap) / CO_SNAP_SUB_SIZE) {
+		// clang-format on
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+	heap += nsub * CO_SNAP_SUB_SIZE;
+
+	// Check that the object records account for all sub-object records.
+	size_t n = 0;
+	for (size_t i = 0; i < nobj; i++)
+		n += ldle_u16(begin + CO_SNAP_HDR_SIZE + i * CO_SNAP_OBJ_SIZE + 4);
+	if (n != nsub) {
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	// clang-format off
+	if (ldle_u16(begin + 16) != co_crc(0, begin + CO_SNAP_CRC_BEGIN,
+			size - CO_SNAP_CRC_BEGIN)) {
+		// clang-format on
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	*snap = (struct co_snap){ .begin = begin, .size = size, .heap = heap };
+
+	return 0;
+}
+
+static int
+co_snap_load_dev(const struct co_snap *snap, co_dev_t *dev)
+{
+	assert(snap);
+	assert(dev);
+
+	const uint_least8_t *begin = snap->begin;
+
+	if (co_dev_set_netid(dev, begin[19]) == -1)
+		return -1;
+	co_dev_set_rate(dev, ldle_u16(begin + 20));
+	co_dev_set_lss(dev, begin[22]);
+	co_dev_set_vendor_id(dev, ldle_u32(begin + 24));
+	co_dev_set_product_code(dev, ldle_u32(begin + 28));
+	co_dev_set_revision(dev, ldle_u32(begin + 32));
+	co_dev_set_dummy(dev, ldle_u32(begin + 36));
+	co_dev_set_baud(dev, ldle_u32(begin + 40));
+
+	const char *name[4];
+	for (int i = 0; i < 4; i++) {
+		if (co_snap_get_str(snap, ldle_u32(begin + 44 + 4 * i),
+				    &name[i])
+				== -1)
+			return -1;
+	}
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_dev_set_name(dev, name[0]) == -1)
+		return -1;
+	if (co_dev_set_vendor_name(dev, name[1]) == -1)
+		return -1;
+	if (co_dev_set_product_name(dev, name[2]) == -1)
+		return -1;
+	if (co_dev_set_order_code(dev, name[3]) == -1)
+		return -1;
+#endif
+
+	size_t nobj = ldle_u16(begin + 6);
+	const uint_least8_t *op = begin + CO_SNAP_HDR_SIZE;
+	const uint_least8_t *sp = op + nobj * CO_SNAP_OBJ_SIZE;
+	for (size_t i = 0; i < nobj; i++, op += CO_SNAP_OBJ_SIZE) {
+		co_obj_t *obj = co_obj_create(ldle_u16(op));
+		if (!obj)
+			return -1;
+		if (co_dev_insert_obj(dev, obj) == -1) {
+			int errc = get_errc();
+			co_obj_destroy(obj);
+			set_errc(errc);
+			return -1;
+		}
+		if (co_snap_load_obj(snap, obj, op, &sp) == -1)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+co_snap_load_obj(const struct co_snap *snap, co_obj_t *obj,
+		const uint_least8_t *op, const uint_least8_t **psp)
+{
+	assert(snap);
+	assert(obj);
+	assert(op);
+	assert(psp);
+
+	const char *name;
+	if (co_snap_get_str(snap, ldle_u32(op + 8), &name) == -1)
+		return -1;
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_obj_set_name(obj, name) == -1)
+		return -1;
+#endif
+
+	if (co_obj_set_code(obj, op[2]) == -1)
+		return -1;
+
+	size_t n = ldle_u16(op + 4);
+	for (size_t i = 0; i < n; i++, *psp += CO_SNAP_SUB_SIZE) {
+		const uint_least8_t *sp = *psp;
+		co_sub_t *sub = co_sub_create(sp[0], ldle_u16(sp + 4));
+		if (!sub)
+			return -1;
+		if (co_obj_insert_sub(obj, sub) == -1) {
+			int errc = get_errc();
+			co_sub_destroy(sub);
+			set_errc(errc);
+			return -1;
+		}
+		if (co_snap_load_sub(snap, sub, sp) == -1)
+			return -1;
+	}
+
+	return 0;
+}
+
+static int
+co_snap_load_sub(const struct co_snap *snap, co_sub_t *sub,
+		const uint_least8_t *sp)
+{
+	assert(snap);
+	assert(sub);
+	assert(sp);
+
+	const char *name;
+	if (co_snap_get_str(snap, ldle_u32(sp + 12), &name) == -1)
+		return -1;
+#if !LELY_NO_CO_OBJ_NAME
+	if (co_sub_set_name(sub, name) == -1)
+		return -1;
+#endif
+
+	if (co_sub_set_access(sub, sp[1]) == -1)
+		return -1;
+	co_sub_set_pdo_mapping(sub, sp[2]);
+	co_sub_set_flags(sub, ldle_u32(sp + 8));
+
+	co_unsigned16_t type = sub->type;
+#if !LELY_NO_CO_OBJ_LIMITS
+	if (co_snap_get_val(snap, ldle_u32(sp + 16), type, &sub->min) == -1)
+		return -1;
+	if (co_snap_get_val(snap, ldle_u32(sp + 20), type, &sub->max) == -1)
+		return -1;
+#endif
+#if !LELY_NO_CO_OBJ_DEFAULT
+	if (co_snap_get_val(snap, ldle_u32(sp + 24), type, &sub->def) == -1)
+		return -1;
+#endif
+	if (co_snap_get_val(snap, ldle_u32(sp + 28), type, sub->val) == -1)
+		return -1;
+
+	return 0;
+}
+
+static int
+co_snap_get_str(const struct co_snap *snap, uint_least32_t off,
+		const char **pstr)
+{
+	assert(snap);
+	assert(pstr);
+
+	if (!off) {
+		*pstr = NULL;
+		return 0;
+	}
+
+	// The string has to be part of the heap and null-terminated.
+	// clang-format off
+	if (off < snap->heap || off >= snap->size || !memchr(snap->begin + off,
+			'\0', snap->size - off)) {
+		// clang-format on
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	*pstr = (const char *)snap->begin + off;
+	return 0;
+}
+
+static int
+co_snap_get_val(const struct co_snap *snap, uint_least32_t off,
+		co_unsigned16_t type, void *val)
+{
+	assert(snap);
+	assert(val);
+
+	if (!off)
+		return 0;
+
+	if (off < snap->heap || snap->size - off < 4) {
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+	const uint_least8_t *begin = snap->begin + off + 4;
+	size_t n = ldle_u32(begin - 4);
+	if (n > snap->size - off - 4) {
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	// Read the value directly into the sub-object, replacing the value
+	// created by co_sub_create().
+	co_val_fini(type, val);
+	if (co_val_read(type, val, begin, begin + n) != n) {
+		set_errnum(ERRNUM_INVAL);
+		return -1;
+	}
+
+	return 0;
+}
+
+static size_t
+co_snap_write_dev(const co_dev_t *dev, uint_least8_t *begin)
+{
+	assert(dev);
+
+	size_t nobj = 0;
+	size_t nsub = 0;
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj), nobj++)
+		nsub += co_obj_get_subidx(obj, 0, NULL);
+
+	size_t heap = CO_SNAP_HDR_SIZE + nobj * CO_SNAP_OBJ_SIZE
+			+ nsub * CO_SNAP_SUB_SIZE;
+
+	if (begin) {
+		memset(begin, 0, heap);
+		memcpy(begin, CO_SNAP_MAGIC, 4);
+		stle_u16(begin + 4, CO_SNAP_VERSION);
+		stle_u16(begin + 6, (uint_least16_t)nobj);
+		stle_u32(begin + 8, nsub);
+		begin[18] = co_dev_get_id(dev);
+		begin[19] = co_dev_get_netid(dev);
+		stle_u16(begin + 20, co_dev_get_rate(dev));
+		begin[22] = !!co_dev_get_lss(dev);
+		stle_u32(begin + 24, co_dev_get_vendor_id(dev));
+		stle_u32(begin + 28, co_dev_get_product_code(dev));
+		stle_u32(begin + 32, co_dev_get_revision(dev));
+		stle_u32(begin + 36, co_dev_get_dummy(dev));
+		stle_u32(begin + 40, co_dev_get_baud(dev));
+	}
+
+#if !LELY_NO_CO_OBJ_NAME
+	const char *name[4] = { co_dev_get_name(dev),
+		co_dev_get_vendor_name(dev), co_dev_get_product_name(dev),
+		co_dev_get_order_code(dev) };
+	for (int i = 0; i < 4; i++) {
+		uint_least32_t off = co_snap_write_str(begin, &heap, name[i]);
+		if (begin)
+			stle_u32(begin + 44 + 4 * i, off);
+	}
+#endif
+
+	uint_least8_t *op = begin ? begin + CO_SNAP_HDR_SIZE : NULL;
+	uint_least8_t *sp = begin ? op + nobj * CO_SNAP_OBJ_SIZE : NULL;
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj)) {
+		if (op) {
+			stle_u16(op, co_obj_get_idx(obj));
+			op[2] = co_obj_get_code(obj);
+			stle_u16(op + 4, co_obj_get_subidx(obj, 0, NULL));
+		}
+#if !LELY_NO_CO_OBJ_NAME
+		uint_least32_t off = co_snap_write_str(
+				begin, &heap, co_obj_get_name(obj));
+		if (op)
+			stle_u32(op + 8, off);
+#endif
+		if (op)
+			op += CO_SNAP_OBJ_SIZE;
+
+		for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+				sub = co_sub_next(sub)) {
+			co_unsigned16_t type = co_sub_get_type(sub);
+			uint_least32_t off[5] = { 0 };
+#if !LELY_NO_CO_OBJ_NAME
+			off[0] = co_snap_write_str(
+					begin, &heap, co_sub_get_name(sub));
+#endif
+#if !LELY_NO_CO_OBJ_LIMITS
+			off[1] = co_snap_write_val(begin, &heap, type,
+					co_sub_get_min(sub));
+			off[2] = co_snap_write_val(begin, &heap, type,
+					co_sub_get_max(sub));
+#endif
+#if !LELY_NO_CO_OBJ_DEFAULT
+			off[3] = co_snap_write_val(begin, &heap, type,
+					co_sub_get_def(sub));
+#endif
+			off[4] = co_snap_write_val(begin, &heap, type,
+					co_sub_get_val(sub));
+			if (!sp)
+				continue;
+			sp[0] = co_sub_get_subidx(sub);
+			sp[1] = co_sub_get_access(sub);
+			sp[2] = !!co_sub_get_pdo_mapping(sub);
+			stle_u16(sp + 4, type);
+			stle_u32(sp + 8, co_sub_get_flags(sub));
+			for (int i = 0; i < 5; i++)
+				stle_u32(sp + 12 + 4 * i, off[i]);
+			sp += CO_SNAP_SUB_SIZE;
+		}
+	}
+
+	if (begin) {
+		stle_u32(begin + 12, heap);
+		stle_u16(begin + 16,
+				co_crc(0, begin + CO_SNAP_CRC_BEGIN,
+						heap - CO_SNAP_CRC_BEGIN));
+	}
+
+	return heap;
+}
+
+static uint_least32_t
+co_snap_write_str(uint_least8_t *begin, size_t *pheap, const char *s)
+{
+	assert(pheap);
+
+	if (!s)
+		return 0;
+
+	size_t off = *pheap;
+	size_t n = strlen(s) + 1;
+	if (begin)
+		memcpy(begin + off, s, n);
+	*pheap += n;
+
+	return off;
+}
+
+static uint_least32_t
+co_snap_write_val(uint_least8_t *begin, size_t *pheap, co_unsigned16_t type,
+		const void *val)
+{
+	assert(pheap);
+
+	// Empty strings and domains are not stored.
+	size_t n = val ? co_val_write(type, val, NULL, NULL) : 0;
+	if (!n)
+		return 0;
+
+	size_t off = *pheap;
+	if (begin) {
+		stle_u32(begin + off, n);
+		co_val_write(type, val, begin + off + 4, NULL);
+	}
+	*pheap += 4 + n;
+
+	return off;
+}
+
+#endif // !LELY_NO_CO_SNAP
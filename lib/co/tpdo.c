@@ -34,6 +34,7 @@
 
 #if !LELY_NO_CO_TPDO
 
+#include <lely/co/detail/dev.h>
 #include <lely/co/dev.h>
 #include <lely/co/obj.h>
 #include <lely/co/sdo.h>
@@ -58,12 +59,12 @@ struct co_tpdo {
 	struct co_pdo_comm_par comm;
 	/// The PDO mapping parameter.
 	struct co_pdo_map_par map;
+	/// The compiled PDO mapping.
+	struct co_pdo_plan plan;
 	/// A pointer to the CAN frame receiver.
 	can_recv_t *recv;
 	/// A pointer to the CAN timer for events.
 	can_timer_t *timer_event;
-	/// A pointer to the CAN timer for the synchronous time window.
-	can_timer_t *timer_swnd;
 	/// A buffered CAN frame, used for RTR-only or event-driven TPDOs.
 	struct can_msg msg;
 	/// The time at which the next event-driven TPDO may be sent.
@@ -72,6 +73,10 @@ struct co_tpdo {
 	unsigned int event : 1;
 	/// A flag indicating the synchronous time window has expired.
 	unsigned int swnd : 1;
+	/// A flag indicating whether #swnd_end is valid.
+	unsigned int swnd_dl : 1;
+	/// The time at which the synchronous time window expires.
+	struct timespec swnd_end;
 	/// The SYNC start value.
 	co_unsigned8_t sync;
 	/// The SYNC counter value.
@@ -116,10 +121,10 @@ static void co_tpdo_init_recv(co_tpdo_t *pdo);
 static void co_tpdo_init_timer_event(co_tpdo_t *pdo);
 
 /**
- * Initializes the CAN timer for the synchronous time window of a Transmit-PDO
- * service.
+ * Returns 1 if the synchronous time window of a Transmit-PDO service has
+ * expired, and 0 if not.
  */
-static void co_tpdo_init_timer_swnd(co_tpdo_t *pdo);
+static int co_tpdo_swnd_expired(co_tpdo_t *pdo);
 
 /**
  * The download indication function for (all sub-objects of) CANopen objects
@@ -153,14 +158,6 @@ static int co_tpdo_recv(const struct can_msg *msg, void *data);
  */
 static int co_tpdo_timer_event(const struct timespec *tp, void *data);
 
-/**
- * The CAN timer callback function for the synchronous time window of a
- * Transmit-PDO service.
- *
- * @see can_timer_func_t
- */
-static int co_tpdo_timer_swnd(const struct timespec *tp, void *data);
-
 /// The default sampling indication function. @see co_tpdo_sample_ind_t
 static int default_sample_ind(co_tpdo_t *pdo, void *data);
 
@@ -257,12 +254,14 @@ co_tpdo_start(co_tpdo_t *pdo)
 	// Copy the PDO mapping parameter record.
 	memcpy(&pdo->map, co_obj_addressof_val(obj_1a00),
 			MIN(co_obj_sizeof_val(obj_1a00), sizeof(pdo->map)));
+	co_pdo_plan_init(&pdo->plan, &pdo->map, pdo->dev);
 	// Set the download indication functions PDO mapping parameter record.
 	co_obj_set_dn_ind(obj_1a00, &co_1a00_dn_ind, pdo);
 
 	can_net_get_time(pdo->net, &pdo->inhibit);
 	pdo->event = 0;
 	pdo->swnd = 1;
+	pdo->swnd_dl = 0;
 	pdo->sync = pdo->comm.sync;
 	pdo->cnt = 0;
 
@@ -271,6 +270,8 @@ co_tpdo_start(co_tpdo_t *pdo)
 
 	pdo->stopped = 0;
 
+	co_dev_pdo_comm_changed(pdo->dev);
+
 	return 0;
 }
 
@@ -282,7 +283,7 @@ co_tpdo_stop(co_tpdo_t *pdo)
 	if (pdo->stopped)
 		return;
 
-	can_timer_stop(pdo->timer_swnd);
+	pdo->swnd_dl = 0;
 	can_timer_stop(pdo->timer_event);
 
 	can_recv_stop(pdo->recv);
@@ -456,6 +457,28 @@ co_tpdo_sync(co_tpdo_t *pdo, co_unsigned8_t cnt)
 {
 	assert(pdo);
 
+	// Ignore the synchronous window length unless the TPDO is valid and
+	// synchronous.
+	if ((pdo->comm.cobid & CO_PDO_COBID_VALID)
+			|| (pdo->comm.trans > 0xf0 && pdo->comm.trans != 0xfc))
+		return co_tpdo_sync_swnd(pdo, cnt, NULL);
+
+	co_unsigned32_t swnd = co_dev_get_val_u32(pdo->dev, 0x1007, 0x00);
+	if (!swnd)
+		return co_tpdo_sync_swnd(pdo, cnt, NULL);
+
+	struct timespec end = { 0, 0 };
+	can_net_get_time(pdo->net, &end);
+	timespec_add_usec(&end, swnd);
+	return co_tpdo_sync_swnd(pdo, cnt, &end);
+}
+
+int
+co_tpdo_sync_swnd(co_tpdo_t *pdo, co_unsigned8_t cnt,
+		const struct timespec *end)
+{
+	assert(pdo);
+
 	if (cnt > 240) {
 		set_errnum(ERRNUM_INVAL);
 		return -1;
@@ -480,7 +503,9 @@ co_tpdo_sync(co_tpdo_t *pdo, co_unsigned8_t cnt)
 
 	// Reset the time window for synchronous PDOs.
 	pdo->swnd = 0;
-	co_tpdo_init_timer_swnd(pdo);
+	pdo->swnd_dl = !!end;
+	if (end)
+		pdo->swnd_end = *end;
 
 	if (!pdo->comm.trans) {
 		// In case of a synchronous (acyclic) TPDO, do nothing unless an
@@ -517,7 +542,7 @@ co_tpdo_sample_res(co_tpdo_t *pdo, co_unsigned32_t ac)
 		return 0;
 
 	// Check if the synchronous window expired.
-	if (!ac && pdo->comm.trans != 0xfd && pdo->swnd)
+	if (!ac && pdo->comm.trans != 0xfd && co_tpdo_swnd_expired(pdo))
 		ac = CO_SDO_AC_TIMEOUT;
 
 	// Do not send a PDO in case of an error.
@@ -581,23 +606,19 @@ co_tpdo_init_timer_event(co_tpdo_t *pdo)
 		can_timer_timeout(pdo->timer_event, pdo->net, pdo->comm.event);
 }
 
-static void
-co_tpdo_init_timer_swnd(co_tpdo_t *pdo)
+static int
+co_tpdo_swnd_expired(co_tpdo_t *pdo)
 {
 	assert(pdo);
-	assert(!(pdo->comm.cobid & CO_PDO_COBID_VALID));
-	assert(pdo->comm.trans <= 0xf0 || pdo->comm.trans == 0xfc);
 
-	can_timer_stop(pdo->timer_swnd);
-	// Ignore the synchronous window length unless the TPDO is valid and
-	// synchronous.
-	co_unsigned32_t swnd = co_dev_get_val_u32(pdo->dev, 0x1007, 0x00);
-	if (swnd) {
-		struct timespec start = { 0, 0 };
-		can_net_get_time(pdo->net, &start);
-		timespec_add_usec(&start, swnd);
-		can_timer_start(pdo->timer_swnd, pdo->net, &start, NULL);
+	if (!pdo->swnd && pdo->swnd_dl) {
+		struct timespec now = { 0, 0 };
+		can_net_get_time(pdo->net, &now);
+		if (timespec_cmp(&now, &pdo->swnd_end) >= 0)
+			pdo->swnd = 1;
 	}
+
+	return pdo->swnd;
 }
 
 static co_unsigned32_t
@@ -655,10 +676,11 @@ co_1800_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 		pdo->msg = (struct can_msg)CAN_MSG_INIT;
 		pdo->event = 0;
 		pdo->swnd = 1;
+		pdo->swnd_dl = 0;
 
 		co_tpdo_init_recv(pdo);
 		co_tpdo_init_timer_event(pdo);
-		can_timer_stop(pdo->timer_swnd);
+		co_dev_pdo_comm_changed(pdo->dev);
 		break;
 	}
 	case 2: {
@@ -682,6 +704,7 @@ co_1800_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 		pdo->comm.trans = trans;
 
 		co_tpdo_init_recv(pdo);
+		co_dev_pdo_comm_changed(pdo->dev);
 		break;
 	}
 	case 3: {
@@ -789,6 +812,7 @@ co_1a00_dn_ind(co_sub_t *sub, struct co_sdo_req *req, co_unsigned32_t ac,
 		}
 
 		pdo->map.n = n;
+		co_pdo_plan_init(&pdo->plan, &pdo->map, pdo->dev);
 	} else {
 		assert(type == CO_DEFTYPE_UNSIGNED32);
 		co_unsigned32_t map = val.u32;
@@ -868,18 +892,6 @@ co_tpdo_timer_event(const struct timespec *tp, void *data)
 	return 0;
 }
 
-static int
-co_tpdo_timer_swnd(const struct timespec *tp, void *data)
-{
-	(void)tp;
-	co_tpdo_t *pdo = data;
-	assert(pdo);
-
-	pdo->swnd = 1;
-
-	return 0;
-}
-
 static int
 default_sample_ind(co_tpdo_t *pdo, void *data)
 {
@@ -904,8 +916,8 @@ co_tpdo_init_frame(co_tpdo_t *pdo, struct can_msg *msg)
 	}
 
 	size_t n = CAN_MAX_LEN;
-	co_unsigned32_t ac = co_pdo_up(
-			&pdo->map, pdo->dev, &pdo->req, msg->data, &n);
+	co_unsigned32_t ac = co_pdo_plan_up(
+			&pdo->plan, pdo->dev, &pdo->req, msg->data, &n);
 	if (ac) {
 		if (pdo->ind)
 			pdo->ind(pdo, ac, NULL, 0, pdo->data);
@@ -982,6 +994,7 @@ co_tpdo_init(co_tpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 
 	memset(&pdo->comm, 0, sizeof(pdo->comm));
 	memset(&pdo->map, 0, sizeof(pdo->map));
+	memset(&pdo->plan, 0, sizeof(pdo->plan));
 
 	pdo->recv = can_recv_create(co_tpdo_get_alloc(pdo));
 	if (!pdo->recv) {
@@ -997,18 +1010,13 @@ co_tpdo_init(co_tpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 	}
 	can_timer_set_func(pdo->timer_event, &co_tpdo_timer_event, pdo);
 
-	pdo->timer_swnd = can_timer_create(co_tpdo_get_alloc(pdo));
-	if (!pdo->timer_swnd) {
-		errc = get_errc();
-		goto error_create_timer_swnd;
-	}
-	can_timer_set_func(pdo->timer_swnd, &co_tpdo_timer_swnd, pdo);
-
 	pdo->msg = (struct can_msg)CAN_MSG_INIT;
 
 	pdo->inhibit = (struct timespec){ 0, 0 };
 	pdo->event = 0;
 	pdo->swnd = 1;
+	pdo->swnd_dl = 0;
+	pdo->swnd_end = (struct timespec){ 0, 0 };
 	pdo->sync = 0;
 	pdo->cnt = 0;
 
@@ -1022,9 +1030,7 @@ co_tpdo_init(co_tpdo_t *pdo, can_net_t *net, co_dev_t *dev, co_unsigned16_t num)
 
 	return pdo;
 
-	// can_timer_destroy(pdo->timer_swnd);
-error_create_timer_swnd:
-	can_timer_destroy(pdo->timer_event);
+	// can_timer_destroy(pdo->timer_event);
 error_create_timer_event:
 	can_recv_destroy(pdo->recv);
 error_create_recv:
@@ -1043,7 +1049,6 @@ co_tpdo_fini(co_tpdo_t *pdo)
 
 	co_sdo_req_fini(&pdo->req);
 
-	can_timer_destroy(pdo->timer_swnd);
 	can_timer_destroy(pdo->timer_event);
 	can_recv_destroy(pdo->recv);
 }
@@ -92,6 +92,9 @@ struct Device::Impl_ : util::BasicLockable {
 
   void OnWrite(uint16_t idx, uint8_t subidx);
 
+  static uint32_t OnDnInd(co_sub_t* sub, co_sdo_req* req, uint32_t ac,
+                          void* data);
+
   ::std::tuple<uint16_t, uint8_t>
   RpdoMapping(uint8_t id, uint16_t idx, uint8_t subidx,
               ::std::error_code& ec) const noexcept {
@@ -166,14 +169,26 @@ struct Device::Impl_ : util::BasicLockable {
 
 #if !LELY_NO_CO_RPDO
   ::std::map<uint32_t, uint32_t> rpdo_mapping;
+
+  /// The remote sub-objects mapped into a single Receive-PDO.
+  struct RpdoBatch {
+    uint8_t id{0};
+    ::std::vector<RpdoMappedObject> objs;
+  };
+
+  /// The resolved RPDO mappings, indexed by PDO number - 1.
+  ::std::vector<RpdoBatch> rpdo_batch;
+  bool rpdo_batching{false};
 #endif
 #if !LELY_NO_CO_TPDO
   ::std::map<uint32_t, uint32_t> tpdo_mapping;
 #endif
 
   ::std::function<void(uint16_t, uint8_t)> on_write;
-#if !LELY_NO_CO_LSS
+#if !LELY_NO_CO_RPDO
   ::std::function<void(uint8_t, uint16_t, uint8_t)> on_rpdo_write;
+  ::std::function<void(uint8_t, int, const RpdoMappedObject*, ::std::size_t)>
+      on_rpdo_batch_write;
 #endif
 };
 
@@ -526,6 +541,232 @@ Device::Write(uint16_t idx, uint8_t subidx, const void* p, ::std::size_t n,
   set_errc(errsv);
 }
 
+namespace {
+
+bool
+has_custom_up_ind(const co_sub_t* sub) noexcept {
+#if LELY_NO_CO_OBJ_UPLOAD
+  (void)sub;
+  return false;
+#else
+  return !co_sub_has_default_up_ind(sub);
+#endif
+}
+
+}  // namespace
+
+template <class T>
+SubObjectRef<T>
+Device::GetSubObjectRef(uint16_t idx, uint8_t subidx) {
+  ::std::error_code ec;
+  auto ref = GetSubObjectRef<T>(idx, subidx, ec);
+  if (ec) throw_sdo_error(id(), idx, subidx, ec, "GetSubObjectRef");
+  return ref;
+}
+
+template <class T>
+SubObjectRef<T>
+Device::GetSubObjectRef(uint16_t idx, uint8_t subidx,
+                        ::std::error_code& ec) noexcept {
+  using traits = canopen_traits<T>;
+
+  ::std::lock_guard<Impl_> lock(*impl_);
+
+  auto obj = co_dev_find_obj(dev(), idx);
+  if (!obj) {
+    ec = SdoErrc::NO_OBJ;
+    return {};
+  }
+
+  auto sub = co_obj_find_sub(obj, subidx);
+  if (!sub) {
+    ec = SdoErrc::NO_SUB;
+    return {};
+  }
+
+  if (!is_canopen_same(traits::index, co_sub_get_type(sub))) {
+    ec = SdoErrc::TYPE_LEN;
+    return {};
+  }
+
+  ec.clear();
+  return SubObjectRef<T>(this, sub, idx, subidx);
+}
+
+template <class T>
+T
+SubObjectRef<T>::Read() const {
+  ::std::error_code ec;
+  T value(Read(ec));
+  if (ec) throw_sdo_error(dev_ ? dev_->id() : 0, idx_, subidx_, ec, "Read");
+  return value;
+}
+
+template <class T>
+T
+SubObjectRef<T>::Read(::std::error_code& ec) const {
+  using traits = canopen_traits<T>;
+  using c_type = typename traits::c_type;
+
+  if (!sub_) {
+    ec = SdoErrc::NO_SUB;
+    return T();
+  }
+
+  {
+    ::std::lock_guard<Device::Impl_> lock(*dev_->impl_);
+
+    if (!(co_sub_get_access(sub_) & CO_ACCESS_READ)) {
+      ec = SdoErrc::NO_READ;
+      return T();
+    }
+
+    if (!has_custom_up_ind(sub_)) {
+      ec.clear();
+      auto pval = static_cast<const c_type*>(co_sub_get_val(sub_));
+      return traits::from_c_type(*pval);
+    }
+  }
+
+  // Let the custom upload indication function produce the value.
+  return dev_->Read<T>(idx_, subidx_, ec);
+}
+
+template <class T>
+void
+SubObjectRef<T>::Write(T value) {
+  ::std::error_code ec;
+  Write(value, ec);
+  if (ec) throw_sdo_error(dev_ ? dev_->id() : 0, idx_, subidx_, ec, "Write");
+}
+
+template <class T>
+void
+SubObjectRef<T>::Write(T value, ::std::error_code& ec) {
+  using traits = canopen_traits<T>;
+
+  if (!sub_) {
+    ec = SdoErrc::NO_SUB;
+    return;
+  }
+
+  {
+    auto impl = dev_->impl_.get();
+    ::std::lock_guard<Device::Impl_> lock(*impl);
+
+    if (!(co_sub_get_access(sub_) & CO_ACCESS_WRITE)) {
+      ec = SdoErrc::NO_WRITE;
+      return;
+    }
+    // Do not let a previous error abort the conversion below.
+    ec.clear();
+
+    co_sub_dn_ind_t* ind = nullptr;
+    void* data = nullptr;
+    co_sub_get_dn_ind(sub_, &ind, &data);
+    // The download indication function installed by the device only issues a
+    // notification after the default behavior, which we can do ourselves.
+    bool notify = ind == &Device::Impl_::OnDnInd && data == impl;
+    if (notify || co_sub_has_default_dn_ind(sub_)) {
+      auto val = traits::to_c_type(value, ec);
+      if (ec) return;
+#if !LELY_NO_CO_OBJ_LIMITS
+      auto ac = co_sub_chk_val(sub_, traits::index, &val);
+      if (ac) {
+        ec = static_cast<SdoErrc>(ac);
+        return;
+      }
+#endif
+      // Copying a basic value cannot fail.
+      co_sub_dn(sub_, &val);
+      if (notify) impl->OnWrite(idx_, subidx_);
+      return;
+    }
+  }
+
+  // Let the custom download indication function process the value.
+  dev_->Write(idx_, subidx_, value, ec);
+}
+
+#ifndef DOXYGEN_SHOULD_SKIP_THIS
+
+// BOOLEAN
+template class SubObjectRef<bool>;
+template SubObjectRef<bool> Device::GetSubObjectRef<bool>(uint16_t, uint8_t);
+template SubObjectRef<bool> Device::GetSubObjectRef<bool>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// INTEGER8
+template class SubObjectRef<int8_t>;
+template SubObjectRef<int8_t> Device::GetSubObjectRef<int8_t>(uint16_t,
+                                                              uint8_t);
+template SubObjectRef<int8_t> Device::GetSubObjectRef<int8_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// INTEGER16
+template class SubObjectRef<int16_t>;
+template SubObjectRef<int16_t> Device::GetSubObjectRef<int16_t>(uint16_t,
+                                                                uint8_t);
+template SubObjectRef<int16_t> Device::GetSubObjectRef<int16_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// INTEGER32
+template class SubObjectRef<int32_t>;
+template SubObjectRef<int32_t> Device::GetSubObjectRef<int32_t>(uint16_t,
+                                                                uint8_t);
+template SubObjectRef<int32_t> Device::GetSubObjectRef<int32_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// UNSIGNED8
+template class SubObjectRef<uint8_t>;
+template SubObjectRef<uint8_t> Device::GetSubObjectRef<uint8_t>(uint16_t,
+                                                                uint8_t);
+template SubObjectRef<uint8_t> Device::GetSubObjectRef<uint8_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// UNSIGNED16
+template class SubObjectRef<uint16_t>;
+template SubObjectRef<uint16_t> Device::GetSubObjectRef<uint16_t>(uint16_t,
+                                                                  uint8_t);
+template SubObjectRef<uint16_t> Device::GetSubObjectRef<uint16_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// UNSIGNED32
+template class SubObjectRef<uint32_t>;
+template SubObjectRef<uint32_t> Device::GetSubObjectRef<uint32_t>(uint16_t,
+                                                                  uint8_t);
+template SubObjectRef<uint32_t> Device::GetSubObjectRef<uint32_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// REAL32
+template class SubObjectRef<float>;
+template SubObjectRef<float> Device::GetSubObjectRef<float>(uint16_t, uint8_t);
+template SubObjectRef<float> Device::GetSubObjectRef<float>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// REAL64
+template class SubObjectRef<double>;
+template SubObjectRef<double> Device::GetSubObjectRef<double>(uint16_t,
+                                                              uint8_t);
+template SubObjectRef<double> Device::GetSubObjectRef<double>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// INTEGER64
+template class SubObjectRef<int64_t>;
+template SubObjectRef<int64_t> Device::GetSubObjectRef<int64_t>(uint16_t,
+                                                                uint8_t);
+template SubObjectRef<int64_t> Device::GetSubObjectRef<int64_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+// UNSIGNED64
+template class SubObjectRef<uint64_t>;
+template SubObjectRef<uint64_t> Device::GetSubObjectRef<uint64_t>(uint16_t,
+                                                                  uint8_t);
+template SubObjectRef<uint64_t> Device::GetSubObjectRef<uint64_t>(
+    uint16_t, uint8_t, ::std::error_code&) noexcept;
+
+#endif  // DOXYGEN_SHOULD_SKIP_THIS
+
 #if !LELY_NO_STDIO
 void
 Device::WriteDcf(const uint8_t* begin, const uint8_t* end) {
@@ -832,6 +1073,28 @@ Device::OnRpdoWrite(
 #endif
 }
 
+void
+Device::OnRpdoWrite(::std::function<void(uint8_t, int, const RpdoMappedObject*,
+                                         ::std::size_t)>
+                        on_rpdo_write) {
+#if LELY_NO_CO_RPDO
+  (void)on_rpdo_write;
+#else
+  ::std::lock_guard<Impl_> lock(*impl_);
+  impl_->on_rpdo_batch_write = on_rpdo_write;
+#endif
+}
+
+void
+Device::SetRpdoWriteBatching(bool enable) {
+#if LELY_NO_CO_RPDO
+  (void)enable;
+#else
+  ::std::lock_guard<Impl_> lock(*impl_);
+  impl_->rpdo_batching = enable;
+#endif
+}
+
 co_dev_t*
 Device::dev() const noexcept {
   return impl_->dev.get();
@@ -1598,6 +1861,7 @@ void
 Device::UpdateRpdoMapping() {
 #if !LELY_NO_CO_RPDO
   impl_->rpdo_mapping.clear();
+  impl_->rpdo_batch.clear();
 
   // Loop over all RPDOs.
   co_obj_t* obj_1400 = nullptr;
@@ -1639,6 +1903,11 @@ Device::UpdateRpdoMapping() {
     // Check if the number of mapped objects is the same.
     auto n = co_obj_get_val_u8(obj_1600, 0);
     if (n != co_obj_get_val_u8(obj_5a00, 0)) continue;
+    // Resolve the list of remote sub-objects for batched notifications.
+    if (impl_->rpdo_batch.size() <= static_cast<::std::size_t>(i))
+      impl_->rpdo_batch.resize(i + 1);
+    auto& batch = impl_->rpdo_batch[i];
+    batch.id = id;
     for (int j = 1; j <= n; j++) {
       auto rmap = co_obj_get_val_u32(obj_1600, j);
       auto tmap = co_obj_get_val_u32(obj_5a00, j);
@@ -1654,11 +1923,37 @@ Device::UpdateRpdoMapping() {
       impl_->rpdo_mapping[tmap] = rmap;
       // Store the reverse mapping for OnRpdoWrite().
       impl_->rpdo_mapping[rmap] = tmap;
+      // Only objects with a write notification (see Impl_::OnWrite()) are
+      // included in the batch.
+      if (rmap >= 0x200000 && rmap < 0xc00000)
+        batch.objs.push_back({static_cast<uint16_t>((tmap >> 8) & 0xffff),
+                              static_cast<uint8_t>(tmap & 0xff)});
     }
   }
 #endif  // !LELY_NO_CO_RPDO
 }
 
+void
+Device::RpdoWriteInd(int num) {
+#if LELY_NO_CO_RPDO
+  (void)num;
+#else
+  if (!impl_->rpdo_batching || num < 1) return;
+  auto i = static_cast<::std::size_t>(num - 1);
+  if (i >= impl_->rpdo_batch.size()) return;
+  const auto& batch = impl_->rpdo_batch[i];
+  if (batch.objs.empty()) return;
+
+  OnRpdoWrite(batch.id, num, batch.objs.data(), batch.objs.size());
+
+  if (impl_->on_rpdo_batch_write) {
+    auto f = impl_->on_rpdo_batch_write;
+    util::UnlockGuard<Impl_> unlock(*impl_);
+    f(batch.id, num, batch.objs.data(), batch.objs.size());
+  }
+#endif
+}
+
 void
 Device::UpdateTpdoMapping() {
 #if !LELY_NO_CO_TPDO
@@ -1742,20 +2037,7 @@ Device::Impl_::Impl_(Device* self_, const ::std::string& dcf_txt,
     if (co_obj_get_idx(obj) < 0x2000) continue;
     // Skip reserved objects.
     if (co_obj_get_idx(obj) >= 0xC000) break;
-    co_obj_set_dn_ind(
-        obj,
-        [](co_sub_t* sub, co_sdo_req* req, uint32_t ac,
-           void* data) -> uint32_t {
-          // Implement the default behavior, but do not issue a notification for
-          // incomplete or failed writes.
-          if (ac) return ac;
-          if (co_sub_on_dn(sub, req, &ac) == -1 || ac) return ac;
-          auto impl_ = static_cast<Impl_*>(data);
-          impl_->OnWrite(co_obj_get_idx(co_sub_get_obj(sub)),
-                         co_sub_get_subidx(sub));
-          return 0;
-        },
-        static_cast<void*>(this));
+    co_obj_set_dn_ind(obj, &Impl_::OnDnInd, static_cast<void*>(this));
   }
 }
 #endif
@@ -1774,25 +2056,24 @@ Device::Impl_::Impl_(Device* self_, co_dev_t* staticDevice, uint8_t id, util::Ba
     if (co_obj_get_idx(obj) < 0x2000) continue;
     // Skip reserved objects.
     if (co_obj_get_idx(obj) >= 0xC000) break;
-    co_obj_set_dn_ind(
-        obj,
-        [](co_sub_t* sub, co_sdo_req* req, uint32_t ac,
-           void* data) -> uint32_t {
-          // Implement the default behavior, but do not issue a notification for
-          // incomplete or failed writes.
-          if (ac) return ac;
-          if (co_sub_on_dn(sub, req, &ac) == -1 || ac) return ac;
-          auto impl_ = static_cast<Impl_*>(data);
-          impl_->OnWrite(co_obj_get_idx(co_sub_get_obj(sub)),
-                         co_sub_get_subidx(sub));
-          return 0;
-        },
-        static_cast<void*>(this));
+    co_obj_set_dn_ind(obj, &Impl_::OnDnInd, static_cast<void*>(this));
   }
 }
 
 #endif  // !LELY_NO_CO_DCF
 
+uint32_t
+Device::Impl_::OnDnInd(co_sub_t* sub, co_sdo_req* req, uint32_t ac,
+                       void* data) {
+  // Implement the default behavior, but do not issue a notification for
+  // incomplete or failed writes.
+  if (ac) return ac;
+  if (co_sub_on_dn(sub, req, &ac) == -1 || ac) return ac;
+  auto impl_ = static_cast<Impl_*>(data);
+  impl_->OnWrite(co_obj_get_idx(co_sub_get_obj(sub)), co_sub_get_subidx(sub));
+  return 0;
+}
+
 void
 Device::Impl_::OnWrite(uint16_t idx, uint8_t subidx) {
   self->OnWrite(idx, subidx);
@@ -1804,6 +2085,12 @@ Device::Impl_::OnWrite(uint16_t idx, uint8_t subidx) {
   }
 
 #if !LELY_NO_CO_RPDO
+  // With batching enabled, the notification is issued once per PDO by
+  // Device::RpdoWriteInd(). Since the origin of a write is not known here,
+  // this also drops the notification for SDO downloads (as documented in
+  // SetRpdoWriteBatching()).
+  if (rpdo_batching) return;
+
   uint8_t id = 0;
   ::std::error_code ec;
   ::std::tie(id, idx, subidx) = RpdoMapping(idx, subidx, ec);
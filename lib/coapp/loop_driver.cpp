@@ -27,12 +27,16 @@
 
 #include <lely/coapp/loop_driver.hpp>
 
+#include <lely/compat/threads.h>
+
+#include <algorithm>
 #include <atomic>
 #ifdef __MINGW32__
-#include <lely/compat/threads.h>
+#include <windows.h>
 #else
 #include <thread>
 #endif
+#include <vector>
 
 #include <cassert>
 
@@ -40,9 +44,28 @@ namespace lely {
 
 namespace canopen {
 
+/// The internal implementation of #lely::canopen::LoopDriverPool.
+struct LoopDriverPool::Impl_ {
+  explicit Impl_(::std::size_t nthrd);
+  Impl_(const Impl_&) = delete;
+  Impl_& operator=(const Impl_&) = delete;
+  ~Impl_();
+
+  void Start();
+  void Join();
+
+  ev::Loop loop;
+#ifdef __MINGW32__
+  ::std::vector<thrd_t> thrs;
+#else
+  ::std::vector<::std::thread> threads;
+#endif
+  ::std::atomic_flag joined{false};
+};
+
 /// The internal implementation of #lely::canopen::LoopDriver.
 struct LoopDriver::Impl_ : io_svc {
-  explicit Impl_(LoopDriver* self, io::ContextBase ctx);
+  explicit Impl_(LoopDriver* self, io::ContextBase ctx, bool pooled);
   Impl_(const Impl_&) = delete;
   Impl_& operator=(const Impl_&) = delete;
   ~Impl_();
@@ -55,8 +78,14 @@ struct LoopDriver::Impl_ : io_svc {
 
   LoopDriver* self{nullptr};
   io::ContextBase ctx{nullptr};
+  bool pooled{false};
   ::std::atomic_flag shutdown{false};
   ev::Promise<void, void> stopped;
+  // Only used if the driver runs on a shared event loop, since the calling
+  // thread cannot wait for the (shared) threads to terminate.
+  mtx_t mtx;
+  cnd_t cond;
+  bool done{false};
 #ifdef __MINGW32__
   thrd_t thr;
 #else
@@ -65,6 +94,40 @@ struct LoopDriver::Impl_ : io_svc {
   ::std::atomic_flag joined{false};
 };
 
+namespace detail {
+
+LoopDriverBase::LoopDriverBase()
+    : own_loop(new ev::Loop), loop(*own_loop), strand(loop.get_executor()) {}
+
+LoopDriverBase::LoopDriverBase(LoopDriverPool& pool)
+    : loop(pool.GetLoop()), strand(loop.get_executor()) {}
+
+}  // namespace detail
+
+LoopDriverPool::LoopDriverPool(::std::size_t nthrd)
+    : impl_(new Impl_(nthrd)) {}
+
+LoopDriverPool::~LoopDriverPool() = default;
+
+ev::Loop&
+LoopDriverPool::GetLoop() noexcept {
+  return impl_->loop;
+}
+
+::std::size_t
+LoopDriverPool::size() const noexcept {
+#ifdef __MINGW32__
+  return impl_->thrs.size();
+#else
+  return impl_->threads.size();
+#endif
+}
+
+void
+LoopDriverPool::Join() {
+  impl_->Join();
+}
+
 // clang-format off
 const io_svc_vtbl LoopDriver::Impl_::svc_vtbl = {
     nullptr,
@@ -76,7 +139,14 @@ const io_svc_vtbl LoopDriver::Impl_::svc_vtbl = {
 
 LoopDriver::LoopDriver(AsyncMaster& master, uint8_t id)
     : BasicDriver(strand.get_inner_executor(), master, id),
-      impl_(new Impl_(this, master.GetContext())) {}
+      impl_(new Impl_(this, master.GetContext(), false)) {}
+
+LoopDriver::LoopDriver(LoopDriverPool& pool, AsyncMaster& master, uint8_t id)
+    : LoopDriverBase(pool),
+      // The event loop is run by multiple threads, so all tasks of the driver
+      // have to go through the strand to be serialized.
+      BasicDriver(strand, master, id),
+      impl_(new Impl_(this, master.GetContext(), true)) {}
 
 LoopDriver::~LoopDriver() = default;
 
@@ -118,17 +188,86 @@ LoopDriver::USleep(uint_least64_t usec, ::std::error_code& ec) {
   if (!f.is_ready()) master.CancelWait(*wait);
 }
 
-LoopDriver::Impl_::Impl_(LoopDriver* self_, io::ContextBase ctx_)
+LoopDriverPool::Impl_::Impl_(::std::size_t nthrd) {
+  if (!nthrd) {
+#ifdef __MINGW32__
+    SYSTEM_INFO si;
+    GetSystemInfo(&si);
+    nthrd = si.dwNumberOfProcessors;
+#else
+    nthrd = ::std::thread::hardware_concurrency();
+#endif
+    nthrd = ::std::max<::std::size_t>(nthrd, 1);
+  }
+
+  // Signal the existence of a fake task to prevent the loop from stopping
+  // when it runs out of tasks.
+  loop.get_executor().on_task_init();
+  for (::std::size_t i = 0; i < nthrd; i++) {
+#ifdef __MINGW32__
+    thrd_t thr;
+    if (thrd_create(
+            &thr,
+            [](void* arg) noexcept {
+              static_cast<LoopDriverPool::Impl_*>(arg)->Start();
+              return 0;
+            },
+            this) != thrd_success) {
+      Join();
+      util::throw_errc("thrd_create");
+    }
+    thrs.push_back(thr);
+#else
+    try {
+      threads.emplace_back(&Impl_::Start, this);
+    } catch (...) {
+      Join();
+      throw;
+    }
+#endif
+  }
+}
+
+LoopDriverPool::Impl_::~Impl_() { Join(); }
+
+void
+LoopDriverPool::Impl_::Start() {
+  loop.run();
+}
+
+void
+LoopDriverPool::Impl_::Join() {
+  if (!joined.test_and_set()) {
+    loop.stop();
+#ifdef __MINGW32__
+    for (auto thr : thrs) thrd_join(thr, nullptr);
+#else
+    for (auto& thread : threads) thread.join();
+#endif
+    loop.get_executor().on_task_fini();
+  }
+}
+
+LoopDriver::Impl_::Impl_(LoopDriver* self_, io::ContextBase ctx_, bool pooled_)
     : io_svc IO_SVC_INIT(&svc_vtbl),
       self(self_),
-      ctx(ctx_)
+      ctx(ctx_),
+      pooled(pooled_)
 #ifndef __MINGW32__
       ,
-      thread(&Impl_::Start, this)
+      thread(pooled ? ::std::thread() : ::std::thread(&Impl_::Start, this))
 #endif
 {
+  if (pooled) {
+    if (mtx_init(&mtx, mtx_plain) != thrd_success) util::throw_errc("mtx_init");
+    if (cnd_init(&cond) != thrd_success) {
+      int errc = get_errc();
+      mtx_destroy(&mtx);
+      util::throw_errc("cnd_init", errc);
+    }
+  }
 #ifdef __MINGW32__
-  if (thrd_create(
+  if (!pooled && thrd_create(
           &thr,
           [](void* arg) noexcept {
             static_cast<LoopDriver::Impl_*>(arg)->Start();
@@ -143,6 +282,10 @@ LoopDriver::Impl_::Impl_(LoopDriver* self_, io::ContextBase ctx_)
 LoopDriver::Impl_::~Impl_() {
   Join();
   ctx.remove(*this);
+  if (pooled) {
+    cnd_destroy(&cond);
+    mtx_destroy(&mtx);
+  }
 }
 
 void
@@ -174,8 +317,22 @@ LoopDriver::Impl_::Shutdown() {
   if (!shutdown.test_and_set()) {
     // Stop receiving CANopen events.
     self->master.Erase(*self);
-    // Stop the blocking run of the event loop.
-    self->GetLoop().stop();
+    if (pooled) {
+      // The shared event loop keeps running. Since the strand executes tasks
+      // in order, the tasks queued before this one are finished once it runs.
+      self->strand.post([this]() {
+        stopped.set(0);
+        // Notify Join() while holding the mutex, since the driver may be
+        // destroyed as soon as it is released.
+        mtx_lock(&mtx);
+        done = true;
+        cnd_broadcast(&cond);
+        mtx_unlock(&mtx);
+      });
+    } else {
+      // Stop the blocking run of the event loop.
+      self->GetLoop().stop();
+    }
   }
 }
 
@@ -183,11 +340,17 @@ void
 LoopDriver::Impl_::Join() {
   if (!joined.test_and_set()) {
     Shutdown();
+    if (pooled) {
+      mtx_lock(&mtx);
+      while (!done) cnd_wait(&cond, &mtx);
+      mtx_unlock(&mtx);
+    } else {
 #ifdef __MINGW32__
-    thrd_join(thr, nullptr);
+      thrd_join(thr, nullptr);
 #else
-    thread.join();
+      thread.join();
 #endif
+    }
   }
 }
 
@@ -33,6 +33,7 @@
 #include <array>
 #include <map>
 #include <string>
+#include <vector>
 
 #include <cassert>
 
@@ -333,6 +334,16 @@ BasicMaster::OnRpdoWrite(uint8_t id, uint16_t idx, uint8_t subidx) noexcept {
   }
 }
 
+void
+BasicMaster::OnRpdoWrite(uint8_t id, int num, const RpdoMappedObject* p,
+                         ::std::size_t n) noexcept {
+  auto it = find(id);
+  if (it != end()) {
+    util::UnlockGuard<util::BasicLockable> unlock(*this);
+    it->second->OnRpdoWrite(num, p, n);
+  }
+}
+
 void
 BasicMaster::OnCommand(NmtCommand cs) noexcept {
   // Abort all ongoing and pending SDO requests unless the master is in the
@@ -535,6 +546,18 @@ AsyncMaster::OnRpdoWrite(uint8_t id, uint16_t idx, uint8_t subidx) noexcept {
   }
 }
 
+void
+AsyncMaster::OnRpdoWrite(uint8_t id, int num, const RpdoMappedObject* p,
+                         ::std::size_t n) noexcept {
+  auto it = find(id);
+  if (it != end()) {
+    DriverBase* driver = it->second;
+    ::std::vector<RpdoMappedObject> objs(p, p + n);
+    driver->GetExecutor().post(
+        [=]() { driver->OnRpdoWrite(num, objs.data(), objs.size()); });
+  }
+}
+
 void
 AsyncMaster::OnCommand(NmtCommand cs) noexcept {
   // Abort all ongoing and pending SDO requests unless the master is in the
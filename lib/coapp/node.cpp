@@ -691,6 +691,9 @@ void
 Node::Impl_::OnRpdoInd(co_rpdo_t* pdo, uint32_t ac, const void* ptr,
                        size_t n) noexcept {
   int num = co_rpdo_get_num(pdo);
+  // Issue the batched write notification, if enabled, before notifying the
+  // implementation of the PDO itself.
+  if (!ac) self->RpdoWriteInd(num);
   self->OnRpdo(num, static_cast<SdoErrc>(ac), ptr, n);
 
   if (on_rpdo) {
@@ -28,6 +28,9 @@
 #endif
 #include <lely/co/val.h>
 #include <lely/coapp/sdo.hpp>
+#if !LELY_NO_THREADS
+#include <lely/compat/threads.h>
+#endif
 
 #include <limits>
 #include <memory>
@@ -41,6 +44,150 @@ namespace lely {
 
 namespace canopen {
 
+namespace detail {
+
+/**
+ * The pool of recycled memory blocks for the SDO request wrappers of a
+ * Client-SDO queue. Blocks are rounded up to a multiple of #kBlockSize bytes
+ * and kept on a free list per size once the request completes. Since the
+ * completion task may run on any executor, and may outlive the queue, the pool
+ * is protected by a mutex and reference counted: the queue holds one reference
+ * and each outstanding request another.
+ */
+class SdoRequestPool {
+ public:
+  SdoRequestPool();
+  SdoRequestPool(const SdoRequestPool&) = delete;
+  SdoRequestPool& operator=(const SdoRequestPool&) = delete;
+
+  /**
+   * Allocates a block of at least <b>size</b> bytes and acquires a reference
+   * to the pool.
+   */
+  void* Allocate(::std::size_t size);
+
+  /**
+   * Returns a block obtained from Allocate() to the pool and releases the
+   * reference acquired by Allocate().
+   */
+  void Deallocate(void* ptr, ::std::size_t size) noexcept;
+
+  /**
+   * Releases the reference held by the owner of the pool. The pool is
+   * destroyed once all outstanding blocks have been returned.
+   */
+  void Release() noexcept;
+
+ private:
+  /// The granularity (in bytes) of the block sizes.
+  static constexpr ::std::size_t kBlockSize = 64;
+  /// The number of block sizes. Larger blocks are not recycled.
+  static constexpr ::std::size_t kNumSizes = 8;
+
+  struct Block {
+    Block* next;
+  };
+
+  ~SdoRequestPool();
+
+  void Lock() noexcept;
+  void Unlock() noexcept;
+
+#if !LELY_NO_THREADS
+  mtx_t mtx_;
+#endif
+  ::std::size_t refcnt_{1};
+  Block* free_[kNumSizes]{};
+};
+
+SdoRequestPool::SdoRequestPool() {
+#if !LELY_NO_THREADS
+  if (mtx_init(&mtx_, mtx_plain) != thrd_success) util::throw_errc("mtx_init");
+#endif
+}
+
+SdoRequestPool::~SdoRequestPool() {
+  for (auto& free : free_) {
+    while (free) {
+      auto block = free;
+      free = block->next;
+      ::operator delete(block);
+    }
+  }
+#if !LELY_NO_THREADS
+  mtx_destroy(&mtx_);
+#endif
+}
+
+void*
+SdoRequestPool::Allocate(::std::size_t size) {
+  ::std::size_t i = size ? (size - 1) / kBlockSize : 0;
+
+  Lock();
+  Block* block = nullptr;
+  if (i < kNumSizes && (block = free_[i])) free_[i] = block->next;
+  refcnt_++;
+  Unlock();
+
+  if (block) return block;
+  try {
+    return ::operator new(i < kNumSizes ? (i + 1) * kBlockSize : size);
+  } catch (...) {
+    Release();
+    throw;
+  }
+}
+
+void
+SdoRequestPool::Deallocate(void* ptr, ::std::size_t size) noexcept {
+  ::std::size_t i = size ? (size - 1) / kBlockSize : 0;
+  if (i >= kNumSizes) ::operator delete(ptr);
+
+  Lock();
+  if (i < kNumSizes) free_[i] = new (ptr) Block{free_[i]};
+  bool last = !--refcnt_;
+  Unlock();
+
+  if (last) delete this;
+}
+
+void
+SdoRequestPool::Release() noexcept {
+  Lock();
+  bool last = !--refcnt_;
+  Unlock();
+
+  if (last) delete this;
+}
+
+inline void
+SdoRequestPool::Lock() noexcept {
+#if !LELY_NO_THREADS
+  mtx_lock(&mtx_);
+#endif
+}
+
+inline void
+SdoRequestPool::Unlock() noexcept {
+#if !LELY_NO_THREADS
+  mtx_unlock(&mtx_);
+#endif
+}
+
+template <class R>
+inline void
+SdoRequestBase::Destroy(R* req) noexcept {
+  auto pool = req->pool_;
+  if (pool) {
+    req->~R();
+    pool->Deallocate(req, sizeof(R));
+  } else {
+    delete req;
+  }
+}
+
+}  // namespace detail
+
 /// The internal implementation of the Client-SDO queue.
 struct Sdo::Impl_ {
   Impl_(can_net_t* net, co_dev_t* dev, uint8_t num);
@@ -75,6 +222,16 @@ struct Sdo::Impl_ {
 
   sllist queue;
 #endif
+
+  struct PoolReleaser {
+    void
+    operator()(detail::SdoRequestPool* pool) const noexcept {
+      pool->Release();
+    }
+  };
+
+  ::std::unique_ptr<detail::SdoRequestPool, PoolReleaser> pool{
+      new detail::SdoRequestPool()};
 };
 
 namespace detail {
@@ -110,9 +267,8 @@ SdoDownloadRequestWrapper<T>::operator()() noexcept {
   auto idx = this->idx;
   auto subidx = this->subidx;
   auto ec = this->ec;
-  ::std::function<Signature> con;
-  con.swap(this->con_);
-  delete this;
+  auto con = ::std::move(this->con_);
+  this->Destroy(this);
   if (con) con(id, idx, subidx, ec);
 }
 
@@ -133,9 +289,8 @@ SdoDownloadDcfRequestWrapper::operator()() noexcept {
   auto idx = this->idx;
   auto subidx = this->subidx;
   auto ec = this->ec;
-  ::std::function<Signature> con;
-  con.swap(this->con_);
-  delete this;
+  auto con = ::std::move(this->con_);
+  this->Destroy(this);
   if (con) con(id, idx, subidx, ec);
 }
 
@@ -157,9 +312,8 @@ SdoUploadRequestWrapper<T>::operator()() noexcept {
   auto subidx = this->subidx;
   auto ec = this->ec;
   T value = ::std::move(this->value);
-  ::std::function<Signature> con;
-  con.swap(this->con_);
-  delete this;
+  auto con = ::std::move(this->con_);
+  this->Destroy(this);
   if (con) con(id, idx, subidx, ec, ::std::move(value));
 }
 
@@ -431,6 +585,18 @@ Sdo::AsyncDownloadDcf(ev_exec_t* exec, const char* path,
 #endif
 
 
+void*
+Sdo::AllocateRequest(::std::size_t size, detail::SdoRequestPool*& pool) {
+  pool = impl_->pool.get();
+  return pool->Allocate(size);
+}
+
+void
+Sdo::DeallocateRequest(detail::SdoRequestPool* pool, void* ptr,
+                       ::std::size_t size) noexcept {
+  pool->Deallocate(ptr, size);
+}
+
 void
 Sdo::Submit(detail::SdoRequestBase& req) {
   impl_->Submit(req);
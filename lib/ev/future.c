@@ -41,11 +41,37 @@
 #include <assert.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef LELY_EV_FUTURE_MAX
 #define LELY_EV_FUTURE_MAX MAX((LELY_VLA_SIZE_MAX / sizeof(ev_future_t *)), 1)
 #endif
 
+/**
+ * The granularity (in bytes) of the size classes of the thread-local promise
+ * cache.
+ */
+#ifndef LELY_EV_PROMISE_CACHE_BLOCK
+#define LELY_EV_PROMISE_CACHE_BLOCK 64
+#endif
+
+/**
+ * The number of size classes of the thread-local promise cache. Promises larger
+ * than `LELY_EV_PROMISE_CACHE_NCLASS * LELY_EV_PROMISE_CACHE_BLOCK` bytes
+ * (including the shared state) are not cached.
+ */
+#ifndef LELY_EV_PROMISE_CACHE_NCLASS
+#define LELY_EV_PROMISE_CACHE_NCLASS 8
+#endif
+
+/**
+ * The maximum number of promises kept in each size class of the thread-local
+ * promise cache. If 0, the cache is disabled.
+ */
+#ifndef LELY_EV_PROMISE_CACHE_SIZE
+#define LELY_EV_PROMISE_CACHE_SIZE 16
+#endif
+
 /// The state of a future.
 enum ev_future_state {
 	/// The future is waiting.
@@ -108,6 +134,16 @@ struct ev_promise {
 #endif
 	/// The (destructor) function invoked when this struct is reclaimed.
 	ev_promise_dtor_t *dtor;
+	/**
+	 * A pointer to the allocator used to allocate this struct, or NULL if
+	 * it was allocated from the thread-local promise cache or the heap.
+	 */
+	alloc_t *alloc;
+	/**
+	 * The size class of this struct in the thread-local promise cache, or
+	 * #LELY_EV_PROMISE_CACHE_NCLASS if it is too large to be cached.
+	 */
+	size_t cls;
 	/// The future used to monitor if the promise has been satisfied.
 	struct ev_future future;
 };
@@ -116,9 +152,41 @@ struct ev_promise {
 
 static inline ev_promise_t *ev_promise_from_future(const ev_future_t *future);
 
-static void *ev_promise_alloc(size_t size);
+static void *ev_promise_alloc(alloc_t *alloc, size_t size);
 static void ev_promise_free(void *ptr);
 
+#if LELY_EV_PROMISE_CACHE_SIZE > 0
+
+/**
+ * A thread-local cache of promises, containing a free list for each size class.
+ * The first bytes of each free promise are used as the link to the next one.
+ */
+struct ev_promise_cache {
+	/// The first free promise in each size class.
+	void *free[LELY_EV_PROMISE_CACHE_NCLASS];
+	/// The number of free promises in each size class.
+	size_t n[LELY_EV_PROMISE_CACHE_NCLASS];
+#if !LELY_NO_THREADS
+	/**
+	 * A flag indicating whether the cache is registered to be cleared when
+	 * the thread exits.
+	 */
+	int registered;
+#endif
+};
+
+static struct ev_promise_cache *ev_promise_cache_get(void);
+#if !LELY_NO_THREADS
+// The destructor of the thread-specific storage key of the cache.
+#if !LELY_HAVE_PTHREAD_H && _WIN32
+static void WINAPI ev_promise_cache_dtor(void *arg);
+#else
+static void ev_promise_cache_dtor(void *arg);
+#endif
+#endif
+
+#endif // LELY_EV_PROMISE_CACHE_SIZE > 0
+
 static ev_promise_t *ev_promise_init(
 		ev_promise_t *promise, ev_promise_dtor_t *dtor);
 static void ev_promise_fini(ev_promise_t *promise);
@@ -152,10 +220,17 @@ static void ev_future_when_any_func(struct ev_task *task);
 
 ev_promise_t *
 ev_promise_create(size_t size, ev_promise_dtor_t *dtor)
+{
+	return ev_promise_create_with_alloc(NULL, size, dtor);
+}
+
+ev_promise_t *
+ev_promise_create_with_alloc(
+		alloc_t *alloc, size_t size, ev_promise_dtor_t *dtor)
 {
 	int errc = 0;
 
-	ev_promise_t *promise = ev_promise_alloc(size);
+	ev_promise_t *promise = ev_promise_alloc(alloc, size);
 	if (!promise) {
 		errc = get_errc();
 		goto error_alloc;
@@ -592,21 +667,147 @@ ev_promise_from_future(const ev_future_t *future)
 }
 
 static void *
-ev_promise_alloc(size_t size)
+ev_promise_alloc(alloc_t *alloc, size_t size)
 {
-	// cppcheck-suppress AssignmentAddressToInteger
-	void *ptr = calloc(1, EV_PROMISE_SIZE + size);
-	if (!ptr)
-		set_errc_from_errno();
-	return ptr;
+	size += EV_PROMISE_SIZE;
+
+	ev_promise_t *promise = NULL;
+	size_t cls = LELY_EV_PROMISE_CACHE_NCLASS;
+	if (alloc) {
+		promise = mem_alloc(alloc, _Alignof(max_align_t), size);
+		if (!promise)
+			return NULL;
+		memset(promise, 0, size);
+	} else {
+#if LELY_EV_PROMISE_CACHE_SIZE > 0
+		cls = (size - 1) / LELY_EV_PROMISE_CACHE_BLOCK;
+		if (cls < LELY_EV_PROMISE_CACHE_NCLASS) {
+			struct ev_promise_cache *cache = ev_promise_cache_get();
+			if (cache && cache->free[cls]) {
+				promise = cache->free[cls];
+				cache->free[cls] = *(void **)promise;
+				cache->n[cls]--;
+				memset(promise, 0, size);
+			}
+			// Allocate the entire block, so it can be reused for
+			// any promise in the same size class.
+			size = (cls + 1) * LELY_EV_PROMISE_CACHE_BLOCK;
+		} else {
+			cls = LELY_EV_PROMISE_CACHE_NCLASS;
+		}
+#endif
+		// cppcheck-suppress AssignmentAddressToInteger
+		if (!promise && !(promise = calloc(1, size))) {
+			set_errc_from_errno();
+			return NULL;
+		}
+	}
+	promise->alloc = alloc;
+	promise->cls = cls;
+
+	return promise;
 }
 
 static void
 ev_promise_free(void *ptr)
 {
-	free(ptr);
+	ev_promise_t *promise = ptr;
+	assert(promise);
+
+	if (promise->alloc) {
+		mem_free(promise->alloc, promise);
+		return;
+	}
+
+#if LELY_EV_PROMISE_CACHE_SIZE > 0
+	size_t cls = promise->cls;
+	if (cls < LELY_EV_PROMISE_CACHE_NCLASS) {
+		struct ev_promise_cache *cache = ev_promise_cache_get();
+		if (cache && cache->n[cls] < LELY_EV_PROMISE_CACHE_SIZE) {
+			*(void **)promise = cache->free[cls];
+			cache->free[cls] = promise;
+			cache->n[cls]++;
+			return;
+		}
+	}
+#endif
+
+	free(promise);
 }
 
+#if LELY_EV_PROMISE_CACHE_SIZE > 0
+
+#if LELY_NO_THREADS
+
+static struct ev_promise_cache *
+ev_promise_cache_get(void)
+{
+	static struct ev_promise_cache cache;
+	return &cache;
+}
+
+#else // !LELY_NO_THREADS
+
+static _Thread_local struct ev_promise_cache ev_promise_cache;
+
+static once_flag ev_promise_cache_once = ONCE_FLAG_INIT;
+static tss_t ev_promise_cache_key;
+static int ev_promise_cache_key_valid;
+
+static void
+ev_promise_cache_once_func(void)
+{
+	// clang-format off
+	ev_promise_cache_key_valid = tss_create(&ev_promise_cache_key,
+			&ev_promise_cache_dtor) == thrd_success;
+	// clang-format on
+}
+
+static struct ev_promise_cache *
+ev_promise_cache_get(void)
+{
+	struct ev_promise_cache *cache = &ev_promise_cache;
+	if (!cache->registered) {
+		// Register the cache, so it is cleared when the thread exits.
+		// Without a thread-specific storage key, the cache is disabled
+		// to prevent leaking its contents.
+		call_once(&ev_promise_cache_once, &ev_promise_cache_once_func);
+		if (!ev_promise_cache_key_valid
+				|| tss_set(ev_promise_cache_key, cache)
+						!= thrd_success)
+			return NULL;
+		cache->registered = 1;
+	}
+	return cache;
+}
+
+#if !LELY_HAVE_PTHREAD_H && _WIN32
+static void WINAPI
+#else
+static void
+#endif
+ev_promise_cache_dtor(void *arg)
+{
+	struct ev_promise_cache *cache = arg;
+	assert(cache);
+
+	for (size_t cls = 0; cls < LELY_EV_PROMISE_CACHE_NCLASS; cls++) {
+		while (cache->free[cls]) {
+			void *ptr = cache->free[cls];
+			cache->free[cls] = *(void **)ptr;
+			free(ptr);
+		}
+		cache->n[cls] = 0;
+	}
+	// If a promise is released by another destructor after this one, the
+	// cache is registered again.
+	cache->registered = 0;
+}
+
+#endif // !LELY_NO_THREADS
+
+#endif // LELY_EV_PROMISE_CACHE_SIZE > 0
+
 static ev_promise_t *
 ev_promise_init(ev_promise_t *promise, ev_promise_dtor_t *dtor)
 {
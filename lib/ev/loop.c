@@ -48,6 +48,78 @@
 #define LELY_EV_LOOP_CTX_MAX_UNUSED 16
 #endif
 
+#ifndef LELY_EV_LOOP_WS
+#if !LELY_NO_THREADS && !LELY_NO_ATOMICS && (!_WIN32 || defined(__MINGW32__))
+/// A flag indicating whether work-stealing queues are supported.
+#define LELY_EV_LOOP_WS 1
+#else
+#define LELY_EV_LOOP_WS 0
+#endif
+#endif
+
+#if LELY_EV_LOOP_WS
+
+#ifndef LELY_EV_LOOP_WSQ_SIZE
+/**
+ * The number of tasks that fit in a single work-stealing queue. This MUST be a
+ * power of 2. Tasks posted to a full queue are added to the shared task queue.
+ */
+#define LELY_EV_LOOP_WSQ_SIZE 256
+#endif
+
+#ifndef LELY_EV_LOOP_WS_FAIR
+/**
+ * The maximum number of consecutive tasks a thread executes from its own
+ * work-stealing queue before checking the shared task queue (and the polling
+ * task) again.
+ */
+#define LELY_EV_LOOP_WS_FAIR 61
+#endif
+
+/**
+ * The type of a slot in a work-stealing queue. Without <stdatomic.h>, every
+ * spelling of `_Atomic(struct ev_task *)` declares a distinct type, so all
+ * slots, and pointers to them, MUST use this typedef.
+ */
+typedef _Atomic(struct ev_task *) ev_loop_wsq_slot_t;
+
+/**
+ * A work-stealing queue. The queue is a bounded ring buffer of task pointers.
+ * Only the owning thread adds tasks (at the bottom), but any thread can take
+ * tasks from the top, including the owner. A slot is claimed by incrementing
+ * #top and subsequently exchanging the task pointer with `NULL`. Aborting a
+ * task clears its slot, in which case the claiming thread skips it.
+ */
+struct ev_loop_wsq {
+	/// A pointer to the event loop owning this queue.
+	ev_loop_t *loop;
+	/**
+	 * A flag indicating whether the queue is in use by a thread. This flag
+	 * is protected by the mutex of the event loop.
+	 */
+	int owned;
+	/// The index of the first task in the queue.
+	atomic_size_t top;
+	/// The index one past the last task in the queue.
+	atomic_size_t bottom;
+	/// The value of the stop epoch of the loop last seen by the owner.
+	size_t epoch;
+	/**
+	 * The number of consecutive tasks taken by the owner without locking
+	 * the event loop.
+	 */
+	size_t tick;
+	/// The slots containing the queued tasks.
+	ev_loop_wsq_slot_t slots[LELY_EV_LOOP_WSQ_SIZE];
+};
+
+static int ev_loop_wsq_push(struct ev_loop_wsq *wsq, struct ev_task *task);
+static struct ev_task *ev_loop_wsq_take(struct ev_loop_wsq *wsq);
+static int ev_loop_wsq_remove(struct ev_loop_wsq *wsq, struct ev_task *task);
+static int ev_loop_wsq_empty(const struct ev_loop_wsq *wsq);
+
+#endif // LELY_EV_LOOP_WS
+
 /// An event loop context.
 struct ev_loop_ctx {
 	/**
@@ -113,10 +185,18 @@ struct ev_loop_thrd {
 	int stopped;
 	/// A pointer to the event loop context for this thread.
 	struct ev_loop_ctx *ctx;
+#if LELY_EV_LOOP_WS
+	/// A pointer to the work-stealing queue owned by this thread.
+	struct ev_loop_wsq *wsq;
+	/// The number of nested run functions using #wsq.
+	size_t wsdepth;
+#endif
 };
 
 #if LELY_NO_THREADS
 static struct ev_loop_thrd ev_loop_thrd = { 0, NULL };
+#elif LELY_EV_LOOP_WS
+static _Thread_local struct ev_loop_thrd ev_loop_thrd = { 0, NULL, NULL, 0 };
 #else
 static _Thread_local struct ev_loop_thrd ev_loop_thrd = { 0, NULL };
 #endif
@@ -193,6 +273,23 @@ struct ev_loop {
 	 * #LELY_EV_LOOP_CTX_MAX_UNUSED.
 	 */
 	size_t nunused;
+#if LELY_EV_LOOP_WS
+	/// An array of work-stealing queues, one for each thread.
+	struct ev_loop_wsq *wsqs;
+	/**
+	 * The number of work-stealing queues in #wsqs. This value is only
+	 * modified while holding the mutex, but it can be read without.
+	 */
+	atomic_size_t nwsq;
+	/**
+	 * The stop epoch. This value is incremented whenever the event loop or
+	 * one of its threads is stopped, or a future becomes ready, to ensure
+	 * the threads check their state before executing the next task.
+	 */
+	atomic_size_t epoch;
+	/// The number of threads polling or waiting for a task to be submitted.
+	atomic_size_t nidle;
+#endif
 };
 
 static inline ev_loop_t *ev_loop_from_impl(const ev_std_exec_impl_t *impl);
@@ -200,10 +297,24 @@ static inline ev_loop_t *ev_loop_from_impl(const ev_std_exec_impl_t *impl);
 static int ev_loop_empty(const ev_loop_t *loop);
 static size_t ev_loop_ntasks(const ev_loop_t *loop);
 
+static struct ev_task *ev_loop_pop(ev_loop_t *loop);
+
+static int ev_loop_idle_begin(ev_loop_t *loop);
+static void ev_loop_idle_end(ev_loop_t *loop);
+
 static void ev_loop_do_stop(ev_loop_t *loop);
 
 static int ev_loop_kill_any(ev_loop_t *loop, int polling);
 
+#if LELY_EV_LOOP_WS
+static inline size_t ev_loop_nwsq(const ev_loop_t *loop);
+static void ev_loop_ws_enter(ev_loop_t *loop);
+static void ev_loop_ws_leave(ev_loop_t *loop);
+static int ev_loop_ws_run_fast(ev_loop_t *loop);
+static void ev_loop_ws_sync(ev_loop_t *loop);
+static void ev_loop_ws_kill(ev_loop_t *loop);
+#endif
+
 void *
 ev_loop_alloc(void)
 {
@@ -258,6 +369,13 @@ ev_loop_init(ev_loop_t *loop, ev_poll_t *poll, size_t npoll, int poll_task)
 	loop->unused = NULL;
 	loop->nunused = 0;
 
+#if LELY_EV_LOOP_WS
+	loop->wsqs = NULL;
+	atomic_init(&loop->nwsq, 0);
+	atomic_init(&loop->epoch, 0);
+	atomic_init(&loop->nidle, 0);
+#endif
+
 	return loop;
 }
 
@@ -266,6 +384,14 @@ ev_loop_fini(ev_loop_t *loop)
 {
 	assert(loop);
 
+#if LELY_EV_LOOP_WS
+	for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+		assert(!loop->wsqs[i].owned);
+		assert(ev_loop_wsq_empty(&loop->wsqs[i]));
+	}
+	free(loop->wsqs);
+#endif
+
 	while (loop->unused) {
 		struct ev_loop_ctx *ctx = loop->unused;
 		loop->unused = ctx->next;
@@ -337,6 +463,76 @@ ev_loop_get_exec(const ev_loop_t *loop)
 	return &loop->exec.exec_vptr;
 }
 
+size_t
+ev_loop_get_work_stealing(const ev_loop_t *loop)
+{
+	assert(loop);
+
+#if LELY_EV_LOOP_WS
+	return ev_loop_nwsq(loop);
+#else
+	(void)loop;
+
+	return 0;
+#endif
+}
+
+int
+ev_loop_set_work_stealing(ev_loop_t *loop, size_t nthrd)
+{
+	assert(loop);
+
+#if LELY_EV_LOOP_WS
+	struct ev_loop_wsq *wsqs = NULL;
+	if (nthrd) {
+		wsqs = malloc(nthrd * sizeof(*wsqs));
+		if (!wsqs) {
+			set_errc_from_errno();
+			return -1;
+		}
+		for (size_t i = 0; i < nthrd; i++) {
+			struct ev_loop_wsq *wsq = &wsqs[i];
+			wsq->loop = loop;
+			wsq->owned = 0;
+			atomic_init(&wsq->top, 0);
+			atomic_init(&wsq->bottom, 0);
+			wsq->epoch = 0;
+			wsq->tick = 0;
+			for (size_t j = 0; j < LELY_EV_LOOP_WSQ_SIZE; j++)
+				atomic_init(&wsq->slots[j], NULL);
+		}
+	}
+
+	mtx_lock(&loop->mtx);
+	// The queues cannot be replaced while they are in use.
+	for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+		if (loop->wsqs[i].owned) {
+			mtx_unlock(&loop->mtx);
+			free(wsqs);
+			set_errnum(ERRNUM_BUSY);
+			return -1;
+		}
+		assert(ev_loop_wsq_empty(&loop->wsqs[i]));
+	}
+	struct ev_loop_wsq *tmp = loop->wsqs;
+	loop->wsqs = wsqs;
+	atomic_store_explicit(&loop->nwsq, nthrd, memory_order_relaxed);
+	mtx_unlock(&loop->mtx);
+
+	free(tmp);
+
+	return 0;
+#else
+	(void)loop;
+
+	if (!nthrd)
+		return 0;
+
+	set_errnum(ERRNUM_NOSYS);
+	return -1;
+#endif
+}
+
 void
 ev_loop_stop(ev_loop_t *loop)
 {
@@ -385,8 +581,14 @@ ev_loop_wait(ev_loop_t *loop, ev_future_t *future)
 {
 	size_t n = 0;
 	struct ev_loop_ctx *ctx = NULL;
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_enter(loop);
+#endif
 	while (ev_loop_ctx_wait_one(&ctx, loop, future))
 		n += n < SIZE_MAX;
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_leave(loop);
+#endif
 	ev_loop_ctx_destroy(ctx);
 	return n;
 }
@@ -397,8 +599,14 @@ ev_loop_wait_until(ev_loop_t *loop, ev_future_t *future,
 {
 	size_t n = 0;
 	struct ev_loop_ctx *ctx = NULL;
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_enter(loop);
+#endif
 	while (ev_loop_ctx_wait_one_until(&ctx, loop, future, abs_time))
 		n += n < SIZE_MAX;
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_leave(loop);
+#endif
 	ev_loop_ctx_destroy(ctx);
 	return n;
 }
@@ -445,6 +653,9 @@ ev_loop_kill(ev_loop_t *loop, void *thr_)
 	mtx_lock(&loop->mtx);
 #endif
 	if (!thr->stopped) {
+#if LELY_EV_LOOP_WS
+		ev_loop_ws_kill(loop);
+#endif
 		if (thr->ctx) {
 			if ((result = ev_loop_ctx_kill(thr->ctx, 1)) == -1)
 				errc = get_errc();
@@ -475,6 +686,9 @@ ev_loop_ctx_task_func(struct ev_task *task)
 #endif
 	if (ctx->refcnt > 1 && !*ctx->pstopped && !ctx->ready) {
 		ctx->ready = 1;
+#if LELY_EV_LOOP_WS
+		ev_loop_ws_kill(loop);
+#endif
 		ev_loop_ctx_kill(ctx, 0);
 	}
 #if !LELY_NO_THREADS
@@ -663,9 +877,19 @@ ev_loop_ctx_wait_one(
 	assert(loop);
 	assert(!ctx || ctx->loop == loop);
 
+#if LELY_EV_LOOP_WS
+	// Execute a task from the work-stealing queue of this thread, if
+	// available, without locking the event loop.
+	if (ev_loop_ws_run_fast(loop))
+		return 1;
+#endif
+
 	size_t n = 0;
 #if !LELY_NO_THREADS
 	mtx_lock(&loop->mtx);
+#endif
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_sync(loop);
 #endif
 	int poll_task = 0;
 	while (!loop->stopped && (!ctx || (!*ctx->pstopped && !ctx->ready))) {
@@ -678,8 +902,7 @@ ev_loop_ctx_wait_one(
 			ev_loop_do_stop(loop);
 			continue;
 		}
-		struct ev_task *task = ev_task_from_node(
-				sllist_pop_front(&loop->queue));
+		struct ev_task *task = ev_loop_pop(loop);
 		if (task && task == &loop->task) {
 			// The polling task is not a real task, but is part of
 			// the task queue for scheduling purposes.
@@ -723,7 +946,7 @@ ev_loop_ctx_wait_one(
 			// Wake polling threads in LIFO order.
 			dllist_push_front(&loop->polling, &ctx->node);
 			loop->npolling++;
-			int empty = sllist_empty(&loop->queue);
+			int empty = ev_loop_idle_begin(loop);
 #if !LELY_NO_THREADS
 			mtx_unlock(&loop->mtx);
 #endif
@@ -731,15 +954,18 @@ ev_loop_ctx_wait_one(
 #if !LELY_NO_THREADS
 			mtx_lock(&loop->mtx);
 #endif
+			ev_loop_idle_end(loop);
 			loop->npolling--;
 			dllist_remove(&loop->polling, &ctx->node);
 			ctx->polling = 0;
 			if (result == -1)
 				break;
-		} else if (!sllist_empty(&loop->queue)) {
+		} else if (!ev_loop_idle_begin(loop)) {
+			ev_loop_idle_end(loop);
 			continue;
 		} else {
 #if LELY_NO_THREADS
+			ev_loop_idle_end(loop);
 			break;
 #else // !LELY_NO_THREADS
 			ctx->waiting = 1;
@@ -748,6 +974,7 @@ ev_loop_ctx_wait_one(
 			int result = cnd_wait(&ctx->cond, &loop->mtx);
 			dllist_remove(&loop->waiting, &ctx->node);
 			ctx->waiting = 0;
+			ev_loop_idle_end(loop);
 			if (result != thrd_success)
 				break;
 #endif // !LELY_NO_THREADS
@@ -786,9 +1013,19 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 	(void)abs_time;
 #endif
 
+#if LELY_EV_LOOP_WS
+	// Execute a task from the work-stealing queue of this thread, if
+	// available, without locking the event loop.
+	if (ev_loop_ws_run_fast(loop))
+		return 1;
+#endif
+
 	size_t n = 0;
 #if !LELY_NO_THREADS
 	mtx_lock(&loop->mtx);
+#endif
+#if LELY_EV_LOOP_WS
+	ev_loop_ws_sync(loop);
 #endif
 	int poll_task = 0;
 	while (!loop->stopped && (!ctx || (!*ctx->pstopped && !ctx->ready))) {
@@ -801,8 +1038,7 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 			ev_loop_do_stop(loop);
 			continue;
 		}
-		struct ev_task *task = ev_task_from_node(
-				sllist_pop_front(&loop->queue));
+		struct ev_task *task = ev_loop_pop(loop);
 		if (task && task == &loop->task) {
 			// The polling task is not a real task, but is part of
 			// the task queue for scheduling purposes.
@@ -846,8 +1082,10 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 			// Wake polling threads in LIFO order.
 			dllist_push_front(&loop->polling, &ctx->node);
 			loop->npolling++;
-#if !LELY_NO_TIMEOUT
-			int empty = sllist_empty(&loop->queue);
+#if LELY_NO_TIMEOUT
+			ev_loop_idle_begin(loop);
+#else
+			int empty = ev_loop_idle_begin(loop);
 #endif
 #if !LELY_NO_THREADS
 			mtx_unlock(&loop->mtx);
@@ -878,12 +1116,14 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 #if !LELY_NO_THREADS
 			mtx_lock(&loop->mtx);
 #endif
+			ev_loop_idle_end(loop);
 			loop->npolling--;
 			dllist_remove(&loop->polling, &ctx->node);
 			ctx->polling = 0;
 			if (result == -1)
 				break;
-		} else if (!sllist_empty(&loop->queue)) {
+		} else if (!ev_loop_idle_begin(loop)) {
+			ev_loop_idle_end(loop);
 			continue;
 #if !LELY_NO_THREADS && !LELY_NO_TIMEOUT
 		} else if (abs_time) {
@@ -894,6 +1134,7 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 					&ctx->cond, &loop->mtx, abs_time);
 			dllist_remove(&loop->waiting, &ctx->node);
 			ctx->waiting = 0;
+			ev_loop_idle_end(loop);
 			if (result != thrd_success) {
 				if (result == thrd_timedout)
 					set_errnum(ERRNUM_TIMEDOUT);
@@ -901,6 +1142,7 @@ ev_loop_ctx_wait_one_until(struct ev_loop_ctx **pctx, ev_loop_t *loop,
 			}
 #endif // !LELY_NO_THREADS
 		} else {
+			ev_loop_idle_end(loop);
 			break;
 		}
 	}
@@ -998,6 +1240,21 @@ ev_loop_std_exec_impl_post(ev_std_exec_impl_t *impl, struct ev_task *task)
 	ev_loop_t *loop = ev_loop_from_impl(impl);
 	assert(task);
 
+#if LELY_EV_LOOP_WS
+	// If this thread owns a work-stealing queue, add the task to that queue
+	// without locking the event loop. Only wake up a thread if one is idle,
+	// so it can steal the task.
+	struct ev_loop_wsq *wsq = ev_loop_thrd.wsq;
+	if (wsq && wsq->loop == loop && !ev_loop_wsq_push(wsq, task)) {
+		if (atomic_load(&loop->nidle)) {
+			mtx_lock(&loop->mtx);
+			ev_loop_kill_any(loop, 1);
+			mtx_unlock(&loop->mtx);
+		}
+		return;
+	}
+#endif
+
 #if !LELY_NO_THREADS
 	mtx_lock(&loop->mtx);
 #endif
@@ -1032,8 +1289,25 @@ ev_loop_std_exec_impl_abort(ev_std_exec_impl_t *impl, struct ev_task *task)
 		}
 		if (poll_task)
 			sllist_push_back(&loop->queue, &loop->task._node);
+#if LELY_EV_LOOP_WS
+		for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+			struct ev_loop_wsq *wsq = &loop->wsqs[i];
+			while ((task = ev_loop_wsq_take(wsq)))
+				sllist_push_back(&queue, &task->_node);
+		}
+#endif
 	} else if (sllist_remove(&loop->queue, &task->_node)) {
 		sllist_push_back(&queue, &task->_node);
+#if LELY_EV_LOOP_WS
+	} else {
+		// The task may be queued on one of the work-stealing queues.
+		for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+			if (ev_loop_wsq_remove(&loop->wsqs[i], task)) {
+				sllist_push_back(&queue, &task->_node);
+				break;
+			}
+		}
+#endif
 	}
 #if !LELY_NO_THREADS
 	mtx_unlock(&loop->mtx);
@@ -1058,11 +1332,17 @@ ev_loop_empty(const ev_loop_t *loop)
 {
 	assert(loop);
 
-	if (sllist_empty(&loop->queue))
-		return 1;
 	struct slnode *node = sllist_first(&loop->queue);
 	// The task queue is considered empty if only the polling task remains.
-	return node == &loop->task._node && node->next == NULL;
+	if (node && (node != &loop->task._node || node->next))
+		return 0;
+#if LELY_EV_LOOP_WS
+	for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+		if (!ev_loop_wsq_empty(&loop->wsqs[i]))
+			return 0;
+	}
+#endif
+	return 1;
 }
 
 static size_t
@@ -1078,6 +1358,63 @@ ev_loop_ntasks(const ev_loop_t *loop)
 #endif
 }
 
+static struct ev_task *
+ev_loop_pop(ev_loop_t *loop)
+{
+	assert(loop);
+
+	struct ev_task *task =
+			ev_task_from_node(sllist_pop_front(&loop->queue));
+#if LELY_EV_LOOP_WS
+	size_t nwsq = ev_loop_nwsq(loop);
+	if (!task && nwsq) {
+		// Take a task from the work-stealing queue of this thread, or
+		// steal one from the other threads, starting with the next
+		// queue to spread the load.
+		struct ev_loop_wsq *wsq = ev_loop_thrd.wsq;
+		size_t i = wsq && wsq->loop == loop ? wsq - loop->wsqs : 0;
+		for (size_t j = 0; !task && j < nwsq; j++)
+			task = ev_loop_wsq_take(&loop->wsqs[(i + j) % nwsq]);
+	}
+#endif
+	return task;
+}
+
+static int
+ev_loop_idle_begin(ev_loop_t *loop)
+{
+	assert(loop);
+
+#if LELY_EV_LOOP_WS
+	// Announce that this thread is about to become idle _before_ checking
+	// the work-stealing queues. Since both this increment and the push of
+	// a task are sequentially consistent, either the check below sees the
+	// task, or the posting thread sees this thread and wakes it up.
+	atomic_fetch_add(&loop->nidle, 1);
+	if (!sllist_empty(&loop->queue))
+		return 0;
+	for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+		if (!ev_loop_wsq_empty(&loop->wsqs[i]))
+			return 0;
+	}
+	return 1;
+#else
+	return sllist_empty(&loop->queue);
+#endif
+}
+
+static void
+ev_loop_idle_end(ev_loop_t *loop)
+{
+	assert(loop);
+
+#if LELY_EV_LOOP_WS
+	atomic_fetch_sub(&loop->nidle, 1);
+#else
+	(void)loop;
+#endif
+}
+
 static void
 ev_loop_do_stop(ev_loop_t *loop)
 {
@@ -1085,6 +1422,9 @@ ev_loop_do_stop(ev_loop_t *loop)
 
 	if (!loop->stopped) {
 		loop->stopped = 1;
+#if LELY_EV_LOOP_WS
+		ev_loop_ws_kill(loop);
+#endif
 #if !LELY_NO_THREADS
 		dllist_foreach (&loop->waiting, node) {
 			struct ev_loop_ctx *ctx = structof(
@@ -1121,4 +1461,203 @@ ev_loop_kill_any(ev_loop_t *loop, int polling)
 	return 0;
 }
 
+#if LELY_EV_LOOP_WS
+
+static inline size_t
+ev_loop_nwsq(const ev_loop_t *loop)
+{
+	assert(loop);
+
+	return atomic_load_explicit(
+			(atomic_size_t *)&loop->nwsq, memory_order_relaxed);
+}
+
+static void
+ev_loop_ws_enter(ev_loop_t *loop)
+{
+	assert(loop);
+
+	struct ev_loop_thrd *thr = &ev_loop_thrd;
+	if (thr->wsq) {
+		// In case of a nested run function, keep using the same queue.
+		if (thr->wsq->loop == loop)
+			thr->wsdepth++;
+		return;
+	}
+
+	if (!ev_loop_nwsq(loop))
+		return;
+
+	mtx_lock(&loop->mtx);
+	for (size_t i = 0; i < ev_loop_nwsq(loop); i++) {
+		struct ev_loop_wsq *wsq = &loop->wsqs[i];
+		if (!wsq->owned) {
+			wsq->owned = 1;
+			// Force the first task to be taken on the slow path.
+			wsq->epoch = atomic_load(&loop->epoch) - 1;
+			wsq->tick = 0;
+			thr->wsq = wsq;
+			thr->wsdepth = 1;
+			break;
+		}
+	}
+	mtx_unlock(&loop->mtx);
+}
+
+static void
+ev_loop_ws_leave(ev_loop_t *loop)
+{
+	assert(loop);
+
+	struct ev_loop_thrd *thr = &ev_loop_thrd;
+	struct ev_loop_wsq *wsq = thr->wsq;
+	if (!wsq || wsq->loop != loop || --thr->wsdepth)
+		return;
+	thr->wsq = NULL;
+
+	mtx_lock(&loop->mtx);
+	// Move the remaining tasks to the shared queue, so they can be executed
+	// by the other threads (or the next run function).
+	int empty = 1;
+	struct ev_task *task;
+	while ((task = ev_loop_wsq_take(wsq))) {
+		sllist_push_back(&loop->queue, &task->_node);
+		empty = 0;
+	}
+	wsq->owned = 0;
+	if (!empty)
+		ev_loop_kill_any(loop, 1);
+	mtx_unlock(&loop->mtx);
+}
+
+static int
+ev_loop_ws_run_fast(ev_loop_t *loop)
+{
+	assert(loop);
+
+	struct ev_loop_wsq *wsq = ev_loop_thrd.wsq;
+	if (!wsq || wsq->loop != loop)
+		return 0;
+	// Take the slow path if the loop or this thread may have been stopped,
+	// or a future may have become ready.
+	if (wsq->epoch != atomic_load_explicit(
+					    &loop->epoch, memory_order_acquire))
+		return 0;
+	// Regularly take the slow path to prevent starvation of the tasks on
+	// the shared queue, including the polling task.
+	if (++wsq->tick >= LELY_EV_LOOP_WS_FAIR) {
+		wsq->tick = 0;
+		return 0;
+	}
+
+	struct ev_task *task = ev_loop_wsq_take(wsq);
+	if (!task)
+		return 0;
+	assert(task->exec);
+	ev_exec_run(task->exec, task);
+	return 1;
+}
+
+static void
+ev_loop_ws_sync(ev_loop_t *loop)
+{
+	assert(loop);
+
+	struct ev_loop_wsq *wsq = ev_loop_thrd.wsq;
+	if (wsq && wsq->loop == loop) {
+		wsq->epoch = atomic_load_explicit(
+				&loop->epoch, memory_order_relaxed);
+		wsq->tick = 0;
+	}
+}
+
+static void
+ev_loop_ws_kill(ev_loop_t *loop)
+{
+	assert(loop);
+
+	atomic_fetch_add_explicit(&loop->epoch, 1, memory_order_release);
+}
+
+static int
+ev_loop_wsq_push(struct ev_loop_wsq *wsq, struct ev_task *task)
+{
+	assert(wsq);
+	assert(task);
+
+	// Only the owner modifies the bottom of the queue.
+	size_t bottom = atomic_load_explicit(
+			&wsq->bottom, memory_order_relaxed);
+	size_t top = atomic_load_explicit(&wsq->top, memory_order_acquire);
+	ev_loop_wsq_slot_t *slot =
+			&wsq->slots[bottom & (LELY_EV_LOOP_WSQ_SIZE - 1)];
+	// The queue is full if all slots are claimed, or if the last claimed
+	// slot has not been cleared yet by the claiming thread.
+	if (bottom - top >= LELY_EV_LOOP_WSQ_SIZE
+			|| atomic_load_explicit(slot, memory_order_acquire))
+		return -1;
+	atomic_store_explicit(slot, task, memory_order_relaxed);
+	// This store is sequentially consistent, to synchronize with
+	// ev_loop_idle_begin().
+	atomic_store(&wsq->bottom, bottom + 1);
+	return 0;
+}
+
+static struct ev_task *
+ev_loop_wsq_take(struct ev_loop_wsq *wsq)
+{
+	assert(wsq);
+
+	for (;;) {
+		size_t top = atomic_load_explicit(
+				&wsq->top, memory_order_acquire);
+		size_t bottom = atomic_load(&wsq->bottom);
+		if (top == bottom)
+			return NULL;
+		// Claim the first slot.
+		if (!atomic_compare_exchange_weak_explicit(&wsq->top, &top,
+				    top + 1, memory_order_acq_rel,
+				    memory_order_relaxed))
+			continue;
+		// Take the task from the slot, unless it was aborted.
+		struct ev_task *task = atomic_exchange_explicit(
+				&wsq->slots[top & (LELY_EV_LOOP_WSQ_SIZE - 1)],
+				NULL, memory_order_acq_rel);
+		if (task)
+			return task;
+	}
+}
+
+static int
+ev_loop_wsq_remove(struct ev_loop_wsq *wsq, struct ev_task *task)
+{
+	assert(wsq);
+	assert(task);
+
+	size_t top = atomic_load_explicit(&wsq->top, memory_order_acquire);
+	size_t bottom = atomic_load(&wsq->bottom);
+	for (; top != bottom; top++) {
+		struct ev_task *tmp = task;
+		// Clear the slot if it still contains the task. The thread
+		// claiming the slot will skip it.
+		ev_loop_wsq_slot_t *slot =
+				&wsq->slots[top & (LELY_EV_LOOP_WSQ_SIZE - 1)];
+		if (atomic_compare_exchange_strong_explicit(slot, &tmp, NULL,
+				    memory_order_acq_rel, memory_order_relaxed))
+			return 1;
+	}
+	return 0;
+}
+
+static int
+ev_loop_wsq_empty(const struct ev_loop_wsq *wsq)
+{
+	assert(wsq);
+
+	struct ev_loop_wsq *wsq_ = (struct ev_loop_wsq *)wsq;
+	return atomic_load(&wsq_->top) == atomic_load(&wsq_->bottom);
+}
+
+#endif // LELY_EV_LOOP_WS
+
 #endif // !LELY_NO_MALLOC
@@ -39,6 +39,18 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+#ifndef LELY_EV_STRAND_MPSC
+#if !LELY_NO_THREADS && !LELY_NO_ATOMICS && (!_WIN32 || defined(__MINGW32__))
+/**
+ * A flag indicating whether strands use a lock-free multi-producer,
+ * single-consumer task queue. If not, the task queue is protected by a mutex.
+ */
+#define LELY_EV_STRAND_MPSC 1
+#else
+#define LELY_EV_STRAND_MPSC 0
+#endif
+#endif
+
 static void ev_strand_exec_on_task_init(ev_exec_t *exec);
 static void ev_strand_exec_on_task_fini(ev_exec_t *exec);
 static int ev_strand_exec_dispatch(ev_exec_t *exec, struct ev_task *task);
@@ -62,15 +74,62 @@ struct ev_strand {
 	ev_exec_t *inner_exec;
 	struct ev_task task;
 #if !LELY_NO_THREADS
+	/**
+	 * The mutex protecting the task queue. If #LELY_EV_STRAND_MPSC is 1, it
+	 * only protects the consumer side of the queue, i.e., #queue, against
+	 * concurrent calls to ev_strand_func() and ev_strand_exec_abort().
+	 */
 	mtx_t mtx;
 #endif
+#if LELY_EV_STRAND_MPSC
+	/**
+	 * A flag indicating whether ev_strand_func() has been submitted to the
+	 * inner executor.
+	 */
+	atomic_int posted;
+	/**
+	 * A pointer to the node most recently pushed onto the task queue by a
+	 * producer. The pushed nodes form a stack, linked in reverse order.
+	 */
+	_Atomic(struct slnode *) top;
+#else
 	int posted;
+#endif
+	/**
+	 * The queue of pending tasks. If #LELY_EV_STRAND_MPSC is 1, this queue
+	 * is only accessed by the consumer and contains the tasks taken from
+	 * #top, in the order in which they were pushed.
+	 */
 	struct sllist queue;
+#if LELY_EV_STRAND_MPSC
+	/// The address of #ev_strand_thrd of the thread running a task.
+	_Atomic(const int *) thr;
+#else
 	const int *thr;
+#endif
 };
 
 static void ev_strand_func(struct ev_task *task);
 
+#if LELY_EV_STRAND_MPSC
+
+/**
+ * Pushes a task onto the task queue of a strand. This function is lock-free and
+ * can be invoked concurrently from multiple threads.
+ *
+ * @returns 1 if ev_strand_func() needs to be submitted to the inner executor,
+ * and 0 if not.
+ */
+static int ev_strand_push(struct ev_strand *strand, struct ev_task *task);
+
+/**
+ * Moves the tasks pushed by the producers to the end of the consumer queue of a
+ * strand. This function MUST be invoked while holding the mutex of the strand.
+ */
+static void ev_strand_take(struct ev_strand *strand);
+
+#endif // LELY_EV_STRAND_MPSC
+
 static inline struct ev_strand *ev_strand_from_exec(const ev_exec_t *exec);
 
 #if LELY_NO_THREADS
@@ -112,11 +171,21 @@ ev_strand_init(ev_exec_t *exec, ev_exec_t *inner_exec)
 		return NULL;
 #endif
 
+#if LELY_EV_STRAND_MPSC
+	atomic_init(&strand->posted, 0);
+
+	atomic_init(&strand->top, NULL);
+#else
 	strand->posted = 0;
+#endif
 
 	sllist_init(&strand->queue);
 
+#if LELY_EV_STRAND_MPSC
+	atomic_init(&strand->thr, NULL);
+#else
 	strand->thr = NULL;
+#endif
 
 	return exec;
 }
@@ -128,6 +197,20 @@ ev_strand_fini(ev_exec_t *exec)
 
 	ev_strand_exec_abort(exec, NULL);
 
+#if LELY_EV_STRAND_MPSC
+	// Abort ev_strand_func().
+	if (atomic_load(&strand->posted)
+			&& ev_exec_abort(strand->task.exec, &strand->task))
+		atomic_store(&strand->posted, 0);
+	// If necessary, busy-wait until ev_strand_func() completes.
+	while (atomic_load(&strand->posted))
+		thrd_yield();
+	// ev_strand_func() clears the flag while holding the mutex.
+	mtx_lock(&strand->mtx);
+	mtx_unlock(&strand->mtx);
+
+	mtx_destroy(&strand->mtx);
+#else
 #if !LELY_NO_THREADS
 	mtx_lock(&strand->mtx);
 #endif
@@ -145,6 +228,7 @@ ev_strand_fini(ev_exec_t *exec)
 
 	mtx_destroy(&strand->mtx);
 #endif
+#endif // LELY_EV_STRAND_MPSC
 }
 
 ev_exec_t *
@@ -218,6 +302,21 @@ ev_strand_exec_dispatch(ev_exec_t *exec, struct ev_task *task)
 		task->exec = exec;
 	ev_strand_exec_on_task_init(exec);
 
+#if LELY_EV_STRAND_MPSC
+	// Only the current thread can store the address of its own
+	// ev_strand_thrd, so a relaxed load suffices.
+	if (atomic_load_explicit(&strand->thr, memory_order_relaxed)
+			== &ev_strand_thrd) {
+		if (task->func)
+			task->func(task);
+		ev_strand_exec_on_task_fini(exec);
+		return 1;
+	} else {
+		if (ev_strand_push(strand, task))
+			ev_exec_post(strand->task.exec, &strand->task);
+		return 0;
+	}
+#else
 #if !LELY_NO_THREADS
 	mtx_lock(&strand->mtx);
 #endif
@@ -240,6 +339,7 @@ ev_strand_exec_dispatch(ev_exec_t *exec, struct ev_task *task)
 			ev_exec_post(strand->task.exec, &strand->task);
 		return 0;
 	}
+#endif // LELY_EV_STRAND_MPSC
 }
 
 static void
@@ -253,6 +353,9 @@ ev_strand_exec_defer(ev_exec_t *exec, struct ev_task *task)
 		task->exec = exec;
 	ev_strand_exec_on_task_init(exec);
 
+#if LELY_EV_STRAND_MPSC
+	int post = ev_strand_push(strand, task);
+#else
 #if !LELY_NO_THREADS
 	mtx_lock(&strand->mtx);
 #endif
@@ -261,6 +364,7 @@ ev_strand_exec_defer(ev_exec_t *exec, struct ev_task *task)
 	strand->posted = 1;
 #if !LELY_NO_THREADS
 	mtx_unlock(&strand->mtx);
+#endif
 #endif
 	if (post)
 		ev_exec_post(strand->task.exec, &strand->task);
@@ -276,6 +380,9 @@ ev_strand_exec_abort(ev_exec_t *exec, struct ev_task *task)
 
 #if !LELY_NO_THREADS
 	mtx_lock(&strand->mtx);
+#endif
+#if LELY_EV_STRAND_MPSC
+	ev_strand_take(strand);
 #endif
 	if (!task)
 		sllist_append(&queue, &strand->queue);
@@ -300,6 +407,42 @@ ev_strand_func(struct ev_task *task)
 	struct ev_strand *strand = structof(task, struct ev_strand, task);
 	ev_exec_t *exec = &strand->exec_vptr;
 
+#if LELY_EV_STRAND_MPSC
+	mtx_lock(&strand->mtx);
+	if (sllist_empty(&strand->queue))
+		ev_strand_take(strand);
+	task = ev_task_from_node(sllist_pop_front(&strand->queue));
+	int post = !sllist_empty(&strand->queue);
+	mtx_unlock(&strand->mtx);
+
+	if (task) {
+		assert(!atomic_load_explicit(&strand->thr, memory_order_relaxed));
+		atomic_store_explicit(&strand->thr, &ev_strand_thrd,
+				memory_order_relaxed);
+		assert(task->exec == exec);
+		if (task->func)
+			task->func(task);
+		ev_strand_exec_on_task_fini(exec);
+		atomic_store_explicit(&strand->thr, NULL, memory_order_relaxed);
+	}
+
+	assert(atomic_load(&strand->posted) == 1);
+	// A task pushed in the meantime (for example, by the task we just
+	// executed) can be detected without locking the mutex.
+	if (!post)
+		post = atomic_load(&strand->top) != NULL;
+	if (!post) {
+		// Clear the flag _before_ checking the queue again, so a task
+		// pushed by a producer that still saw the flag set is not
+		// missed. The mutex keeps ev_strand_fini() from destroying the
+		// strand while we are still checking.
+		mtx_lock(&strand->mtx);
+		atomic_store(&strand->posted, 0);
+		if (atomic_load(&strand->top))
+			post = !atomic_exchange(&strand->posted, 1);
+		mtx_unlock(&strand->mtx);
+	}
+#else
 #if !LELY_NO_THREADS
 	mtx_lock(&strand->mtx);
 #endif
@@ -325,10 +468,53 @@ ev_strand_func(struct ev_task *task)
 #if !LELY_NO_THREADS
 	mtx_unlock(&strand->mtx);
 #endif
+#endif // LELY_EV_STRAND_MPSC
 	if (post)
 		ev_exec_post(strand->task.exec, &strand->task);
 }
 
+#if LELY_EV_STRAND_MPSC
+
+static int
+ev_strand_push(struct ev_strand *strand, struct ev_task *task)
+{
+	assert(strand);
+	assert(task);
+
+	struct slnode *node = &task->_node;
+	// The node is not visible to other threads until the compare-and-swap
+	// succeeds, so its link does not need to be atomic.
+	node->next = atomic_load_explicit(&strand->top, memory_order_relaxed);
+	// clang-format off
+	while (!atomic_compare_exchange_weak_explicit(&strand->top, &node->next,
+			node, memory_order_release, memory_order_relaxed))
+		// clang-format on
+		;
+	// Only the producer that sets the flag submits ev_strand_func().
+	return !atomic_exchange(&strand->posted, 1);
+}
+
+static void
+ev_strand_take(struct ev_strand *strand)
+{
+	assert(strand);
+
+	struct slnode *node = atomic_exchange_explicit(
+			&strand->top, NULL, memory_order_acquire);
+	// Reverse the stack, so the tasks are appended in the order in which
+	// they were pushed.
+	struct sllist queue;
+	sllist_init(&queue);
+	while (node) {
+		struct slnode *next = node->next;
+		sllist_push_front(&queue, node);
+		node = next;
+	}
+	sllist_append(&strand->queue, &queue);
+}
+
+#endif // LELY_EV_STRAND_MPSC
+
 static inline struct ev_strand *
 ev_strand_from_exec(const ev_exec_t *exec)
 {
@@ -36,6 +36,14 @@ static void io_can_chan_read_post(
 static size_t io_can_chan_read_queue_post(
 		struct sllist *queue, int result, int errc);
 
+#if !LELY_NO_CANFD
+/**
+ * Returns the CAN bus features (any combination of #IO_CAN_BUS_FLAG_FDF and
+ * #IO_CAN_BUS_FLAG_BRS) required to write all CAN frames of a write operation.
+ */
+static int io_can_chan_write_flags(const struct io_can_chan_write *write);
+#endif
+
 static void io_can_chan_write_post(struct io_can_chan_write *write, int errc);
 static size_t io_can_chan_write_queue_post(struct sllist *queue, int errc);
 
@@ -67,6 +75,21 @@ io_can_chan_read_queue_post(struct sllist *queue, int result, int errc)
 	return n;
 }
 
+#if !LELY_NO_CANFD
+static inline int
+io_can_chan_write_flags(const struct io_can_chan_write *write)
+{
+	int flags = 0;
+	for (size_t i = 0; i < write->n; i++) {
+		if (write->msg[i].flags & CAN_FLAG_FDF)
+			flags |= IO_CAN_BUS_FLAG_FDF;
+		if (write->msg[i].flags & CAN_FLAG_BRS)
+			flags |= IO_CAN_BUS_FLAG_BRS;
+	}
+	return flags;
+}
+#endif
+
 static inline void
 io_can_chan_write_post(struct io_can_chan_write *write, int errc)
 {
@@ -38,6 +38,9 @@
 #include <lely/util/util.h>
 
 #include <assert.h>
+#include <limits.h>
+#include <malloc.h>
+#include <string.h>
 
 #ifndef LELY_IO_CAN_NET_TXLEN
 /**
@@ -99,9 +102,10 @@ struct io_can_net {
 	size_t read_errcnt;
 	/// The current state of the CAN bus.
 	int state;
-	/// The CAN frame being written.
-	struct can_msg write_msg;
-	/// The operation used to write CAN frames.
+	/**
+	 * The operation used to write CAN frames. All contiguous frames in the
+	 * transmit queue are written at once, directly from #tx_buf.
+	 */
 	struct io_can_chan_write write;
 	/// The error code of the last write operation.
 	int write_errc;
@@ -170,10 +174,39 @@ struct io_can_net {
 	unsigned read_submitted : 1;
 	/// A flag indicating whether #write has been submitted to #chan.
 	unsigned write_submitted : 1;
+	/// A flag indicating whether the receivers of #net have changed.
+	unsigned filter_changed : 1;
 	/// A pointer to the internal CAN network interface.
 	can_net_t *net;
 	/// The time at which the next CAN timer will trigger.
 	struct timespec next;
+	/**
+	 * The maximum number of CAN frame filters set on #chan, or 0 if frames
+	 * are not filtered by the channel.
+	 */
+	size_t max_filters;
+	/**
+	 * The CAN frame filters currently set on #chan, or NULL if all frames
+	 * are accepted.
+	 */
+	struct can_net_filter *filters;
+	/// The number of filters at #filters.
+	size_t nfilters;
+	/**
+	 * The filters matching each frame sent with #net. These frames need to
+	 * pass the filters of #chan as well, since their write confirmations
+	 * are received like any other frame.
+	 */
+	struct can_net_filter *tx_filters;
+	/// The number of filters at #tx_filters.
+	size_t ntx_filters;
+	/// The number of filters for which #tx_filters has room.
+	size_t tx_filters_size;
+	/**
+	 * The bitmap of the 11-bit CAN identifiers of the data frames in
+	 * #tx_filters, so the common case can be checked without a search.
+	 */
+	unsigned char tx_bid[(CAN_MASK_BID + 1) / CHAR_BIT];
 };
 
 static void io_can_net_wait_next_func(struct ev_task *task);
@@ -183,6 +216,7 @@ static void io_can_net_write_func(struct ev_task *task);
 
 static int io_can_net_next_func(const struct timespec *tp, void *data);
 static int io_can_net_send_func(const struct can_msg *msg, void *data);
+static void io_can_net_filter_func(void *data);
 
 static void io_can_net_c_wait_func(struct spscring *ring, void *arg);
 
@@ -193,6 +227,10 @@ void io_can_net_do_write(io_can_net_t *net);
 
 size_t io_can_net_do_abort_tasks(io_can_net_t *net);
 
+int io_can_net_do_filter(io_can_net_t *net);
+int io_can_net_do_tx_filter(io_can_net_t *net, const struct can_msg *msg);
+void io_can_net_do_accept_all(io_can_net_t *net);
+
 static void default_on_read_error_func(int errc, size_t errcnt, void *arg);
 static void default_on_queue_error_func(int errc, size_t errcnt, void *arg);
 static void default_on_write_error_func(int errc, size_t errcnt, void *arg);
@@ -266,9 +304,8 @@ io_can_net_init(io_can_net_t *net, ev_exec_t *exec, io_timer_t *timer,
 
 	net->state = CAN_STATE_ACTIVE;
 
-	net->write_msg = (struct can_msg)CAN_MSG_INIT;
 	net->write = (struct io_can_chan_write)IO_CAN_CHAN_WRITE_INIT(
-			&net->write_msg, NULL, &io_can_net_write_func);
+			NULL, NULL, &io_can_net_write_func);
 	net->write_errc = 0;
 	net->write_errcnt = 0;
 
@@ -304,6 +341,7 @@ io_can_net_init(io_can_net_t *net, ev_exec_t *exec, io_timer_t *timer,
 	net->wait_confirm_submitted = 0;
 	net->read_submitted = 0;
 	net->write_submitted = 0;
+	net->filter_changed = 0;
 
 	if (!(net->net = can_net_create(NULL))) {
 		errc = get_errc();
@@ -311,6 +349,14 @@ io_can_net_init(io_can_net_t *net, ev_exec_t *exec, io_timer_t *timer,
 	}
 	net->next = (struct timespec){ 0, 0 };
 
+	net->max_filters = 0;
+	net->filters = NULL;
+	net->nfilters = 0;
+	net->tx_filters = NULL;
+	net->ntx_filters = 0;
+	net->tx_filters_size = 0;
+	memset(net->tx_bid, 0, sizeof(net->tx_bid));
+
 	// Initialize the CAN network clock with the current time.
 	if (io_can_net_set_time(net) == -1) {
 		errc = get_errc();
@@ -372,6 +418,8 @@ io_can_net_fini(io_can_net_t *net)
 	mtx_unlock(&net->mtx);
 #endif
 
+	free(net->tx_filters);
+	free(net->filters);
 	can_net_destroy(net->net);
 #if !LELY_NO_THREADS
 	mtx_destroy(&net->mtx);
@@ -645,6 +693,56 @@ io_can_net_set_on_can_error_func(io_can_net_t *net,
 #endif
 }
 
+size_t
+io_can_net_get_max_filters(const io_can_net_t *net)
+{
+	assert(net);
+
+#if !LELY_NO_THREADS
+	mtx_lock((mtx_t *)&net->mtx);
+#endif
+	size_t max = net->max_filters;
+#if !LELY_NO_THREADS
+	mtx_unlock((mtx_t *)&net->mtx);
+#endif
+	return max;
+}
+
+int
+io_can_net_set_max_filters(io_can_net_t *net, size_t max)
+{
+	assert(net);
+
+	int result = 0;
+#if !LELY_NO_THREADS
+	mtx_lock(&net->mtx);
+#endif
+	if (max) {
+		// Register the function to be invoked when a receiver is
+		// started or stopped.
+		can_net_set_filter_func(net->net, &io_can_net_filter_func, net);
+		net->max_filters = max;
+		result = io_can_net_do_filter(net);
+	} else if (net->max_filters) {
+		can_net_set_filter_func(net->net, NULL, NULL);
+		net->max_filters = 0;
+		net->filter_changed = 0;
+		free(net->tx_filters);
+		net->tx_filters = NULL;
+		net->ntx_filters = 0;
+		net->tx_filters_size = 0;
+		memset(net->tx_bid, 0, sizeof(net->tx_bid));
+		free(net->filters);
+		net->filters = NULL;
+		net->nfilters = 0;
+		result = io_can_chan_set_filters(net->chan, NULL, 0);
+	}
+#if !LELY_NO_THREADS
+	mtx_unlock(&net->mtx);
+#endif
+	return result;
+}
+
 int
 io_can_net_lock(io_can_net_t *net)
 {
@@ -662,16 +760,18 @@ io_can_net_lock(io_can_net_t *net)
 int
 io_can_net_unlock(io_can_net_t *net)
 {
-#if LELY_NO_THREADS
-	(void)net;
+	assert(net);
+
+	// Update the CAN frame filters once for all receivers started or
+	// stopped while the mutex was locked.
+	if (net->filter_changed)
+		io_can_net_do_filter(net);
 
+#if LELY_NO_THREADS
 	return 0;
 #else
-	assert(net);
-
 	return mtx_unlock(&net->mtx);
 #endif
-	assert(net);
 }
 
 can_net_t *
@@ -737,6 +837,9 @@ io_can_net_wait_next_func(struct ev_task *task)
 	}
 	net->wait_next_submitted = submit_wait_next;
 
+	if (net->filter_changed)
+		io_can_net_do_filter(net);
+
 #if !LELY_NO_THREADS
 	mtx_unlock(&net->mtx);
 #endif
@@ -826,6 +929,9 @@ io_can_net_read_func(struct ev_task *task)
 
 	int submit_read = net->read_submitted = !net->shutdown;
 
+	if (net->filter_changed)
+		io_can_net_do_filter(net);
+
 #if !LELY_NO_THREADS
 	mtx_unlock(&net->mtx);
 #endif
@@ -862,10 +968,13 @@ io_can_net_write_func(struct ev_task *task)
 		net->write_errcnt = 0;
 	}
 
-	// Remove the frame from the transmit queue, unless the write operation
-	// was canceled, in which we discard the entire queue.
-	assert(spscring_c_capacity(&net->tx_ring) >= 1);
-	size_t n = 1;
+	// Remove the written frames from the transmit queue, including the
+	// frame that could not be written in case of an error, unless the
+	// write operation was canceled, in which we discard the entire queue.
+	assert(spscring_c_capacity(&net->tx_ring) >= write->n);
+	size_t n = write->n;
+	if (write->errc && write->nwritten < n)
+		n = write->nwritten + 1;
 	if (errc2num(write->errc) == ERRNUM_CANCELED) {
 		n = spscring_c_capacity(&net->tx_ring);
 		// Track the number of dropped frames. The first frame has
@@ -928,6 +1037,11 @@ io_can_net_send_func(const struct can_msg *msg, void *data)
 	io_can_net_t *net = data;
 	assert(net);
 
+	// Make sure the write confirmation of the frame is not filtered, before
+	// the frame is written.
+	if (net->max_filters)
+		io_can_net_do_tx_filter(net, msg);
+
 	size_t n = 1;
 	size_t i = spscring_p_alloc(&net->tx_ring, &n);
 	if (n) {
@@ -954,6 +1068,17 @@ io_can_net_send_func(const struct can_msg *msg, void *data)
 	}
 }
 
+static void
+io_can_net_filter_func(void *data)
+{
+	io_can_net_t *net = data;
+	assert(net);
+
+	// Defer updating the filters until the mutex is unlocked, since many
+	// receivers are typically started or stopped at once.
+	net->filter_changed = 1;
+}
+
 static void
 io_can_net_c_wait_func(struct spscring *ring, void *arg)
 {
@@ -979,18 +1104,20 @@ io_can_net_do_wait(io_can_net_t *net)
 {
 	assert(net);
 
-	// Wait for next frame to become available.
+	// Wait for the next frame to become available.
 	// clang-format off
 	if (spscring_c_submit_wait(
 			&net->tx_ring, 1, &io_can_net_c_wait_func, net))
 		// clang-format on
 		return 1;
 
-	// Extract the frame from the transmit queue.
-	size_t n = 1;
-	size_t i = spscring_c_alloc(&net->tx_ring, &n);
-	assert(n == 1);
-	net->write_msg = net->tx_buf[i];
+	// Extract all contiguous frames from the transmit queue. They are
+	// removed from the queue once the write operation completes.
+	size_t n = SIZE_MAX;
+	size_t i = spscring_c_alloc_no_wrap(&net->tx_ring, &n);
+	assert(n >= 1);
+	net->write.msg = &net->tx_buf[i];
+	net->write.n = n;
 
 	return 0;
 }
@@ -1002,7 +1129,7 @@ io_can_net_do_write(io_can_net_t *net)
 	assert(spscring_c_capacity(&net->tx_ring) >= 1);
 	assert(!net->write_submitted);
 
-	// Send the frame.
+	// Send the frames.
 	net->write_submitted = 1;
 	io_can_chan_submit_write(net->chan, &net->write);
 
@@ -1053,6 +1180,129 @@ io_can_net_do_abort_tasks(io_can_net_t *net)
 	return 0;
 }
 
+int
+io_can_net_do_filter(io_can_net_t *net)
+{
+	assert(net);
+	assert(net->max_filters);
+
+	net->filter_changed = 0;
+
+	int errc = 0;
+
+	size_t nrecv = can_net_get_filters(net->net, NULL, 0);
+	size_t n = nrecv + net->ntx_filters;
+	struct can_net_filter *filters = NULL;
+	if (n) {
+		filters = malloc(n * sizeof(*filters));
+		if (!filters) {
+			errc = get_errc();
+			goto error_malloc;
+		}
+		can_net_get_filters(net->net, filters, nrecv);
+		if (net->ntx_filters)
+			memcpy(filters + nrecv, net->tx_filters,
+					net->ntx_filters * sizeof(*filters));
+		n = can_net_compact_filters(filters, n, net->max_filters);
+	}
+
+	// Skip the system call if the filters did not change.
+	int equal = n == net->nfilters;
+	for (size_t i = 0; equal && i < n; i++)
+		equal = filters[i].id == net->filters[i].id
+				&& filters[i].mask == net->filters[i].mask
+				&& filters[i].flags == net->filters[i].flags
+				&& filters[i].flags_mask
+						== net->filters[i].flags_mask;
+	if (equal) {
+		free(filters);
+		return 0;
+	}
+
+	if (io_can_chan_set_filters(net->chan, filters, n) == -1) {
+		errc = get_errc();
+		goto error_set_filters;
+	}
+
+	free(net->filters);
+	net->filters = filters;
+	net->nfilters = n;
+
+	return 0;
+
+error_set_filters:
+	free(filters);
+error_malloc:
+	diag(DIAG_WARNING, errc,
+			"unable to set CAN frame filters; accepting all frames");
+	io_can_net_do_accept_all(net);
+	set_errc(errc);
+	return -1;
+}
+
+int
+io_can_net_do_tx_filter(io_can_net_t *net, const struct can_msg *msg)
+{
+	assert(net);
+	assert(msg);
+
+	// Check if a frame with the same identifier and flags has been sent
+	// before.
+	size_t bid = msg->id & CAN_MASK_BID;
+	if (!msg->flags && msg->id == bid) {
+		if (net->tx_bid[bid / CHAR_BIT] & (1u << (bid % CHAR_BIT)))
+			return 0;
+	} else {
+		for (size_t i = 0; i < net->ntx_filters; i++) {
+			if (net->tx_filters[i].id == msg->id
+					&& net->tx_filters[i].flags
+							== msg->flags)
+				return 0;
+		}
+	}
+
+	if (net->ntx_filters == net->tx_filters_size) {
+		size_t size = net->tx_filters_size
+				? 2 * net->tx_filters_size
+				: 16;
+		struct can_net_filter *tx_filters = realloc(
+				net->tx_filters, size * sizeof(*tx_filters));
+		if (!tx_filters) {
+			int errc = get_errc();
+			diag(DIAG_WARNING, errc,
+					"unable to set CAN frame filters; accepting all frames");
+			io_can_net_do_accept_all(net);
+			set_errc(errc);
+			return -1;
+		}
+		net->tx_filters = tx_filters;
+		net->tx_filters_size = size;
+	}
+	net->tx_filters[net->ntx_filters++] =
+			(struct can_net_filter){ .id = msg->id,
+				.mask = CAN_MASK_EID,
+				.flags = msg->flags,
+				.flags_mask = 0xff };
+	if (!msg->flags && msg->id == bid)
+		net->tx_bid[bid / CHAR_BIT] |= 1u << (bid % CHAR_BIT);
+
+	return io_can_net_do_filter(net);
+}
+
+void
+io_can_net_do_accept_all(io_can_net_t *net)
+{
+	assert(net);
+
+	free(net->filters);
+	net->filters = NULL;
+	net->nfilters = 0;
+
+	// If this fails as well, there is nothing left to try. Since the
+	// filters are only a hint, frames may be lost but not misinterpreted.
+	io_can_chan_set_filters(net->chan, NULL, 0);
+}
+
 static void
 default_on_read_error_func(int errc, size_t errcnt, void *arg)
 {
@@ -26,6 +26,7 @@
 #if !LELY_NO_STDIO && defined(__linux__)
 
 #include "../can.h"
+#include <lely/can/net.h>
 #include <lely/io2/ctx.h>
 #include <lely/io2/linux/can.h>
 #include <lely/io2/posix/poll.h>
@@ -37,6 +38,7 @@
 #include <assert.h>
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 
 #if !LELY_NO_THREADS
 #include <pthread.h>
@@ -57,6 +59,22 @@
 #define LELY_IO_CAN_RXLEN 1024
 #endif
 
+#ifndef LELY_IO_CAN_RXBATCH
+/**
+ * The default (and maximum) number of CAN frames read from a SocketCAN file
+ * descriptor with a single system call.
+ */
+#define LELY_IO_CAN_RXBATCH 32
+#endif
+
+#ifndef LELY_IO_CAN_TXBATCH
+/**
+ * The maximum number of CAN frames written to a SocketCAN file descriptor with
+ * a single system call.
+ */
+#define LELY_IO_CAN_TXBATCH 32
+#endif
+
 struct io_can_frame {
 #if LELY_NO_CANFD
 	struct can_frame frame;
@@ -65,16 +83,29 @@ struct io_can_frame {
 #endif
 	size_t nbytes;
 	struct timespec ts;
+	/// The flags of the received message (`MSG_CONFIRM`).
+	int flags;
+	/**
+	 * The total number of frames dropped by the kernel since the socket was
+	 * opened, as reported by the `SO_RXQ_OVFL` socket option.
+	 */
+	uint_least32_t drops;
+};
+
+/// The buffer for the ancillary data received with a SocketCAN frame.
+union io_can_frame_cmsg {
+	char buf[CMSG_SPACE(sizeof(struct timeval))
+			+ CMSG_SPACE(sizeof(uint32_t))];
+	// Align the buffer for a struct cmsghdr.
+	size_t align;
 };
 
 static int io_can_fd_set_default(int fd);
-#if LELY_NO_CANFD
-static int io_can_fd_read(int fd, struct can_frame *frame, size_t *pnbytes,
-		int *pflags, struct timespec *tp, int timeout);
-#else
-static int io_can_fd_read(int fd, struct canfd_frame *frame, size_t *pnbytes,
-		int *pflags, struct timespec *tp, int timeout);
-#endif
+static int io_can_fd_read(int fd, struct io_can_frame *frame, int timeout);
+static ssize_t io_can_fd_read_batch(
+		int fd, struct io_can_frame *frames, size_t n, int timeout);
+static int io_can_fd_read_cmsg(
+		int fd, struct io_can_frame *frame, struct msghdr *msg);
 #if LELY_NO_CANFD
 static int io_can_fd_write(int fd, const struct can_frame *frame, size_t nbytes,
 		int dontwait);
@@ -83,6 +114,10 @@ static int io_can_fd_write(int fd, const struct canfd_frame *frame,
 		size_t nbytes, int timeout);
 #endif
 static int io_can_fd_write_msg(int fd, const struct can_msg *msg, int timeout);
+static ssize_t io_can_fd_write_msgs(
+		int fd, const struct can_msg *msgs, size_t n, int timeout);
+static int io_can_frame_from_msg(
+		struct io_can_frame *frame, const struct can_msg *msg);
 
 static io_ctx_t *io_can_chan_impl_dev_get_ctx(const io_dev_t *dev);
 static ev_exec_t *io_can_chan_impl_dev_get_exec(const io_dev_t *dev);
@@ -108,6 +143,8 @@ static int io_can_chan_impl_write(
 		io_can_chan_t *chan, const struct can_msg *msg, int timeout);
 static void io_can_chan_impl_submit_write(
 		io_can_chan_t *chan, struct io_can_chan_write *write);
+static int io_can_chan_impl_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n);
 
 // clang-format off
 static const struct io_can_chan_vtbl io_can_chan_impl_vtbl = {
@@ -116,7 +153,8 @@ static const struct io_can_chan_vtbl io_can_chan_impl_vtbl = {
 	&io_can_chan_impl_read,
 	&io_can_chan_impl_submit_read,
 	&io_can_chan_impl_write,
-	&io_can_chan_impl_submit_write
+	&io_can_chan_impl_submit_write,
+	&io_can_chan_impl_set_filters
 };
 // clang-format on
 
@@ -163,6 +201,8 @@ struct io_can_chan_impl {
 	struct spscring rxring;
 	/// The receive queue.
 	struct io_can_frame *rxbuf;
+	/// The number of dropped frames last reported by the receive queue.
+	uint_least32_t drops;
 #if !LELY_NO_THREADS
 	/**
 	 * The mutex protecting the file descriptor, the flags and the queues of
@@ -176,6 +216,16 @@ struct io_can_chan_impl {
 	int flags;
 	/// The I/O events currently being monitored by #poll for #fd.
 	int events;
+	/// The maximum number of frames read from #fd with one system call.
+	size_t rxbatch;
+	/**
+	 * The `CAN_RAW_FILTER` filters of #fd, or NULL if all frames are
+	 * accepted. The filters are applied again when a new file descriptor is
+	 * opened or assigned.
+	 */
+	struct can_filter *filters;
+	/// The number of filters at #filters.
+	size_t nfilters;
 	/// A flag indicating whether the I/O service has been shut down.
 	unsigned shutdown : 1;
 	/// A flag indicating whether #rxbuf_task has been posted to #exec.
@@ -192,6 +242,11 @@ struct io_can_chan_impl {
 	struct sllist confirm_queue;
 	/// The write operation currently being executed.
 	struct ev_task *current_write;
+	/**
+	 * The number of CAN frames of the first operation in #write_queue that
+	 * have already been sent.
+	 */
+	size_t nsent;
 };
 
 static void io_can_chan_impl_watch_func(
@@ -208,6 +263,8 @@ static inline struct io_can_chan_impl *io_can_chan_impl_from_svc(
 		const struct io_svc *svc);
 
 static void io_can_chan_impl_c_signal(struct spscring *ring, void *arg);
+static void io_can_chan_impl_c_drops(struct io_can_chan_impl *impl,
+		const struct io_can_frame *frame);
 
 static void io_can_chan_impl_do_pop(struct io_can_chan_impl *impl,
 		struct sllist *read_queue, struct sllist *write_queue,
@@ -218,11 +275,34 @@ static void io_can_chan_impl_do_read(struct io_can_chan_impl *impl,
 static void io_can_chan_impl_do_confirm(struct io_can_chan_impl *impl,
 		struct sllist *queue, const struct can_msg *msg);
 
+/**
+ * Returns the index of the first unconfirmed frame of a write operation, among
+ * the first <b>n</b> frames, that is equal to <b>msg</b>, or <b>n</b> if no
+ * such frame exists.
+ */
+static size_t io_can_chan_write_find(const struct io_can_chan_write *write,
+		size_t n, const struct can_msg *msg);
+
 static size_t io_can_chan_impl_do_abort_tasks(struct io_can_chan_impl *impl);
 
 static int io_can_chan_impl_set_fd(
 		struct io_can_chan_impl *impl, int fd, int flags);
 
+/**
+ * Converts a CAN network interface frame filter to a SocketCAN filter. The
+ * flags other than #CAN_FLAG_IDE and #CAN_FLAG_RTR are ignored, so the
+ * resulting filter MAY accept more frames.
+ */
+static void can_net_filter2can_filter(
+		const struct can_net_filter *src, struct can_filter *dst);
+
+/**
+ * Sets the `CAN_RAW_FILTER` filters of a SocketCAN file descriptor. If <b>n</b>
+ * is 0, all frames are accepted.
+ */
+static int io_can_fd_set_filters(
+		int fd, const struct can_filter *filters, size_t n);
+
 void *
 io_can_chan_alloc(void)
 {
@@ -281,6 +361,7 @@ io_can_chan_init(io_can_chan_t *chan, io_poll_t *poll, ev_exec_t *exec,
 		errsv = errno;
 		goto error_alloc_rxbuf;
 	}
+	impl->drops = 0;
 
 #if !LELY_NO_THREADS
 	if ((errsv = pthread_mutex_init(&impl->mtx, NULL)))
@@ -290,6 +371,9 @@ io_can_chan_init(io_can_chan_t *chan, io_poll_t *poll, ev_exec_t *exec,
 	impl->fd = -1;
 	impl->flags = 0;
 	impl->events = 0;
+	impl->rxbatch = LELY_IO_CAN_RXBATCH;
+	impl->filters = NULL;
+	impl->nfilters = 0;
 
 	impl->shutdown = 0;
 	impl->rxbuf_posted = 0;
@@ -300,6 +384,7 @@ io_can_chan_init(io_can_chan_t *chan, io_poll_t *poll, ev_exec_t *exec,
 	sllist_init(&impl->write_queue);
 	sllist_init(&impl->confirm_queue);
 	impl->current_write = NULL;
+	impl->nsent = 0;
 
 	if (impl->ctx)
 		io_ctx_insert(impl->ctx, &impl->svc);
@@ -367,6 +452,7 @@ io_can_chan_fini(io_can_chan_t *chan)
 	pthread_mutex_destroy(&impl->mtx);
 #endif
 
+	free(impl->filters);
 	free(impl->rxbuf);
 
 #if !LELY_NO_THREADS
@@ -574,6 +660,44 @@ io_can_chan_close(io_can_chan_t *chan)
 	return fd != -1 ? close(fd) : 0;
 }
 
+size_t
+io_can_chan_get_rxbatch(const io_can_chan_t *chan)
+{
+	const struct io_can_chan_impl *impl = io_can_chan_impl_from_chan(chan);
+
+#if !LELY_NO_THREADS
+	pthread_mutex_lock((pthread_mutex_t *)&impl->mtx);
+#endif
+	size_t rxbatch = impl->rxbatch;
+#if !LELY_NO_THREADS
+	pthread_mutex_unlock((pthread_mutex_t *)&impl->mtx);
+#endif
+	return rxbatch;
+}
+
+int
+io_can_chan_set_rxbatch(io_can_chan_t *chan, size_t rxbatch)
+{
+	struct io_can_chan_impl *impl = io_can_chan_impl_from_chan(chan);
+
+	if (!rxbatch)
+		rxbatch = LELY_IO_CAN_RXBATCH;
+	if (rxbatch > LELY_IO_CAN_RXBATCH) {
+		errno = EINVAL;
+		return -1;
+	}
+
+#if !LELY_NO_THREADS
+	pthread_mutex_lock(&impl->mtx);
+#endif
+	impl->rxbatch = rxbatch;
+#if !LELY_NO_THREADS
+	pthread_mutex_unlock(&impl->mtx);
+#endif
+
+	return 0;
+}
+
 static int
 io_can_fd_set_default(int fd)
 {
@@ -606,24 +730,40 @@ io_can_fd_set_default(int fd)
 		// clang-format on
 		return -1;
 
+	// Receive the timestamp of each frame as ancillary data, so we do not
+	// need an additional system call per frame to obtain it.
+	optval = 1;
+	// clang-format off
+	if (setsockopt(fd, SOL_SOCKET, SO_TIMESTAMP, &optval, sizeof(optval))
+			== -1)
+		// clang-format on
+		return -1;
+
+	// Receive the number of frames dropped by the kernel as ancillary data.
+	optval = 1;
+	// clang-format off
+	if (setsockopt(fd, SOL_SOCKET, SO_RXQ_OVFL, &optval, sizeof(optval))
+			== -1)
+		// clang-format on
+		return -1;
+
 	return 0;
 }
 
 static int
-#if LELY_NO_CANFD
-io_can_fd_read(int fd, struct can_frame *frame, size_t *pnbytes, int *pflags,
-		struct timespec *tp, int timeout)
-#else
-io_can_fd_read(int fd, struct canfd_frame *frame, size_t *pnbytes, int *pflags,
-		struct timespec *tp, int timeout)
-#endif
+io_can_fd_read(int fd, struct io_can_frame *frame, int timeout)
 {
-	struct iovec iov = { .iov_base = (void *)frame,
-		.iov_len = sizeof(*frame) };
+	assert(frame);
+
+	struct iovec iov = { .iov_base = (void *)&frame->frame,
+		.iov_len = sizeof(frame->frame) };
+	union io_can_frame_cmsg control;
 	struct msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1 };
 
 	ssize_t result;
 	for (;;) {
+		msg.msg_control = control.buf;
+		msg.msg_controllen = sizeof(control.buf);
 		result = io_fd_recvmsg(fd, &msg, 0, timeout);
 		if (result < 0)
 			return result;
@@ -637,25 +777,126 @@ io_can_fd_read(int fd, struct canfd_frame *frame, size_t *pnbytes, int *pflags,
 			timeout = 0;
 	}
 
-	if (pnbytes)
-		*pnbytes = result;
+	frame->nbytes = result;
+
+	return io_can_fd_read_cmsg(fd, frame, &msg);
+}
 
-	if (pflags)
-		*pflags = msg.msg_flags;
+static ssize_t
+io_can_fd_read_batch(
+		int fd, struct io_can_frame *frames, size_t n, int timeout)
+{
+	assert(frames);
+	assert(n);
+
+	if (n > LELY_IO_CAN_RXBATCH)
+		n = LELY_IO_CAN_RXBATCH;
+	if (n == 1)
+		return io_can_fd_read(fd, frames, timeout) < 0 ? -1 : 1;
+
+#ifdef _GNU_SOURCE
+	struct mmsghdr msgvec[LELY_IO_CAN_RXBATCH];
+	struct iovec iov[LELY_IO_CAN_RXBATCH];
+	union io_can_frame_cmsg control[LELY_IO_CAN_RXBATCH];
+	for (size_t i = 0; i < n; i++) {
+		iov[i].iov_base = (void *)&frames[i].frame;
+		iov[i].iov_len = sizeof(frames[i].frame);
+		msgvec[i] = (struct mmsghdr){ .msg_len = 0 };
+		struct msghdr *msg = &msgvec[i].msg_hdr;
+		msg->msg_iov = &iov[i];
+		msg->msg_iovlen = 1;
+		msg->msg_control = control[i].buf;
+		msg->msg_controllen = sizeof(control[i].buf);
+	}
+
+	int result = io_fd_recvmmsg(fd, msgvec, n, 0, timeout);
+	if (result < 0)
+		return -1;
 
-	if (tp) {
-		if (msg.msg_flags & MSG_CONFIRM) {
-			// Ignore the timestamp for write confirmations.
-			*tp = (struct timespec){ 0, 0 };
-		} else {
-			struct timeval tv = { 0, 0 };
-			if (ioctl(fd, SIOCGSTAMP, &tv) == -1)
+	// Process the received frames and drop the invalid ones.
+	size_t nframes = 0;
+	for (int i = 0; i < result; i++) {
+		size_t nbytes = msgvec[i].msg_len;
+#if LELY_NO_CANFD
+		if (nbytes != CAN_MTU)
+#else
+		if (nbytes != CAN_MTU && nbytes != CANFD_MTU)
+#endif
+			continue;
+		struct io_can_frame *frame = &frames[nframes];
+		if (frame != &frames[i])
+			frame->frame = frames[i].frame;
+		frame->nbytes = nbytes;
+		if (io_can_fd_read_cmsg(fd, frame, &msgvec[i].msg_hdr) == -1)
+			return -1;
+		nframes++;
+	}
+	return nframes;
+#else
+	// Emulate recvmmsg() by receiving frames one at a time, without
+	// waiting once the first frame has been received.
+	size_t nframes = 0;
+	int errsv = errno;
+	while (nframes < n) {
+		// clang-format off
+		if (io_can_fd_read(fd, &frames[nframes],
+				nframes ? 0 : timeout) < 0) {
+			// clang-format on
+			// clang-format off
+			if (!nframes || (errno != EAGAIN
+					&& errno != EWOULDBLOCK))
+				// clang-format on
 				return -1;
-			tp->tv_sec = tv.tv_sec;
-			tp->tv_nsec = tv.tv_usec * 1000;
+			errno = errsv;
+			break;
+		}
+		nframes++;
+	}
+	return nframes;
+#endif
+}
+
+static int
+io_can_fd_read_cmsg(int fd, struct io_can_frame *frame, struct msghdr *msg)
+{
+	assert(frame);
+	assert(msg);
+
+	frame->flags = msg->msg_flags;
+	frame->drops = 0;
+
+	int has_ts = 0;
+	for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg;
+			cmsg = CMSG_NXTHDR(msg, cmsg)) {
+		if (cmsg->cmsg_level != SOL_SOCKET)
+			continue;
+		if (cmsg->cmsg_type == SCM_TIMESTAMP) {
+			struct timeval tv;
+			memcpy(&tv, CMSG_DATA(cmsg), sizeof(tv));
+			frame->ts.tv_sec = tv.tv_sec;
+			frame->ts.tv_nsec = tv.tv_usec * 1000;
+			has_ts = 1;
+		} else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+			uint32_t drops;
+			memcpy(&drops, CMSG_DATA(cmsg), sizeof(drops));
+			frame->drops = drops;
 		}
 	}
 
+	if (frame->flags & MSG_CONFIRM) {
+		// Ignore the timestamp for write confirmations.
+		frame->ts = (struct timespec){ 0, 0 };
+	} else if (!has_ts) {
+		// Fall back to the timestamp of the last received frame if the
+		// file descriptor was not configured by
+		// io_can_fd_set_default().
+		struct timeval tv = { 0, 0 };
+		if (ioctl(fd, SIOCGSTAMP, &tv) == -1)
+			return -1;
+		frame->ts.tv_sec = tv.tv_sec;
+		frame->ts.tv_nsec = tv.tv_usec * 1000;
+	}
+
 	return 0;
 }
 
@@ -681,26 +922,95 @@ io_can_fd_write_msg(int fd, const struct can_msg *msg, int timeout)
 
 	// Convert the frame to the SocketCAN format.
 	struct io_can_frame frame;
+	if (io_can_frame_from_msg(&frame, msg) == -1)
+		return -1;
+
+	return io_can_fd_write(fd, &frame.frame, frame.nbytes, timeout);
+}
+
+static ssize_t
+io_can_fd_write_msgs(
+		int fd, const struct can_msg *msgs, size_t n, int timeout)
+{
+	assert(msgs);
+	assert(n);
+
+	if (n > LELY_IO_CAN_TXBATCH)
+		n = LELY_IO_CAN_TXBATCH;
+	if (n == 1)
+		return io_can_fd_write_msg(fd, msgs, timeout) < 0 ? -1 : 1;
+
+#ifdef _GNU_SOURCE
+	struct io_can_frame frames[LELY_IO_CAN_TXBATCH];
+	struct mmsghdr msgvec[LELY_IO_CAN_TXBATCH];
+	struct iovec iov[LELY_IO_CAN_TXBATCH];
+	// Convert the frames to the SocketCAN format. Only the frames preceding
+	// an invalid frame are sent; the error is reported by the next call.
+	size_t nframes = 0;
+	int errsv = errno;
+	for (; nframes < n; nframes++) {
+		if (io_can_frame_from_msg(&frames[nframes], &msgs[nframes])
+				== -1) {
+			if (!nframes)
+				return -1;
+			errno = errsv;
+			break;
+		}
+		iov[nframes].iov_base = (void *)&frames[nframes].frame;
+		iov[nframes].iov_len = frames[nframes].nbytes;
+		msgvec[nframes] = (struct mmsghdr){ .msg_len = 0 };
+		msgvec[nframes].msg_hdr.msg_iov = &iov[nframes];
+		msgvec[nframes].msg_hdr.msg_iovlen = 1;
+	}
+
+	return io_fd_sendmmsg(fd, msgvec, nframes, 0, timeout);
+#else
+	// Emulate sendmmsg() by sending frames one at a time, without waiting
+	// once the first frame has been sent.
+	size_t nframes = 0;
+	int errsv = errno;
+	while (nframes < n) {
+		// clang-format off
+		if (io_can_fd_write_msg(fd, &msgs[nframes],
+				nframes ? 0 : timeout) == -1) {
+			// clang-format on
+			if (!nframes)
+				return -1;
+			errno = errsv;
+			break;
+		}
+		nframes++;
+	}
+	return nframes;
+#endif
+}
+
+static int
+io_can_frame_from_msg(struct io_can_frame *frame, const struct can_msg *msg)
+{
+	assert(frame);
+	assert(msg);
+
 #if !LELY_NO_CANFD
 	if (msg->flags & CAN_FLAG_FDF) {
-		if (can_msg2canfd_frame(msg, &frame.frame) == -1) {
+		if (can_msg2canfd_frame(msg, &frame->frame) == -1) {
 			errno = EINVAL;
 			return -1;
 		}
-		frame.nbytes = CANFD_MTU;
+		frame->nbytes = CANFD_MTU;
 	} else {
 #endif
-		if (can_msg2can_frame(msg, (struct can_frame *)&frame.frame)
+		if (can_msg2can_frame(msg, (struct can_frame *)&frame->frame)
 				== -1) {
 			errno = EINVAL;
 			return -1;
 		}
-		frame.nbytes = CAN_MTU;
+		frame->nbytes = CAN_MTU;
 #if !LELY_NO_CANFD
 	}
 #endif
 
-	return io_can_fd_write(fd, &frame.frame, frame.nbytes, timeout);
+	return 0;
 }
 
 static io_ctx_t *
@@ -815,6 +1125,7 @@ io_can_chan_impl_read(io_can_chan_t *chan, struct can_msg *msg,
 		size_t i = spscring_c_alloc(&impl->rxring, &n);
 		if (n) {
 			frame = &impl->rxbuf[i];
+			io_can_chan_impl_c_drops(impl, frame);
 			break;
 		}
 #if !LELY_NO_THREADS
@@ -826,15 +1137,19 @@ io_can_chan_impl_read(io_can_chan_t *chan, struct can_msg *msg,
 #if !LELY_NO_THREADS
 		pthread_mutex_unlock(&impl->mtx);
 #endif
-		int flags = 0;
-		// clang-format off
-		if (io_can_fd_read(fd, &frame->frame, &frame->nbytes, &flags,
-				&frame->ts, timeout) < 0)
-			// clang-format on
+		if (io_can_fd_read(fd, frame, timeout) < 0)
 			return -1;
 		// Process the frame unless it is a write confirmation.
-		if (!(flags & MSG_CONFIRM))
+		if (!(frame->flags & MSG_CONFIRM)) {
+#if !LELY_NO_THREADS
+			pthread_mutex_lock(&impl->c_mtx);
+#endif
+			io_can_chan_impl_c_drops(impl, frame);
+#if !LELY_NO_THREADS
+			pthread_mutex_unlock(&impl->c_mtx);
+#endif
 			break;
+		}
 		// Convert the frame from the SocketCAN format.
 		void *src = &frame->frame;
 		struct can_msg msg;
@@ -963,14 +1278,14 @@ io_can_chan_impl_submit_write(
 	struct io_can_chan_impl *impl = io_can_chan_impl_from_chan(chan);
 	assert(write);
 	assert(write->msg);
+	assert(write->n);
 	struct ev_task *task = &write->task;
 
+	write->errc = 0;
+	write->nwritten = 0;
+
 #if !LELY_NO_CANFD
-	int flags = 0;
-	if (write->msg->flags & CAN_FLAG_FDF)
-		flags |= IO_CAN_BUS_FLAG_FDF;
-	if (write->msg->flags & CAN_FLAG_BRS)
-		flags |= IO_CAN_BUS_FLAG_BRS;
+	int flags = io_can_chan_write_flags(write);
 #endif
 
 	if (!task->exec)
@@ -1008,6 +1323,52 @@ io_can_chan_impl_submit_write(
 	}
 }
 
+static int
+io_can_chan_impl_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n)
+{
+	struct io_can_chan_impl *impl = io_can_chan_impl_from_chan(chan);
+	assert(filters || !n);
+
+#ifdef CAN_RAW_FILTER_MAX
+	if (n > CAN_RAW_FILTER_MAX) {
+		errno = EINVAL;
+		return -1;
+	}
+#endif
+
+	struct can_filter *buf = NULL;
+	if (n) {
+		buf = calloc(n, sizeof(*buf));
+		if (!buf)
+			return -1;
+		for (size_t i = 0; i < n; i++)
+			can_net_filter2can_filter(&filters[i], &buf[i]);
+	}
+
+	int result = 0;
+#if !LELY_NO_THREADS
+	pthread_mutex_lock(&impl->mtx);
+#endif
+	if (impl->fd != -1)
+		result = io_can_fd_set_filters(impl->fd, buf, n);
+	if (!result) {
+		struct can_filter *tmp = impl->filters;
+		impl->filters = buf;
+		impl->nfilters = n;
+		buf = tmp;
+	}
+#if !LELY_NO_THREADS
+	pthread_mutex_unlock(&impl->mtx);
+#endif
+
+	int errsv = errno;
+	free(buf);
+	errno = errsv;
+
+	return result;
+}
+
 static void
 io_can_chan_impl_svc_shutdown(struct io_svc *svc)
 {
@@ -1118,49 +1479,56 @@ io_can_chan_impl_rxbuf_task_func(struct ev_task *task)
 			|| !sllist_empty(&impl->confirm_queue)) {
 		// clang-format on
 		int fd = impl->fd;
+		size_t rxbatch = impl->rxbatch;
 #if !LELY_NO_THREADS
 		pthread_mutex_unlock(&impl->mtx);
 #endif
 
 		struct io_can_frame frame_;
-		struct io_can_frame *frame = &frame_;
-		// Try to obtain an empty slot in the receive queue.
-		size_t n = 1;
+		struct io_can_frame *frames = &frame_;
+		// Try to obtain one or more empty slots in the receive queue.
+		size_t n = rxbatch;
 		size_t i = spscring_p_alloc(&impl->rxring, &n);
 		if (n)
-			frame = &impl->rxbuf[i];
+			frames = &impl->rxbuf[i];
 
-		// Try to read a CAN or CAN FD format frame from the CAN bus.
-		int flags = 0;
-		result = io_can_fd_read(fd, &frame->frame, &frame->nbytes,
-				&flags, &frame->ts,
+		// Try to read one or more CAN or CAN FD format frames from the
+		// CAN bus with a single system call.
+		ssize_t nframes = io_can_fd_read_batch(fd, frames, n ? n : 1,
 				impl->poll ? 0 : LELY_IO_RX_TIMEOUT);
+		result = nframes < 0 ? -1 : 0;
 		errc = !result ? 0 : errno;
 		wouldblock = errc == EAGAIN || errc == EWOULDBLOCK;
 
-		// Convert the frame from the SocketCAN format if it is a write
-		// confirmation.
-		struct can_msg msg;
-		if (!result && (flags & MSG_CONFIRM)) {
-			void *src = &frame->frame;
-#if !LELY_NO_CANFD
-			if (frame->nbytes == CANFD_MTU)
-				canfd_frame2can_msg(src, &msg);
-			else
-#endif
-				can_frame2can_msg(src, &msg);
-		}
-
-		// Make the frame available for reading.
-		if (!result && !(flags & MSG_CONFIRM))
-			spscring_p_commit(&impl->rxring, n);
-
 #if !LELY_NO_THREADS
 		pthread_mutex_lock(&impl->mtx);
 #endif
-		// Process the write confirmation, if any.
-		if (!result && flags & MSG_CONFIRM)
-			io_can_chan_impl_do_confirm(impl, &queue, &msg);
+		// Process the write confirmations, if any, and remove them from
+		// the received frames.
+		size_t j = 0;
+		for (ssize_t k = 0; k < nframes; k++) {
+			struct io_can_frame *frame = &frames[k];
+			if (frame->flags & MSG_CONFIRM) {
+				// Convert the frame from the SocketCAN format.
+				struct can_msg msg;
+				void *src = &frame->frame;
+#if !LELY_NO_CANFD
+				if (frame->nbytes == CANFD_MTU)
+					canfd_frame2can_msg(src, &msg);
+				else
+#endif
+					can_frame2can_msg(src, &msg);
+				io_can_chan_impl_do_confirm(impl, &queue, &msg);
+			} else {
+				if (&frames[j] != frame)
+					frames[j] = *frame;
+				j++;
+			}
+		}
+
+		// Make the remaining frames available for reading.
+		if (n && j)
+			spscring_p_commit(&impl->rxring, j);
 
 		// Stop if the operation did or would block, or if an error
 		// occurred.
@@ -1276,7 +1644,11 @@ io_can_chan_impl_write_task_func(struct ev_task *task)
 
 	int errsv = errno;
 
+	struct sllist queue;
+	sllist_init(&queue);
+
 	int wouldblock = 0;
+	int retry = 0;
 
 #if !LELY_NO_THREADS
 	pthread_mutex_lock(&impl->mtx);
@@ -1286,30 +1658,48 @@ io_can_chan_impl_write_task_func(struct ev_task *task)
 	while ((task = impl->current_write = ev_task_from_node(
 				sllist_pop_front(&impl->write_queue)))) {
 		int fd = impl->fd;
+		// Resume a write operation that was only partially sent.
+		size_t nsent = impl->nsent;
+		impl->nsent = 0;
 #if !LELY_NO_THREADS
 		pthread_mutex_unlock(&impl->mtx);
 #endif
 		struct io_can_chan_write *write =
 				io_can_chan_write_from_task(task);
-		int result = io_can_fd_write_msg(fd, write->msg,
+		assert(nsent < write->n);
+		ssize_t result = io_can_fd_write_msgs(fd, write->msg + nsent,
+				write->n - nsent,
 				impl->poll ? 0 : LELY_IO_TX_TIMEOUT);
-		int errc = !result ? 0 : errno;
+		int errc = result >= 0 ? 0 : errno;
 		wouldblock = errc == EAGAIN || errc == EWOULDBLOCK;
-		if (!wouldblock && errc)
-			// The operation failed immediately.
-			io_can_chan_write_post(write, errc);
 #if !LELY_NO_THREADS
 		pthread_mutex_lock(&impl->mtx);
 #endif
-		if (!errc)
-			// Wait for the write confirmation.
-			sllist_push_back(&impl->confirm_queue, &task->_node);
+		if (result > 0)
+			nsent += result;
+		// Retry if the operation would block or if not all frames could
+		// be sent at once.
+		retry = wouldblock || (!errc && nsent < write->n);
+		if (errc && !wouldblock) {
+			// The operation failed immediately.
+			write->errc = errc;
+			sllist_push_back(&queue, &task->_node);
+		} else if (!retry) {
+			if (write->nwritten == write->n)
+				// All frames have already been confirmed.
+				sllist_push_back(&queue, &task->_node);
+			else
+				// Wait for the write confirmations.
+				sllist_push_back(&impl->confirm_queue,
+						&task->_node);
+		}
 		if (task == impl->current_write) {
-			// Put the write operation back on the queue if it would
-			// block, unless it was canceled.
-			if (wouldblock) {
+			// Put the write operation back on the queue if it has
+			// to be retried, unless it was canceled.
+			if (retry) {
 				sllist_push_front(&impl->write_queue,
 						&task->_node);
+				impl->nsent = nsent;
 				task = NULL;
 			}
 			impl->current_write = NULL;
@@ -1349,12 +1739,15 @@ io_can_chan_impl_write_task_func(struct ev_task *task)
 	pthread_mutex_unlock(&impl->mtx);
 #endif
 
-	if (task && wouldblock)
-		// The operation would block but was canceled before it could be
-		// requeued.
+	if (task && retry)
+		// The operation has to be retried but was canceled before it
+		// could be requeued.
 		io_can_chan_write_post(
 				io_can_chan_write_from_task(task), ECANCELED);
 
+	// Post the completed or failed write operations.
+	ev_task_queue_post(&queue);
+
 	if (post_rxbuf)
 		ev_exec_post(impl->rxbuf_task.exec, &impl->rxbuf_task);
 
@@ -1410,6 +1803,23 @@ io_can_chan_impl_c_signal(struct spscring *ring, void *arg)
 		ev_exec_post(impl->read_task.exec, &impl->read_task);
 }
 
+static void
+io_can_chan_impl_c_drops(struct io_can_chan_impl *impl,
+		const struct io_can_frame *frame)
+{
+	assert(impl);
+	assert(frame);
+
+	// The kernel only reports the number of dropped frames once it is
+	// non-zero.
+	if (!frame->drops || frame->drops == impl->drops)
+		return;
+	uint_least32_t drops = (frame->drops - impl->drops) & 0xffffffffu;
+	impl->drops = frame->drops;
+	diag(DIAG_WARNING, 0, "%lu CAN frame(s) dropped by the kernel",
+			(unsigned long)drops);
+}
+
 static void
 io_can_chan_impl_do_pop(struct io_can_chan_impl *impl,
 		struct sllist *read_queue, struct sllist *write_queue,
@@ -1424,8 +1834,13 @@ io_can_chan_impl_do_pop(struct io_can_chan_impl *impl,
 		sllist_append(read_queue, &impl->read_queue);
 		sllist_append(write_queue, &impl->write_queue);
 		sllist_append(confirm_queue, &impl->confirm_queue);
+		impl->nsent = 0;
 	} else if (sllist_remove(&impl->read_queue, &task->_node)) {
 		sllist_push_back(read_queue, &task->_node);
+	} else if (sllist_first(&impl->write_queue) == &task->_node) {
+		sllist_pop_front(&impl->write_queue);
+		sllist_push_back(write_queue, &task->_node);
+		impl->nsent = 0;
 	} else if (sllist_remove(&impl->write_queue, &task->_node)) {
 		sllist_push_back(write_queue, &task->_node);
 	} else if (sllist_remove(&impl->confirm_queue, &task->_node)) {
@@ -1467,6 +1882,7 @@ io_can_chan_impl_do_read(struct io_can_chan_impl *impl, struct sllist *queue,
 
 		// Copy the frame from the buffer.
 		struct io_can_frame *frame = &impl->rxbuf[i];
+		io_can_chan_impl_c_drops(impl, frame);
 		void *data = &frame->frame;
 		int is_err = can_frame2can_err(data, read->err);
 		if (!is_err && read->msg) {
@@ -1506,35 +1922,73 @@ io_can_chan_impl_do_confirm(struct io_can_chan_impl *impl, struct sllist *queue,
 	assert(queue);
 	assert(msg);
 
-	// Find the matching write operation.
+	// Find the matching write operation and frame.
+	struct io_can_chan_write *write = NULL;
+	size_t i = 0;
 	struct slnode *node = sllist_first(&impl->confirm_queue);
-	while (node) {
-		struct io_can_chan_write *write = io_can_chan_write_from_task(
-				ev_task_from_node(node));
-		if (!can_msg_cmp(msg, write->msg))
+	for (; node; node = node->next) {
+		write = io_can_chan_write_from_task(ev_task_from_node(node));
+		if ((i = io_can_chan_write_find(write, write->n, msg))
+				< write->n)
 			break;
-		node = node->next;
 	}
-	if (!node)
-		return;
-
-	// Complete the matching write operation. Any preceding write operations
-	// waiting for confirmation are considered to have failed.
-	struct ev_task *task;
-	while ((task = ev_task_from_node(
-				sllist_pop_front(&impl->confirm_queue)))) {
-		sllist_push_front(queue, &task->_node);
-		struct io_can_chan_write *write =
-				io_can_chan_write_from_task(task);
-		if (&task->_node == node) {
-			write->errc = 0;
-			break;
-		} else {
-			write->errc = EIO;
+	if (!node) {
+		// Check the frames of the write operation that is being sent,
+		// or of the one that was only partially sent.
+		struct ev_task *task = impl->current_write;
+		size_t n = 0;
+		if (task) {
+			n = io_can_chan_write_from_task(task)->n;
+		} else if (impl->nsent) {
+			task = ev_task_from_node(
+					sllist_first(&impl->write_queue));
+			n = impl->nsent;
 		}
+		if (!task)
+			return;
+		write = io_can_chan_write_from_task(task);
+		if ((i = io_can_chan_write_find(write, n, msg)) == n)
+			return;
+	}
+
+	// Any write operations waiting for confirmation preceding the matching
+	// one are considered to have failed.
+	struct slnode *first;
+	while ((first = sllist_first(&impl->confirm_queue)) != node) {
+		sllist_pop_front(&impl->confirm_queue);
+		sllist_push_front(queue, first);
+		io_can_chan_write_from_task(ev_task_from_node(first))->errc =
+				EIO;
+	}
+
+	// Any unconfirmed frames preceding the matching one are considered to
+	// have been lost.
+	if (i > write->nwritten)
+		write->errc = EIO;
+	write->nwritten = i + 1;
+
+	// Complete the write operation once all frames have been confirmed.
+	if (node && write->nwritten == write->n) {
+		sllist_pop_front(&impl->confirm_queue);
+		sllist_push_front(queue, node);
 	}
 }
 
+static size_t
+io_can_chan_write_find(const struct io_can_chan_write *write, size_t n,
+		const struct can_msg *msg)
+{
+	assert(write);
+	assert(n <= write->n);
+	assert(msg);
+
+	for (size_t i = write->nwritten; i < n; i++) {
+		if (!can_msg_cmp(msg, &write->msg[i]))
+			return i;
+	}
+	return n;
+}
+
 static size_t
 io_can_chan_impl_do_abort_tasks(struct io_can_chan_impl *impl)
 {
@@ -1602,6 +2056,7 @@ io_can_chan_impl_set_fd(struct io_can_chan_impl *impl, int fd, int flags)
 	spscring_c_alloc(&impl->rxring, &n);
 	if (n)
 		spscring_c_commit(&impl->rxring, n);
+	impl->drops = 0;
 #if !LELY_NO_THREADS
 	pthread_mutex_unlock(&impl->c_mtx);
 #endif
@@ -1612,6 +2067,14 @@ io_can_chan_impl_set_fd(struct io_can_chan_impl *impl, int fd, int flags)
 
 	impl->flags = flags;
 
+	// Apply the current filters to the new file descriptor. If this fails,
+	// the frames are only filtered in user space.
+	// clang-format off
+	if (impl->fd != -1 && impl->nfilters && io_can_fd_set_filters(
+			impl->fd, impl->filters, impl->nfilters) == -1)
+		// clang-format on
+		diag(DIAG_WARNING, errno, "unable to set CAN frame filters");
+
 	// Cancel pending operations.
 	sllist_append(&read_queue, &impl->read_queue);
 	sllist_append(&write_queue, &impl->write_queue);
@@ -1619,6 +2082,7 @@ io_can_chan_impl_set_fd(struct io_can_chan_impl *impl, int fd, int flags)
 
 	// Mark the ongoing write operation as canceled, if necessary.
 	impl->current_write = NULL;
+	impl->nsent = 0;
 
 #if !LELY_NO_THREADS
 	pthread_mutex_unlock(&impl->mtx);
@@ -1631,4 +2095,42 @@ io_can_chan_impl_set_fd(struct io_can_chan_impl *impl, int fd, int flags)
 	return fd;
 }
 
+static void
+can_net_filter2can_filter(
+		const struct can_net_filter *src, struct can_filter *dst)
+{
+	assert(src);
+	assert(dst);
+
+	dst->can_id = src->id & src->mask & CAN_EFF_MASK;
+	dst->can_mask = src->mask & CAN_EFF_MASK;
+	if (src->flags_mask & CAN_FLAG_IDE) {
+		dst->can_mask |= CAN_EFF_FLAG;
+		if (src->flags & CAN_FLAG_IDE)
+			dst->can_id |= CAN_EFF_FLAG;
+	}
+	if (src->flags_mask & CAN_FLAG_RTR) {
+		dst->can_mask |= CAN_RTR_FLAG;
+		if (src->flags & CAN_FLAG_RTR)
+			dst->can_id |= CAN_RTR_FLAG;
+	}
+}
+
+static int
+io_can_fd_set_filters(int fd, const struct can_filter *filters, size_t n)
+{
+	// A single filter with an empty mask accepts all frames, like the
+	// default filter of a SocketCAN socket.
+	struct can_filter filter = { .can_id = 0, .can_mask = 0 };
+	if (!n) {
+		filters = &filter;
+		n = 1;
+	}
+
+	// clang-format off
+	return setsockopt(fd, SOL_CAN_RAW, CAN_RAW_FILTER, filters,
+			n * sizeof(*filters));
+	// clang-format on
+}
+
 #endif // !LELY_NO_STDIO && __linux__
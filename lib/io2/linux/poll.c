@@ -42,12 +42,12 @@
 #include <sys/epoll.h>
 
 // clang-format off
-#define EPOLL_EVENT_INIT(events, fd) \
+#define EPOLL_EVENT_INIT(events, fd, edge) \
 	{ \
 		(((events) & IO_EVENT_IN) ? (EPOLLIN | EPOLLRDHUP) : 0) \
 				| (((events) & IO_EVENT_PRI) ? EPOLLPRI : 0) \
 				| (((events) & IO_EVENT_OUT) ? EPOLLOUT : 0) \
-				| EPOLLONESHOT, \
+				| ((edge) ? EPOLLET : EPOLLONESHOT), \
 		{ .fd = (fd) } \
 	}
 // clang-format on
@@ -98,6 +98,11 @@ struct io_poll {
 #endif
 	struct rbtree tree;
 	size_t nwatch;
+	/**
+	 * A flag indicating whether file descriptors are registered
+	 * persistently in edge-triggered mode.
+	 */
+	int edge;
 };
 
 static inline io_poll_t *io_poll_from_svc(const struct io_svc *svc);
@@ -109,6 +114,13 @@ static int io_poll_close(io_poll_t *poll);
 static void io_poll_process(
 		io_poll_t *poll, int revents, struct io_poll_watch *watch);
 
+/**
+ * Registers or updates a file descriptor in edge-triggered mode. This function
+ * is invoked by io_poll_watch() with the mutex locked.
+ */
+static int io_poll_watch_edge(io_poll_t *poll, struct rbnode *node, int fd,
+		int events, struct io_poll_watch *watch);
+
 static int io_fd_cmp(const void *p1, const void *p2);
 
 static inline struct io_poll_watch *io_poll_watch_from_node(
@@ -176,6 +188,7 @@ io_poll_init(io_poll_t *poll, io_ctx_t *ctx, int signo)
 
 	rbtree_init(&poll->tree, &io_fd_cmp);
 	poll->nwatch = 0;
+	poll->edge = 0;
 
 	if (io_poll_open(poll) == -1) {
 		errsv = errno;
@@ -313,8 +326,13 @@ io_poll_watch(io_poll_t *poll, int fd, int events, struct io_poll_watch *watch)
 		goto error;
 	}
 
-	if (events) {
-		struct epoll_event event = EPOLL_EVENT_INIT(events, fd);
+	if (events && poll->edge) {
+		if (io_poll_watch_edge(poll, node, fd, events, watch) == -1) {
+			errsv = errno;
+			goto error;
+		}
+	} else if (events) {
+		struct epoll_event event = EPOLL_EVENT_INIT(events, fd, 0);
 		if (node && events != watch->_events) {
 			if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &event) == -1) {
 				errsv = errno;
@@ -356,6 +374,46 @@ error:
 	return result;
 }
 
+int
+io_poll_get_edge(const io_poll_t *poll)
+{
+	assert(poll);
+
+#if !LELY_NO_THREADS
+	pthread_mutex_lock((pthread_mutex_t *)&poll->mtx);
+#endif
+	int edge = poll->edge;
+#if !LELY_NO_THREADS
+	pthread_mutex_unlock((pthread_mutex_t *)&poll->mtx);
+#endif
+	return edge;
+}
+
+int
+io_poll_set_edge(io_poll_t *poll, int edge)
+{
+	assert(poll);
+
+	int result = 0;
+	int errsv = errno;
+#if !LELY_NO_THREADS
+	pthread_mutex_lock(&poll->mtx);
+#endif
+	// The mode of already registered file descriptors cannot be changed
+	// without losing events.
+	if (!rbtree_empty(&poll->tree)) {
+		errsv = EBUSY;
+		result = -1;
+	} else {
+		poll->edge = !!edge;
+	}
+#if !LELY_NO_THREADS
+	pthread_mutex_unlock(&poll->mtx);
+#endif
+	errno = errsv;
+	return result;
+}
+
 static int
 io_poll_svc_notify_fork(struct io_svc *svc, enum io_fork_event e)
 {
@@ -381,9 +439,15 @@ io_poll_svc_notify_fork(struct io_svc *svc, enum io_fork_event e)
 	rbtree_foreach (&poll->tree, node) {
 		struct io_poll_watch *watch = io_poll_watch_from_node(node);
 		int fd = watch->_fd;
-		int events = watch->_events;
+		// In edge-triggered mode, file descriptors remain registered
+		// while they are not being monitored. Since the readiness is
+		// checked when they are added again, pending events can be
+		// discarded.
+		int events = poll->edge ? watch->_mask : watch->_events;
+		watch->_revents = 0;
 		if (events) {
-			struct epoll_event event = EPOLL_EVENT_INIT(events, fd);
+			struct epoll_event event = EPOLL_EVENT_INIT(
+					events, fd, poll->edge);
 
 			if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) == -1) {
 				if (!result) {
@@ -499,8 +563,22 @@ io_poll_poll_wait(ev_poll_t *poll_, int timeout)
 			if (node) {
 				struct io_poll_watch *watch =
 						io_poll_watch_from_node(node);
-				io_poll_process(poll, revents, watch);
-				n += n < INT_MAX;
+				if (poll->edge) {
+					// Only report the events being
+					// monitored and remember the others.
+					revents |= watch->_revents;
+					watch->_revents = revents;
+					revents &= watch->_events
+							| IO_EVENT_ERR
+							| IO_EVENT_HUP;
+					if (!watch->_events)
+						revents = 0;
+					watch->_revents &= ~revents;
+				}
+				if (revents) {
+					io_poll_process(poll, revents, watch);
+					n += n < INT_MAX;
+				}
 			}
 #if !LELY_NO_THREADS
 			pthread_mutex_unlock(&poll->mtx);
@@ -613,6 +691,59 @@ io_poll_process(io_poll_t *poll, int revents, struct io_poll_watch *watch)
 	}
 }
 
+static int
+io_poll_watch_edge(io_poll_t *poll, struct rbnode *node, int fd, int events,
+		struct io_poll_watch *watch)
+{
+	assert(poll);
+	assert(poll->edge);
+	assert(events);
+	assert(watch);
+	int epfd = poll->epfd;
+
+	if (!node) {
+		struct epoll_event event = EPOLL_EVENT_INIT(events, fd, 1);
+		if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &event) == -1)
+			return -1;
+		watch->_fd = fd;
+		rbnode_init(&watch->_node, &watch->_fd);
+		watch->_events = 0;
+		watch->_mask = events;
+		watch->_revents = 0;
+		rbtree_insert(&poll->tree, &watch->_node);
+	} else if ((events & ~watch->_mask)
+			|| (watch->_revents
+					& (events | IO_EVENT_ERR
+							| IO_EVENT_HUP))) {
+		// Modify the registration if the set of monitored events grows,
+		// or if an event occurred while the file descriptor was not
+		// being monitored for it. Since the kernel checks the readiness
+		// of the file descriptor when it is modified, a pending event
+		// is reported again if it still applies, while a stale one is
+		// discarded.
+		int mask = watch->_mask | events;
+		struct epoll_event event = EPOLL_EVENT_INIT(mask, fd, 1);
+		if (epoll_ctl(epfd, EPOLL_CTL_MOD, fd, &event) == -1) {
+			int errsv = errno;
+			epoll_ctl(epfd, EPOLL_CTL_DEL, fd, NULL);
+			rbtree_remove(&poll->tree, node);
+			if (watch->_events)
+				poll->nwatch--;
+			watch->_events = 0;
+			errno = errsv;
+			return -1;
+		}
+		watch->_mask = mask;
+		watch->_revents = 0;
+	}
+
+	if (!watch->_events)
+		poll->nwatch++;
+	watch->_events = events;
+
+	return 0;
+}
+
 static int
 io_fd_cmp(const void *p1, const void *p2)
 {
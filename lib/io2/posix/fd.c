@@ -25,6 +25,7 @@
 
 #include <assert.h>
 #include <errno.h>
+#include <stddef.h>
 
 #include <fcntl.h>
 #include <poll.h>
@@ -112,6 +113,47 @@ io_fd_recvmsg(int fd, struct msghdr *msg, int flags, int timeout)
 	return result;
 }
 
+#if defined(__linux__) && defined(_GNU_SOURCE)
+int
+io_fd_recvmmsg(int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+		int timeout)
+{
+#ifdef MSG_DONTWAIT
+	if (timeout >= 0)
+		flags |= MSG_DONTWAIT;
+#endif
+	// Do not wait for the remaining messages once the first one arrives.
+	flags |= MSG_WAITFORONE;
+
+	int result = 0;
+	int errsv = errno;
+	for (;;) {
+		errno = errsv;
+		// Try to receive one or more messages.
+		result = recvmmsg(fd, msgvec, vlen, flags, NULL);
+		if (result >= 0)
+			break;
+		if (errno == EINTR)
+			continue;
+		if (!timeout || (errno != EAGAIN && errno != EWOULDBLOCK))
+			return -1;
+		// Wait for a message to arrive.
+		// clang-format off
+		int events = (flags & MSG_OOB)
+				? (POLLRDBAND | POLLPRI) : POLLRDNORM;
+		// clang-format on
+		if (io_fd_wait(fd, &events, timeout) == -1)
+			return -1;
+		// Since the timeout is relative, we can only use a positive
+		// value once.
+		if (timeout > 0)
+			timeout = 0;
+	}
+
+	return result;
+}
+#endif // __linux__ && _GNU_SOURCE
+
 ssize_t
 io_fd_sendmsg(int fd, const struct msghdr *msg, int flags, int timeout)
 {
@@ -145,4 +187,41 @@ io_fd_sendmsg(int fd, const struct msghdr *msg, int flags, int timeout)
 	return result;
 }
 
+#if defined(__linux__) && defined(_GNU_SOURCE)
+int
+io_fd_sendmmsg(int fd, struct mmsghdr *msgvec, unsigned int vlen, int flags,
+		int timeout)
+{
+	flags |= MSG_NOSIGNAL;
+#ifdef MSG_DONTWAIT
+	if (timeout >= 0)
+		flags |= MSG_DONTWAIT;
+#endif
+
+	int result = 0;
+	int errsv = errno;
+	for (;;) {
+		errno = errsv;
+		// Try to send one or more messages. This only fails if the
+		// first message cannot be sent.
+		result = sendmmsg(fd, msgvec, vlen, flags);
+		if (result >= 0)
+			break;
+		if (errno == EINTR)
+			continue;
+		if (!timeout || (errno != EAGAIN && errno != EWOULDBLOCK))
+			return -1;
+		// Wait for the socket to become ready.
+		int events = (flags & MSG_OOB) ? POLLWRBAND : POLLWRNORM;
+		if (io_fd_wait(fd, &events, timeout) == -1)
+			return -1;
+		// Since the timeout is relative, we can only use a positive
+		// value once.
+		if (timeout > 0)
+			timeout = 0;
+	}
+	return result;
+}
+#endif // __linux__ && _GNU_SOURCE
+
 #endif // !LELY_NO_STDIO && _POSIX_C_SOURCE >= 200112L
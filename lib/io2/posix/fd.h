@@ -66,6 +66,22 @@ int io_fd_wait(int fd, int *events, int timeout);
  */
 ssize_t io_fd_recvmsg(int fd, struct msghdr *msg, int flags, int timeout);
 
+#if defined(__linux__) && defined(_GNU_SOURCE)
+/**
+ * Equivalent to Linux `recvmmsg(fd, msgvec, vlen, flags, NULL)`, except that
+ * if <b>fd</b> is non-blocking (or the implementation supports the
+ * `MSG_DONTWAIT` flag) and <b>timeout</b> is non-negative, this function waits
+ * at most <b>timeout</b> milliseconds for the first message to arrive, as if by
+ * io_fd_recvmsg(). Once a message has been received, this function does not
+ * wait for the remaining messages.
+ *
+ * @returns the number of messages received, or -1 on error. In the latter
+ * case, the error number can be obtained from `errno`.
+ */
+int io_fd_recvmmsg(int fd, struct mmsghdr *msgvec, unsigned int vlen,
+		int flags, int timeout);
+#endif
+
 /**
  * Equivalent to POSIX `sendmsg(fd, msg, flags | MSG_NOSIGNAL)`, except that if
  * <b>fd</b> is non-blocking (or the implementation supports the `MSG_DONTWAIT`
@@ -76,6 +92,21 @@ ssize_t io_fd_recvmsg(int fd, struct msghdr *msg, int flags, int timeout);
  */
 ssize_t io_fd_sendmsg(int fd, const struct msghdr *msg, int flags, int timeout);
 
+#if defined(__linux__) && defined(_GNU_SOURCE)
+/**
+ * Equivalent to Linux `sendmmsg(fd, msgvec, vlen, flags | MSG_NOSIGNAL)`,
+ * except that if <b>fd</b> is non-blocking (or the implementation supports the
+ * `MSG_DONTWAIT` flag) and <b>timeout</b> is non-negative, this function waits
+ * at most <b>timeout</b> milliseconds for the socket to become ready for the
+ * first message, as if by io_fd_sendmsg().
+ *
+ * @returns the number of messages sent, or -1 on error. In the latter case, the
+ * error number can be obtained from `errno`.
+ */
+int io_fd_sendmmsg(int fd, struct mmsghdr *msgvec, unsigned int vlen,
+		int flags, int timeout);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
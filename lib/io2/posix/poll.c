@@ -350,6 +350,27 @@ error:
 	return result;
 }
 
+int
+io_poll_get_edge(const io_poll_t *poll)
+{
+	(void)poll;
+
+	return 0;
+}
+
+int
+io_poll_set_edge(io_poll_t *poll, int edge)
+{
+	(void)poll;
+
+	if (edge) {
+		errno = ENOTSUP;
+		return -1;
+	}
+
+	return 0;
+}
+
 static void *
 io_poll_poll_self(const ev_poll_t *poll)
 {
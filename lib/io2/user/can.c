@@ -79,6 +79,8 @@ static int io_user_can_chan_write(
 		io_can_chan_t *chan, const struct can_msg *msg, int timeout);
 static void io_user_can_chan_submit_write(
 		io_can_chan_t *chan, struct io_can_chan_write *write);
+static int io_user_can_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n);
 
 // clang-format off
 static const struct io_can_chan_vtbl io_user_can_chan_vtbl = {
@@ -87,7 +89,8 @@ static const struct io_can_chan_vtbl io_user_can_chan_vtbl = {
 	&io_user_can_chan_read,
 	&io_user_can_chan_submit_read,
 	&io_user_can_chan_write,
-	&io_user_can_chan_submit_write
+	&io_user_can_chan_submit_write,
+	&io_user_can_chan_set_filters
 };
 // clang-format on
 
@@ -685,14 +688,14 @@ io_user_can_chan_submit_write(
 {
 	struct io_user_can_chan *user = io_user_can_chan_from_chan(chan);
 	assert(write);
+	assert(write->msg);
+	assert(write->n);
 	struct ev_task *task = &write->task;
 
+	write->nwritten = 0;
+
 #if !LELY_NO_CANFD
-	int flags = 0;
-	if (write->msg->flags & CAN_FLAG_FDF)
-		flags |= IO_CAN_BUS_FLAG_FDF;
-	if (write->msg->flags & CAN_FLAG_BRS)
-		flags |= IO_CAN_BUS_FLAG_BRS;
+	int flags = io_can_chan_write_flags(write);
 #endif
 
 	if (!task->exec)
@@ -734,6 +737,19 @@ io_user_can_chan_submit_write(
 	}
 }
 
+static int
+io_user_can_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n)
+{
+	(void)chan;
+	(void)filters;
+	(void)n;
+
+	// The user is responsible for delivering frames, so the filters are
+	// ignored.
+	return 0;
+}
+
 static void
 io_user_can_chan_svc_shutdown(struct io_svc *svc)
 {
@@ -863,8 +879,14 @@ io_user_can_chan_write_task_func(struct ev_task *task)
 #endif
 		struct io_can_chan_write *write =
 				io_can_chan_write_from_task(task);
-		int result = io_user_can_chan_write(
-				chan, write->msg, user->txtimeo);
+		int result = 0;
+		while (!result && write->nwritten < write->n) {
+			result = io_user_can_chan_write(chan,
+					&write->msg[write->nwritten],
+					user->txtimeo);
+			if (!result)
+				write->nwritten++;
+		}
 		int errc = !result ? 0 : get_errc();
 		wouldblock = errc == errnum2c(ERRNUM_AGAIN)
 				|| errc == errnum2c(ERRNUM_WOULDBLOCK);
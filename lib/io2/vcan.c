@@ -153,6 +153,8 @@ static int io_vcan_chan_write(
 		io_can_chan_t *chan, const struct can_msg *msg, int timeout);
 static void io_vcan_chan_submit_write(
 		io_can_chan_t *chan, struct io_can_chan_write *write);
+static int io_vcan_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n);
 
 // clang-format off
 static const struct io_can_chan_vtbl io_vcan_chan_vtbl = {
@@ -161,7 +163,8 @@ static const struct io_can_chan_vtbl io_vcan_chan_vtbl = {
 	&io_vcan_chan_read,
 	&io_vcan_chan_submit_read,
 	&io_vcan_chan_write,
-	&io_vcan_chan_submit_write
+	&io_vcan_chan_submit_write,
+	&io_vcan_chan_set_filters
 };
 // clang-format on
 
@@ -1307,8 +1310,12 @@ io_vcan_chan_submit_write(io_can_chan_t *chan, struct io_can_chan_write *write)
 {
 	struct io_vcan_chan *vcan = io_vcan_chan_from_chan(chan);
 	assert(write);
+	assert(write->msg);
+	assert(write->n);
 	struct ev_task *task = &write->task;
 
+	write->nwritten = 0;
+
 	if (!task->exec)
 		task->exec = vcan->exec;
 	ev_exec_on_task_init(task->exec);
@@ -1346,6 +1353,19 @@ io_vcan_chan_submit_write(io_can_chan_t *chan, struct io_can_chan_write *write)
 	}
 }
 
+static int
+io_vcan_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n)
+{
+	(void)chan;
+	(void)filters;
+	(void)n;
+
+	// Frames are exchanged in user space, so filtering them here would not
+	// save anything.
+	return 0;
+}
+
 static void
 io_vcan_chan_svc_shutdown(struct io_svc *svc)
 {
@@ -1439,9 +1459,14 @@ io_vcan_chan_write_task_func(struct ev_task *task)
 #if !LELY_NO_THREADS
 		mtx_unlock(&vcan->mtx);
 #endif
-		// Perform a non-blocking write.
-		int result = io_vcan_chan_write(
-				&vcan->chan_vptr, write->msg, 0);
+		// Perform non-blocking writes of the remaining frames.
+		int result = 0;
+		while (!result && write->nwritten < write->n) {
+			result = io_vcan_chan_write(&vcan->chan_vptr,
+					&write->msg[write->nwritten], 0);
+			if (!result)
+				write->nwritten++;
+		}
 		int errc = !result ? 0 : get_errc();
 		wouldblock = errc == errnum2c(ERRNUM_AGAIN)
 				|| errc == errnum2c(ERRNUM_WOULDBLOCK);
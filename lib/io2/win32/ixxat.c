@@ -162,6 +162,8 @@ static int io_ixxat_chan_write(
 		io_can_chan_t *chan, const struct can_msg *msg, int timeout);
 static void io_ixxat_chan_submit_write(
 		io_can_chan_t *chan, struct io_can_chan_write *write);
+static int io_ixxat_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n);
 
 // clang-format off
 static const struct io_can_chan_vtbl io_ixxat_chan_vtbl = {
@@ -170,7 +172,8 @@ static const struct io_can_chan_vtbl io_ixxat_chan_vtbl = {
 	&io_ixxat_chan_read,
 	&io_ixxat_chan_submit_read,
 	&io_ixxat_chan_write,
-	&io_ixxat_chan_submit_write
+	&io_ixxat_chan_submit_write,
+	&io_ixxat_chan_set_filters
 };
 // clang-format on
 
@@ -1478,14 +1481,13 @@ io_ixxat_chan_submit_write(io_can_chan_t *chan, struct io_can_chan_write *write)
 	struct io_ixxat_chan *ixxat = io_ixxat_chan_from_chan(chan);
 	assert(write);
 	assert(write->msg);
+	assert(write->n);
 	struct ev_task *task = &write->task;
 
+	write->nwritten = 0;
+
 #if !LELY_NO_CANFD
-	int flags = 0;
-	if (write->msg->flags & CAN_FLAG_FDF)
-		flags |= IO_CAN_BUS_FLAG_FDF;
-	if (write->msg->flags & CAN_FLAG_BRS)
-		flags |= IO_CAN_BUS_FLAG_BRS;
+	int flags = io_can_chan_write_flags(write);
 #endif
 
 	if (!task->exec)
@@ -1524,6 +1526,18 @@ io_ixxat_chan_submit_write(io_can_chan_t *chan, struct io_can_chan_write *write)
 	}
 }
 
+static int
+io_ixxat_chan_set_filters(io_can_chan_t *chan,
+		const struct can_net_filter *filters, size_t n)
+{
+	(void)chan;
+	(void)filters;
+	(void)n;
+
+	// Acceptance filtering is not (yet) supported by this driver.
+	return 0;
+}
+
 static void
 io_ixxat_chan_svc_shutdown(struct io_svc *svc)
 {
@@ -1651,7 +1665,13 @@ io_ixxat_chan_write_task_func(struct ev_task *task)
 	int result = 0;
 	int errc = 0;
 	if (write) {
-		result = io_ixxat_write(hCanChn, write->msg, ixxat->txtimeo);
+		while (!result && write->nwritten < write->n) {
+			result = io_ixxat_write(hCanChn,
+					&write->msg[write->nwritten],
+					ixxat->txtimeo);
+			if (!result)
+				write->nwritten++;
+		}
 		if (result == -1) {
 			errc = GetLastError();
 			if (errc == ERROR_TIMEOUT)
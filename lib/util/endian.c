@@ -203,6 +203,66 @@ bcpyle(uint_least8_t *dst, int dstbit, const uint_least8_t *src, int srcbit,
 	}
 }
 
+void
+ldbe_u64v(uint_least64_t *dst, const uint_least8_t *src, size_t n)
+{
+	assert(dst || !n);
+	assert(src || !n);
+
+	for (; n >= 8; n -= 8, src += 8)
+		*dst++ = ldbe_u64(src);
+
+	if (n) {
+		uint_least64_t x = 0;
+		for (size_t i = 0; i < n; i++)
+			x |= (uint_least64_t)(src[i] & 0xff) << (56 - 8 * i);
+		*dst = x;
+	}
+}
+
+void
+stbe_u64v(uint_least8_t *dst, const uint_least64_t *src, size_t n)
+{
+	assert(dst || !n);
+	assert(src || !n);
+
+	for (; n >= 8; n -= 8, dst += 8)
+		stbe_u64(dst, *src++);
+
+	for (size_t i = 0; i < n; i++)
+		dst[i] = (*src >> (56 - 8 * i)) & 0xff;
+}
+
+void
+ldle_u64v(uint_least64_t *dst, const uint_least8_t *src, size_t n)
+{
+	assert(dst || !n);
+	assert(src || !n);
+
+	for (; n >= 8; n -= 8, src += 8)
+		*dst++ = ldle_u64(src);
+
+	if (n) {
+		uint_least64_t x = 0;
+		for (size_t i = 0; i < n; i++)
+			x |= (uint_least64_t)(src[i] & 0xff) << (8 * i);
+		*dst = x;
+	}
+}
+
+void
+stle_u64v(uint_least8_t *dst, const uint_least64_t *src, size_t n)
+{
+	assert(dst || !n);
+	assert(src || !n);
+
+	for (; n >= 8; n -= 8, dst += 8)
+		stle_u64(dst, *src++);
+
+	for (size_t i = 0; i < n; i++)
+		dst[i] = (*src >> (8 * i)) & 0xff;
+}
+
 static inline void
 bitcpy(uint_least8_t *dst, uint_least8_t src, uint_least8_t mask)
 {
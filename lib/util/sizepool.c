@@ -0,0 +1,245 @@
+/**@file
+ * This file is part of the utilities library; it contains the implementation of
+ * the size-class memory pool allocator.
+ *
+ * @see lely/util/sizepool.h
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "util.h"
+#include <lely/compat/stddef.h>
+#include <lely/util/error.h>
+#include <lely/util/sizepool.h>
+#include <lely/util/util.h>
+
+#include <assert.h>
+#include <stdint.h>
+
+/// The alignment (in bytes) of every block in a size-class memory pool.
+#define SIZEPOOL_ALIGN _Alignof(max_align_t)
+
+/// Returns the size of a block in a class, rounded up to #SIZEPOOL_ALIGN.
+static inline size_t sizepool_block_size(size_t size);
+
+static inline struct sizepool *sizepool_from_alloc(alloc_t *alloc);
+
+static void *sizepool_alloc(alloc_t *alloc, size_t alignment, size_t size);
+static void sizepool_free(alloc_t *alloc, void *ptr);
+static size_t sizepool_size(const alloc_t *alloc);
+static size_t sizepool_capacity(const alloc_t *alloc);
+
+// clang-format off
+static const struct alloc_vtbl sizepool_vtbl = {
+	&sizepool_alloc,
+	&sizepool_free,
+	&sizepool_size,
+	&sizepool_capacity
+};
+// clang-format on
+
+size_t
+sizepool_sizeof(const struct sizepool_class *classes, size_t nclasses)
+{
+	assert(classes || !nclasses);
+
+	size_t size = 0;
+	for (size_t i = 0; i < nclasses; i++)
+		size += sizepool_block_size(classes[i].size) * classes[i].num;
+	return size;
+}
+
+alloc_t *
+sizepool_init(struct sizepool *pool, void *memory, size_t size,
+		struct sizepool_class *classes, size_t nclasses)
+{
+	assert(pool);
+	assert(memory || !size);
+	assert(classes || !nclasses);
+
+	if (!memory || ALIGN((uintptr_t)memory, SIZEPOOL_ALIGN)
+					!= (uintptr_t)memory) {
+		set_errnum(ERRNUM_INVAL);
+		return NULL;
+	}
+
+	for (size_t i = 0; i < nclasses; i++) {
+		// The classes MUST be sorted by increasing block size.
+		size_t size = classes[i].size;
+		if (!size || (i && size < classes[i - 1].size)) {
+			set_errnum(ERRNUM_INVAL);
+			return NULL;
+		}
+	}
+
+	if (size < sizepool_sizeof(classes, nclasses)) {
+		set_errnum(ERRNUM_NOMEM);
+		return NULL;
+	}
+
+	pool->vtbl = &sizepool_vtbl;
+
+	pool->classes = classes;
+	pool->nclasses = nclasses;
+
+	char *cur = memory;
+	for (size_t i = 0; i < nclasses; i++) {
+		struct sizepool_class *cls = &classes[i];
+		cls->size = sizepool_block_size(cls->size);
+		cls->beg = cur;
+		cls->end = cls->beg + cls->size * cls->num;
+		// Blocks are only added to the free list once they are freed.
+		// This keeps initialization O(1) in the number of blocks.
+		cls->cur = cls->beg;
+		cls->free = NULL;
+		cls->used = 0;
+		cls->max_used = 0;
+		cls->nfail = 0;
+		cur = cls->end;
+	}
+
+	pool->total = cur - (char *)memory;
+	pool->used = 0;
+	pool->max_used = 0;
+	pool->nfail = 0;
+
+	return &pool->vtbl;
+}
+
+void
+sizepool_reset_stats(struct sizepool *pool)
+{
+	assert(pool);
+
+	for (size_t i = 0; i < pool->nclasses; i++) {
+		struct sizepool_class *cls = &pool->classes[i];
+		cls->max_used = cls->used;
+		cls->nfail = 0;
+	}
+
+	pool->max_used = pool->used;
+	pool->nfail = 0;
+}
+
+static inline size_t
+sizepool_block_size(size_t size)
+{
+	size = ALIGN(size, SIZEPOOL_ALIGN);
+	// Every block must be able to hold the free list pointer.
+	return MAX(size, ALIGN(sizeof(void *), SIZEPOOL_ALIGN));
+}
+
+static inline struct sizepool *
+sizepool_from_alloc(alloc_t *alloc)
+{
+	assert(alloc);
+
+	return structof(alloc, struct sizepool, vtbl);
+}
+
+static void *
+sizepool_alloc(alloc_t *alloc, size_t alignment, size_t size)
+{
+	struct sizepool *pool = sizepool_from_alloc(alloc);
+
+	if (!size)
+		return NULL;
+
+	if (!alignment)
+		alignment = SIZEPOOL_ALIGN;
+
+	// Every block is aligned to SIZEPOOL_ALIGN; stricter alignments are not
+	// supported.
+	if (!powerof2(alignment) || alignment > SIZEPOOL_ALIGN) {
+		set_errnum(ERRNUM_INVAL);
+		return NULL;
+	}
+
+	// Find the smallest class that fits the requested size and has a block
+	// available. The number of classes is fixed, so this is O(1) in the
+	// number of blocks.
+	for (size_t i = 0; i < pool->nclasses; i++) {
+		struct sizepool_class *cls = &pool->classes[i];
+		if (cls->size < size)
+			continue;
+
+		void *ptr = cls->free;
+		if (ptr) {
+			cls->free = *(void **)ptr;
+		} else if (cls->cur < cls->end) {
+			ptr = cls->cur;
+			cls->cur += cls->size;
+		} else {
+			cls->nfail++;
+			continue;
+		}
+
+		cls->used++;
+		cls->max_used = MAX(cls->max_used, cls->used);
+		pool->used += cls->size;
+		pool->max_used = MAX(pool->max_used, pool->used);
+
+		return ptr;
+	}
+
+	pool->nfail++;
+	set_errnum(ERRNUM_NOMEM);
+	return NULL;
+}
+
+static void
+sizepool_free(alloc_t *alloc, void *ptr)
+{
+	struct sizepool *pool = sizepool_from_alloc(alloc);
+
+	if (!ptr)
+		return;
+
+	// Find the class containing the block.
+	for (size_t i = 0; i < pool->nclasses; i++) {
+		struct sizepool_class *cls = &pool->classes[i];
+		if ((char *)ptr < cls->beg || (char *)ptr >= cls->end)
+			continue;
+		assert(!(((char *)ptr - cls->beg) % cls->size));
+		assert(cls->used);
+
+		*(void **)ptr = cls->free;
+		cls->free = ptr;
+
+		cls->used--;
+		pool->used -= cls->size;
+
+		return;
+	}
+
+	// The block was not allocated by this pool.
+	assert(0);
+}
+
+static size_t
+sizepool_size(const alloc_t *alloc)
+{
+	const struct sizepool *pool = sizepool_from_alloc((alloc_t *)alloc);
+
+	return pool->used;
+}
+
+static size_t
+sizepool_capacity(const alloc_t *alloc)
+{
+	const struct sizepool *pool = sizepool_from_alloc((alloc_t *)alloc);
+
+	return pool->total - pool->used;
+}
@@ -0,0 +1,238 @@
+/**@file
+ * This file is part of the utilities library; it contains the implementation of
+ * the hierarchical timing wheel.
+ *
+ * @see lely/util/twheel.h
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "util.h"
+#define LELY_UTIL_TWHEEL_INLINE extern inline
+#include <lely/util/bits.h>
+#include <lely/util/twheel.h>
+
+#include <assert.h>
+
+/**
+ * Returns the level of a timing wheel at which a key is stored, i.e., the level
+ * containing the most significant bit in which the key and the current time
+ * differ. The key MUST be later than the current time.
+ */
+static inline int twheel_level(uint_least64_t key, uint_least64_t now);
+
+/// Returns the slot in the specified level of a timing wheel of a key.
+static inline int twheel_slot(uint_least64_t key, int level);
+
+/// Inserts a node into a timing wheel without updating the number of nodes.
+static void twheel_push(struct twheel *wheel, struct twnode *node);
+
+/**
+ * Moves the nodes in the slots indicated by <b>mask</b> in the specified level
+ * of a timing wheel to <b>list</b>.
+ */
+static void twheel_take(struct twheel *wheel, int level, uint_least64_t mask,
+		struct dllist *list);
+
+void
+twheel_init(struct twheel *wheel, uint_least64_t now)
+{
+	assert(wheel);
+
+	wheel->now = now;
+
+	for (int level = 0; level < TWHEEL_LEVELS; level++) {
+		wheel->mask[level] = 0;
+		for (int slot = 0; slot < TWHEEL_SIZE; slot++)
+			dllist_init(&wheel->slots[level][slot]);
+	}
+
+	dllist_init(&wheel->expired);
+
+	wheel->num_nodes = 0;
+}
+
+void
+twheel_insert(struct twheel *wheel, struct twnode *node)
+{
+	assert(wheel);
+	assert(node);
+
+	twheel_push(wheel, node);
+	wheel->num_nodes++;
+}
+
+void
+twheel_remove(struct twheel *wheel, struct twnode *node)
+{
+	assert(wheel);
+	assert(wheel->num_nodes);
+	assert(node);
+
+	if (node->key <= wheel->now) {
+		dllist_remove(&wheel->expired, &node->list);
+	} else {
+		int level = twheel_level(node->key, wheel->now);
+		int slot = twheel_slot(node->key, level);
+		struct dllist *list = &wheel->slots[level][slot];
+		dllist_remove(list, &node->list);
+		if (dllist_empty(list))
+			wheel->mask[level] &= ~((uint_least64_t)1 << slot);
+	}
+	wheel->num_nodes--;
+}
+
+void
+twheel_advance(struct twheel *wheel, uint_least64_t now,
+		struct dllist *expired)
+{
+	assert(wheel);
+	assert(expired);
+
+	struct dllist list;
+	dllist_init(&list);
+
+	if (now < wheel->now) {
+		// If the time is moved backwards, the position of every node
+		// may have changed.
+		for (int level = 0; level < TWHEEL_LEVELS; level++)
+			twheel_take(wheel, level, wheel->mask[level], &list);
+		dllist_append(&list, &wheel->expired);
+	} else if (now > wheel->now) {
+		// All nodes at levels below the most significant level in which
+		// the old and new time differ have expired. At that level, only
+		// the nodes in the slots between the old and the new time have
+		// to be moved. The nodes at higher levels are unaffected.
+		int top = twheel_level(now, wheel->now);
+		for (int level = 0; level < top; level++)
+			twheel_take(wheel, level, wheel->mask[level], &list);
+		int lo = twheel_slot(wheel->now, top);
+		int hi = twheel_slot(now, top);
+		uint_least64_t mask = (((uint_least64_t)2 << hi) - 1)
+				& ~(((uint_least64_t)2 << lo) - 1);
+		twheel_take(wheel, top, mask, &list);
+	}
+	wheel->now = now;
+
+	// Redistribute the nodes over the lower levels or the list of expired
+	// nodes.
+	struct dlnode *node;
+	while ((node = dllist_pop_front(&list)) != NULL)
+		twheel_push(wheel, structof(node, struct twnode, list));
+
+	wheel->num_nodes -= dllist_size(&wheel->expired);
+	dllist_append(expired, &wheel->expired);
+}
+
+uint_least64_t
+twheel_next(const struct twheel *wheel)
+{
+	assert(wheel);
+
+	if (!dllist_empty(&wheel->expired))
+		return wheel->now;
+
+	for (int level = 0; level < TWHEEL_LEVELS; level++) {
+		if (wheel->mask[level]) {
+			// Combine the bits of the current time above this level
+			// with the first non-empty slot.
+			int shift = level * TWHEEL_BITS;
+			uint_least64_t next = 0;
+			if (level < TWHEEL_LEVELS - 1)
+				next = (wheel->now >> (shift + TWHEEL_BITS))
+						<< (shift + TWHEEL_BITS);
+			next |= (uint_least64_t)ctz64(wheel->mask[level])
+					<< shift;
+			return next;
+		}
+	}
+
+	return UINT64_MAX;
+}
+
+struct twnode *
+twheel_first(const struct twheel *wheel)
+{
+	assert(wheel);
+
+	// The keys of all nodes at a level are smaller than those at the higher
+	// levels. Within a level, the slots are ordered by key.
+	const struct dllist *list = NULL;
+	if (!dllist_empty(&wheel->expired)) {
+		list = &wheel->expired;
+	} else {
+		for (int level = 0; !list && level < TWHEEL_LEVELS; level++) {
+			if (wheel->mask[level])
+				list = &wheel->slots[level]
+						    [ctz64(wheel->mask[level])];
+		}
+	}
+	if (!list)
+		return NULL;
+
+	struct twnode *first = NULL;
+	dllist_foreach (list, node) {
+		struct twnode *twnode = structof(node, struct twnode, list);
+		if (!first || twnode->key < first->key)
+			first = twnode;
+	}
+	return first;
+}
+
+static inline int
+twheel_level(uint_least64_t key, uint_least64_t now)
+{
+	assert(key > now);
+
+	return (63 - clz64(key ^ now)) / TWHEEL_BITS;
+}
+
+static inline int
+twheel_slot(uint_least64_t key, int level)
+{
+	return (key >> (level * TWHEEL_BITS)) & (TWHEEL_SIZE - 1);
+}
+
+static void
+twheel_push(struct twheel *wheel, struct twnode *node)
+{
+	assert(wheel);
+	assert(node);
+
+	if (node->key <= wheel->now) {
+		dllist_push_back(&wheel->expired, &node->list);
+	} else {
+		int level = twheel_level(node->key, wheel->now);
+		int slot = twheel_slot(node->key, level);
+		dllist_push_back(&wheel->slots[level][slot], &node->list);
+		wheel->mask[level] |= (uint_least64_t)1 << slot;
+	}
+}
+
+static void
+twheel_take(struct twheel *wheel, int level, uint_least64_t mask,
+		struct dllist *list)
+{
+	assert(wheel);
+	assert(list);
+
+	mask &= wheel->mask[level];
+	wheel->mask[level] &= ~mask;
+	while (mask) {
+		int slot = ctz64(mask);
+		mask &= mask - 1;
+		dllist_append(list, &wheel->slots[level][slot]);
+	}
+}
@@ -1,18 +1,102 @@
 #include "test.h"
 #include <lely/can/net.h>
+#include <lely/util/time.h>
+
+#include <string.h>
 
 #define MSG_ID 0x123
 
+#define NUM_TIMERS 64
+#define NUM_STEPS 4096
+#define MAX_EVENTS (64 * NUM_STEPS)
+
 int can_recv(const struct can_msg *msg, void *data);
 
+static void test_recv(can_net_t *net);
+
+static int mask_count;
+
+int can_recv_mask(const struct can_msg *msg, void *data);
+
+static void test_recv_mask(can_net_t *net);
+
+static int filter_count;
+
+void can_filter(void *data);
+
+static void test_filter(can_net_t *net);
+
+/// An event recorded while running the timers of a CAN network interface.
+struct timer_event {
+	/// The index of the timer, or -1 if the next time was updated.
+	int i;
+	/// The current time (if #i is not -1).
+	struct timespec tp;
+};
+
+/// The trace of timer events.
+struct timer_trace {
+	size_t n;
+	struct timer_event ev[MAX_EVENTS];
+};
+
+static struct timer_trace trace[2];
+static struct timer_trace *cur_trace;
+
+static can_net_t *timer_net;
+static can_timer_t *timers[NUM_TIMERS];
+static uint_least32_t timer_seed;
+
+int can_timer(const struct timespec *tp, void *data);
+int can_next(const struct timespec *tp, void *data);
+
+static int timer_trace_equal(
+		const struct timer_trace *t1, const struct timer_trace *t2);
+static uint_least32_t timer_rand(void);
+static void timer_restart(int i);
+static void test_timer(can_net_t *net, struct timer_trace *trace);
+
 int
 main(void)
 {
-	tap_plan(8);
+	tap_plan(18 + 3 + 6 + 2);
 
 	can_net_t *net = can_net_create(NULL);
 	tap_assert(net);
 
+	for (int i = 0; i < 2; i++) {
+		tap_test(!can_net_set_recv_lookup(net,
+				i ? CAN_NET_RECV_LOOKUP_TABLE
+				  : CAN_NET_RECV_LOOKUP_TREE));
+		test_recv(net);
+	}
+
+	test_recv_mask(net);
+	test_filter(net);
+
+	can_net_destroy(net);
+
+	// Run the same sequence of timers with both queues and check that they
+	// trigger at the same time and in the same order.
+	for (int i = 0; i < 2; i++) {
+		net = can_net_create(NULL);
+		tap_assert(net);
+		tap_assert(!can_net_set_timer_queue(net,
+				i ? CAN_NET_TIMER_QUEUE_WHEEL
+				  : CAN_NET_TIMER_QUEUE_HEAP));
+		test_timer(net, &trace[i]);
+		can_net_destroy(net);
+	}
+	tap_test(trace[0].n > NUM_STEPS, "%zu timer events", trace[0].n);
+	tap_test(timer_trace_equal(&trace[0], &trace[1]),
+			"heap and wheel yield the same timer events");
+
+	return 0;
+}
+
+static void
+test_recv(can_net_t *net)
+{
 	can_recv_t *r1 = can_recv_create(can_net_get_alloc(net));
 	tap_assert(r1);
 	can_recv_set_func(r1, &can_recv, (void *)(uintptr_t)1);
@@ -50,16 +134,227 @@ main(void)
 
 	can_recv_destroy(r2);
 	can_recv_destroy(r1);
+}
 
-	can_net_destroy(net);
+int
+can_recv(const struct can_msg *msg, void *data)
+{
+	tap_pass("#%d received 0x%03x", (int)(uintptr_t)data, msg->id);
 
 	return 0;
 }
 
+static void
+test_recv_mask(can_net_t *net)
+{
+	can_recv_t *recv = can_recv_create(can_net_get_alloc(net));
+	tap_assert(recv);
+	can_recv_set_func(recv, &can_recv_mask, NULL);
+
+	// Receive all base-format frames in the range 0x080..0x0FF, like an
+	// EMCY consumer.
+	can_recv_start_mask(recv, net, 0x080, 0x780, 0, 0xff);
+
+	struct can_msg msg = CAN_MSG_INIT;
+	mask_count = 0;
+	uint_least32_t ids[] = { 0x080, 0x081, 0x0ff, 0x100, 0x07f };
+	for (size_t i = 0; i < sizeof(ids) / sizeof(*ids); i++) {
+		msg.id = ids[i];
+		can_net_recv(net, &msg);
+	}
+	// Frames with the extended format are rejected by the flags mask.
+	msg.id = 0x081;
+	msg.flags = CAN_FLAG_IDE;
+	can_net_recv(net, &msg);
+	tap_test(mask_count == 3, "masked receiver received %d frames",
+			mask_count);
+
+	// Accept both formats.
+	can_recv_start_mask(recv, net, 0x080, 0x780, 0, 0);
+	mask_count = 0;
+	can_net_recv(net, &msg);
+	tap_test(mask_count == 1);
+
+	can_recv_stop(recv);
+	mask_count = 0;
+	can_net_recv(net, &msg);
+	tap_test(mask_count == 0);
+
+	can_recv_destroy(recv);
+}
+
 int
-can_recv(const struct can_msg *msg, void *data)
+can_recv_mask(const struct can_msg *msg, void *data)
 {
-	tap_pass("#%d received 0x%03x", (int)(uintptr_t)data, msg->id);
+	(void)msg;
+	(void)data;
+
+	mask_count++;
 
 	return 0;
 }
+
+static void
+test_filter(can_net_t *net)
+{
+	can_net_set_filter_func(net, &can_filter, NULL);
+	filter_count = 0;
+
+	// Register the receivers of a node with 4 TPDO consumers, a
+	// heartbeat consumer and an EMCY consumer.
+	can_recv_t *recv[6];
+	for (int i = 0; i < 6; i++) {
+		recv[i] = can_recv_create(can_net_get_alloc(net));
+		tap_assert(recv[i]);
+	}
+	for (int i = 0; i < 4; i++)
+		can_recv_start(recv[i], net, 0x180 + i, 0);
+	can_recv_start(recv[4], net, 0x701, 0);
+	can_recv_start_mask(recv[5], net, 0x080, 0x780, 0, 0);
+	tap_test(filter_count == 6, "%d filter changes", filter_count);
+
+	struct can_net_filter filters[8];
+	size_t n = can_net_get_filters(net, filters, 8);
+	tap_test(n == 6, "%zu filters", n);
+
+	// 0x180..0x183 are merged into a single filter.
+	n = can_net_compact_filters(filters, n, 0);
+	tap_test(n == 3, "%zu filters after lossless merge", n);
+	tap_test(filters[0].id == 0x080 && filters[0].mask == 0x780
+			&& !filters[0].flags_mask);
+	tap_test(filters[1].id == 0x180 && filters[1].mask == 0x1ffffffc);
+
+	// Merging the TPDO and heartbeat filters accepts the fewest additional
+	// frames, since the EMCY filter accepts both formats.
+	n = can_net_compact_filters(filters, n, 2);
+	tap_test(n == 2 && filters[0].id == 0x080 && filters[1].id == 0x100
+					&& filters[1].mask == 0x1ffff97c
+					&& filters[1].flags_mask == 0xff,
+			"%zu filters after lossy merge", n);
+
+	for (int i = 0; i < 6; i++)
+		can_recv_destroy(recv[i]);
+	can_net_set_filter_func(net, NULL, NULL);
+}
+
+void
+can_filter(void *data)
+{
+	(void)data;
+
+	filter_count++;
+}
+
+int
+can_timer(const struct timespec *tp, void *data)
+{
+	int i = (int)(uintptr_t)data;
+
+	if (cur_trace->n < MAX_EVENTS)
+		cur_trace->ev[cur_trace->n++] = (struct timer_event){ i, *tp };
+
+	// Restart some of the timers, like a heartbeat consumer.
+	if (i % 4 == 1)
+		timer_restart(i);
+
+	return 0;
+}
+
+int
+can_next(const struct timespec *tp, void *data)
+{
+	(void)data;
+
+	// The timing wheel may report an earlier time than the heap, so only
+	// the fact that the next time was updated is recorded.
+	(void)tp;
+	if (cur_trace->n < MAX_EVENTS)
+		cur_trace->ev[cur_trace->n++] =
+				(struct timer_event){ -1, { 0, 0 } };
+
+	return 0;
+}
+
+static int
+timer_trace_equal(const struct timer_trace *t1, const struct timer_trace *t2)
+{
+	if (t1->n != t2->n)
+		return 0;
+	for (size_t i = 0; i < t1->n; i++) {
+		if (t1->ev[i].i != t2->ev[i].i
+				|| timespec_cmp(&t1->ev[i].tp, &t2->ev[i].tp))
+			return 0;
+	}
+	return 1;
+}
+
+static uint_least32_t
+timer_rand(void)
+{
+	timer_seed = timer_seed * 1103515245u + 12345u;
+	return (timer_seed >> 8) & 0xffffff;
+}
+
+static void
+timer_restart(int i)
+{
+	// Use random times with nanosecond resolution to prevent timers from
+	// triggering at the same time, since the order of those timers is
+	// unspecified.
+	struct timespec start = { 0, 0 };
+	can_net_get_time(timer_net, &start);
+	timespec_add_nsec(&start, timer_rand() * 64u + timer_rand() % 64u);
+	can_timer_start(timers[i], timer_net, &start, NULL);
+}
+
+static void
+test_timer(can_net_t *net, struct timer_trace *trace)
+{
+	memset(trace, 0, sizeof(*trace));
+	cur_trace = trace;
+	timer_net = net;
+	timer_seed = 1;
+
+	can_net_set_next_func(net, &can_next, NULL);
+
+	for (int i = 0; i < NUM_TIMERS; i++) {
+		timers[i] = can_timer_create(can_net_get_alloc(net));
+		tap_assert(timers[i]);
+		can_timer_set_func(timers[i], &can_timer, (void *)(uintptr_t)i);
+
+		struct timespec start = { 0, 0 };
+		timespec_add_nsec(&start,
+				timer_rand() * 64u + timer_rand() % 64u);
+		if (i % 4 == 0) {
+			struct timespec interval = { 0, 0 };
+			timespec_add_nsec(&interval,
+					1000 + timer_rand() * 32u
+							+ timer_rand() % 32u);
+			can_timer_start(timers[i], net, &start, &interval);
+		} else {
+			can_timer_start(timers[i], net, &start, NULL);
+		}
+	}
+
+	struct timespec now = { 0, 0 };
+	for (int i = 0; i < NUM_STEPS; i++) {
+		if (i % 1024 == 1023) {
+			// Jump far ahead.
+			now.tv_sec += 100;
+		} else if (i % 512 == 511) {
+			// Move the time backwards.
+			timespec_sub_msec(&now, 10);
+		} else {
+			timespec_add_usec(&now, timer_rand() % 50000u);
+		}
+		can_net_set_time(net, &now);
+
+		// Restart a random timer, like a heartbeat consumer.
+		int j = timer_rand() % NUM_TIMERS;
+		if (j % 4)
+			timer_restart(j);
+	}
+
+	for (int i = 0; i < NUM_TIMERS; i++)
+		can_timer_destroy(timers[i]);
+}
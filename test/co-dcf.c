@@ -0,0 +1,210 @@
+#include "test.h"
+#include <lely/co/dcf.h>
+#include <lely/co/obj.h>
+#include <lely/co/val.h>
+#include <lely/util/cmp.h>
+#include <lely/util/config.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *const files[] = { "co-emcy.dcf", "co-gw_txt-master.dcf",
+	"co-gw_txt-slave.dcf", "co-nmt-slave.dcf", "co-pdo-receive.dcf",
+	"co-pdo-transmit.dcf", "co-sdev.dcf", "co-sdo-client.dcf",
+	"co-sdo-server.dcf", "co-sync.dcf", "co-time.dcf",
+	"coapp-fiber-master.dcf", "coapp-fiber-slave.dcf",
+	"coapp-lss-master.dcf", "coapp-lss-slave.dcf" };
+
+#define NUM_FILES (sizeof(files) / sizeof(*files))
+
+// A DCF exercising the corner cases of the lexer: sections and keys in a
+// different case, duplicate sections and keys, quoted strings, sub-object
+// sections before their object and compact sub-objects with explicit names and
+// values.
+static const char text[] = "[deviceinfo]\n"
+			   "VendorName=\"Lely Industries N.V.\"\n"
+			   "vendornumber=0x00000360\n"
+			   "BaudRate_250=1\n"
+			   "[DeviceComissioning]\n"
+			   "NodeID=2\n"
+			   "[MandatoryObjects]\n"
+			   "SupportedObjects=2\n"
+			   "1=0x1000\n"
+			   "2=0x1001\n"
+			   "[ManufacturerObjects]\n"
+			   "SupportedObjects=2\n"
+			   "1=0x2000\n"
+			   "2=0x2A00\n"
+			   "[2000sub1]\n"
+			   "ParameterName=Value 1\n"
+			   "DataType=0x0007\n"
+			   "AccessType=rw\n"
+			   "DefaultValue=$NODEID+0x100\n"
+			   "[1000]\n"
+			   "ParameterName=Device type\n"
+			   "DataType=0x0007\n"
+			   "AccessType=ro\n"
+			   "DefaultValue=1\n"
+			   "DefaultValue=2 ; the last value wins\n"
+			   "[1001]\n"
+			   "ParameterName=Error register\n"
+			   "DataType=0x0005\n"
+			   "AccessType=ro\n"
+			   "[2000]\n"
+			   "ParameterName=Record\n"
+			   "ObjectType=0x09\n"
+			   "SubNumber=2\n"
+			   "[2000SUB0]\n"
+			   "ParameterName=Highest sub-index supported\n"
+			   "DataType=0x0005\n"
+			   "AccessType=const\n"
+			   "[2000sub0]\n"
+			   "DefaultValue=1\n"
+			   "[2a00]\n"
+			   "ParameterName=Array\n"
+			   "ObjectType=0x08\n"
+			   "DataType=0x0009\n"
+			   "AccessType=rw\n"
+			   "CompactSubObj=3\n"
+			   "[2A00Name]\n"
+			   "NrOfEntries=1\n"
+			   "2=\"  Second \"\n"
+			   "[2A00Value]\n"
+			   "NrOfEntries=2\n"
+			   "1=one\n"
+			   "3=\"three\\tor so\"\n";
+
+static int co_dev_equal(const co_dev_t *dev1, const co_dev_t *dev2);
+
+int
+main(void)
+{
+	tap_plan(2 * NUM_FILES + 7);
+
+	for (size_t i = 0; i < NUM_FILES; i++) {
+		char filename[256];
+		snprintf(filename, sizeof(filename), "%s/%s", TEST_SRCDIR,
+				files[i]);
+
+		co_dev_t *dev = co_dev_create_from_dcf_file(filename);
+		tap_test(dev, "co_dev_create_from_dcf_file(\"%s\")", files[i]);
+
+		config_t *cfg = config_create(CONFIG_CASE);
+		tap_assert(cfg);
+		tap_assert(config_parse_ini_file(cfg, filename));
+		co_dev_t *cdev = co_dev_create_from_dcf_cfg(cfg);
+		tap_assert(cdev);
+		config_destroy(cfg);
+
+		tap_test(dev && co_dev_equal(dev, cdev),
+				"%s: loaders produce identical devices",
+				files[i]);
+
+		co_dev_destroy(cdev);
+		co_dev_destroy(dev);
+	}
+
+	co_dev_t *dev = co_dev_create_from_dcf_text(text, NULL, NULL);
+	tap_assert(dev);
+
+	config_t *cfg = config_create(CONFIG_CASE);
+	tap_assert(cfg);
+	tap_assert(config_parse_ini_text(cfg, text, NULL, NULL));
+	co_dev_t *cdev = co_dev_create_from_dcf_cfg(cfg);
+	tap_assert(cdev);
+	config_destroy(cfg);
+
+	tap_test(co_dev_equal(dev, cdev), "loaders produce identical devices");
+
+	tap_test(!str_cmp(co_dev_get_vendor_name(dev), "Lely Industries N.V."));
+	tap_test(co_dev_get_val_u32(dev, 0x1000, 0x00) == 2,
+			"the last value wins");
+	tap_test(co_dev_get_val_u32(dev, 0x2000, 0x01) == 0x102,
+			"$NODEID is added to the value");
+	tap_test(co_dev_get_val_u8(dev, 0x2000, 0x00) == 1,
+			"duplicate sections are merged");
+#if !LELY_NO_CO_OBJ_NAME
+	tap_test(!str_cmp(co_sub_get_name(co_dev_find_sub(dev, 0x2a00, 0x02)),
+				 "  Second "),
+			"quoted names are not trimmed");
+#else
+	tap_skip(0, "quoted names are not trimmed");
+#endif
+	const co_sub_t *sub = co_dev_find_sub(dev, 0x2a00, 0x03);
+	tap_test(sub
+					&& !str_cmp(*(char *const *)co_sub_get_val(
+								    sub),
+							"three\tor so"),
+			"escape sequences are expanded");
+
+	co_dev_destroy(cdev);
+	co_dev_destroy(dev);
+
+	return 0;
+}
+
+static int
+co_dev_equal(const co_dev_t *dev1, const co_dev_t *dev2)
+{
+	if (co_dev_get_id(dev1) != co_dev_get_id(dev2)
+			|| co_dev_get_netid(dev1) != co_dev_get_netid(dev2)
+			|| co_dev_get_vendor_id(dev1)
+					!= co_dev_get_vendor_id(dev2)
+			|| co_dev_get_baud(dev1) != co_dev_get_baud(dev2)
+			|| co_dev_get_dummy(dev1) != co_dev_get_dummy(dev2)
+			|| str_cmp(co_dev_get_vendor_name(dev1),
+					co_dev_get_vendor_name(dev2)))
+		return 0;
+
+	co_unsigned16_t maxidx = co_dev_get_idx(dev1, 0, NULL);
+	if (co_dev_get_idx(dev2, 0, NULL) != maxidx)
+		return 0;
+	co_unsigned16_t *idx = malloc(maxidx * sizeof(co_unsigned16_t));
+	tap_assert(idx);
+	co_dev_get_idx(dev1, maxidx, idx);
+
+	int result = 1;
+	for (size_t i = 0; result && i < maxidx; i++) {
+		const co_obj_t *obj1 = co_dev_find_obj(dev1, idx[i]);
+		const co_obj_t *obj2 = co_dev_find_obj(dev2, idx[i]);
+		if (!obj2 || co_obj_get_code(obj1) != co_obj_get_code(obj2)
+				|| str_cmp(co_obj_get_name(obj1),
+						co_obj_get_name(obj2))) {
+			result = 0;
+			break;
+		}
+
+		co_unsigned8_t subidx[0xff];
+		co_unsigned8_t maxsubidx = co_obj_get_subidx(obj1, 0xff, subidx);
+		if (co_obj_get_subidx(obj2, 0, NULL) != maxsubidx) {
+			result = 0;
+			break;
+		}
+		for (size_t j = 0; result && j < maxsubidx; j++) {
+			const co_sub_t *sub1 = co_obj_find_sub(obj1, subidx[j]);
+			const co_sub_t *sub2 = co_obj_find_sub(obj2, subidx[j]);
+			co_unsigned16_t type = co_sub_get_type(sub1);
+			// clang-format off
+			result = sub2 && co_sub_get_type(sub2) == type
+					&& co_sub_get_access(sub1)
+							== co_sub_get_access(sub2)
+					&& co_sub_get_pdo_mapping(sub1)
+							== co_sub_get_pdo_mapping(sub2)
+					&& co_sub_get_flags(sub1)
+							== co_sub_get_flags(sub2)
+					&& !str_cmp(co_sub_get_name(sub1),
+							co_sub_get_name(sub2))
+					&& !co_val_cmp(type,
+							co_sub_get_val(sub1),
+							co_sub_get_val(sub2))
+					&& !co_val_cmp(type,
+							co_sub_get_def(sub1),
+							co_sub_get_def(sub2));
+			// clang-format on
+		}
+	}
+
+	free(idx);
+
+	return result;
+}
@@ -0,0 +1,119 @@
+#include "test.h"
+#include <lely/co/dcf.h>
+#include <lely/co/obj.h>
+#include <lely/util/error.h>
+
+#include <stdio.h>
+#include <string.h>
+
+static const char *const files[] = { "co-emcy.dcf", "co-gw_txt-master.dcf",
+	"co-nmt-slave.dcf", "co-pdo-receive.dcf", "co-pdo-transmit.dcf",
+	"co-sdev.dcf", "co-sdo-client.dcf", "co-sdo-server.dcf" };
+
+#define NUM_FILES (sizeof(files) / sizeof(*files))
+
+// Checks that every (sub-)object can be found in a frozen object dictionary,
+// and that indices and sub-indices in between cannot.
+static int check_find(const co_dev_t *dev);
+
+int
+main(void)
+{
+	tap_plan(2 * NUM_FILES + 11);
+
+	for (size_t i = 0; i < NUM_FILES; i++) {
+		char filename[256];
+		snprintf(filename, sizeof(filename), "%s/%s", TEST_SRCDIR,
+				files[i]);
+
+		co_dev_t *dev = co_dev_create_from_dcf_file(filename);
+		tap_assert(dev);
+
+		tap_test(!co_dev_freeze(dev) && co_dev_is_frozen(dev),
+				"%s: co_dev_freeze()", files[i]);
+		tap_test(check_find(dev), "%s: frozen lookups", files[i]);
+
+		co_dev_destroy(dev);
+	}
+
+	char filename[256];
+	snprintf(filename, sizeof(filename), "%s/%s", TEST_SRCDIR,
+			"co-sdev.dcf");
+	co_dev_t *dev = co_dev_create_from_dcf_file(filename);
+	tap_assert(dev);
+	co_unsigned32_t vendor_id = co_dev_get_val_u32(dev, 0x1018, 0x01);
+	const char *name =
+			*(char *const *)co_dev_get_val(dev, 0x2009, 0x00);
+	tap_assert(name);
+
+	tap_test(!co_dev_freeze(dev));
+	tap_test(!co_dev_freeze(dev), "freezing twice succeeds");
+
+	tap_test(co_dev_get_val_u32(dev, 0x1018, 0x01) == vendor_id,
+			"values are preserved");
+	tap_test(!strcmp(*(char *const *)co_dev_get_val(dev, 0x2009, 0x00),
+				 name),
+			"strings are preserved");
+	tap_test(co_dev_set_val_u32(dev, 0x1018, 0x01, 0x12345678) == 4
+					&& co_dev_get_val_u32(dev, 0x1018, 0x01)
+							== 0x12345678,
+			"values can be modified");
+
+	co_obj_t *obj = co_obj_create(0x3000);
+	tap_assert(obj);
+	tap_test(co_dev_insert_obj(dev, obj) == -1
+					&& get_errnum() == ERRNUM_PERM,
+			"objects cannot be inserted");
+	co_sub_t *sub = co_sub_create(0x01, CO_DEFTYPE_UNSIGNED32);
+	tap_assert(sub);
+	tap_test(co_obj_insert_sub(co_dev_find_obj(dev, 0x1018), sub) == -1
+					&& get_errnum() == ERRNUM_PERM,
+			"sub-objects cannot be inserted");
+	tap_test(co_dev_remove_obj(dev, co_dev_find_obj(dev, 0x1018)) == -1,
+			"objects cannot be removed");
+
+	tap_test(!co_dev_thaw(dev) && !co_dev_is_frozen(dev));
+	tap_assert(!co_dev_insert_obj(dev, obj));
+	tap_assert(!co_obj_insert_sub(obj, sub));
+	tap_test(co_dev_get_val_u32(dev, 0x1018, 0x01) == 0x12345678
+					&& !strcmp(*(char *const *)co_dev_get_val(
+							   dev, 0x2009, 0x00),
+							name),
+			"values are preserved by co_dev_thaw()");
+
+	// Destroy the device while it is frozen.
+	tap_test(!co_dev_freeze(dev) && co_dev_find_sub(dev, 0x3000, 0x01));
+	co_dev_destroy(dev);
+
+	return 0;
+}
+
+static int
+check_find(const co_dev_t *dev)
+{
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj)) {
+		co_unsigned16_t idx = co_obj_get_idx(obj);
+		if (co_dev_find_obj(dev, idx) != obj)
+			return 0;
+		co_obj_t *next = co_obj_next(obj);
+		if (!next || co_obj_get_idx(next) != idx + 1) {
+			if (co_dev_find_obj(dev, idx + 1))
+				return 0;
+		}
+		for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+				sub = co_sub_next(sub)) {
+			co_unsigned8_t subidx = co_sub_get_subidx(sub);
+			if (co_obj_find_sub(obj, subidx) != sub
+					|| co_dev_find_sub(dev, idx, subidx)
+							!= sub)
+				return 0;
+			co_sub_t *nsub = co_sub_next(sub);
+			if ((!nsub || co_sub_get_subidx(nsub) != subidx + 1)
+					&& subidx < 0xff
+					&& co_obj_find_sub(obj, subidx + 1))
+				return 0;
+		}
+	}
+	return !co_dev_find_obj(dev, 0) && !co_dev_find_sub(dev, 0xffff, 0xff);
+}
@@ -0,0 +1,102 @@
+#include "test.h"
+#include <lely/co/dev.h>
+#include <lely/co/obj.h>
+#include <lely/util/error.h>
+
+#include <string.h>
+
+#include "test-co-sdev-in-place.h"
+
+// Checks that every (sub-)object can be found in the pre-linked object
+// dictionary, in the order of the object and sub-object trees.
+static int check_find(const co_dev_t *dev);
+
+int
+main(void)
+{
+	tap_plan(15);
+
+	co_dev_t *dev = &test_co_sdev;
+
+	tap_test(co_dev_is_frozen(dev), "the device is frozen");
+	tap_test(check_find(dev), "lookups");
+	tap_test(co_dev_get_idx(dev, 0, NULL) == 3 + 26,
+			"all objects are present");
+	tap_test(!co_dev_find_obj(dev, 0x2017)
+					&& !co_dev_find_sub(dev, 0x1018, 0x05),
+			"missing objects are not found");
+
+	tap_test(co_dev_get_val_u32(dev, 0x1018, 0x01) == 0x00000360,
+			"UNSIGNED32 values can be read");
+	tap_test(co_dev_get_val_i8(dev, 0x2002, 0x00) == -0x7f,
+			"INTEGER8 values can be read");
+	tap_test(co_dev_get_val_i40(dev, 0x2012, 0x00)
+					== -INT64_C(0x7fffffffff),
+			"INTEGER40 values can be read");
+	tap_test(!strcmp(*(char *const *)co_dev_get_val(dev, 0x2009, 0x00),
+				 "Hello, World!"),
+			"VISIBLE_STRING values can be read");
+	tap_test(!*(void *const *)co_dev_get_val(dev, 0x201c, 0x00),
+			"empty OCTET_STRING values can be read");
+
+	tap_test(co_dev_set_val_u32(dev, 0x2007, 0x00, 0x12345678) == 4
+					&& co_dev_get_val_u32(dev, 0x2007, 0x00)
+							== 0x12345678,
+			"UNSIGNED32 values can be modified");
+	tap_test(co_dev_set_val_i40(dev, 0x2012, 0x00, -42)
+					== sizeof(co_integer40_t)
+					&& co_dev_get_val_i40(dev, 0x2012, 0x00)
+							== -42,
+			"INTEGER40 values can be modified");
+
+	co_obj_t obj;
+	tap_assert(co_obj_init(&obj, 0x3000, NULL, 0));
+	tap_test(co_dev_insert_obj(dev, &obj) == -1
+					&& get_errnum() == ERRNUM_PERM,
+			"objects cannot be inserted");
+	co_sub_t sub;
+	co_unsigned32_t val = 0;
+	tap_assert(co_sub_init(&sub, 0x05, CO_DEFTYPE_UNSIGNED32, &val));
+	tap_test(co_obj_insert_sub(co_dev_find_obj(dev, 0x1018), &sub) == -1
+					&& get_errnum() == ERRNUM_PERM,
+			"sub-objects cannot be inserted");
+	tap_test(co_dev_remove_obj(dev, co_dev_find_obj(dev, 0x1018)) == -1
+					&& get_errnum() == ERRNUM_PERM,
+			"objects cannot be removed");
+	tap_test(check_find(dev), "lookups after a failed insertion");
+
+	co_sub_fini(&sub);
+	co_obj_fini(&obj);
+
+	return 0;
+}
+
+static int
+check_find(const co_dev_t *dev)
+{
+	co_unsigned16_t idx[0x20];
+	co_unsigned16_t maxidx = co_dev_get_idx(dev, 0x20, idx);
+	if (maxidx > 0x20)
+		return 0;
+
+	size_t i = 0;
+	for (co_obj_t *obj = co_dev_first_obj(dev); obj;
+			obj = co_obj_next(obj), i++) {
+		if (i >= maxidx || co_obj_get_idx(obj) != idx[i])
+			return 0;
+		if (co_dev_find_obj(dev, idx[i]) != obj)
+			return 0;
+		int subidx = -1;
+		for (co_sub_t *sub = co_obj_first_sub(obj); sub;
+				sub = co_sub_next(sub)) {
+			if (co_sub_get_subidx(sub) <= subidx)
+				return 0;
+			subidx = co_sub_get_subidx(sub);
+			if (co_obj_find_sub(obj, subidx) != sub
+					|| co_dev_find_sub(dev, idx[i], subidx)
+							!= sub)
+				return 0;
+		}
+	}
+	return i == maxidx && !co_dev_find_obj(dev, 0);
+}
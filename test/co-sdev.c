@@ -10,7 +10,7 @@
 int
 main(void)
 {
-	tap_plan(3 * 25 + 6);
+	tap_plan(6 * 26 + 6);
 
 	co_dev_t *dev = co_dev_create_from_dcf_file(TEST_SRCDIR "/co-sdev.dcf");
 	tap_assert(dev);
@@ -46,6 +46,32 @@ main(void)
 					"!co_val_cmp(%04X, <dev>:%04X:%02X, <sdev>:%04X:%02X)",
 					type, idx[i], subidx[j], idx[i],
 					subidx[j]);
+#if !LELY_NO_CO_OBJ_LIMITS
+			// Catch limits printed without (or with the wrong) union
+			// member, such as CO_INTEGER40_MIN.
+			tap_test(!co_val_cmp(type, co_sub_get_min(sub),
+						 co_sub_get_min(ssub)),
+					"!co_val_cmp(%04X, <dev>:%04X:%02X.min, <sdev>:%04X:%02X.min)",
+					type, idx[i], subidx[j], idx[i],
+					subidx[j]);
+			tap_test(!co_val_cmp(type, co_sub_get_max(sub),
+						 co_sub_get_max(ssub)),
+					"!co_val_cmp(%04X, <dev>:%04X:%02X.max, <sdev>:%04X:%02X.max)",
+					type, idx[i], subidx[j], idx[i],
+					subidx[j]);
+#else
+			tap_skip(0, "LELY_NO_CO_OBJ_LIMITS");
+			tap_skip(0, "LELY_NO_CO_OBJ_LIMITS");
+#endif
+#if !LELY_NO_CO_OBJ_DEFAULT
+			tap_test(!co_val_cmp(type, co_sub_get_def(sub),
+						 co_sub_get_def(ssub)),
+					"!co_val_cmp(%04X, <dev>:%04X:%02X.def, <sdev>:%04X:%02X.def)",
+					type, idx[i], subidx[j], idx[i],
+					subidx[j]);
+#else
+			tap_skip(0, "LELY_NO_CO_OBJ_DEFAULT");
+#endif
 
 			char buf[256];
 			char *cp = buf;
@@ -0,0 +1,106 @@
+#include "test.h"
+#include <lely/co/dcf.h>
+#include <lely/co/obj.h>
+#include <lely/co/snap.h>
+#include <lely/util/cmp.h>
+#include <lely/util/endian.h>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FILENAME "co-snap.dat"
+
+static const char *const files[] = { "co-emcy.dcf", "co-gw_txt-master.dcf",
+	"co-gw_txt-slave.dcf", "co-nmt-slave.dcf", "co-pdo-receive.dcf",
+	"co-pdo-transmit.dcf", "co-sdev.dcf", "co-sdo-client.dcf",
+	"co-sdo-server.dcf", "co-sync.dcf", "co-time.dcf",
+	"coapp-fiber-master.dcf", "coapp-fiber-slave.dcf",
+	"coapp-lss-master.dcf", "coapp-lss-slave.dcf" };
+
+#define NUM_FILES (sizeof(files) / sizeof(*files))
+
+static uint_least8_t *write_snap(const co_dev_t *dev, size_t *psize);
+
+int
+main(void)
+{
+	tap_plan(2 * NUM_FILES + 7);
+
+	for (size_t i = 0; i < NUM_FILES; i++) {
+		char filename[256];
+		snprintf(filename, sizeof(filename), "%s/%s", TEST_SRCDIR,
+				files[i]);
+
+		co_dev_t *dev = co_dev_create_from_dcf_file(filename);
+		tap_assert(dev);
+		size_t size = 0;
+		uint_least8_t *snap = write_snap(dev, &size);
+
+		co_dev_t *sdev = co_dev_create_from_snap(snap, snap + size);
+		tap_test(sdev, "co_dev_create_from_snap(\"%s\")", files[i]);
+
+		// A device is restored exactly if its own snapshot is identical
+		// to the one it was loaded from.
+		size_t ssize = 0;
+		uint_least8_t *ssnap = sdev ? write_snap(sdev, &ssize) : NULL;
+		tap_test(ssnap && ssize == size && !memcmp(snap, ssnap, size),
+				"%s: snapshot round-trip", files[i]);
+
+		free(ssnap);
+		co_dev_destroy(sdev);
+		free(snap);
+		co_dev_destroy(dev);
+	}
+
+	char filename[256];
+	snprintf(filename, sizeof(filename), "%s/%s", TEST_SRCDIR,
+			"co-sdev.dcf");
+	co_dev_t *dev = co_dev_create_from_dcf_file(filename);
+	tap_assert(dev);
+
+	tap_test(!co_dev_write_snap_file(dev, FILENAME));
+	co_dev_t *sdev = co_dev_create_from_snap_file(FILENAME);
+	tap_test(sdev, "co_dev_create_from_snap_file()");
+	tap_test(sdev && !str_cmp(co_dev_get_vendor_name(dev),
+					 co_dev_get_vendor_name(sdev)));
+	co_dev_destroy(sdev);
+
+	size_t size = 0;
+	uint_least8_t *snap = write_snap(dev, &size);
+
+	tap_test(!co_dev_create_from_snap(snap, snap + size - 1),
+			"truncated snapshots are rejected");
+
+	snap[size - 1] ^= 0xff;
+	tap_test(!co_dev_create_from_snap(snap, snap + size),
+			"corrupt snapshots are rejected");
+	snap[size - 1] ^= 0xff;
+
+	stle_u16(snap + 4, CO_SNAP_VERSION + 1);
+	tap_test(!co_dev_create_from_snap(snap, snap + size),
+			"snapshots with a different version are rejected");
+	stle_u16(snap + 4, CO_SNAP_VERSION);
+
+	sdev = co_dev_create_from_snap(snap, snap + size);
+	tap_test(sdev && co_dev_get_val_u32(sdev, 0x1000, 0x00)
+					== co_dev_get_val_u32(dev, 0x1000, 0x00));
+	co_dev_destroy(sdev);
+
+	free(snap);
+	co_dev_destroy(dev);
+
+	return 0;
+}
+
+static uint_least8_t *
+write_snap(const co_dev_t *dev, size_t *psize)
+{
+	size_t size = co_dev_write_snap(dev, NULL, NULL);
+	tap_assert(size);
+	uint_least8_t *snap = malloc(size);
+	tap_assert(snap);
+	tap_assert(co_dev_write_snap(dev, snap, snap + size) == size);
+	*psize = size;
+	return snap;
+}
@@ -23,8 +23,19 @@ using namespace lely::canopen;
 class MySlave : public BasicSlave {
  public:
   using BasicSlave::BasicSlave;
+  using BasicSlave::OnWrite;
+
+  int
+  num_write() const noexcept {
+    return n_write_;
+  }
 
  private:
+  void
+  OnWrite(uint16_t idx, uint8_t subidx) noexcept override {
+    if (idx == 0x2002 && subidx == 0) n_write_++;
+  }
+
   void
   OnSync(uint8_t, const time_point&) noexcept override {
     uint32_t val = (*this)[0x2002][0];
@@ -35,6 +46,8 @@ class MySlave : public BasicSlave {
     // Echo the value back to the master on the next SYNC.
     (*this)[0x2002][0] = val;
   }
+
+  int n_write_{0};
 };
 
 class MyDriver : public FiberDriver {
@@ -49,6 +62,13 @@ class MyDriver : public FiberDriver {
     tap_test(val == (n_ > 3 ? n_ - 3 : 0));
   }
 
+  void
+  OnRpdoWrite(int num, const RpdoMappedObject* p,
+              ::std::size_t n) noexcept override {
+    tap_test(num == 1 && n == 1, "master: received RPDO %d", num);
+    for (; n; n--, p++) OnRpdoWrite(p->idx, p->subidx);
+  }
+
   void
   OnBoot(NmtState, char es, const ::std::string&) noexcept override {
     tap_test(!es, "master: slave #%d successfully booted", id());
@@ -104,7 +124,7 @@ class MyDriver : public FiberDriver {
 
 int
 main() {
-  tap_plan(2 + 3 + NUM_OP + 2 * (NUM_OP - 1) + 1);
+  tap_plan(2 + 7 + 3 + NUM_OP + 3 * (NUM_OP - 1) + 1);
 
   IoGuard io_guard;
   Context ctx;
@@ -119,12 +139,47 @@ main() {
   tap_test(schan.is_open(), "slave: opened virtual CAN channel");
   MySlave slave(stimer, schan, TEST_SRCDIR "/coapp-fiber-slave.dcf", "", 127);
 
+  // Resolve a typed handle to a local sub-object once and access it directly.
+  auto ref = slave.GetSubObjectRef<uint32_t>(0x2002, 0);
+  ref.Write(UINT32_C(0x12345678));
+  tap_test(slave.Read<uint32_t>(0x2002, 0) == UINT32_C(0x12345678),
+           "slave: wrote 2002:00 through a handle");
+  ref.Write(0);
+  tap_test(ref.Read() == 0, "slave: read 2002:00 through a handle");
+  tap_test(slave.num_write() == 2, "slave: handle writes issue a notification");
+  ::std::error_code ec;
+  tap_test(!slave.GetSubObjectRef<uint16_t>(0x2002, 0, ec) &&
+               ec == SdoErrc::TYPE_LEN,
+           "slave: handle creation checks the type");
+  slave.GetSubObjectRef<uint32_t>(0x1018, 1).Write(1, ec);
+  tap_test(ec == SdoErrc::NO_WRITE, "slave: handle writes check the access");
+  auto lim = slave.GetSubObjectRef<uint32_t>(0x2003, 0);
+#if !LELY_NO_CO_OBJ_LIMITS
+  lim.Write(0x100, ec);
+  tap_test(ec == SdoErrc::PARAM_HI && lim.Read() == 0,
+           "slave: handle writes check the limits");
+#else
+  tap_skip(0, "slave: handle writes check the limits");
+#endif
+  // A custom download indication function is invoked through the SDO path.
+  slave.OnWrite<uint32_t>(
+      0x2003, 0,
+      [](uint16_t, uint8_t, uint32_t& new_val, uint32_t) -> ::std::error_code {
+        new_val *= 2;
+        return {};
+      });
+  lim.Write(0x42);
+  tap_test(lim.Read() == 0x84,
+           "slave: handle writes invoke the custom indication function");
+
   Timer mtimer(poll, exec, CLOCK_MONOTONIC);
   VirtualCanChannel mchan(ctx, exec);
   mchan.open(ctrl);
   tap_test(mchan.is_open(), "master: opened virtual CAN channel");
   AsyncMaster master(mtimer, mchan, TEST_SRCDIR "/coapp-fiber-master.dcf", "",
                      1);
+  // Deliver RPDO write notifications once per PDO.
+  master.SetRpdoWriteBatching(true);
   MyDriver driver(exec, master, 127);
 
   slave.Reset();
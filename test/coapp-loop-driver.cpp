@@ -0,0 +1,196 @@
+#include "test.h"
+#include <lely/coapp/loop_driver.hpp>
+#include <lely/coapp/slave.hpp>
+#include <lely/ev/loop.hpp>
+#if _WIN32
+#include <lely/io2/win32/poll.hpp>
+#elif _POSIX_C_SOURCE >= 200112L
+#include <lely/io2/posix/poll.hpp>
+#else
+#error This file requires Windows or POSIX.
+#endif
+#include <lely/io2/sys/clock.hpp>
+#include <lely/io2/sys/io.hpp>
+#include <lely/io2/sys/timer.hpp>
+#include <lely/io2/vcan.hpp>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+using namespace lely::ev;
+using namespace lely::io;
+using namespace lely::canopen;
+
+#define NUM_THRD 2
+#define NUM_NET 2
+#define NUM_OP 4
+
+static ::std::thread::id main_id;
+
+// The number of drivers that have started their configuration.
+static ::std::atomic<int> num_config{0};
+// The number of drivers that have finished their deconfiguration.
+static ::std::atomic<int> num_done{0};
+
+class MyDriver : public LoopDriver {
+ public:
+  MyDriver(LoopDriverPool& pool, AsyncMaster& master, uint8_t id, int net)
+      : LoopDriver(pool, master, id), net_(net) {}
+
+  bool
+  overlapped() const noexcept {
+    return overlapped_;
+  }
+
+ private:
+  // Marks the driver as busy for the duration of an event handler. The strand
+  // of the driver guarantees that its handlers never run concurrently, even
+  // though the pool threads run the handlers of several drivers in parallel.
+  class Guard {
+   public:
+    explicit Guard(MyDriver& drv) : drv_(drv) {
+      if (drv_.busy_.exchange(true)) drv_.overlapped_ = true;
+    }
+
+    Guard(const Guard&) = delete;
+    Guard& operator=(const Guard&) = delete;
+
+    ~Guard() { drv_.busy_ = false; }
+
+   private:
+    MyDriver& drv_;
+  };
+
+  void
+  OnBoot(NmtState, char es, const ::std::string&) noexcept override {
+    Guard guard(*this);
+    tap_test(!es, "master #%d: slave #%d successfully booted", net_, id());
+    // Start SYNC production.
+    master[0x1006][0] = UINT32_C(100000);
+  }
+
+  void
+  OnConfig(::std::function<void(::std::error_code ec)> res) noexcept override {
+    Guard guard(*this);
+    tap_test(::std::this_thread::get_id() != main_id,
+             "master #%d: configuring slave #%d on a pool thread", net_, id());
+    try {
+      // Do not issue the SDO requests until every driver is being configured,
+      // so the blocking calls of the drivers overlap.
+      ++num_config;
+      for (int i = 0; i < 100 && num_config < NUM_NET; i++) USleep(10000);
+      tap_test(num_config == NUM_NET,
+               "master #%d: configuring concurrently with the other drivers",
+               net_);
+
+      // Wait() runs other tasks on the shared loop until the SDO completes.
+      Wait(AsyncWrite<::std::string>(0x2000, 0, "Hello, world!"));
+      auto value = Wait(AsyncRead<::std::string>(0x2000, 0));
+      tap_test(value == "Hello, world!");
+
+      // Sleep for 100 ms before reporting success.
+      USleep(100000);
+      res({});
+    } catch (SdoError& e) {
+      res(e.code());
+    }
+  }
+
+  void
+  OnDeconfig(
+      ::std::function<void(::std::error_code ec)> res) noexcept override {
+    Guard guard(*this);
+    tap_pass("master #%d: deconfiguring slave #%d", net_, id());
+    res({});
+  }
+
+  void
+  OnSync(uint8_t cnt, const time_point&) noexcept override {
+    Guard guard(*this);
+    if (n_ >= NUM_OP) return;
+    tap_pass("master #%d: sent SYNC #%d", net_, cnt);
+
+    // Initiate a clean shutdown once all drivers are done.
+    if (++n_ >= NUM_OP)
+      master.AsyncDeconfig(id()).submit(GetExecutor(), [&]() {
+        if (++num_done == NUM_NET) master.GetContext().shutdown();
+      });
+  }
+
+  int net_{0};
+  uint32_t n_{0};
+  ::std::atomic<bool> busy_{false};
+  bool overlapped_{false};
+};
+
+// A virtual CAN network with a master and a single slave.
+struct Network {
+  Network(Context& ctx, lely::io::Poll& poll, Executor exec,
+          LoopDriverPool& pool, int num)
+      : stimer(poll, exec, CLOCK_MONOTONIC),
+        schan(ctx, exec),
+        mtimer(poll, exec, CLOCK_MONOTONIC),
+        mchan(ctx, exec) {
+    schan.open(ctrl);
+    tap_test(schan.is_open(), "slave #%d: opened virtual CAN channel", num);
+    slave.reset(new BasicSlave(stimer, schan,
+                               TEST_SRCDIR "/coapp-fiber-slave.dcf", "", 127));
+
+    mchan.open(ctrl);
+    tap_test(mchan.is_open(), "master #%d: opened virtual CAN channel", num);
+    master.reset(new AsyncMaster(mtimer, mchan,
+                                 TEST_SRCDIR "/coapp-fiber-master.dcf", "", 1));
+
+    driver.reset(new MyDriver(pool, *master, 127, num));
+  }
+
+  VirtualCanController ctrl{clock_monotonic};
+  Timer stimer;
+  VirtualCanChannel schan;
+  ::std::unique_ptr<BasicSlave> slave;
+  Timer mtimer;
+  VirtualCanChannel mchan;
+  ::std::unique_ptr<AsyncMaster> master;
+  ::std::unique_ptr<MyDriver> driver;
+};
+
+int
+main() {
+  tap_plan(1 + NUM_NET * (2 + 1 + 3 + 1 + NUM_OP + 2));
+
+  main_id = ::std::this_thread::get_id();
+
+  IoGuard io_guard;
+  Context ctx;
+  lely::io::Poll poll(ctx);
+  Loop loop(poll.get_poll());
+  auto exec = loop.get_executor();
+
+  // The drivers of both networks run on strands on the shared event loop of
+  // the pool instead of in their own threads.
+  LoopDriverPool pool(NUM_THRD);
+  tap_test(pool.size() == NUM_THRD);
+
+  ::std::unique_ptr<Network> nets[NUM_NET];
+  for (int i = 0; i < NUM_NET; i++)
+    nets[i].reset(new Network(ctx, poll, exec, pool, i + 1));
+
+  for (auto& net : nets) {
+    net->slave->Reset();
+    net->master->Reset();
+  }
+
+  loop.run();
+
+  for (int i = 0; i < NUM_NET; i++) {
+    auto& driver = *nets[i]->driver;
+    driver.Join();
+    tap_test(driver.AsyncStoppped().is_ready(), "master #%d: driver stopped",
+             i + 1);
+    tap_test(!driver.overlapped(),
+             "master #%d: event handlers never overlapped", i + 1);
+  }
+
+  return 0;
+}
@@ -0,0 +1,86 @@
+#include "test.h"
+#include <lely/can/net.h>
+#include <lely/coapp/sdo.hpp>
+#include <lely/ev/loop.hpp>
+
+using namespace lely::ev;
+using namespace lely::canopen;
+
+#define NUM_REQ 8
+
+// The number of copies of a confirmation function that are still alive. This
+// drops below zero if a confirmation function is destroyed twice.
+static int num_live = 0;
+// The number of confirmations that have run.
+static int num_con = 0;
+// The number of confirmations that reported the cancellation.
+static int num_canceled = 0;
+
+// A member of every confirmation function, counting its copies.
+struct Tracker {
+  Tracker() noexcept { num_live++; }
+  Tracker(const Tracker&) noexcept { num_live++; }
+  Tracker& operator=(const Tracker&) = default;
+  ~Tracker() { num_live--; }
+};
+
+static void
+OnCon(::std::error_code ec) {
+  num_con++;
+  if (ec == SdoErrc::NO_SDO) num_canceled++;
+}
+
+int
+main() {
+  tap_plan(6);
+
+  Loop loop;
+  auto exec = loop.get_executor();
+
+  // Frames are discarded, so every request remains pending until the
+  // Client-SDO is destroyed.
+  can_net_t* net = can_net_create(nullptr);
+  tap_assert(net);
+  can_net_set_send_func(
+      net, [](const can_msg*, void*) { return 0; }, nullptr);
+
+  SdoFuture<uint32_t> f;
+  {
+    Sdo sdo(net, 2);
+
+    // Alternate downloads and uploads, so the pool of the Client-SDO holds
+    // requests of different sizes.
+    Tracker t;
+    for (int i = 0; i < NUM_REQ; i++) {
+      if (i % 2) {
+        sdo.SubmitDownload(exec, 0x2000, 0, static_cast<uint32_t>(i),
+                           [t](uint8_t, uint16_t, uint8_t,
+                               ::std::error_code ec) { OnCon(ec); });
+      } else {
+        sdo.SubmitUpload<uint32_t>(
+            exec, 0x2000, 0,
+            [t](uint8_t, uint16_t, uint8_t, ::std::error_code ec, uint32_t) {
+              OnCon(ec);
+            });
+      }
+    }
+    f = sdo.AsyncUpload<uint32_t>(exec, 0x2000, 0);
+
+    tap_test(!num_con, "confirmations are pending");
+  }
+  tap_test(num_live == NUM_REQ, "pending requests outlive the Client-SDO");
+
+  // Destroying the Client-SDO cancels all requests. The confirmations run, and
+  // the requests are freed, once the event loop executes them.
+  loop.run();
+
+  tap_test(num_con == NUM_REQ, "all confirmations ran");
+  tap_test(num_canceled == NUM_REQ, "all requests were canceled");
+  tap_test(f.is_ready() && f.get().has_error(), "the future is ready");
+  tap_test(!num_live,
+           "every confirmation function was destroyed exactly once");
+
+  can_net_destroy(net);
+
+  return 0;
+}
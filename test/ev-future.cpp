@@ -1,12 +1,15 @@
 #include "test.h"
 #include <lely/ev/future.hpp>
 #include <lely/ev/thrd_loop.hpp>
+#include <lely/util/sizepool.h>
+
+#include <cstddef>
 
 using namespace lely::ev;
 
 int
 main() {
-  tap_plan(8);
+  tap_plan(13);
 
   auto exec = ThreadLoop::get_executor();
 
@@ -29,5 +32,45 @@ main() {
   tap_test(f2.is_ready());
   tap_test(f2.get().value() == 0);
 
+  // A promise recycled from the thread-local cache starts out unsatisfied,
+  // with an empty shared state.
+  for (int i = 0; i < 2; i++) {
+    auto promise = ev_promise_create(sizeof(int), nullptr);
+    tap_assert(promise);
+    auto ptr = static_cast<int*>(ev_promise_data(promise));
+    auto future = ev_promise_get_future(promise);
+    if (!i) {
+      *ptr = 42;
+      tap_assert(ev_promise_set(promise, ptr));
+    } else {
+      tap_test(!ev_future_is_ready(future), "recycled promise is not ready");
+      tap_test(*ptr == 0, "recycled shared state is cleared");
+    }
+    ev_future_release(future);
+    ev_promise_release(promise);
+  }
+
+  // A promise can be allocated with a user-provided allocator.
+  sizepool_class classes[] = {SIZEPOOL_CLASS_INIT(256, 2)};
+  alignas(::std::max_align_t) char memory[512];
+  sizepool pool;
+  auto alloc = sizepool_init(&pool, memory, sizeof(memory), classes, 1);
+  tap_assert(alloc);
+
+  auto promise = ev_promise_create_with_alloc(alloc, sizeof(int), nullptr);
+  tap_test(promise && mem_size(alloc) > 0, "promise allocated from pool");
+  if (promise) {
+    int value = 42;
+    ev_promise_set(promise, &value);
+    auto future = ev_promise_get_future(promise);
+    tap_test(ev_future_is_ready(future) &&
+             *static_cast<int*>(ev_future_get(future)) == 42);
+    ev_future_release(future);
+    ev_promise_release(promise);
+  } else {
+    tap_fail();
+  }
+  tap_test(mem_size(alloc) == 0, "promise returned to pool");
+
   return 0;
 }
@@ -0,0 +1,70 @@
+#include "test.h"
+#include <lely/ev/exec.h>
+#include <lely/ev/loop.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace lely::ev;
+
+#define NUM_THRD 4
+#define NUM_OP (1024 * 1024 - 1)
+
+static ev_exec_t* exec;
+static ev_task tasks[NUM_OP];
+static ::std::atomic<::std::size_t> nop;
+
+// Every task submits two more tasks, until all tasks have been submitted, to
+// keep all threads busy.
+static void
+func(ev_task* task) {
+  ::std::size_t i = task - tasks;
+  if (2 * i + 1 < NUM_OP) ev_exec_post(exec, &tasks[2 * i + 1]);
+  if (2 * i + 2 < NUM_OP) ev_exec_post(exec, &tasks[2 * i + 2]);
+  // Release the outstanding work guard once all tasks have been executed.
+  if (++nop == NUM_OP) ev_exec_on_task_fini(exec);
+}
+
+static void
+run(Loop& loop) {
+  nop = 0;
+  for (auto& task : tasks) task = EV_TASK_INIT(exec, &func);
+
+  loop.restart();
+  ev_exec_on_task_init(exec);
+  ev_exec_post(exec, &tasks[0]);
+
+  auto t1 = ::std::chrono::high_resolution_clock::now();
+  ::std::vector<::std::thread> thrds;
+  for (int i = 0; i < NUM_THRD; i++)
+    thrds.emplace_back([&loop]() { loop.run(); });
+  for (auto& thr : thrds) thr.join();
+  auto t2 = ::std::chrono::high_resolution_clock::now();
+
+  tap_test(nop == NUM_OP);
+  tap_test(loop.stopped());
+
+  auto ns = ::std::chrono::nanoseconds(t2 - t1).count();
+  tap_diag("%f ns per op", double(ns) / NUM_OP);
+}
+
+int
+main() {
+  tap_plan(1 + 2 * 2);
+
+  Loop loop;
+  exec = loop.get_executor();
+
+  tap_diag("shared queue:");
+  run(loop);
+
+  loop.set_work_stealing(NUM_THRD);
+  tap_test(loop.get_work_stealing() == NUM_THRD);
+
+  tap_diag("work-stealing queues:");
+  run(loop);
+
+  return 0;
+}
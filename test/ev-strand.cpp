@@ -0,0 +1,105 @@
+#include "test.h"
+#include <lely/ev/loop.hpp>
+#include <lely/ev/strand.hpp>
+#include <lely/util/util.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace lely::ev;
+
+#define NUM_PROD 4
+#define NUM_CONS 2
+#define NUM_OP (256 * 1024)
+
+struct StrandTask {
+  ev_task task;
+  int prod;
+  int seq;
+};
+
+static ev_exec_t* loop_exec;
+static StrandTask tasks[NUM_PROD][NUM_OP];
+static int next_seq[NUM_PROD];
+static ::std::atomic<bool> running;
+static ::std::atomic<::std::size_t> nop;
+static ::std::size_t nerr;
+
+// The tasks of a strand are never executed concurrently, so neither the flag
+// nor the sequence numbers need to be protected. Any overlap or reordering is
+// counted as an error.
+static void
+func(ev_task* task) {
+  auto self = structof(task, StrandTask, task);
+  if (running.exchange(true)) nerr++;
+  if (self->seq != next_seq[self->prod]++) nerr++;
+  running = false;
+  // Release the outstanding work guard once all tasks have been executed.
+  if (++nop == NUM_PROD * NUM_OP) ev_exec_on_task_fini(loop_exec);
+}
+
+static int order[4];
+static int norder;
+
+static void
+order_func(ev_task* task) {
+  order[norder++] = structof(task, StrandTask, task)->seq;
+}
+
+int
+main() {
+  tap_plan(2 + 6);
+
+  Loop loop;
+  loop_exec = loop.get_executor();
+  Strand strand(loop.get_executor());
+
+  // Several producer threads post tasks to the same strand while several
+  // threads run the event loop.
+  for (int i = 0; i < NUM_PROD; i++) {
+    for (int j = 0; j < NUM_OP; j++)
+      tasks[i][j] = StrandTask{EV_TASK_INIT(strand, &func), i, j};
+  }
+  ev_exec_on_task_init(loop_exec);
+
+  auto t1 = ::std::chrono::high_resolution_clock::now();
+  ::std::vector<::std::thread> thrds;
+  for (int i = 0; i < NUM_CONS; i++)
+    thrds.emplace_back([&loop]() { loop.run(); });
+  for (int i = 0; i < NUM_PROD; i++) {
+    thrds.emplace_back([i]() {
+      for (int j = 0; j < NUM_OP; j++)
+        ev_exec_post(tasks[i][j].task.exec, &tasks[i][j].task);
+    });
+  }
+  for (auto& thr : thrds) thr.join();
+  auto t2 = ::std::chrono::high_resolution_clock::now();
+
+  tap_test(nop == NUM_PROD * NUM_OP);
+  tap_test(!nerr, "tasks are serialized in submission order");
+
+  auto ns = ::std::chrono::nanoseconds(t2 - t1).count();
+  tap_diag("%f ns per op", double(ns) / (NUM_PROD * NUM_OP));
+
+  // Aborting tasks from the front, the middle and the back of the queue.
+  StrandTask t[4];
+  for (int i = 0; i < 4; i++) t[i] = StrandTask{EV_TASK_INIT(strand, &order_func), 0, i};
+  loop.restart();
+  for (int i = 0; i < 3; i++) strand.post(t[i].task);
+  tap_test(strand.abort(t[1].task), "abort a task in the middle");
+  tap_test(!strand.abort(t[1].task), "abort a task that is not queued");
+  tap_test(strand.abort(t[2].task), "abort the last task");
+  strand.post(t[3].task);
+  tap_test(strand.abort(t[0].task), "abort the first task");
+  strand.post(t[0].task);
+  loop.run();
+  tap_test(norder == 2 && order[0] == 3 && order[1] == 0,
+           "remaining tasks are executed in order");
+
+  for (int i = 0; i < 3; i++) strand.post(t[i].task);
+  tap_test(strand.abort_all() == 3, "abort all tasks");
+
+  return 0;
+}
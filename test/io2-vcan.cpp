@@ -36,7 +36,7 @@ struct MyOp : public CoCanChannelRead {
 
 int
 main() {
-  tap_plan(4 + 2 * (NUM_OP + 1) + 1);
+  tap_plan(4 + 2 * (NUM_OP + 1) + 1 + 1);
 
   IoGuard io_guard;
   Context ctx;
@@ -56,6 +56,19 @@ main() {
   ctrl.restart();
   tap_test(!ctrl.stopped());
 
+  can_msg msgs[NUM_OP];
+  for (auto& msg : msgs) {
+    msg = CAN_MSG_INIT;
+    msg.id = 3;
+  }
+  struct io_can_chan_write write = IO_CAN_CHAN_WRITEV_INIT(
+      msgs, NUM_OP, loop.get_executor(), [](ev_task* task) noexcept {
+        auto write = io_can_chan_write_from_task(task);
+        tap_test(!write->errc && write->nwritten == write->n,
+                 "vectored write");
+      });
+  chan1.submit_write(write);
+
   MyOp op1(chan1, 1);
   chan1.submit_read(op1);
 
@@ -14,7 +14,7 @@
 int
 main(void)
 {
-	tap_plan(4);
+	tap_plan(7);
 
 	// clang-format off
 	static const uint_least8_t rev8[] = {
@@ -193,5 +193,71 @@ main(void)
 	}
 	tap_test(ok);
 
+	// The word-at-a-time kernels are checked against bcpybe() and bcpyle().
+	uint_least8_t buf[16];
+	uint_least8_t out[16];
+	for (size_t i = 0; i < sizeof(buf); i++)
+		buf[i] = (i * 0x9d + 0x37) & 0xff;
+	uint_least64_t w[2];
+
+	ok = 1;
+	ldbe_u64v(w, buf, sizeof(buf));
+	for (size_t n = 1; n <= 64 && ok; n++) {
+		for (size_t bit = 0; bit + n <= 8 * sizeof(buf) && ok; bit++) {
+			uint_least8_t tmp[8] = { 0 };
+			bcpybe(tmp, 0, buf, bit, n);
+			uint_least64_t x = ldbe_u64(tmp) >> (64 - n);
+			ok = bgetbe(w, bit, n) == x;
+
+			uint_least8_t chk2[16];
+			memcpy(chk2, buf, sizeof(chk2));
+			stbe_u64(tmp, ~x << (64 - n));
+			bcpybe(chk2, bit, tmp, 0, n);
+
+			uint_least64_t v[2] = { w[0], w[1] };
+			bsetbe(v, bit, ~x, n);
+			stbe_u64v(out, v, sizeof(out));
+			ok = ok && !memcmp(out, chk2, sizeof(out));
+		}
+	}
+	tap_test(ok, "bgetbe() and bsetbe() match bcpybe()");
+
+	ok = 1;
+	ldle_u64v(w, buf, sizeof(buf));
+	for (size_t n = 1; n <= 64 && ok; n++) {
+		for (size_t bit = 0; bit + n <= 8 * sizeof(buf) && ok; bit++) {
+			uint_least8_t tmp[8] = { 0 };
+			bcpyle(tmp, 0, buf, bit, n);
+			uint_least64_t x = ldle_u64(tmp);
+			ok = bgetle(w, bit, n) == x;
+
+			uint_least8_t chk2[16];
+			memcpy(chk2, buf, sizeof(chk2));
+			stle_u64(tmp, ~x);
+			bcpyle(chk2, bit, tmp, 0, n);
+
+			uint_least64_t v[2] = { w[0], w[1] };
+			bsetle(v, bit, ~x, n);
+			stle_u64v(out, v, sizeof(out));
+			ok = ok && !memcmp(out, chk2, sizeof(out));
+		}
+	}
+	tap_test(ok, "bgetle() and bsetle() match bcpyle()");
+
+	ok = 1;
+	for (size_t n = 0; n <= sizeof(buf) && ok; n++) {
+		memset(out, 0, sizeof(out));
+		ldbe_u64v(w, buf, n);
+		stbe_u64v(out, w, n);
+		ok = !memcmp(out, buf, n) && (n == sizeof(buf) || !out[n]);
+
+		memset(out, 0, sizeof(out));
+		ldle_u64v(w, buf, n);
+		stle_u64v(out, w, n);
+		ok = ok && !memcmp(out, buf, n)
+				&& (n == sizeof(buf) || !out[n]);
+	}
+	tap_test(ok, "partial words are loaded and stored");
+
 	return 0;
 }
@@ -24,6 +24,9 @@
 
 #include <lely/co/dcf.h>
 #include <lely/co/sdev.h>
+#if !LELY_NO_CO_SNAP
+#include <lely/co/snap.h>
+#endif
 #include <lely/compat/stdio.h>
 #include <lely/compat/unistd.h>
 #include <lely/util/diag.h>
@@ -36,13 +39,29 @@
 	"Arguments: [options...] filename <variable name>\n" \
 	"Options:\n" \
 	"  -h, --help            Display this information\n" \
+	"  --in-place            Define a pre-linked CANopen device (co_dev_t) that\n" \
+	"                        can be used in place instead of a static device\n" \
+	"                        description (struct co_sdev); requires\n" \
+	"                        LELY_NO_MALLOC\n" \
 	"  --no-strings          Do not include optional strings in the output\n" \
 	"  -o <file>, --output=<file>\n" \
-	"                        Write the output to <file> instead of stdout"
+	"                        Write the output to <file> instead of stdout" \
+	HELP_SNAP
+#if LELY_NO_CO_SNAP
+#define HELP_SNAP
+#else
+#define HELP_SNAP \
+	"\n" \
+	"  -s, --snapshot        Write a binary object dictionary snapshot to the\n" \
+	"                        output file instead of C code (see\n" \
+	"                        <lely/co/snap.h>); no variable name is needed"
+#endif
 // clang-format on
 
 #define FLAG_HELP 0x01
 #define FLAG_NO_STRINGS 0x02
+#define FLAG_SNAPSHOT 0x04
+#define FLAG_IN_PLACE 0x08
 
 int
 main(int argc, char *argv[])
@@ -75,8 +94,14 @@ main(int argc, char *argv[])
 				break;
 			if (!strcmp(arg, "help")) {
 				flags |= FLAG_HELP;
+			} else if (!strcmp(arg, "in-place")) {
+				flags |= FLAG_IN_PLACE;
 			} else if (!strcmp(arg, "no-strings")) {
 				flags |= FLAG_NO_STRINGS;
+#if !LELY_NO_CO_SNAP
+			} else if (!strcmp(arg, "snapshot")) {
+				flags |= FLAG_SNAPSHOT;
+#endif
 			} else if (!strncmp(arg, "output=", 7)) {
 				ofname = arg + 7;
 			} else {
@@ -84,7 +109,11 @@ main(int argc, char *argv[])
 						arg);
 			}
 		} else {
+#if LELY_NO_CO_SNAP
 			int c = getopt(argc, argv, ":ho:");
+#else
+			int c = getopt(argc, argv, ":ho:s");
+#endif
 			if (c == -1)
 				break;
 			switch (c) {
@@ -99,6 +128,9 @@ main(int argc, char *argv[])
 				break;
 			case 'h': flags |= FLAG_HELP; break;
 			case 'o': ofname = optarg; break;
+#if !LELY_NO_CO_SNAP
+			case 's': flags |= FLAG_SNAPSHOT; break;
+#endif
 			}
 		}
 	}
@@ -120,7 +152,17 @@ main(int argc, char *argv[])
 		goto error_arg;
 	}
 
-	if (optpos < 2 || !name) {
+	if ((flags & FLAG_SNAPSHOT) && (flags & FLAG_IN_PLACE)) {
+		diag(DIAG_ERROR, 0, "--snapshot and --in-place are incompatible");
+		goto error_arg;
+	}
+
+	if ((flags & FLAG_SNAPSHOT) && !ofname) {
+		diag(DIAG_ERROR, 0, "no output file specified");
+		goto error_arg;
+	}
+
+	if (!(flags & FLAG_SNAPSHOT) && (optpos < 2 || !name)) {
 		diag(DIAG_ERROR, 0, "no variable name specified");
 		goto error_arg;
 	}
@@ -144,13 +186,25 @@ main(int argc, char *argv[])
 	if (!dev)
 		goto errror_create_dev;
 
-	size_t n = snprintf_c99_sdev(NULL, 0, dev);
+#if !LELY_NO_CO_SNAP
+	if (flags & FLAG_SNAPSHOT) {
+		int result = co_dev_write_snap_file(dev, ofname);
+		co_dev_destroy(dev);
+		return result == -1 ? EXIT_FAILURE : EXIT_SUCCESS;
+	}
+#endif
+
+	size_t n = (flags & FLAG_IN_PLACE) ? snprintf_c99_dev(NULL, 0, dev, name)
+					   : snprintf_c99_sdev(NULL, 0, dev);
 	char *s = malloc(n + 1);
 	if (n && !s) {
 		diag(DIAG_ERROR, get_errc(), "unable to allocate string");
 		goto error_malloc_s;
 	}
-	snprintf_c99_sdev(s, n + 1, dev);
+	if (flags & FLAG_IN_PLACE)
+		snprintf_c99_dev(s, n + 1, dev, name);
+	else
+		snprintf_c99_sdev(s, n + 1, dev);
 
 	FILE *stream = stdout;
 	if (ofname) {
@@ -163,11 +217,23 @@ main(int argc, char *argv[])
 		}
 	}
 
-	fprintf(stream,
-			"#include <lely/co/sdev.h>\n\n"
-			"#define CO_SDEV_STRING(s)\t%s\n\n"
-			"const struct co_sdev %s = %s;\n\n",
-			(flags & FLAG_NO_STRINGS) ? "NULL" : "s", name, s);
+	if (flags & FLAG_IN_PLACE)
+		fprintf(stream,
+				"#include <lely/co/detail/dev.h>\n"
+				"#include <lely/co/detail/obj.h>\n"
+				"#include <lely/util/cmp.h>\n\n"
+				"#if !LELY_NO_MALLOC\n"
+				"#error In-place object dictionaries require LELY_NO_MALLOC.\n"
+				"#endif\n\n"
+				"#define CO_DEV_STRING(s)\t%s\n\n%s\n",
+				(flags & FLAG_NO_STRINGS) ? "NULL" : "s", s);
+	else
+		fprintf(stream,
+				"#include <lely/co/sdev.h>\n\n"
+				"#define CO_SDEV_STRING(s)\t%s\n\n"
+				"const struct co_sdev %s = %s;\n\n",
+				(flags & FLAG_NO_STRINGS) ? "NULL" : "s", name,
+				s);
 
 	if (ofname)
 		fclose(stream);
@@ -27,6 +27,8 @@
 #include <CppUTest/TestHarness.h>
 
 #include <lely/can/net.h>
+#include <lely/util/error.h>
+#include <lely/util/time.h>
 
 #include <libtest/allocators/default.hpp>
 #include <libtest/allocators/limited.hpp>
@@ -90,6 +92,29 @@ TEST(CAN_NetAllocation, CanNetCreate_Nominal) {
   POINTERS_EQUAL(nullptr, sdata);
 }
 
+/// @name can_net_set_timer_queue()
+///@{
+
+/// \Given a pointer to the network (can_net_t) created with a limited
+///        allocator with no memory left
+///
+/// \When can_net_set_timer_queue() is called with CAN_NET_TIMER_QUEUE_WHEEL
+///
+/// \Then -1 is returned, the timer queue is not changed
+TEST(CAN_NetAllocation, CanNetSetTimerQueue_NoMemoryAvailable) {
+  allocator.LimitAllocationTo(can_net_sizeof());
+  net = can_net_create(allocator.ToAllocT());
+  CHECK(net != nullptr);
+
+  const auto ret = can_net_set_timer_queue(net, CAN_NET_TIMER_QUEUE_WHEEL);
+
+  CHECK_EQUAL(-1, ret);
+  CHECK_EQUAL(ERRNUM_NOMEM, get_errnum());
+  CHECK_EQUAL(CAN_NET_TIMER_QUEUE_HEAP, can_net_get_timer_queue(net));
+}
+
+///@}
+
 TEST_GROUP(CAN_Net) {
   Allocators::Default allocator;
   can_net_t* net = nullptr;
@@ -595,6 +620,254 @@ TEST(CAN_Net, CanNetRecv_RecvFuncError) {
   can_recv_destroy(recv3);
 }
 
+/// \Given a pointer to the network (can_net_t) with a receiver started with
+///        can_recv_start_mask() for a range of base-format CAN identifiers
+///
+/// \When can_net_recv() is called with CAN messages inside and outside the
+///       range
+///
+/// \Then 0 is returned, the receiver callback is only called for the messages
+///       inside the range
+TEST(CAN_Net, CanNetRecv_Mask) {
+  CAN_Net_Static::rfunc_empty_counter = 0;
+  can_recv_t* const recv = can_recv_create(allocator.ToAllocT());
+  can_recv_set_func(recv, recv_func_empty, nullptr);
+  can_recv_start_mask(recv, net, 0x080u, 0x780u, 0, 0xffu);
+
+  can_msg msg = CAN_MSG_INIT;
+  for (const uint_least32_t id : {0x080u, 0x0ffu, 0x100u, 0x07fu}) {
+    msg.id = id;
+    CHECK_EQUAL(0, can_net_recv(net, &msg));
+  }
+  msg.id = 0x081u;
+  msg.flags = CAN_FLAG_IDE;
+  CHECK_EQUAL(0, can_net_recv(net, &msg));
+
+  CHECK_EQUAL(2u, CAN_Net_Static::rfunc_empty_counter);
+
+  can_recv_destroy(recv);
+}
+
+/// \Given a pointer to the network (can_net_t) with a receiver started with
+///        can_recv_start_mask() with an empty flags mask and a receiver started
+///        with can_recv_start() for the same CAN identifier
+///
+/// \When can_net_recv() is called with an extended-format CAN message
+///
+/// \Then -1 is returned, both receiver callbacks are called
+TEST(CAN_Net, CanNetRecv_MaskAndExact) {
+  CAN_Net_Static::rfunc_empty_counter = 0;
+  CAN_Net_Static::rfunc_err_counter = 0;
+  can_recv_t* const recv1 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv2 = can_recv_create(allocator.ToAllocT());
+  can_recv_set_func(recv1, recv_func_empty, nullptr);
+  can_recv_set_func(recv2, recv_func_err, nullptr);
+  can_recv_start_mask(recv1, net, 0x1000u, 0x1f000u, 0, 0);
+  can_recv_start(recv2, net, 0x1234u, CAN_FLAG_IDE);
+
+  can_msg msg = CAN_MSG_INIT;
+  msg.id = 0x1234u;
+  msg.flags = CAN_FLAG_IDE;
+  const auto ret = can_net_recv(net, &msg);
+
+  CHECK_EQUAL(-1, ret);
+  CHECK_EQUAL(1u, CAN_Net_Static::rfunc_empty_counter);
+  CHECK_EQUAL(1u, CAN_Net_Static::rfunc_err_counter);
+
+  can_recv_destroy(recv1);
+  can_recv_destroy(recv2);
+}
+
+///@}
+
+/// @name can_net_set_recv_lookup()
+///@{
+
+/// \Given a pointer to the network (can_net_t)
+///
+/// \When can_net_get_recv_lookup() is called
+///
+/// \Then CAN_NET_RECV_LOOKUP_TREE is returned
+TEST(CAN_Net, CanNetGetRecvLookup_Default) {
+  CHECK_EQUAL(CAN_NET_RECV_LOOKUP_TREE, can_net_get_recv_lookup(net));
+}
+
+/// \Given a pointer to the network (can_net_t)
+///
+/// \When can_net_set_recv_lookup() is called with an invalid strategy
+///
+/// \Then -1 is returned, the lookup strategy is not changed
+TEST(CAN_Net, CanNetSetRecvLookup_Invalid) {
+  const auto ret = can_net_set_recv_lookup(
+      net, static_cast<can_net_recv_lookup>(CAN_NET_RECV_LOOKUP_TABLE + 1));
+
+  CHECK_EQUAL(-1, ret);
+  CHECK_EQUAL(CAN_NET_RECV_LOOKUP_TREE, can_net_get_recv_lookup(net));
+}
+
+/// \Given a pointer to the network (can_net_t) with receivers for an 11-bit
+///        and a 29-bit CAN identifier
+///
+/// \When can_net_set_recv_lookup() is called with CAN_NET_RECV_LOOKUP_TABLE
+///       and CAN_NET_RECV_LOOKUP_TREE, and a frame is received for each
+///       identifier after every change
+///
+/// \Then 0 is returned, all receivers are moved and still invoked
+TEST(CAN_Net, CanNetSetRecvLookup_MovesReceivers) {
+  can_recv_t* const recv1 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv2 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv3 = can_recv_create(allocator.ToAllocT());
+  can_recv_set_func(recv1, recv_func_empty, nullptr);
+  can_recv_set_func(recv2, recv_func_empty, nullptr);
+  can_recv_set_func(recv3, recv_func_empty, nullptr);
+  can_recv_start(recv1, net, 0x701u, 0);
+  can_recv_start(recv2, net, 0x701u, 0);
+  can_recv_start(recv3, net, 0x1234567u, CAN_FLAG_IDE);
+
+  can_msg msg1 = CAN_MSG_INIT;
+  msg1.id = 0x701u;
+  can_msg msg2 = CAN_MSG_INIT;
+  msg2.id = 0x1234567u;
+  msg2.flags = CAN_FLAG_IDE;
+
+  CAN_Net_Static::rfunc_empty_counter = 0;
+  CHECK_EQUAL(0, can_net_set_recv_lookup(net, CAN_NET_RECV_LOOKUP_TABLE));
+  CHECK_EQUAL(CAN_NET_RECV_LOOKUP_TABLE, can_net_get_recv_lookup(net));
+  CHECK_EQUAL(0, can_net_recv(net, &msg1));
+  CHECK_EQUAL(0, can_net_recv(net, &msg2));
+  CHECK_EQUAL(3u, CAN_Net_Static::rfunc_empty_counter);
+
+  can_recv_stop(recv1);
+  CHECK_EQUAL(0, can_net_recv(net, &msg1));
+  CHECK_EQUAL(4u, CAN_Net_Static::rfunc_empty_counter);
+
+  CHECK_EQUAL(0, can_net_set_recv_lookup(net, CAN_NET_RECV_LOOKUP_TREE));
+  CHECK_EQUAL(CAN_NET_RECV_LOOKUP_TREE, can_net_get_recv_lookup(net));
+  CHECK_EQUAL(0, can_net_recv(net, &msg1));
+  CHECK_EQUAL(0, can_net_recv(net, &msg2));
+  CHECK_EQUAL(6u, CAN_Net_Static::rfunc_empty_counter);
+
+  can_recv_destroy(recv1);
+  can_recv_destroy(recv2);
+  can_recv_destroy(recv3);
+}
+
+///@}
+
+/// @name can_net_set_timer_queue()
+///@{
+
+/// \Given a pointer to the network (can_net_t)
+///
+/// \When can_net_get_timer_queue() is called
+///
+/// \Then CAN_NET_TIMER_QUEUE_HEAP is returned
+TEST(CAN_Net, CanNetGetTimerQueue_Default) {
+  CHECK_EQUAL(CAN_NET_TIMER_QUEUE_HEAP, can_net_get_timer_queue(net));
+}
+
+/// \Given a pointer to the network (can_net_t)
+///
+/// \When can_net_set_timer_queue() is called with an invalid timer queue
+///
+/// \Then -1 is returned, the timer queue is not changed
+TEST(CAN_Net, CanNetSetTimerQueue_Invalid) {
+  const auto ret = can_net_set_timer_queue(
+      net, static_cast<can_net_timer_queue>(CAN_NET_TIMER_QUEUE_WHEEL + 1));
+
+  CHECK_EQUAL(-1, ret);
+  CHECK_EQUAL(CAN_NET_TIMER_QUEUE_HEAP, can_net_get_timer_queue(net));
+}
+
+/// \Given a pointer to the network (can_net_t) with three timers
+///
+/// \When can_net_set_timer_queue() is called with CAN_NET_TIMER_QUEUE_WHEEL
+///       and CAN_NET_TIMER_QUEUE_HEAP, and the time is set after each change
+///
+/// \Then 0 is returned, all timers are moved and still invoked
+TEST(CAN_Net, CanNetSetTimerQueue_MovesTimers) {
+  const timespec tstart1 = {0, 500000000L};
+  const timespec tstart2 = {1, 0L};
+  const timespec tstart3 = {10, 0L};
+  can_timer_t* const timer1 = can_timer_create(allocator.ToAllocT());
+  can_timer_t* const timer2 = can_timer_create(allocator.ToAllocT());
+  can_timer_t* const timer3 = can_timer_create(allocator.ToAllocT());
+  can_timer_set_func(timer1, timer_func_empty, nullptr);
+  can_timer_set_func(timer2, timer_func_empty, nullptr);
+  can_timer_set_func(timer3, timer_func_empty, nullptr);
+  can_timer_start(timer1, net, &tstart1, nullptr);
+  can_timer_start(timer2, net, &tstart2, nullptr);
+  can_timer_start(timer3, net, &tstart3, nullptr);
+
+  CHECK_EQUAL(0, can_net_set_timer_queue(net, CAN_NET_TIMER_QUEUE_WHEEL));
+  CHECK_EQUAL(CAN_NET_TIMER_QUEUE_WHEEL, can_net_get_timer_queue(net));
+  const timespec tp1 = {0, 999999999L};
+  CHECK_EQUAL(0, can_net_set_time(net, &tp1));
+  CHECK_EQUAL(1, CAN_Net_Static::tfunc_empty_counter);
+
+  can_timer_stop(timer2);
+  CHECK_EQUAL(0, can_net_set_timer_queue(net, CAN_NET_TIMER_QUEUE_HEAP));
+  CHECK_EQUAL(CAN_NET_TIMER_QUEUE_HEAP, can_net_get_timer_queue(net));
+  const timespec tp2 = {10, 0L};
+  CHECK_EQUAL(0, can_net_set_time(net, &tp2));
+  CHECK_EQUAL(2, CAN_Net_Static::tfunc_empty_counter);
+
+  can_timer_destroy(timer1);
+  can_timer_destroy(timer2);
+  can_timer_destroy(timer3);
+}
+
+/// \Given a pointer to the network (can_net_t) using a timing wheel with two
+///        timers in the same tick and a periodic timer, and the next timer
+///        callback set
+///
+/// \When can_net_set_time() is called with a time between the timers
+///
+/// \Then 0 is returned, only the timers with a start time not later than the
+///       new time are invoked and the next timer callback is called with a
+///       time not later than the start time of the next timer, and equal to
+///       it once the tick of the timer has been reached
+TEST(CAN_Net, CanNetSetTimerQueue_Wheel) {
+  CHECK_EQUAL(0, can_net_set_timer_queue(net, CAN_NET_TIMER_QUEUE_WHEEL));
+
+  timespec next = {0, 0L};
+  can_net_set_next_func(
+      net,
+      [](const timespec* tp, void* data) {
+        *static_cast<timespec*>(data) = *tp;
+        return 0;
+      },
+      &next);
+
+  const timespec tstart1 = {2, 100L};
+  const timespec tstart2 = {2, 200L};
+  const timespec tstart3 = {1, 0L};
+  const timespec interval = {1, 0L};
+  can_timer_t* const timer1 = can_timer_create(allocator.ToAllocT());
+  can_timer_t* const timer2 = can_timer_create(allocator.ToAllocT());
+  can_timer_t* const timer3 = can_timer_create(allocator.ToAllocT());
+  can_timer_set_func(timer1, timer_func_empty, nullptr);
+  can_timer_set_func(timer2, timer_func_empty, nullptr);
+  can_timer_set_func(timer3, timer_func_empty, nullptr);
+  can_timer_start(timer2, net, &tstart2, nullptr);
+  can_timer_start(timer1, net, &tstart1, nullptr);
+  CHECK_COMPARE(timespec_cmp(&next, &tstart1), <=, 0);
+  can_timer_start(timer3, net, &tstart3, &interval);
+  CHECK_COMPARE(timespec_cmp(&next, &tstart3), <=, 0);
+
+  const timespec tp = {2, 150L};
+  const auto ret = can_net_set_time(net, &tp);
+
+  CHECK_EQUAL(0, ret);
+  CHECK_EQUAL(3, CAN_Net_Static::tfunc_empty_counter);
+  CHECK_EQUAL(2, next.tv_sec);
+  CHECK_EQUAL(200L, next.tv_nsec);
+
+  can_timer_destroy(timer1);
+  can_timer_destroy(timer2);
+  can_timer_destroy(timer3);
+}
+
 ///@}
 
 /// @name can_net_send()
@@ -632,6 +905,111 @@ TEST(CAN_Net, CanNetSend_Err) {
 
 ///@}
 
+/// @name can_net_get_filters()
+///@{
+
+/// \Given a pointer to the network (can_net_t) with two receivers started for
+///        the same CAN identifier and a masked receiver
+///
+/// \When can_net_get_filters() is called with an array that is too small
+///
+/// \Then 2 is returned, only the first filter is stored
+TEST(CAN_Net, CanNetGetFilters_Nominal) {
+  can_recv_t* const recv1 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv2 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv3 = can_recv_create(allocator.ToAllocT());
+  can_recv_start(recv1, net, 0x181u, 0);
+  can_recv_start(recv2, net, 0x181u, 0);
+  can_recv_start_mask(recv3, net, 0x080u, 0x780u, 0, 0);
+
+  can_net_filter filters[1];
+  const auto ret = can_net_get_filters(net, filters, 1u);
+
+  CHECK_EQUAL(2u, ret);
+  CHECK_EQUAL(0x181u, filters[0].id);
+  CHECK_EQUAL(CAN_MASK_EID, filters[0].mask);
+  CHECK_EQUAL(0, filters[0].flags);
+  CHECK_EQUAL(0xffu, filters[0].flags_mask);
+
+  can_recv_destroy(recv1);
+  can_recv_destroy(recv2);
+  can_recv_destroy(recv3);
+}
+
+///@}
+
+/// @name can_net_compact_filters()
+///@{
+
+/// \Given an array of filters for consecutive CAN identifiers and a duplicate
+///
+/// \When can_net_compact_filters() is called without a maximum
+///
+/// \Then 1 is returned, the filters are merged into a single masked filter
+TEST(CAN_Net, CanNetCompactFilters_Lossless) {
+  can_net_filter filters[5];
+  for (uint_least32_t i = 0; i < 4u; i++)
+    filters[i] = {0x184u + i, CAN_MASK_EID, 0, 0xffu};
+  filters[4] = filters[2];
+
+  const auto ret = can_net_compact_filters(filters, 5u, 0);
+
+  CHECK_EQUAL(1u, ret);
+  CHECK_EQUAL(0x184u, filters[0].id);
+  CHECK_EQUAL(CAN_MASK_EID & ~0x3u, filters[0].mask);
+  CHECK_EQUAL(0xffu, filters[0].flags_mask);
+}
+
+/// \Given an array of filters for unrelated CAN identifiers
+///
+/// \When can_net_compact_filters() is called with a maximum of 1
+///
+/// \Then 1 is returned, the filter accepts all original CAN identifiers
+TEST(CAN_Net, CanNetCompactFilters_Max) {
+  can_net_filter filters[3] = {{0x181u, CAN_MASK_EID, 0, 0xffu},
+                               {0x202u, CAN_MASK_EID, 0, 0xffu},
+                               {0x5ffu, CAN_MASK_EID, 0, 0xffu}};
+
+  const auto ret = can_net_compact_filters(filters, 3u, 1u);
+
+  CHECK_EQUAL(1u, ret);
+  for (const uint_least32_t id : {0x181u, 0x202u, 0x5ffu})
+    CHECK_EQUAL(filters[0].id & filters[0].mask, id & filters[0].mask);
+  CHECK_EQUAL(0xffu, filters[0].flags_mask);
+}
+
+///@}
+
+/// @name can_net_set_filter_func()
+///@{
+
+/// \Given a pointer to the network (can_net_t) with a filter function set
+///
+/// \When receivers are started and stopped
+///
+/// \Then the filter function is only called when the first receiver for a
+///       CAN identifier is started or the last one is stopped
+TEST(CAN_Net, CanNetSetFilterFunc_Nominal) {
+  can_recv_t* const recv1 = can_recv_create(allocator.ToAllocT());
+  can_recv_t* const recv2 = can_recv_create(allocator.ToAllocT());
+  unsigned int counter = 0;
+  can_net_set_filter_func(
+      net, [](void* data) { ++*static_cast<unsigned int*>(data); }, &counter);
+
+  can_recv_start(recv1, net, 0x181u, 0);
+  can_recv_start(recv2, net, 0x181u, 0);
+  CHECK_EQUAL(1u, counter);
+  can_recv_stop(recv1);
+  CHECK_EQUAL(1u, counter);
+  can_recv_stop(recv2);
+  CHECK_EQUAL(2u, counter);
+
+  can_recv_destroy(recv1);
+  can_recv_destroy(recv2);
+}
+
+///@}
+
 namespace CAN_NetTimer_Static {
 static unsigned int timer_func_counter = 0;
 }
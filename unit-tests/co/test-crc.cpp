@@ -153,4 +153,42 @@ TEST(CO_Crc, VerifyCRC_CiA301) {
   CHECK_EQUAL(0x31c3u, crc);
 }
 
+/// \Given the initial CRC `0x0000`
+///
+/// \When co_crc() is called with a buffer of characters
+///       `"123456789123456789"`, which is longer than the number of bytes
+///       processed per iteration
+///
+/// \Then `0xedc6` is returned
+TEST(CO_Crc, VerifyCRC_Long) {
+  const size_t BUF_SIZE = 18u;
+  const uint_least8_t buf[BUF_SIZE] = {'1', '2', '3', '4', '5', '6',
+                                       '7', '8', '9', '1', '2', '3',
+                                       '4', '5', '6', '7', '8', '9'};
+
+  const auto crc = co_crc(0x0000u, buf, BUF_SIZE);
+
+  CHECK_EQUAL(0xedc6u, crc);
+}
+
+/// \Given the initial CRC `0x0000` and a buffer
+///
+/// \When co_crc() is called for consecutive 7-byte segments of the buffer,
+///       with the result of the previous call as the initial value
+///
+/// \Then the same CRC is returned as when co_crc() is called once for the
+///       entire buffer
+TEST(CO_Crc, Incremental) {
+  const size_t BUF_SIZE = 1000u;
+  uint_least8_t buf[BUF_SIZE] = {0};
+  for (size_t i = 0; i < BUF_SIZE; i++)
+    buf[i] = static_cast<uint_least8_t>(i * 31u + 7u);
+
+  uint_least16_t crc = 0x0000u;
+  for (size_t i = 0; i < BUF_SIZE; i += 7u)
+    crc = co_crc(crc, buf + i, BUF_SIZE - i < 7u ? BUF_SIZE - i : 7u);
+
+  CHECK_EQUAL(co_crc(0x0000u, buf, BUF_SIZE), crc);
+}
+
 ///@}
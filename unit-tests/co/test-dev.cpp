@@ -1596,4 +1596,59 @@ TEST(CO_DevTpdoEvent, CoDevTpdEvent_CallsIndicationFunction_ForMatchedTpdos) {
   CHECK_EQUAL(30, CO_DevTPDO_Static::tpdo_event_ind_last_pdo_num);
 }
 
+TEST(CO_DevTpdoEvent, CoDevTpdoEvent_SubMappedTwice_SingleIndication) {
+  CreateAcyclicTpdoCommObject();
+  CreateSingleEntryMapping(EncodeMapping(OBJ_IDX, SUB_IDX, SUB_SIZE));
+  co_sub_t* const map_sub = co_dev_find_sub(dev, 0x1a00u, 0x01u);
+  co_sub_t* const map2_sub = co_sub_create(0x02u, CO_DEFTYPE_UNSIGNED32);
+  CHECK(map2_sub != nullptr);
+  CHECK_EQUAL(0, co_obj_insert_sub(co_sub_get_obj(map_sub), map2_sub));
+  co_sub_set_val_u32(map2_sub, EncodeMapping(OBJ_IDX, SUB_IDX, SUB_SIZE));
+  co_sub_set_val_u8(co_dev_find_sub(dev, 0x1a00u, 0x00u), 0x02u);
+
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+}
+
+TEST(CO_DevTpdoEvent, CoDevTpdoEvent_MappingChanged) {
+  CreateAcyclicTpdoCommObject();
+  CreateSingleEntryMapping(EncodeMapping(OBJ_IDX, SUB_IDX, SUB_SIZE));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+
+  co_sub_set_val_u32(co_dev_find_sub(dev, 0x1a00u, 0x01u),
+                     EncodeMapping(OBJ_IDX, SUB_IDX + 10, SUB_SIZE));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+}
+
+TEST(CO_DevTpdoEvent, CoDevTpdoEvent_CobIdInvalidatedByDownload) {
+  CreateAcyclicTpdoCommObject();
+  CreateSingleEntryMapping(EncodeMapping(OBJ_IDX, SUB_IDX, SUB_SIZE));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+
+  co_unsigned32_t cobid = DEV_ID | CO_PDO_COBID_VALID;
+  CHECK_EQUAL(0, co_sub_dn(co_dev_find_sub(dev, 0x1800u, 0x01u), &cobid));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+}
+
+TEST(CO_DevTpdoEvent, CoDevTpdoEvent_MappingObjectRemoved) {
+  CreateAcyclicTpdoCommObject();
+  CreateSingleEntryMapping(EncodeMapping(OBJ_IDX, SUB_IDX, SUB_SIZE));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+
+  co_obj_t* const obj1a00 = co_dev_find_obj(dev, 0x1a00u);
+  CHECK_EQUAL(0, co_dev_remove_obj(dev, obj1a00));
+  co_dev_tpdo_event(dev, OBJ_IDX, SUB_IDX);
+  CHECK_EQUAL(0, co_dev_insert_obj(dev, obj1a00));
+
+  CHECK_EQUAL(1, CO_DevTPDO_Static::tpdo_event_ind_counter);
+}
+
 #endif  // !LELY_NO_CO_TPDO
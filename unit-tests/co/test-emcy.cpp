@@ -146,24 +146,24 @@ TEST(CO_EmcyCreate, CoEmcyAlignof_Nominal) {
 ///
 /// \When co_emcy_sizeof() is called
 ///
-/// \Then if LELY_NO_MALLOC and !LELY_NO_CANFD: 3336 is returned;
-///       else if LELY_NO_MALLOC: 2440 is returned;
-///       else if \__MINGW32__ and !__MINGW64__: 1368 is returned;
-///       else 2160 is returned
+/// \Then if LELY_NO_MALLOC and !LELY_NO_CANFD: 1824 is returned;
+///       else if LELY_NO_MALLOC: 928 is returned;
+///       else if \__MINGW32__ and !__MINGW64__: 868 is returned;
+///       else 648 is returned
 TEST(CO_EmcyCreate, CoEmcySizeof_Nominal) {
   const auto size = co_emcy_sizeof();
 
 #ifdef LELY_NO_MALLOC
 #if !LELY_NO_CANFD
-  CHECK_EQUAL(3336u, size);
+  CHECK_EQUAL(1824u, size);
 #else
-  CHECK_EQUAL(2440u, size);
+  CHECK_EQUAL(928u, size);
 #endif
 #else
 #if defined(__MINGW32__) && !defined(__MINGW64__)
-  CHECK_EQUAL(1368u, size);
+  CHECK_EQUAL(868u, size);
 #else
-  CHECK_EQUAL(2160u, size);
+  CHECK_EQUAL(648u, size);
 #endif
 #endif  // LELY_NO_MALLOC
 }
@@ -487,8 +487,8 @@ TEST(CO_EmcyAllocation, CoEmcyCreate_MemoryOnlyForEmcyAndTimer) {
 /// \Given pointers to initialized device (co_dev_t) and network (can_net_t),
 ///        the Emergency Consumer Object (0x1028) with at least one consumer
 ///        COB-ID configured and a memory allocator limited exactly to allocate
-///        instances of an EMCY service, a timer (can_timer_t) and one frame
-///        receiver (can_recv_t) for every consumer COB-ID
+///        instances of an EMCY service, a timer (can_timer_t) and a single
+///        frame receiver (can_recv_t) shared by all consumer COB-IDs
 ///
 /// \When co_emcy_create() is called with the pointers to the network and the
 ///       device
@@ -222,18 +222,14 @@ TEST_GROUP_BASE(CO_NmtAllocation, CO_NmtBase) {
 
   static size_t GetSlavesAllocSize() {
     size_t size = 0;
-#if !LELY_NO_CO_MASTER
-    size += can_recv_sizeof();
-#if !LELY_NO_CO_NG
+#if !LELY_NO_CO_MASTER && !LELY_NO_CO_NG
     size += can_timer_sizeof();
 #endif
-#endif  // !LELY_NO_CO_MASTER
     return CO_NUM_NODES * size;
   }
 
   static size_t GetHbConsumersAllocSize(const size_t hb_num) {
-    return hb_num *
-           (co_nmt_hb_sizeof() + can_recv_sizeof() + can_timer_sizeof());
+    return hb_num * (co_nmt_hb_sizeof() + can_timer_sizeof());
   }
 
   static size_t GetSsdoAllocSize(size_t ssdo_num = 1u) {
@@ -257,7 +253,7 @@ TEST_GROUP_BASE(CO_NmtAllocation, CO_NmtBase) {
     return size;
   }
 
-  static size_t GetNmtRecvsAllocSize() { return 2u * can_recv_sizeof(); }
+  static size_t GetNmtRecvsAllocSize() { return 3u * can_recv_sizeof(); }
 
   TEST_SETUP() {
     LelyUnitTest::DisableDiagnosticMessages();
@@ -462,7 +458,7 @@ TEST(CO_NmtAllocation, CoNmtCreate_NoMemoryForEcRecv) {
 /// \Given initialized device (co_dev_t) and network (can_net_t) with a memory
 ///        allocator limited to only allocate the NMT service instance, DCFs for
 ///        application/communication parameters, the default services instances,
-///        a receiver for NMT messages and a receiver for NMT error control
+///        a receiver for NMT messages and two receivers for NMT error control
 ///        messages
 ///
 /// \When co_nmt_create() is called with pointers to the network and the device
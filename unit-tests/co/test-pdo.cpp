@@ -30,6 +30,7 @@
 #include <CppUTest/TestHarness.h>
 
 #include <lely/can/msg.h>
+#include <lely/co/detail/obj.h>
 #include <lely/co/dev.h>
 #include <lely/co/obj.h>
 #include <lely/co/pdo.h>
@@ -1637,4 +1638,108 @@ TEST(CoPdo_CoPdoUp, Nominal) {
   CHECK_EQUAL(0x00u, buf[5]);
 }
 
+TEST_GROUP_BASE(CoPdo_CoPdoPlan, CO_PdoBase) {
+  co_pdo_map_par par = CO_PDO_MAP_PAR_INIT;
+  co_pdo_plan plan = CO_PDO_PLAN_INIT;
+  co_sub_t* sub = nullptr;
+
+  static bool sub_dn_ind_called;
+
+  static co_unsigned32_t sub_dn_ind(co_sub_t* sub, co_sdo_req* req,
+                                    co_unsigned32_t ac, void*) {
+    if (ac) return ac;
+    sub_dn_ind_called = true;
+    return co_sub_default_dn_ind(sub, req, ac, nullptr);
+  }
+
+  TEST_SETUP() {
+    TEST_BASE_SETUP();
+    sub_dn_ind_called = false;
+
+    CoObjTHolder obj(DEFAULT_OBJ_IDX);
+    CHECK(obj.Get() != nullptr);
+    obj.InsertAndSetSub(0x01u, CO_DEFTYPE_UNSIGNED16, co_unsigned16_t(0u));
+    sub = obj.GetLastSub();
+    CHECK_EQUAL(0, co_sub_set_access(sub, CO_ACCESS_RW));
+    co_sub_set_pdo_mapping(sub, 1);
+    CHECK_EQUAL(0, co_dev_insert_obj(dev, obj.Take()));
+
+    par.n = 0x03u;
+    par.map[0] = 0x00000008u;
+    par.map[2] = (co_unsigned32_t(DEFAULT_OBJ_IDX) << 16) | 0x0110u;
+    co_dev_set_dummy(dev, 0xffffffffu);
+  }
+};
+bool TEST_GROUP_CppUTestGroupCoPdo_CoPdoPlan::sub_dn_ind_called = false;
+
+TEST(CoPdo_CoPdoPlan, Init) {
+  co_pdo_plan_init(&plan, &par, dev);
+
+  CHECK_EQUAL(2u, plan.n);
+  CHECK_EQUAL(24u, plan.bits);
+  POINTERS_EQUAL(nullptr, plan.ent[0].sub);
+  CHECK_EQUAL(0u, plan.ent[0].offset);
+  CHECK_EQUAL(8u, plan.ent[0].len);
+  POINTERS_EQUAL(sub, plan.ent[1].sub);
+  CHECK_EQUAL(8u, plan.ent[1].offset);
+  CHECK_EQUAL(16u, plan.ent[1].len);
+}
+
+TEST(CoPdo_CoPdoPlan, Dn_BufferTooSmall) {
+  co_pdo_plan_init(&plan, &par, dev);
+  const uint_least8_t buf[2] = {0x00u, 0x34u};
+
+  const auto ret = co_pdo_plan_dn(&plan, dev, &req, buf, sizeof(buf));
+
+  CHECK_EQUAL(CO_SDO_AC_PDO_LEN, ret);
+}
+
+TEST(CoPdo_CoPdoPlan, Dn_Nominal) {
+  co_pdo_plan_init(&plan, &par, dev);
+  const uint_least8_t buf[3] = {0x00u, 0x34u, 0x12u};
+
+  const auto ret = co_pdo_plan_dn(&plan, dev, &req, buf, sizeof(buf));
+
+  CHECK_EQUAL(0u, ret);
+  CHECK_EQUAL(0x1234u, co_sub_get_val_u16(sub));
+}
+
+TEST(CoPdo_CoPdoPlan, Dn_CustomDnInd) {
+  co_sub_set_dn_ind(sub, &sub_dn_ind, nullptr);
+  co_pdo_plan_init(&plan, &par, dev);
+  const uint_least8_t buf[3] = {0x00u, 0x34u, 0x12u};
+
+  const auto ret = co_pdo_plan_dn(&plan, dev, &req, buf, sizeof(buf));
+
+  CHECK_EQUAL(0u, ret);
+  CHECK(sub_dn_ind_called);
+  CHECK_EQUAL(0x1234u, co_sub_get_val_u16(sub));
+}
+
+TEST(CoPdo_CoPdoPlan, Dn_NoWrite) {
+  CHECK_EQUAL(0, co_sub_set_access(sub, CO_ACCESS_RO));
+  co_pdo_plan_init(&plan, &par, dev);
+  const uint_least8_t buf[3] = {0x00u, 0x34u, 0x12u};
+
+  const auto ret = co_pdo_plan_dn(&plan, dev, &req, buf, sizeof(buf));
+
+  CHECK_EQUAL(CO_SDO_AC_NO_WRITE, ret);
+}
+
+TEST(CoPdo_CoPdoPlan, Up_Nominal) {
+  par.n = 0x01u;
+  par.map[0] = par.map[2];
+  co_pdo_plan_init(&plan, &par, dev);
+  co_sub_set_val_u16(sub, 0xbbddu);
+  uint_least8_t buf[CAN_MAX_LEN] = {0};
+  size_t n = sizeof(buf);
+
+  const auto ret = co_pdo_plan_up(&plan, dev, &req, buf, &n);
+
+  CHECK_EQUAL(0u, ret);
+  CHECK_EQUAL(2u, n);
+  CHECK_EQUAL(0xddu, buf[0]);
+  CHECK_EQUAL(0xbbu, buf[1]);
+}
+
 // TODO(sdo): check if buffers have correct values after the download/upload
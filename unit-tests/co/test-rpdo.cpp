@@ -931,6 +931,35 @@ TEST(CO_Rpdo, CoRpdoRecv_ExpiredSyncWindow) {
   CHECK(!CO_RpdoStatic::rpdo_err_func_called);
 }
 
+TEST(CO_Rpdo, CoRpdoRecv_ExpiredSharedSyncWindow) {
+  SetComm00HighestSubidxSupported(0x02u);
+  SetComm01CobId(DEV_ID);
+  SetComm02SynchronousTransmission();
+
+  CreateRpdo();
+  co_rpdo_set_ind(rpdo, rpdo_ind_func, nullptr);
+  co_rpdo_set_err(rpdo, rpdo_err_func, nullptr);
+  StartRpdo();
+
+  // start sync window, provided by the caller instead of object 0x1007
+  const timespec end = {0, 1000u};
+  CHECK_EQUAL(0, co_rpdo_sync_swnd(rpdo, 0x00u, &end));
+
+  // expire sync window
+  CHECK_EQUAL(0, can_net_set_time(net, &end));
+
+  can_msg msg = CAN_MSG_INIT;
+  msg.id = DEV_ID;
+  const auto recv = can_net_recv(net, &msg);
+  CHECK_EQUAL(0, recv);
+
+  CHECK_EQUAL(0, co_rpdo_sync(rpdo, 0x00u));
+
+  // message was ignored as sync window had already expired when it was received
+  CHECK(!CO_RpdoStatic::rpdo_ind_func_called);
+  CHECK(!CO_RpdoStatic::rpdo_err_func_called);
+}
+
 TEST(CO_Rpdo, CoRpdoRecv_NoPDOInSyncWindow_NoErrFunc) {
   SetComm00HighestSubidxSupported(0x05u);
   SetComm01CobId(DEV_ID);
@@ -1064,26 +1093,9 @@ TEST(CO_RpdoAllocation, CoRpdoCreate_MemoryOnlyForRpdoAndTimer) {
   POINTERS_EQUAL(nullptr, rpdo);
 }
 
-TEST(CO_RpdoAllocation, CoRpdoCreate_MemoryOnlyForRpdoAndRecvAndSingleTimer) {
-  limitedAllocator.LimitAllocationTo(co_rpdo_sizeof() + can_recv_sizeof() +
-                                     can_timer_sizeof());
-
-  rpdo = co_rpdo_create(net, dev, DEV_ID);
-
-  POINTERS_EQUAL(nullptr, rpdo);
-}
-
-TEST(CO_RpdoAllocation, CoRpdoCreate_MemoryOnlyForRpdoAndTwoTimers) {
-  limitedAllocator.LimitAllocationTo(co_rpdo_sizeof() + 2 * can_timer_sizeof());
-
-  rpdo = co_rpdo_create(net, dev, DEV_ID);
-
-  POINTERS_EQUAL(nullptr, rpdo);
-}
-
 TEST(CO_RpdoAllocation, CoRpdoCreate_AllNecessaryMemoryIsAvailable) {
   limitedAllocator.LimitAllocationTo(co_rpdo_sizeof() + can_recv_sizeof() +
-                                     2 * can_timer_sizeof());
+                                     can_timer_sizeof());
 
   rpdo = co_rpdo_create(net, dev, DEV_ID);
 
@@ -1156,6 +1156,30 @@ TEST(CO_Tpdo, CoTpdoSampleRes_SyncWindowTimeout) {
   POINTERS_EQUAL(&ind_data, CoTpdoInd::data);
 }
 
+TEST(CO_Tpdo, CoTpdoSampleRes_SharedSyncWindowTimeout) {
+  SetComm00HighestSubidxSupported(0x02u);
+  SetComm01CobId(DEV_ID);
+  SetComm02TransmissionType(0x01u);
+
+  CreateTpdo();
+  co_tpdo_set_sample_ind(tpdo, CoTpdoSampleInd::func, &sind_data);
+
+  const timespec end = {0, 1000000u};  // 1 ms
+  CHECK_EQUAL(0, co_tpdo_sync_swnd(tpdo, 0, &end));
+  CHECK(CoTpdoSampleInd::called);
+
+  CHECK_EQUAL(0, can_net_set_time(net, &end));
+
+  const auto ret = co_tpdo_sample_res(tpdo, 0);
+
+  CHECK_EQUAL(0, ret);
+  CHECK(!CanSend::called());
+
+  CHECK(CoTpdoInd::called);
+  POINTERS_EQUAL(tpdo, CoTpdoInd::pdo);
+  CHECK_EQUAL(CO_SDO_AC_TIMEOUT, CoTpdoInd::ac);
+}
+
 TEST(CO_Tpdo, CoTpdoSampleRes_InitFrameFail) {
   SetComm00HighestSubidxSupported(0x02u);
   SetComm01CobId(DEV_ID);
@@ -1446,26 +1470,9 @@ TEST(CO_TpdoAllocation, CoTpdoCreate_MemoryOnlyForTpdoAndTimer) {
   POINTERS_EQUAL(nullptr, tpdo);
 }
 
-TEST(CO_TpdoAllocation, CoTpdoCreate_MemoryOnlyForTpdoAndRecvAndSingleTimer) {
-  limitedAllocator.LimitAllocationTo(co_tpdo_sizeof() + can_recv_sizeof() +
-                                     can_timer_sizeof());
-
-  tpdo = co_tpdo_create(net, dev, DEV_ID);
-
-  POINTERS_EQUAL(nullptr, tpdo);
-}
-
-TEST(CO_TpdoAllocation, CoTpdoCreate_MemoryOnlyForTpdoAndTwoTimers) {
-  limitedAllocator.LimitAllocationTo(co_tpdo_sizeof() + 2 * can_timer_sizeof());
-
-  tpdo = co_tpdo_create(net, dev, DEV_ID);
-
-  POINTERS_EQUAL(nullptr, tpdo);
-}
-
 TEST(CO_TpdoAllocation, CoTpdoCreate_AllNecessaryMemoryIsAvailable) {
   limitedAllocator.LimitAllocationTo(co_tpdo_sizeof() + can_recv_sizeof() +
-                                     2 * can_timer_sizeof());
+                                     can_timer_sizeof());
 
   tpdo = co_tpdo_create(net, dev, DEV_ID);
 
@@ -0,0 +1,243 @@
+/**@file
+ * This file is part of the CANopen Library Unit Test Suite.
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <CppUTest/TestHarness.h>
+
+#include <cstddef>
+
+#include <lely/util/error.h>
+#include <lely/util/sizepool.h>
+
+TEST_GROUP(Util_SizePoolInit) {
+  static const size_t ALIGN = alignof(max_align_t);
+
+  sizepool pool;
+  alignas(max_align_t) char memory[16 * ALIGN];
+};
+
+/// @name sizepool_init()
+///@{
+
+/// \Given an uninitialized size-class memory pool, a memory buffer and a list
+///        of size classes
+///
+/// \When sizepool_init() is called
+///
+/// \Then a pointer to an abstract allocator (alloc_t) is returned, the block
+///       sizes are rounded up to the fundamental alignment and the classes are
+///       laid out consecutively in the memory buffer
+TEST(Util_SizePoolInit, SizePool_Init) {
+  sizepool_class classes[] = {SIZEPOOL_CLASS_INIT(1, 4),
+                              SIZEPOOL_CLASS_INIT(ALIGN + 1, 2)};
+
+  CHECK_EQUAL(8u * ALIGN, sizepool_sizeof(classes, 2));
+
+  const auto* alloc = sizepool_init(&pool, memory, sizeof(memory), classes, 2);
+
+  CHECK(alloc != nullptr);
+  CHECK_EQUAL(ALIGN, classes[0].size);
+  POINTERS_EQUAL(memory, classes[0].beg);
+  CHECK_EQUAL(2u * ALIGN, classes[1].size);
+  POINTERS_EQUAL(memory + 4u * ALIGN, classes[1].beg);
+  CHECK_EQUAL(0, mem_size(alloc));
+  CHECK_EQUAL(8u * ALIGN, mem_capacity(alloc));
+}
+
+/// \Given an uninitialized size-class memory pool and a memory buffer
+///
+/// \When sizepool_init() is called with size classes requiring more memory
+///       than available
+///
+/// \Then a null pointer is returned and ERRNUM_NOMEM error number is set
+TEST(Util_SizePoolInit, SizePool_Init_TooSmall) {
+  sizepool_class classes[] = {SIZEPOOL_CLASS_INIT(ALIGN, 17)};
+
+  const auto* alloc = sizepool_init(&pool, memory, sizeof(memory), classes, 1);
+
+  POINTERS_EQUAL(nullptr, alloc);
+  CHECK_EQUAL(ERRNUM_NOMEM, get_errnum());
+}
+
+/// \Given an uninitialized size-class memory pool and a memory buffer
+///
+/// \When sizepool_init() is called with size classes which are not sorted by
+///       block size
+///
+/// \Then a null pointer is returned and ERRNUM_INVAL error number is set
+TEST(Util_SizePoolInit, SizePool_Init_Unsorted) {
+  sizepool_class classes[] = {SIZEPOOL_CLASS_INIT(2 * ALIGN, 1),
+                              SIZEPOOL_CLASS_INIT(ALIGN, 1)};
+
+  const auto* alloc = sizepool_init(&pool, memory, sizeof(memory), classes, 2);
+
+  POINTERS_EQUAL(nullptr, alloc);
+  CHECK_EQUAL(ERRNUM_INVAL, get_errnum());
+}
+
+///@}
+
+TEST_GROUP(Util_SizePool) {
+  static const size_t ALIGN = alignof(max_align_t);
+
+  sizepool pool;
+  sizepool_class classes[2] = {SIZEPOOL_CLASS_INIT(ALIGN, 2),
+                               SIZEPOOL_CLASS_INIT(4 * ALIGN, 1)};
+  alignas(max_align_t) char memory[6 * ALIGN];
+  alloc_t* alloc = nullptr;
+
+  TEST_SETUP() {
+    alloc = sizepool_init(&pool, memory, sizeof(memory), classes, 2);
+    CHECK(alloc != nullptr);
+  }
+};
+
+/// @name mem_alloc()
+///@{
+
+/// \Given a pointer to an allocator (alloc_t) based on a size-class memory
+///        pool, with no prior allocations
+///
+/// \When mem_alloc() is called with a size fitting the smallest class
+///
+/// \Then a pointer to the first block of the smallest class is returned, the
+///       size and usage statistics of the pool and the class are updated
+TEST(Util_SizePool, SizePool_Alloc) {
+  const auto result = mem_alloc(alloc, 0, 1);
+
+  POINTERS_EQUAL(memory, result);
+  CHECK_EQUAL(ALIGN, mem_size(alloc));
+  CHECK_EQUAL(5u * ALIGN, mem_capacity(alloc));
+  CHECK_EQUAL(1u, classes[0].used);
+  CHECK_EQUAL(1u, classes[0].max_used);
+  CHECK_EQUAL(ALIGN, pool.max_used);
+}
+
+/// \Given a pointer to an allocator (alloc_t) based on a size-class memory
+///        pool, with all blocks of the smallest class in use
+///
+/// \When mem_alloc() is called with a size fitting the smallest class
+///
+/// \Then a block of the next larger class is returned and the failed attempt
+///       is recorded in the statistics of the smallest class
+TEST(Util_SizePool, SizePool_Alloc_NextClass) {
+  CHECK(mem_alloc(alloc, 0, ALIGN) != nullptr);
+  CHECK(mem_alloc(alloc, 0, ALIGN) != nullptr);
+
+  const auto result = mem_alloc(alloc, 0, ALIGN);
+
+  POINTERS_EQUAL(memory + 2u * ALIGN, result);
+  CHECK_EQUAL(1u, classes[0].nfail);
+  CHECK_EQUAL(1u, classes[1].used);
+  CHECK_EQUAL(0, pool.nfail);
+}
+
+/// \Given a pointer to an allocator (alloc_t) based on a size-class memory
+///        pool, with no prior allocations
+///
+/// \When mem_alloc() is called with a size larger than the largest class
+///
+/// \Then a null pointer is returned, nothing is changed, ERRNUM_NOMEM error
+///       number is set and the failure is recorded
+TEST(Util_SizePool, SizePool_Alloc_TooLarge) {
+  const auto result = mem_alloc(alloc, 0, 4u * ALIGN + 1u);
+
+  POINTERS_EQUAL(nullptr, result);
+  CHECK_EQUAL(0, mem_size(alloc));
+  CHECK_EQUAL(ERRNUM_NOMEM, get_errnum());
+  CHECK_EQUAL(1u, pool.nfail);
+}
+
+/// \Given a pointer to an allocator (alloc_t) based on a size-class memory
+///        pool, with no prior allocations
+///
+/// \When mem_alloc() is called with an alignment larger than the fundamental
+///       alignment
+///
+/// \Then a null pointer is returned, nothing is changed and ERRNUM_INVAL error
+///       number is set
+TEST(Util_SizePool, SizePool_Alloc_IncorrectAlignment) {
+  const auto result = mem_alloc(alloc, 2u * ALIGN, 1u);
+
+  POINTERS_EQUAL(nullptr, result);
+  CHECK_EQUAL(0, mem_size(alloc));
+  CHECK_EQUAL(ERRNUM_INVAL, get_errnum());
+}
+
+///@}
+
+/// @name mem_free()
+///@{
+
+/// \Given a pointer to an allocator (alloc_t) based on a size-class memory
+///        pool, with a block allocated
+///
+/// \When mem_free() is called with the block and a block of the same class is
+///       allocated again
+///
+/// \Then the freed block is reused, the size of the pool is restored and the
+///       high-water mark is unchanged
+TEST(Util_SizePool, SizePool_Free) {
+  const auto ptr1 = mem_alloc(alloc, 0, ALIGN);
+  const auto ptr2 = mem_alloc(alloc, 0, ALIGN);
+
+  mem_free(alloc, ptr1);
+
+  CHECK_EQUAL(ALIGN, mem_size(alloc));
+  CHECK_EQUAL(1u, classes[0].used);
+  CHECK_EQUAL(2u, classes[0].max_used);
+
+  POINTERS_EQUAL(ptr1, mem_alloc(alloc, 0, ALIGN));
+
+  mem_free(alloc, ptr1);
+  mem_free(alloc, ptr2);
+
+  CHECK_EQUAL(0, mem_size(alloc));
+  CHECK_EQUAL(2u * ALIGN, pool.max_used);
+}
+
+///@}
+
+/// @name sizepool_reset_stats()
+///@{
+
+/// \Given a size-class memory pool with a block in use and a failed
+///        allocation
+///
+/// \When sizepool_reset_stats() is called
+///
+/// \Then the high-water marks are set to the current usage and the number of
+///       failed allocations is cleared
+TEST(Util_SizePool, SizePool_ResetStats) {
+  const auto ptr = mem_alloc(alloc, 0, ALIGN);
+  mem_free(alloc, mem_alloc(alloc, 0, ALIGN));
+  mem_alloc(alloc, 0, 8u * ALIGN);
+
+  sizepool_reset_stats(&pool);
+
+  CHECK_EQUAL(1u, classes[0].max_used);
+  CHECK_EQUAL(ALIGN, pool.max_used);
+  CHECK_EQUAL(0, pool.nfail);
+
+  mem_free(alloc, ptr);
+}
+
+///@}
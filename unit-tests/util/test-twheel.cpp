@@ -0,0 +1,287 @@
+/**@file
+ * This file is part of the CANopen Library Unit Test Suite.
+ *
+ * @copyright 2026 agent <agent@local>
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#include <config.h>
+#endif
+
+#include <cstdint>
+
+#include <CppUTest/TestHarness.h>
+
+#include <lely/util/twheel.h>
+#include <lely/util/util.h>
+
+TEST_GROUP(Util_Twheel) {
+  twheel wheel;
+  static const size_t NODES_NUM = 6;
+
+  twnode nodes[NODES_NUM];
+  const uint_least64_t keys[NODES_NUM] = {
+      1u, 63u, 64u, 4095u, 4096u, UINT64_C(0x8000000000000000)};
+
+  bool Contains(const dllist* const list, const twnode* const node) {
+    dllist_foreach(list, dlnode) {
+      if (structof(dlnode, twnode, list) == node) return true;
+    }
+    return false;
+  }
+
+  TEST_SETUP() {
+    twheel_init(&wheel, 0);
+
+    for (size_t i = 0; i < NODES_NUM; i++) twnode_init(&nodes[i], keys[i]);
+  }
+};
+
+/// @name twheel_init()
+///@{
+
+/// \Given an uninitialized timing wheel (twheel)
+///
+/// \When twheel_init() is called with the current time
+///
+/// \Then the wheel is empty, the current time is set and no first node is
+///       available
+TEST(Util_Twheel, TwheelInit_Nominal) {
+  twheel_init(&wheel, 42u);
+
+  CHECK_EQUAL(42u, twheel_now(&wheel));
+  CHECK_EQUAL(1, twheel_empty(&wheel));
+  CHECK_EQUAL(0, twheel_size(&wheel));
+  CHECK_EQUAL(UINT64_MAX, twheel_next(&wheel));
+  POINTERS_EQUAL(nullptr, twheel_first(&wheel));
+}
+
+///@}
+
+/// @name twheel_insert()
+///@{
+
+/// \Given an empty timing wheel (twheel)
+///
+/// \When twheel_insert() is called with nodes with keys at every level
+///
+/// \Then the size of the wheel is updated and the node with the smallest key
+///       is the first node
+TEST(Util_Twheel, TwheelInsert_Nominal) {
+  for (size_t i = NODES_NUM; i > 0; i--) twheel_insert(&wheel, &nodes[i - 1]);
+
+  CHECK_EQUAL(NODES_NUM, twheel_size(&wheel));
+  POINTERS_EQUAL(&nodes[0], twheel_first(&wheel));
+}
+
+/// \Given a timing wheel (twheel)
+///
+/// \When twheel_insert() is called with a node with a key which is not later
+///       than the current time
+///
+/// \Then the node is reported as expired by the next call to twheel_advance()
+TEST(Util_Twheel, TwheelInsert_Expired) {
+  twheel_init(&wheel, 64u);
+
+  twheel_insert(&wheel, &nodes[0]);
+  POINTERS_EQUAL(&nodes[0], twheel_first(&wheel));
+
+  dllist expired;
+  dllist_init(&expired);
+  twheel_advance(&wheel, 64u, &expired);
+
+  CHECK_EQUAL(1u, dllist_size(&expired));
+  CHECK(Contains(&expired, &nodes[0]));
+  CHECK_EQUAL(1, twheel_empty(&wheel));
+}
+
+///@}
+
+/// @name twheel_remove()
+///@{
+
+/// \Given a timing wheel (twheel) with nodes inserted
+///
+/// \When twheel_remove() is called for the first node
+///
+/// \Then the size of the wheel is updated and the next node becomes the first
+///       node
+TEST(Util_Twheel, TwheelRemove_Nominal) {
+  for (size_t i = 0; i < NODES_NUM; i++) twheel_insert(&wheel, &nodes[i]);
+
+  twheel_remove(&wheel, &nodes[0]);
+
+  CHECK_EQUAL(NODES_NUM - 1u, twheel_size(&wheel));
+  POINTERS_EQUAL(&nodes[1], twheel_first(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with all nodes inserted
+///
+/// \When twheel_remove() is called for every node
+///
+/// \Then the wheel is empty
+TEST(Util_Twheel, TwheelRemove_All) {
+  for (size_t i = 0; i < NODES_NUM; i++) twheel_insert(&wheel, &nodes[i]);
+
+  for (size_t i = 0; i < NODES_NUM; i++) twheel_remove(&wheel, &nodes[i]);
+
+  CHECK_EQUAL(1, twheel_empty(&wheel));
+  POINTERS_EQUAL(nullptr, twheel_first(&wheel));
+}
+
+///@}
+
+/// @name twheel_advance()
+///@{
+
+/// \Given a timing wheel (twheel) with nodes inserted at several levels
+///
+/// \When twheel_advance() is called with a time between the keys of the nodes
+///
+/// \Then only the nodes with a key not later than the new time are reported as
+///       expired, the other nodes remain in the wheel
+TEST(Util_Twheel, TwheelAdvance_Nominal) {
+  for (size_t i = 0; i < NODES_NUM; i++) twheel_insert(&wheel, &nodes[i]);
+
+  dllist expired;
+  dllist_init(&expired);
+  twheel_advance(&wheel, 64u, &expired);
+
+  CHECK_EQUAL(64u, twheel_now(&wheel));
+  CHECK_EQUAL(3u, dllist_size(&expired));
+  CHECK(Contains(&expired, &nodes[0]));
+  CHECK(Contains(&expired, &nodes[1]));
+  CHECK(Contains(&expired, &nodes[2]));
+  CHECK_EQUAL(NODES_NUM - 3u, twheel_size(&wheel));
+  POINTERS_EQUAL(&nodes[3], twheel_first(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with nodes inserted at several levels
+///
+/// \When twheel_advance() is called repeatedly with one tick at a time
+///
+/// \Then every node is reported as expired exactly at its key
+TEST(Util_Twheel, TwheelAdvance_Tick) {
+  for (size_t i = 0; i < NODES_NUM - 1u; i++) twheel_insert(&wheel, &nodes[i]);
+
+  dllist expired;
+  dllist_init(&expired);
+  for (uint_least64_t now = 1; now <= keys[NODES_NUM - 2u]; now++) {
+    twheel_advance(&wheel, now, &expired);
+    dlnode* node = nullptr;
+    while ((node = dllist_pop_front(&expired)) != nullptr)
+      CHECK_EQUAL(now, structof(node, twnode, list)->key);
+  }
+
+  CHECK_EQUAL(1, twheel_empty(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with nodes inserted
+///
+/// \When twheel_advance() is called with a time earlier than the current time
+///
+/// \Then no node is reported as expired and the nodes are still ordered
+TEST(Util_Twheel, TwheelAdvance_Backwards) {
+  twheel_init(&wheel, 4000u);
+  twheel_insert(&wheel, &nodes[3]);
+  twheel_insert(&wheel, &nodes[4]);
+
+  dllist expired;
+  dllist_init(&expired);
+  twheel_advance(&wheel, 10u, &expired);
+
+  CHECK_EQUAL(10u, twheel_now(&wheel));
+  CHECK_EQUAL(1, dllist_empty(&expired));
+  CHECK_EQUAL(2u, twheel_size(&wheel));
+  POINTERS_EQUAL(&nodes[3], twheel_first(&wheel));
+
+  twheel_advance(&wheel, 4095u, &expired);
+
+  CHECK_EQUAL(1u, dllist_size(&expired));
+  CHECK(Contains(&expired, &nodes[3]));
+  POINTERS_EQUAL(&nodes[4], twheel_first(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with all nodes inserted
+///
+/// \When twheel_advance() is called with the maximum time
+///
+/// \Then all nodes are reported as expired
+TEST(Util_Twheel, TwheelAdvance_Max) {
+  for (size_t i = 0; i < NODES_NUM; i++) twheel_insert(&wheel, &nodes[i]);
+
+  dllist expired;
+  dllist_init(&expired);
+  twheel_advance(&wheel, UINT64_MAX, &expired);
+
+  CHECK_EQUAL(NODES_NUM, dllist_size(&expired));
+  CHECK_EQUAL(1, twheel_empty(&wheel));
+}
+
+///@}
+
+/// @name twheel_next()
+///@{
+
+/// \Given a timing wheel (twheel) with a node at the lowest level
+///
+/// \When twheel_next() is called
+///
+/// \Then the key of the node is returned
+TEST(Util_Twheel, TwheelNext_LowestLevel) {
+  twheel_insert(&wheel, &nodes[1]);
+  twheel_insert(&wheel, &nodes[4]);
+
+  CHECK_EQUAL(keys[1], twheel_next(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with two nodes in the same slot of a higher
+///        level
+///
+/// \When twheel_next() is called
+///
+/// \Then the start of the slot is returned, and once the wheel is advanced to
+///       that time, the key of the first node is returned
+TEST(Util_Twheel, TwheelNext_HigherLevel) {
+  twnode_init(&nodes[0], 4100u);
+  twnode_init(&nodes[1], 4097u);
+  twheel_insert(&wheel, &nodes[0]);
+  twheel_insert(&wheel, &nodes[1]);
+  twheel_insert(&wheel, &nodes[5]);
+
+  CHECK_EQUAL(4096u, twheel_next(&wheel));
+  POINTERS_EQUAL(&nodes[1], twheel_first(&wheel));
+
+  dllist expired;
+  dllist_init(&expired);
+  twheel_advance(&wheel, 4096u, &expired);
+
+  CHECK_EQUAL(1, dllist_empty(&expired));
+  CHECK_EQUAL(4097u, twheel_next(&wheel));
+}
+
+/// \Given a timing wheel (twheel) with an expired node
+///
+/// \When twheel_next() is called
+///
+/// \Then the current time is returned
+TEST(Util_Twheel, TwheelNext_Expired) {
+  twheel_init(&wheel, 64u);
+  twheel_insert(&wheel, &nodes[0]);
+
+  CHECK_EQUAL(64u, twheel_next(&wheel));
+}
+
+///@}